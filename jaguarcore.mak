@@ -7,6 +7,10 @@
 # This software is licensed under the GPL v3 or any later version. See the
 # file LICENSE file for details. ;-)
 #
+# Use STANDALONE=1 to build a self-contained library, without Qt & SDL, which
+# includes the 68K core and the C interface (see src/jaguarcore.h). As the
+# objects are not the same, do a clean build when switching between the two.
+#
 
 ifeq ("$(V)","1")
 Q :=
@@ -51,9 +55,11 @@ INCS := -I./src
 
 OBJS := \
 	obj/blitter.o      \
+	obj/brkcond.o      \
 	obj/cdintf.o       \
 	obj/cdrom.o        \
 	obj/dac.o          \
+	obj/dasmcache.o    \
 	obj/dsp.o          \
 	obj/eeprom.o       \
 	obj/event.o        \
@@ -69,18 +75,50 @@ OBJS := \
 	obj/jaguar.o       \
 	obj/jerry.o        \
 	obj/joystick.o     \
+	obj/machine.o      \
 	obj/memory.o       \
 	obj/memtrack.o     \
 	obj/mmu.o          \
 	obj/modelsBIOS.o   \
 	obj/op.o           \
+	obj/perfcounters.o \
+	obj/savedata.o     \
 	obj/state.o        \
 	obj/tom.o          \
+	obj/trace.o        \
 	obj/universalhdr.o \
 	obj/wavetable.o
 
+M68K_LIB  :=
+M68K_OBJS :=
+
+# Self-contained library, without Qt & SDL
+ifeq "$(STANDALONE)" "1"
+SDL_CFLAGS :=
+QT_CFLAGS := -fPIC
+DEFINES += -DNO_QT -DNO_SDL
+
+OBJS += \
+	obj/crc32.o        \
+	obj/jaguarcore.o   \
+	obj/log.o          \
+	obj/settings.o
+
+M68K_LIB  := src/m68000/obj/libm68k.a
+M68K_OBJS := \
+	src/m68000/obj/cpustbl.o \
+	src/m68000/obj/cpudefs.o \
+	src/m68000/obj/cpuemu.o \
+	src/m68000/obj/cpustbl_nf.o \
+	src/m68000/obj/cpuemu_nf.o \
+	src/m68000/obj/cpuextra.o \
+	src/m68000/obj/readcpu.o \
+	src/m68000/obj/m68kinterface.o \
+	src/m68000/obj/m68kdasm.o
+endif
+
 # Targets for convenience sake, not "real" targets
-.PHONY: clean
+.PHONY: clean vjtrace bin2z bios test
 
 all: obj obj/libjaguarcore.a
 	@echo "Done!"
@@ -89,8 +127,49 @@ obj:
 	@mkdir obj
 
 # Library rules (might not be cross-platform compatible)
-obj/libjaguarcore.a: $(OBJS) 
-	$(Q)$(AR) $(ARFLAGS) obj/libjaguarcore.a $(OBJS)
+obj/libjaguarcore.a: $(OBJS) $(M68K_LIB)
+	$(Q)$(AR) $(ARFLAGS) obj/libjaguarcore.a $(OBJS) $(M68K_OBJS)
+
+# Execution trace reader (see src/tools/vjtrace.cpp)
+vjtrace: obj obj/vjtrace
+
+obj/vjtrace: src/tools/vjtrace.cpp src/trace.h
+	@echo -e "\033[01;33m***\033[00;32m Compiling $<...\033[00m"
+	$(Q)$(CC) $(CXXFLAGS) $(INCS) $< -o $@ -lz -lstdc++
+
+# Compiled in BIOS & firmware images (see src/tools/bin2z.cpp); the images are not
+# distributed, BIOSDIR is the directory having them
+BIOSDIR := bios
+
+bin2z: obj obj/bin2z
+
+obj/bin2z: src/tools/bin2z.cpp
+	@echo -e "\033[01;33m***\033[00;32m Compiling $<...\033[00m"
+	$(Q)$(CC) $(CXXFLAGS) $< -o $@ -lz -lstdc++
+
+bios: bin2z
+	$(Q)obj/bin2z $(BIOSDIR)/jagbios.bin jaguarBootROM jagbios.h "This is the Jaguar Series K boot ROM" > src/jagbios.cpp
+	$(Q)obj/bin2z $(BIOSDIR)/jagbios2.bin jaguarBootROM2 jagbios2.h "This is the Jaguar Series M boot ROM" > src/jagbios2.cpp
+	$(Q)obj/bin2z $(BIOSDIR)/jagstub1bios.bin jaguarDevBootROM1 jagstub1bios.h > src/jagstub1bios.cpp
+	$(Q)obj/bin2z $(BIOSDIR)/jagstub2bios.bin jaguarDevBootROM2 jagstub2bios.h > src/jagstub2bios.cpp
+	$(Q)obj/bin2z $(BIOSDIR)/jagcdbios.bin jaguarCDBootROM jagcdbios.h > src/jagcdbios.cpp
+	$(Q)obj/bin2z $(BIOSDIR)/jagdevcdbios.bin jaguarDevCDBootROM jagdevcdbios.h > src/jagdevcdbios.cpp
+
+# Tests of the self-contained library (see src/tests), built & run by:
+# make -f jaguarcore.mak STANDALONE=1 test
+TESTS := obj/coretest obj/optest obj/riscdramtest
+
+test: obj obj/libjaguarcore.a $(TESTS)
+	$(Q)for t in $(TESTS); do $$t || exit 1; done
+
+obj/%test: src/tests/%test.cpp obj/libjaguarcore.a
+	@echo -e "\033[01;33m***\033[00;32m Compiling $<...\033[00m"
+	$(Q)$(CC) $(CXXFLAGS) $(DEFINES) $(INCS) -I./src/m68000 $< -o $@ -Lobj -ljaguarcore -lstdc++ -lm -lz -lpthread
+
+# The 68K core objects come from its own makefile
+src/m68000/obj/libm68k.a:
+	@echo -e "\033[01;33m***\033[00;32m Making Customized UAE 68K Core...\033[00m"
+	$(Q)$(MAKE) -C src/m68000 CROSS=$(CROSS) CFLAGS="$(CFLAGS) -fPIC" SDL_CFLAGS= V="$(V)"
 
 # Main source compilation (implicit rules)...
 
@@ -11,6 +11,9 @@
 // ---  ----------  -----------------------------------------------------------
 // JLH  01/16/2010  Created this log ;-)
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  Blitter state moved in the machine context
+// JPM   Oct./2026  Registers read/written at once
+// JPM   Oct./2026  Blits performance counters
 //
 
 //
@@ -29,6 +32,7 @@
 #include <string.h>
 #include "jaguar.h"
 #include "log.h"
+#include "machine.h"
 //#include "memory.h"
 #include "settings.h"
 
@@ -58,9 +62,9 @@ uint8_t blitter_working = 0;
 bool startConciseBlitLogging = false;
 bool logBlit = false;
 
-// Blitter register RAM (most of it is hidden from the user)
+// Blitter register RAM (most of it is hidden from the user), in the machine context (see blitter.h)
 
-static uint8_t blitter_ram[0x100];
+#define blitter_ram		(jaguarMachine->blitter.blitter_ram)
 
 // Other crapola
 
@@ -70,10 +74,8 @@ extern int blit_start_log;
 void BlitterMidsummer(uint32_t cmd);
 void BlitterMidsummer2(void);
 
-#define REG(A)	(((uint32_t)blitter_ram[(A)] << 24) | ((uint32_t)blitter_ram[(A)+1] << 16) \
-				| ((uint32_t)blitter_ram[(A)+2] << 8) | (uint32_t)blitter_ram[(A)+3])
-#define WREG(A,D)	(blitter_ram[(A)] = ((D)>>24)&0xFF, blitter_ram[(A)+1] = ((D)>>16)&0xFF, \
-					blitter_ram[(A)+2] = ((D)>>8)&0xFF, blitter_ram[(A)+3] = (D)&0xFF)
+#define REG(A)		GET32(blitter_ram, (A))
+#define WREG(A,D)	SET32(blitter_ram, (A), (D))
 
 // Blitter registers (offsets from F02200)
 
@@ -1747,6 +1749,9 @@ if (blit_start_log)
 #endif
 #else
 	{
+		PERF_COUNT_SHARED(blits, 1);
+		PERF_COUNT_SHARED(blitPixels, (REG(PIXLINECOUNTER) & 0xFFFF) * (REG(PIXLINECOUNTER) >> 16));
+
 		if (vjs.useFastBlitter)
 			blitter_blit(GET32(blitter_ram, 0x38));
 		else
@@ -5044,7 +5049,7 @@ void ADDARRAY(uint16_t * addq, uint8_t daddasel, uint8_t daddbsel, uint8_t daddm
 
 	uint8_t cinsel = (daddmode >= 1 && daddmode <= 4 ? 1 : 0);
 
-static uint8_t co[4];//These are preserved between calls...
+uint8_t * co = jaguarMachine->blitter.co;//These are preserved between calls (by the machine)...
 	uint8_t cin[4];
 
 	for(int i=0; i<4; i++)
@@ -5373,7 +5378,7 @@ Ci_y		:= EO (ci_y, cyt[1], suba_y);*/
 
 ////////////////////////////////////// C++ CODE //////////////////////////////////////
 //I'm sure the following will generate a bunch of warnings, but will have to do for now.
-	static uint16_t co_x = 0, co_y = 0;	// Carry out has to propogate between function calls...
+	uint16_t & co_x = jaguarMachine->blitter.co_x, & co_y = jaguarMachine->blitter.co_y;	// Carry out has to propogate between function calls (by the machine)...
 	uint16_t ci_x = co_x ^ (suba_x ? 1 : 0);
 	uint16_t ci_y = co_y ^ (suba_y ? 1 : 0);
 	uint32_t addqt_x = adda_x + addb_x + ci_x;
@@ -24,6 +24,15 @@ void blitter_reg_write(uint32_t offset, uint32_t data);
 
 extern uint8_t blitter_working;
 
+// Blitter state of a machine
+
+struct BlitterState
+{
+	uint8_t blitter_ram[0x100];					// Blitter register RAM (most of it is hidden from the user)
+	uint8_t co[4];								// Data adders carry out, preserved between calls
+	uint16_t co_x, co_y;						// Address adders carry out, preserved between calls
+};
+
 //For testing only...
 void LogBlit(void);
 
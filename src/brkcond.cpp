@@ -0,0 +1,365 @@
+//
+// brkcond.cpp - Conditions of the breakpoints
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// The expression is parsed by recursive descent into a postfix bytecode, run on
+// a small stack. The compiler keeps track of the stack depth, so the evaluation
+// does no checks; variables & symbols are resolved to addresses at compile
+// time, the debug information being looked up once only.
+//
+
+#include "brkcond.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jaguar.h"
+#include "m68000/m68kinterface.h"
+
+
+// Bytecode operations; BC_PUSH & BC_REG are followed by their operand
+enum
+{
+	BC_END = 0, BC_PUSH, BC_REG, BC_HITS, BC_READ8, BC_READ16, BC_READ32,
+	BC_NEG, BC_NOT, BC_LNOT, BC_MUL, BC_DIV, BC_MOD, BC_ADD, BC_SUB, BC_SHL, BC_SHR,
+	BC_LT, BC_LE, BC_GT, BC_GE, BC_EQ, BC_NE, BC_AND, BC_XOR, BC_OR, BC_LAND, BC_LOR
+};
+
+// Binary operators, by priority level (lowest first)
+struct BrkCondOperator
+{
+	const char * text;
+	uint32_t op;
+	int level;
+};
+
+static const BrkCondOperator operators[] = {
+	{ "||", BC_LOR, 0 }, { "&&", BC_LAND, 1 }, { "|", BC_OR, 2 }, { "^", BC_XOR, 3 }, { "&", BC_AND, 4 },
+	{ "==", BC_EQ, 5 }, { "!=", BC_NE, 5 }, { "<=", BC_LE, 6 }, { ">=", BC_GE, 6 }, { "<<", BC_SHL, 7 },
+	{ ">>", BC_SHR, 7 }, { "<", BC_LT, 6 }, { ">", BC_GT, 6 }, { "+", BC_ADD, 8 }, { "-", BC_SUB, 8 },
+	{ "*", BC_MUL, 9 }, { "/", BC_DIV, 9 }, { "%", BC_MOD, 9 }
+};
+
+#define BRKCOND_LEVELS		10
+
+// Parser state
+struct BrkCondParser
+{
+	const char * p;
+	BrkCondResolver resolver;
+	BrkCondition * condition;
+	int depth;
+	char * error;
+	size_t errorSize;
+	bool failed;
+};
+
+
+static void Fail(BrkCondParser * parser, const char * text)
+{
+	if (!parser->failed && parser->error && parser->errorSize)
+		snprintf(parser->error, parser->errorSize, "%s", text);
+
+	parser->failed = true;
+}
+
+
+static void SkipSpaces(BrkCondParser * parser)
+{
+	while (isspace((unsigned char)*parser->p))
+		parser->p++;
+}
+
+
+//
+// Add an operation, with the change of the stack depth it does
+//
+static void Emit(BrkCondParser * parser, uint32_t op, int stack)
+{
+	if (parser->condition->size >= (BRKCOND_CODE_MAX - 1))
+		return Fail(parser, "Condition too long");
+
+	parser->condition->code[parser->condition->size++] = op;
+
+	if ((parser->depth += stack) > BRKCOND_STACK_MAX)
+		Fail(parser, "Condition too complex");
+}
+
+
+static void EmitOperand(BrkCondParser * parser, uint32_t op, uint32_t value)
+{
+	Emit(parser, op, 1);
+	Emit(parser, value, 0);
+}
+
+
+//
+// Optional size of a memory access (.b, .w or .l), a long by default
+//
+static void EmitRead(BrkCondParser * parser)
+{
+	uint32_t op = BC_READ32;
+
+	if ((parser->p[0] == '.') && parser->p[1] && !isalnum((unsigned char)parser->p[2]))
+	{
+		switch (tolower((unsigned char)parser->p[1]))
+		{
+		case 'b':	op = BC_READ8;	parser->p += 2;	break;
+		case 'w':	op = BC_READ16;	parser->p += 2;	break;
+		case 'l':					parser->p += 2;	break;
+		default:
+			return Fail(parser, "Unknown size");
+		}
+	}
+
+	Emit(parser, op, 0);
+}
+
+
+static void ParseExpression(BrkCondParser * parser, int level);
+
+
+//
+// Number, register, hits, memory contents, variable, or unary operator
+//
+static void ParsePrimary(BrkCondParser * parser)
+{
+	SkipSpaces(parser);
+	char c = *parser->p;
+
+	if ((c == '-') || (c == '~') || (c == '!'))
+	{
+		parser->p++;
+		ParsePrimary(parser);
+		Emit(parser, (c == '-' ? BC_NEG : (c == '~' ? BC_NOT : BC_LNOT)), 0);
+	}
+	else if (c == '(')
+	{
+		parser->p++;
+		ParseExpression(parser, 0);
+		SkipSpaces(parser);
+
+		if (*parser->p != ')')
+			return Fail(parser, "Missing )");
+
+		parser->p++;
+	}
+	else if (c == '[')
+	{
+		parser->p++;
+		ParseExpression(parser, 0);
+		SkipSpaces(parser);
+
+		if (*parser->p != ']')
+			return Fail(parser, "Missing ]");
+
+		parser->p++;
+		EmitRead(parser);
+	}
+	else if ((c == '$') || isdigit((unsigned char)c))
+	{
+		char * end;
+		uint32_t value;
+
+		if (c == '$')
+			value = strtoul(parser->p + 1, &end, 16);
+		else
+			value = strtoul(parser->p, &end, (((c == '0') && (tolower((unsigned char)parser->p[1]) == 'x')) ? 16 : 10));
+
+		if ((end == parser->p + 1) && (c == '$'))
+			return Fail(parser, "Bad number");
+
+		parser->p = end;
+		EmitOperand(parser, BC_PUSH, value);
+	}
+	else if ((c == '&') || (c == '_') || isalpha((unsigned char)c))
+	{
+		bool address = (c == '&');
+		char name[256];
+		size_t len = 0;
+
+		if (address)
+		{
+			parser->p++;
+			SkipSpaces(parser);
+		}
+
+		while ((*parser->p == '_') || isalnum((unsigned char)*parser->p))
+		{
+			if (len < (sizeof(name) - 1))
+				name[len++] = *parser->p;
+
+			parser->p++;
+		}
+
+		name[len] = 0;
+
+		if (!len)
+			return Fail(parser, "Name expected");
+
+		// Registers & hit counts
+		if (!address)
+		{
+			if ((len == 2) && ((tolower(name[0]) == 'd') || (tolower(name[0]) == 'a')) && (name[1] >= '0') && (name[1] <= '7'))
+				return EmitOperand(parser, BC_REG, (tolower(name[0]) == 'd' ? M68K_REG_D0 : M68K_REG_A0) + (name[1] - '0'));
+
+			if (!strcasecmp(name, "sp"))
+				return EmitOperand(parser, BC_REG, M68K_REG_A7);
+
+			if (!strcasecmp(name, "pc"))
+				return EmitOperand(parser, BC_REG, M68K_REG_PC);
+
+			if (!strcasecmp(name, "sr"))
+				return EmitOperand(parser, BC_REG, M68K_REG_SR);
+
+			if (!strcasecmp(name, "hits"))
+				return Emit(parser, BC_HITS, 1);
+		}
+
+		size_t adr = (parser->resolver ? parser->resolver(name) : 0);
+
+		if (!adr)
+			return Fail(parser, "Unknown variable");
+
+		EmitOperand(parser, BC_PUSH, (uint32_t)adr);
+
+		if (!address)
+			EmitRead(parser);
+	}
+	else
+		Fail(parser, (c ? "Syntax error" : "Unexpected end"));
+}
+
+
+//
+// Binary operators of a priority level & the ones above it
+//
+static void ParseExpression(BrkCondParser * parser, int level)
+{
+	if (level == BRKCOND_LEVELS)
+		return ParsePrimary(parser);
+
+	ParseExpression(parser, level + 1);
+
+	while (!parser->failed)
+	{
+		const BrkCondOperator * found = NULL;
+		SkipSpaces(parser);
+
+		for(size_t i=0; i<(sizeof(operators) / sizeof(operators[0])); i++)
+		{
+			size_t len = strlen(operators[i].text);
+
+			// The longest operators come first
+			if (!strncmp(parser->p, operators[i].text, len))
+			{
+				found = &operators[i];
+				break;
+			}
+		}
+
+		if (!found || (found->level != level))
+			return;
+
+		parser->p += strlen(found->text);
+		ParseExpression(parser, level + 1);
+		Emit(parser, found->op, -1);
+	}
+}
+
+
+//
+// Compile a condition; returns NULL, with the error, if it is not valid
+//
+BrkCondition * BrkCondCompile(const char * text, BrkCondResolver resolver, char * error/*= NULL*/, size_t errorSize/*= 0*/)
+{
+	BrkCondParser parser;
+
+	parser.p = text;
+	parser.resolver = resolver;
+	parser.condition = (BrkCondition *)calloc(1, sizeof(BrkCondition));
+	parser.depth = 0;
+	parser.error = error;
+	parser.errorSize = errorSize;
+	parser.failed = false;
+
+	if (!parser.condition)
+		return NULL;
+
+	ParseExpression(&parser, 0);
+	SkipSpaces(&parser);
+
+	if (*parser.p)
+		Fail(&parser, "Syntax error");
+
+	if (parser.failed)
+	{
+		free(parser.condition);
+		return NULL;
+	}
+
+	// Emit() keeps room for it
+	parser.condition->code[parser.condition->size++] = BC_END;
+	return parser.condition;
+}
+
+
+//
+// Evaluate a condition, at its breakpoint
+//
+bool BrkCondEvaluate(const BrkCondition * condition, size_t hitCounts)
+{
+	uint32_t stack[BRKCOND_STACK_MAX + 1];
+	uint32_t * sp = stack;
+	const uint32_t * pc = condition->code;
+
+	for(;;)
+	{
+		switch (*pc++)
+		{
+		case BC_END:	return (sp[0] != 0);
+		case BC_PUSH:	*++sp = *pc++;	break;
+		case BC_REG:	*++sp = m68k_get_reg(NULL, (m68k_register_t)*pc++);	break;
+		case BC_HITS:	*++sp = (uint32_t)hitCounts;	break;
+		case BC_READ8:	*sp = JaguarReadByte(*sp & 0xFFFFFF, DEBUG);	break;
+		case BC_READ16:	*sp = JaguarReadWord(*sp & 0xFFFFFF, DEBUG);	break;
+		case BC_READ32:	*sp = JaguarReadLong(*sp & 0xFFFFFF, DEBUG);	break;
+		case BC_NEG:	*sp = -*sp;	break;
+		case BC_NOT:	*sp = ~*sp;	break;
+		case BC_LNOT:	*sp = !*sp;	break;
+		case BC_MUL:	sp--;	sp[0] *= sp[1];	break;
+		case BC_DIV:	sp--;	sp[0] = (sp[1] ? sp[0] / sp[1] : 0);	break;
+		case BC_MOD:	sp--;	sp[0] = (sp[1] ? sp[0] % sp[1] : 0);	break;
+		case BC_ADD:	sp--;	sp[0] += sp[1];	break;
+		case BC_SUB:	sp--;	sp[0] -= sp[1];	break;
+		case BC_SHL:	sp--;	sp[0] = (sp[1] < 32 ? sp[0] << sp[1] : 0);	break;
+		case BC_SHR:	sp--;	sp[0] = (sp[1] < 32 ? sp[0] >> sp[1] : 0);	break;
+		case BC_LT:		sp--;	sp[0] = (sp[0] < sp[1]);	break;
+		case BC_LE:		sp--;	sp[0] = (sp[0] <= sp[1]);	break;
+		case BC_GT:		sp--;	sp[0] = (sp[0] > sp[1]);	break;
+		case BC_GE:		sp--;	sp[0] = (sp[0] >= sp[1]);	break;
+		case BC_EQ:		sp--;	sp[0] = (sp[0] == sp[1]);	break;
+		case BC_NE:		sp--;	sp[0] = (sp[0] != sp[1]);	break;
+		case BC_AND:	sp--;	sp[0] &= sp[1];	break;
+		case BC_XOR:	sp--;	sp[0] ^= sp[1];	break;
+		case BC_OR:		sp--;	sp[0] |= sp[1];	break;
+		case BC_LAND:	sp--;	sp[0] = (sp[0] && sp[1]);	break;
+		case BC_LOR:	sp--;	sp[0] = (sp[0] || sp[1]);	break;
+		default:		return true;
+		}
+	}
+}
+
+
+void BrkCondFree(BrkCondition * condition)
+{
+	free(condition);
+}
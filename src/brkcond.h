@@ -0,0 +1,41 @@
+//
+// brkcond.h: Conditions of the breakpoints
+//
+// A condition is a C like expression, compiled once into a bytecode evaluated
+// when the address of its breakpoint is reached, the breakpoint halting only if
+// it is true (not 0). Values are 32 bits, & the expression may use:
+//  - numbers, decimal or hexadecimal ($ or 0x)
+//  - the 68K registers: d0-d7, a0-a7, sp, pc & sr
+//  - hits, the hit counts of the breakpoint (reached address)
+//  - memory contents, [<expression>] with an optional .b, .w or .l size (long
+//    by default)
+//  - variables & symbols names, giving their contents (same sizes as above);
+//    prefixed by &, their address
+//  - the operators, by priority: unary - ~ !, * / %, + -, << >>, < <= > >=
+//    (unsigned), == !=, &, ^, |, &&, ||, & parentheses
+// For example: "d0 == 3 && hits > 100", or "score.w >= $100".
+//
+
+#ifndef __BRKCOND_H__
+#define __BRKCOND_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BRKCOND_CODE_MAX		256					// Bytecode words of a condition
+#define BRKCOND_STACK_MAX		32
+
+// Gives the address of a variable or a symbol, 0 if it is unknown
+typedef size_t (* BrkCondResolver)(char * name);
+
+struct BrkCondition
+{
+	size_t size;
+	uint32_t code[BRKCOND_CODE_MAX];
+};
+
+BrkCondition * BrkCondCompile(const char * text, BrkCondResolver resolver, char * error = NULL, size_t errorSize = 0);
+bool BrkCondEvaluate(const BrkCondition * condition, size_t hitCounts);
+void BrkCondFree(BrkCondition * condition);
+
+#endif	// __BRKCOND_H__
@@ -11,6 +11,7 @@
 // Who  When        What
 // ---  ----------  ------------------------------------------------------------
 // JLH  01/16/2010  Created this log ;-)
+// JPM   Oct./2026  CD-ROM state moved in the machine context
 //
 
 #include "cdrom.h"
@@ -21,6 +22,7 @@
 //#include "memory.h"
 #include "cdintf.h"									// System agnostic CD interface functions
 #include "log.h"
+#include "machine.h"
 #include "dac.h"
 
 //#define CDROM_LOG									// For CDROM logging, obviously
@@ -178,12 +180,30 @@ const char * BReg[12] = { "BUTCH", "DSCNTRL", "DS_DATA", "???", "I2CNTRL",
 //extern const char * whoName[9];
 
 
-static uint8_t cdRam[0x100];
-static uint16_t cdCmd = 0, cdPtr = 0;
-static bool haveCDGoodness;
-static uint32_t min, sec, frm, block;
-static uint8_t cdBuf[2352 + 96];
-static uint32_t cdBufPtr = 2352;
+// CD-ROM state lives in the machine context (see cdrom.h)
+#define cdRam				(jaguarMachine->cdrom.cdRam)
+#define cdCmd				(jaguarMachine->cdrom.cdCmd)
+#define cdPtr				(jaguarMachine->cdrom.cdPtr)
+#define haveCDGoodness		(jaguarMachine->cdrom.haveCDGoodness)
+#define min					(jaguarMachine->cdrom.min)
+#define sec					(jaguarMachine->cdrom.sec)
+#define frm					(jaguarMachine->cdrom.frm)
+#define block				(jaguarMachine->cdrom.block)
+#define cdBuf				(jaguarMachine->cdrom.cdBuf)
+#define cdBufPtr			(jaguarMachine->cdrom.cdBufPtr)
+#define cdBuf2				(jaguarMachine->cdrom.cdBuf2)
+#define cdBuf3				(jaguarMachine->cdrom.cdBuf3)
+#define trackNum			(jaguarMachine->cdrom.trackNum)
+#define minTrack			(jaguarMachine->cdrom.minTrack)
+#define maxTrack			(jaguarMachine->cdrom.maxTrack)
+#define currentState		(jaguarMachine->cdrom.currentState)
+#define counter				(jaguarMachine->cdrom.counter)
+#define cmdTx				(jaguarMachine->cdrom.cmdTx)
+#define busCmd				(jaguarMachine->cdrom.busCmd)
+#define rxData				(jaguarMachine->cdrom.rxData)
+#define txData				(jaguarMachine->cdrom.txData)
+#define rxDataBit			(jaguarMachine->cdrom.rxDataBit)
+#define firstTime			(jaguarMachine->cdrom.firstTime)
 //Also need to set up (save/restore) the CD's NVRAM
 
 
@@ -191,6 +211,8 @@ static uint32_t cdBufPtr = 2352;
 void CDROMInit(void)
 {
 	haveCDGoodness = CDIntfInit();
+	cdBufPtr = 2352;
+	trackNum = 1;
 
 //GetRawTOC();
 /*uint8_t buf[2448];
@@ -304,7 +326,6 @@ uint8_t CDROMReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 	return cdRam[offset & 0xFF];
 }
 
-static uint8_t trackNum = 1, minTrack, maxTrack;
 //static uint8_t minutes[16] = {  0,  0,  2,  5,  7, 10, 12, 15, 17, 20, 22, 25, 27, 30, 32, 35 };
 //static uint8_t seconds[16] = {  0,  0, 30,  0, 30,  0, 30,  0, 30,  0, 30,  0, 30,  0, 30,  0 };
 //static uint8_t frames[16]  = {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 };
@@ -684,14 +705,6 @@ void CDROMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 // State machine for sending/receiving data along a serial bus
 //
 
-enum ButchState { ST_INIT, ST_RISING, ST_FALLING };
-static ButchState currentState = ST_INIT;
-static uint16_t counter = 0;
-static bool cmdTx = false;
-static uint16_t busCmd;
-static uint16_t rxData, txData;
-static uint16_t rxDataBit;
-static bool firstTime = false;
 
 static void CDROMBusWrite(uint16_t data)
 {
@@ -808,7 +821,6 @@ static uint16_t CDROMBusRead(void)
 // This simulates a read from BUTCH over the SSI to JERRY. Uses real reading!
 //
 //temp, until I can fix my CD image... Argh!
-static uint8_t cdBuf2[2532 + 96], cdBuf3[2532 + 96];
 uint16_t GetWordFromButchSSI(uint32_t offset, uint32_t who/*= UNKNOWN*/)
 {
 	bool go = ((offset & 0x0F) == 0x0A || (offset & 0x0F) == 0x0E ? true : false);
@@ -19,6 +19,30 @@ uint16_t CDROMReadWord(uint32_t offset, uint32_t who = UNKNOWN);
 void CDROMWriteByte(uint32_t offset, uint8_t data, uint32_t who = UNKNOWN);
 void CDROMWriteWord(uint32_t offset, uint16_t data, uint32_t who = UNKNOWN);
 
+// CD-ROM state of a machine
+
+enum ButchState { ST_INIT, ST_RISING, ST_FALLING };
+
+struct CDROMState
+{
+	uint8_t cdRam[0x100];
+	uint16_t cdCmd, cdPtr;
+	bool haveCDGoodness;
+	uint32_t min, sec, frm, block;
+	uint8_t cdBuf[2352 + 96];
+	uint32_t cdBufPtr;
+	uint8_t cdBuf2[2532 + 96], cdBuf3[2532 + 96];
+	uint8_t trackNum, minTrack, maxTrack;
+	// Serial bus state machine
+	ButchState currentState;
+	uint16_t counter;
+	bool cmdTx;
+	uint16_t busCmd;
+	uint16_t rxData, txData;
+	uint16_t rxDataBit;
+	bool firstTime;
+};
+
 bool ButchIsReadyToSend(void);
 uint16_t GetWordFromButchSSI(uint32_t offset, uint32_t who = UNKNOWN);
 void SetSSIWordsXmittedFromButch(void);
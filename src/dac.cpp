@@ -12,6 +12,11 @@
 // ---  ----------  -------------------------------------------------------------
 // JLH  01/16/2010  Created this log ;-)
 // JLH  04/30/2012  Changed SDL audio handler to run JERRY
+// JPM   Oct./2026  SDL audio handler runs the machine which has opened the audio
+// JPM   Oct./2026  Audio buffer filling usable without SDL, by the core library
+// JPM   Oct./2026  Samples played by the host audio can be given to a capture callback
+// JPM   Oct./2026  DSP performance counters
+// JPM   Oct./2026  Audio clock of the host audio, for the frames pacing
 //
 
 // Need to set up defaults that the BIOS sets for the SSI here in DACInit()... !!! FIX !!!
@@ -42,13 +47,16 @@
 
 #include "dac.h"
 
+#ifndef NO_SDL
 #include "SDL.h"
+#endif
 #include "cdrom.h"
 #include "dsp.h"
 #include "event.h"
 #include "jerry.h"
 #include "jaguar.h"
 #include "log.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
 #include "settings.h"
@@ -57,7 +65,6 @@
 //#define DEBUG_DAC
 
 #define BUFFER_SIZE			0x10000				// Make the DAC buffers 64K x 16 bits
-#define DAC_AUDIO_RATE		48000				// Set the audio rate to 48 KHz
 
 // Jaguar memory locations
 
@@ -75,14 +82,32 @@
 
 // Local variables
 
+#ifndef NO_SDL
 static SDL_AudioSpec desired;
 static bool SDLSoundInitialized;
+static JaguarMachine * dacMachine = NULL;		// Machine played by the host audio (there is only one)
+static void (* captureCallback)(uint16_t * buffer, int length) = NULL;	// Receives the played samples
+
+// Audio clock: samples given to the host audio before a buffer has been asked, & host ticks
+// at that time. It is written by the SDL audio thread, under its mutex.
+struct DACClock
+{
+	uint64_t samples;
+	uint64_t hostTicks;
+};
+
+static DACClock dacClock;
+static SDL_mutex * dacClockMutex = NULL;
+static uint64_t dacSamples;						// Samples given to the host audio
+#endif
 //static uint8_t SCLKFrequencyDivider = 19;			// Default is roughly 22 KHz (20774 Hz in NTSC mode)
 // /*static*/ uint16_t serialMode = 0;
 
 // Private function prototypes
 
+#ifndef NO_SDL
 void SDLSoundCallback(void * userdata, Uint8 * buffer, int length);
+#endif
 void DSPSampleCallback(void);
 
 
@@ -91,8 +116,6 @@ void DSPSampleCallback(void);
 //
 void DACInit(void)
 {
-	SDLSoundInitialized = false;
-
 //	if (!vjs.audioEnabled)
 	if (!vjs.DSPEnabled)
 	{
@@ -100,23 +123,38 @@ void DACInit(void)
 		return;
 	}
 
-	desired.freq = DAC_AUDIO_RATE;
-	desired.format = AUDIO_S16SYS;
-	desired.channels = 2;
-	desired.samples = 2048;						// 2K buffer = audio delay of 42.67 ms (@ 48 KHz)
-	desired.callback = SDLSoundCallback;
-
-	if (SDL_OpenAudio(&desired, NULL) < 0)		// NULL means SDL guarantees what we want
-		WriteLog("DAC: Failed to initialize SDL sound...\n");
+#ifdef NO_SDL
+	WriteLog("DAC: No host audio, the samples have to be pulled with DACFillBuffer().\n");
+#else
+	if (SDLSoundInitialized)
+	{
+		WriteLog("DAC: Host audio already used by another machine.\n");
+	}
 	else
 	{
-		SDLSoundInitialized = true;
-		DACReset();
-		SDL_PauseAudio(false);					// Start playback!
-		WriteLog("DAC: Successfully initialized. Sample rate: %u\n", desired.freq);
+		desired.freq = DAC_AUDIO_RATE;
+		desired.format = AUDIO_S16SYS;
+		desired.channels = 2;
+		desired.samples = 2048;					// 2K buffer = audio delay of 42.67 ms (@ 48 KHz)
+		desired.callback = SDLSoundCallback;
+		dacMachine = jaguarMachine;
+		dacClock.samples = dacClock.hostTicks = dacSamples = 0;
+
+		if (!dacClockMutex)
+			dacClockMutex = SDL_CreateMutex();
+
+		if (SDL_OpenAudio(&desired, NULL) < 0)	// NULL means SDL guarantees what we want
+			WriteLog("DAC: Failed to initialize SDL sound...\n");
+		else
+		{
+			SDLSoundInitialized = true;
+			SDL_PauseAudio(false);				// Start playback!
+			WriteLog("DAC: Successfully initialized. Sample rate: %u\n", desired.freq);
+		}
 	}
+#endif
 
-	ltxd = lrxd = desired.silence;
+	DACReset();
 	sclk = 19;									// Default is roughly 22 KHz
 
 	uint32_t riscClockRate = (vjs.hardwareTypeNTSC ? RISC_CLOCK_RATE_NTSC : RISC_CLOCK_RATE_PAL);
@@ -131,7 +169,7 @@ void DACInit(void)
 void DACReset(void)
 {
 //	LeftFIFOHeadPtr = LeftFIFOTailPtr = 0, RightFIFOHeadPtr = RightFIFOTailPtr = 1;
-	ltxd = lrxd = desired.silence;
+	ltxd = lrxd = 0;							// Silence for signed 16-bit samples
 }
 
 
@@ -140,7 +178,9 @@ void DACReset(void)
 //
 void DACPauseAudioThread(bool state/*= true*/)
 {
+#ifndef NO_SDL
 		SDL_PauseAudio(state);
+#endif
 }
 
 
@@ -149,11 +189,15 @@ void DACPauseAudioThread(bool state/*= true*/)
 //
 void DACDone(void)
 {
-	if (SDLSoundInitialized)
+#ifndef NO_SDL
+	if (SDLSoundInitialized && (dacMachine == jaguarMachine))
 	{
 		SDL_PauseAudio(true);
 		SDL_CloseAudio();
+		SDLSoundInitialized = false;
+		dacMachine = NULL;
 	}
+#endif
 
 	WriteLog("DAC: Done.\n");
 }
@@ -168,17 +212,75 @@ void DACDone(void)
 // timing as well (generating them at the proper times), but that shouldn't be too difficult...
 // If the DSP isn't running, then fill the buffer with L/RTXD and exit.
 
+#ifndef NO_SDL
 //
 // SDL callback routine to fill audio buffer
 //
+void SDLSoundCallback(void * userdata, Uint8 * buffer, int length)
+{
+	// The samples given before have been played when the next buffer is asked
+	SDL_LockMutex(dacClockMutex);
+	dacClock.samples = dacSamples;
+	dacClock.hostTicks = PerfHostTime();
+	SDL_UnlockMutex(dacClockMutex);
+	dacSamples += length / 4;
+
+	// The SDL audio thread runs the JERRY of the machine it plays
+	JaguarMachineSetCurrent(dacMachine);
+	DACFillBuffer((uint16_t *)buffer, length);
+
+	if (captureCallback)
+		captureCallback((uint16_t *)buffer, length);
+}
+#endif
+
+
+//
+// Audio clock of the host audio: stereo samples played, & host ticks
+// when they were (PerfHostTime). Returns false if the current machine has no host audio.
+//
+bool DACGetClock(uint64_t * samples, uint64_t * hostTicks)
+{
+#ifndef NO_SDL
+	if (SDLSoundInitialized && (dacMachine == jaguarMachine) && (SDL_GetAudioStatus() == SDL_AUDIO_PLAYING))
+	{
+		SDL_LockMutex(dacClockMutex);
+		*samples = dacClock.samples;
+		*hostTicks = dacClock.hostTicks;
+		SDL_UnlockMutex(dacClockMutex);
+		return (*hostTicks != 0);
+	}
+#endif
+
+	return false;
+}
+
+
+//
+// Set (or remove, with NULL) the function receiving a copy of the samples played by the host audio
+// It is called from the SDL audio thread.
+//
+void DACSetCaptureCallback(void (* callback)(uint16_t * buffer, int length))
+{
+#ifndef NO_SDL
+	SDL_LockAudio();
+	captureCallback = callback;
+	SDL_UnlockAudio();
+#endif
+}
+
+
+//
+// Run JERRY of the current machine to fill an audio buffer
+//
 // Note: The samples are packed in the buffer in 16 bit left/16 bit right pairs.
 //       Also, length is the length of the buffer in BYTES
 //
-static Uint8 * sampleBuffer;
-static int bufferIndex = 0;
-static int numberOfSamples = 0;
-static bool bufferDone = false;
-void SDLSoundCallback(void * userdata, Uint8 * buffer, int length)
+static THREAD_LOCAL uint16_t * sampleBuffer;
+static THREAD_LOCAL int bufferIndex = 0;
+static THREAD_LOCAL int numberOfSamples = 0;
+static THREAD_LOCAL bool bufferDone = false;
+void DACFillBuffer(uint16_t * buffer, int length)
 {
 	// 1st, check to see if the DSP is running. If not, fill the buffer with L/RXTD and exit.
 
@@ -186,10 +288,13 @@ void SDLSoundCallback(void * userdata, Uint8 * buffer, int length)
 	{
 		for(int i=0; i<(length/2); i+=2)
 		{
-			((uint16_t *)buffer)[i + 0] = ltxd;
-			((uint16_t *)buffer)[i + 1] = rtxd;
+			buffer[i + 0] = ltxd;
+			buffer[i + 1] = rtxd;
 		}
 
+		uint32_t cycles = USEC_TO_RISC_CYCLES((1000000.0 / (double)DAC_AUDIO_RATE) * (length / 4));
+		PERF_COUNT(dsp.cycles, cycles);
+		PERF_COUNT(dsp.idleCycles, cycles);
 		return;
 	}
 
@@ -210,30 +315,39 @@ void SDLSoundCallback(void * userdata, Uint8 * buffer, int length)
 	bufferDone = false;
 
 	SetCallbackTime(DSPSampleCallback, 1000000.0 / (double)DAC_AUDIO_RATE, EVENT_JERRY);
+	uint64_t startTime = PerfHostTime();
 
 	// These timings are tied to NTSC, need to fix that in event.cpp/h! [FIXED]
 	do
 	{
 		double timeToNextEvent = GetTimeToNextEvent(EVENT_JERRY);
+		uint32_t cycles = USEC_TO_RISC_CYCLES(timeToNextEvent);
+		PERF_COUNT(dsp.cycles, cycles);
+
+		if (!vjs.DSPEnabled || !DSPIsRunning())
+			PERF_COUNT(dsp.idleCycles, cycles);
 
 		if (vjs.DSPEnabled)
 		{
 			if (vjs.usePipelinedDSP)
-				DSPExecP2(USEC_TO_RISC_CYCLES(timeToNextEvent));
+				DSPExecP2(cycles);
 			else
-				DSPExec(USEC_TO_RISC_CYCLES(timeToNextEvent));
+				DSPExec(cycles);
 		}
 
 		HandleNextEvent(EVENT_JERRY);
 	}
 	while (!bufferDone);
+
+	PERF_COUNT(hostTime[PERF_TIME_DSP], PerfHostTime() - startTime);
+	PerfDSPDone();
 }
 
 
 void DSPSampleCallback(void)
 {
-	((uint16_t *)sampleBuffer)[bufferIndex + 0] = ltxd;
-	((uint16_t *)sampleBuffer)[bufferIndex + 1] = rtxd;
+	sampleBuffer[bufferIndex + 0] = ltxd;
+	sampleBuffer[bufferIndex + 1] = rtxd;
 	bufferIndex += 2;
 
 	if (bufferIndex == numberOfSamples)
@@ -7,10 +7,15 @@
 
 #include "memory.h"
 
+#define DAC_AUDIO_RATE		48000				// Set the audio rate to 48 KHz
+
 void DACInit(void);
 void DACReset(void);
 void DACPauseAudioThread(bool state = true);
 void DACDone(void);
+void DACFillBuffer(uint16_t * buffer, int length);
+void DACSetCaptureCallback(void (* callback)(uint16_t * buffer, int length));
+bool DACGetClock(uint64_t * samples, uint64_t * hostTicks);
 //int GetCalculatedFrequency(void);
 
 // DAC memory access
@@ -0,0 +1,106 @@
+//
+// dasmcache.cpp - Disassembly cache of the debugger views
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// The 68K, GPU & DSP disassembly views get their instructions from this cache,
+// keyed by processor & address, instead of disassembling them at each refresh.
+// An entry keeps the generation of the 68K code lines (see m68kinterface.h)
+// holding its bytes, the lines being marked so that any write there, by any bus
+// master, counts; a changed generation makes the entry a miss. The GPU & DSP
+// local RAM writes count as well. Loads done without the write handlers flush
+// the cache.
+//
+
+#include "dasmcache.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "jagdasm.h"
+#include "machine.h"
+
+
+#define dasmCache		(jaguarMachine->dasmCache)
+
+
+//
+// Generation of the code line of an address, marking it so the writes count
+//
+static inline uint32_t DasmCacheLine(uint32_t address)
+{
+	unsigned int * codeLine = &m68kCodeLines[(address & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT];
+	*codeLine |= 1;
+	return *codeLine;
+}
+
+
+//
+// Get the disassembly of the instruction at an address, which is only done on
+// a miss; the entry stays valid up to the next call
+//
+DasmCacheEntry * DasmCacheGet(int cpu, uint32_t address, uint32_t options/*= 0*/)
+{
+	DasmCacheEntry * entry = &dasmCache.entries[((address >> 1) + (cpu * (DASMCACHE_SIZE / 3))) & (DASMCACHE_SIZE - 1)];
+
+	if (entry->length && (entry->address == address) && (entry->cpu == cpu) && (entry->options == options)
+		&& (entry->generation[0] == m68kCodeLines[(address & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT])
+		&& (entry->generation[1] == m68kCodeLines[((address + entry->length - 1) & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT]))
+		return entry;
+
+	char buffer[1024];
+	uint32_t length;
+
+	if (cpu == DASMCACHE_M68K)
+		length = m68k_disassemble(buffer, address, 0, options);
+	else
+		length = dasmjag(cpu, buffer, address);
+
+	free(entry->html);
+	memset(entry, 0, sizeof(DasmCacheEntry));
+	entry->address = address;
+	entry->cpu = cpu;
+	entry->options = options;
+	entry->length = (length ? length : 2);
+	entry->generation[0] = DasmCacheLine(address);
+	entry->generation[1] = DasmCacheLine(address + entry->length - 1);
+	size_t textLength = strlen(buffer);
+
+	if (textLength > (DASMCACHE_TEXT_SIZE - 1))
+		textLength = DASMCACHE_TEXT_SIZE - 1;
+
+	memcpy(entry->text, buffer, textLength);
+	entry->text[textLength] = 0;
+
+	return entry;
+}
+
+
+//
+// Keep the HTML rendering of an instruction made by a view
+//
+void DasmCacheSetHTML(DasmCacheEntry * entry, const char * html)
+{
+	free(entry->html);
+
+	if ((entry->html = (char *)malloc(strlen(html) + 1)))
+		strcpy(entry->html, html);
+}
+
+
+//
+// Forget every entry (code loaded without the write handlers, or new debugger
+// information)
+//
+void DasmCacheFlush(void)
+{
+	for(int i=0; i<DASMCACHE_SIZE; i++)
+		free(dasmCache.entries[i].html);
+
+	memset(dasmCache.entries, 0, sizeof(dasmCache.entries));
+}
@@ -0,0 +1,43 @@
+//
+// dasmcache.h: Disassembly cache of the debugger views
+//
+
+#ifndef __DASMCACHE_H__
+#define __DASMCACHE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DASMCACHE_SIZE			1024					// Entries, a power of 2
+#define DASMCACHE_TEXT_SIZE		96
+
+// Processors, the GPU & DSP ones being the dasmjag() types
+enum { DASMCACHE_GPU = 0, DASMCACHE_DSP, DASMCACHE_M68K };
+
+// Disassembly of an instruction, with its debugger annotations
+struct DasmCacheEntry
+{
+	uint32_t address;
+	uint32_t generation[2];								// Code lines of the first & last bytes, when disassembled
+	uint8_t cpu;
+	uint8_t options;									// Disassembly options (68K opcodes display)
+	uint8_t length;										// Instruction length in bytes, 0 for a free entry
+	bool annotated;										// Annotations looked up by the debugger
+	char text[DASMCACHE_TEXT_SIZE];
+	char * symbol;										// Symbol at the address
+	char * fullSource;									// Source filename of the address, & its status (DBGstatus)
+	size_t status;
+	size_t numLine;										// Source line number
+	char * html;										// Instruction as HTML, its addresses replaced by the symbols (allocated)
+};
+
+struct DasmCacheState
+{
+	DasmCacheEntry entries[DASMCACHE_SIZE];
+};
+
+DasmCacheEntry * DasmCacheGet(int cpu, uint32_t address, uint32_t options = 0);
+void DasmCacheSetHTML(DasmCacheEntry * entry, const char * html);
+void DasmCacheFlush(void);
+
+#endif	// __DASMCACHE_H__
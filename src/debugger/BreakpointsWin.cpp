@@ -9,6 +9,7 @@
 // ---  ----------  -----------------------------------------------------------
 // JPM  30/08/2017  Created this file
 // JPM   Oct./2018  Added the breakpoints features
+// JPM   Oct./2026  Added the breakpoints conditions
 //
 
 // STILL TO DO:
@@ -44,12 +45,13 @@ layout(new QVBoxLayout)
 	fixedFont.setStyleHint(QFont::TypeWriter);
 
 	// Set the new layout with proper identation and readibility
-	model->setColumnCount(3);
+	model->setColumnCount(4);
 	model->setHeaderData(0, Qt::Horizontal, QObject::tr("Status"));
 	model->setHeaderData(1, Qt::Horizontal, QObject::tr("Name"));
 #ifdef BRK_HITCOUNTS
 	model->setHeaderData(2, Qt::Horizontal, QObject::tr("Hit Count"));
 #endif
+	model->setHeaderData(3, Qt::Horizontal, QObject::tr("Condition"));
 	// Information table
 	TableView->setModel(model);
 	TableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -112,6 +114,7 @@ void BreakpointsWindow::UpdateInfos(void)
 			sprintf(Addresse, "0x%06X", brkInfo[i].Adr);
 			model->setItem((i + 1), 1, new QStandardItem(QString("%1").arg((FuncName = brkInfo[i].Name) ? FuncName : Addresse)));
 			model->setItem((i + 1), 2, new QStandardItem(QString("%1").arg(brkInfo[i].HitCounts)));
+			model->setItem((i + 1), 3, new QStandardItem(QString("%1").arg(brkInfo[i].Condition ? brkInfo[i].Condition : "")));
 		}
 	}
 }
@@ -18,7 +18,7 @@
 //
 
 #include "debugger/CartFilesListWin.h"
-#include "memory.h"
+#include "machine.h"
 #include "settings.h"
 #include "debugger/DBGManager.h"
 
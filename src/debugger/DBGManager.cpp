@@ -17,6 +17,7 @@
 // JPM  Sept./2019  Support the unsigned/signed short type
 //  RG   Jan./2021  Linux build fixes
 // JPM    May/2021  Code refactoring for the variables
+// JPM   Oct./2026  Added the address from a global variable or a symbol name, for the breakpoints conditions
 //
 
 // To Do
@@ -35,7 +36,7 @@
 #include "DBGManager.h"
 #include "HWLABELManager.h"
 #include "settings.h"
-#include "memory.h"
+#include "machine.h"
 
 
 //
@@ -325,6 +326,23 @@ size_t DBGManager_GetAdrFromSymbolName(char *SymbolName)
 }
 
 
+// Get address from a global variable name, or else from a symbol name
+// Return 0 if none has been found
+size_t DBGManager_GetAdrFromName(char *Name)
+{
+	size_t Adr;
+
+	if ((Adr = DBGManager_GetGlobalVariableAdrFromName(Name)))
+	{
+		return Adr;
+	}
+	else
+	{
+		return DBGManager_GetAdrFromSymbolName(Name);
+	}
+}
+
+
 #if 0
 // Get local variable's type encoding based on his address and Index
 // Return the type encoding found
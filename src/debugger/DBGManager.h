@@ -287,6 +287,7 @@ extern char *DBGManager_GetFunctionName(size_t Adr);
 // Symbols manager
 extern char	*DBGManager_GetSymbolNameFromAdr(size_t Adr);
 extern size_t DBGManager_GetAdrFromSymbolName(char *SymbolName);
+extern size_t DBGManager_GetAdrFromName(char *Name);
 
 // Source text files manager
 extern char	*DBGManager_GetFullSourceFilenameFromAdr(size_t Adr, DBGstatus *Status);
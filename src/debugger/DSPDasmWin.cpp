@@ -8,6 +8,7 @@
 // Who  When        What
 // ---  ----------  -------------------------------------------------------------
 // JPM  02/02/2017  Created this file
+// JPM   Oct./2026  Instructions from the disassembly cache
 //
 
 // STILL TO DO:
@@ -16,7 +17,7 @@
 #include "DSPDasmWin.h"
 #include "dsp.h"
 #include "gpu.h"
-#include "jagdasm.h"
+#include "machine.h"
 #include "settings.h"
 
 
@@ -37,8 +38,7 @@ void DSPDasmWindow::RefreshContents(void)
 {
 	char string[1024];
 	QString s;
-	char buffer[2048];
-	int pc = memBase, oldpc;
+	int pc = memBase;
 	uint32_t DSPPC = DSPReadLong(0xF1A110, DEBUG);
 	bool DSPPCShow = false;
 
@@ -46,34 +46,20 @@ void DSPDasmWindow::RefreshContents(void)
 
 	for(uint32_t i=0; i<vjs.nbrdisasmlines; i++)
 	{
-		oldpc = pc;
-		pc += dasmjag(JAGUAR_DSP, buffer, pc);
+		DasmCacheEntry * entry = DasmCacheGet(DASMCACHE_DSP, pc);
 
-		if (DSPPC == oldpc)
+		if (DSPPC == pc)
 		{
-			sprintf(string, "=> %06X: %s<br>", oldpc, buffer);
+			sprintf(string, "=> %06X: %s<br>", pc, entry->text);
 			DSPPCShow = true;
 		}
 		else
 		{
-			sprintf(string, "   %06X: %s<br>", oldpc, buffer);
+			sprintf(string, "   %06X: %s<br>", pc, entry->text);
 		}
 
-		buffer[0] = 0;	// Clear string
-		char singleCharString[2] = { 0, 0 };
-
-		for(uint j=0; j<strlen(string); j++)
-		{
-			if (string[j] == 32)
-				strcat(buffer, "&nbsp;");
-			else
-			{
-				singleCharString[0] = string[j];
-				strcat(buffer, singleCharString);
-			}
-		}
-
-		s += QString(buffer);
+		pc += entry->length;
+		s += QString(string).replace(' ', "&nbsp;");
 	}
 
 	if (DSPPCShow)
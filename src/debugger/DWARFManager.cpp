@@ -16,6 +16,7 @@
 // JPM   Aug./2020  Added a source code file date check
 //  RG   Jan./2021  Linux build fixes
 // JPM   Apr./2021  Support the structure and union members
+// JPM   Oct./2026  Source files resolved in the background, and loaded at their first view
 //
 
 // To Do
@@ -30,6 +31,9 @@
 #include <time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifndef NO_SDL
+#include <SDL.h>								// For the source files resolution thread
+#endif
 #include "libdwarf.h"
 #include "dwarf.h"
 #include "LEB128.h"
@@ -167,6 +171,8 @@ typedef struct CUStruct
 	size_t *PtrUsedNumLines;						// List of the number lines used
 	struct stat _statbuf;							// File information
 	DWARFstatus Status;								// File status
+	bool Resolved;									// Full filename & file status resolved
+	bool Loaded;									// Source code text loaded & lines indexed
 }S_CUStruct;
 
 
@@ -180,6 +186,13 @@ CUStruct *PtrCU;
 char **ListSearchPaths;
 size_t NbSearchPaths;
 struct stat FileElfExeInfo;
+char **ResolveSrcPaths;								// Search paths used by the source files resolution
+size_t NbResolveSrcPaths;
+#ifndef NO_SDL
+SDL_Thread *ResolveSrcThread;
+SDL_mutex *ResolveSrcMutex;							// Protects the source files resolution
+volatile bool ResolveSrcQuit;
+#endif
 
 
 // Function declarations
@@ -193,6 +206,13 @@ void DWARFManager_SourceFileSearchPathsInit(void);
 void DWARFManager_SourceFileSearchPathsReset(void);
 void DWARFManager_SourceFileSearchPathsClose(void);
 void DWARFManager_ConformSlachesBackslashes(char *Ptr);
+void DWARFManager_ResolveSrcStart(void);
+void DWARFManager_ResolveSrcStop(void);
+void DWARFManager_ResolveSrc(size_t Index);
+void DWARFManager_LoadSrc(size_t Index);
+#ifndef NO_SDL
+int DWARFManager_ResolveSrcThreadFunc(void *);
+#endif
 #if 0
 size_t DWARFManager_GetNbGlobalVariables(void);
 size_t DWARFManager_GetNbLocalVariables(size_t Adr);
@@ -302,6 +322,9 @@ bool DWARFManager_ElfClose(void)
 // Dwarf manager Compilation Units close
 void DWARFManager_CloseDMI(void)
 {
+	// Stop the source files resolution
+	DWARFManager_ResolveSrcStop();
+
 	// loop on all CU
 	while (NbCU--)
 	{
@@ -316,10 +339,13 @@ void DWARFManager_CloseDMI(void)
 		free(PtrCU[NbCU].PtrUsedNumLines);
 
 		// free lines from the source code
+		// Lines are pointers in the source code text, unless they have been converted
+#ifdef CONVERT_QT_HML
 		while (PtrCU[NbCU].NbLinesLoadSrc--)
 		{
 			free(PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].NbLinesLoadSrc]);
 		}
+#endif
 		free(PtrCU[NbCU].PtrLinesLoadSrc);
 
 		// free the functions information
@@ -387,9 +413,8 @@ void DWARFManager_InitDMI(void)
 	Dwarf_Off return_offset;
 	Dwarf_Line *linebuf;
 	Dwarf_Half form;
-	FILE *SrcFile;
 	char *return_string;
-	char *Ptr, *Ptr1;
+	char *Ptr;
 
 	// Initialisation for the Compilation Units table
 	NbCU = 0;
@@ -504,165 +529,9 @@ void DWARFManager_InitDMI(void)
 								PtrCU[NbCU].PtrSourceFilename = (char *)calloc(1, 1);
 							}
 
-							// Check directory presence
-							if (!PtrCU[NbCU].PtrSourceFileDirectory)
-							{
-								// Check if file exists in the search paths
-								for (size_t i = 0; i < NbSearchPaths; i++)
-								{
-									PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + strlen((const char *)ListSearchPaths[i]) + 2);
-#if defined(_WIN32)
-									sprintf(PtrCU[NbCU].PtrFullFilename, "%s\\%s", ListSearchPaths[i], PtrCU[NbCU].PtrSourceFilename);
-									if (!fopen_s(&SrcFile, PtrCU[NbCU].PtrFullFilename, "rb"))
-#else
-									sprintf(PtrCU[NbCU].PtrFullFilename, "%s/%s", ListSearchPaths[i], PtrCU[NbCU].PtrSourceFilename);
-									SrcFile = fopen(PtrCU[NbCU].PtrFullFilename, "rb");
-									if (SrcFile == NULL)
-#endif
-									{
-										PtrCU[NbCU].PtrSourceFileDirectory = (char *)realloc(PtrCU[NbCU].PtrSourceFileDirectory, strlen(ListSearchPaths[i]) + 1);
-										strcpy(PtrCU[NbCU].PtrSourceFileDirectory, ListSearchPaths[i]);
-									}
-								}
-
-								// File directory doesn't exits
-								if (!PtrCU[NbCU].PtrSourceFileDirectory)
-								{
-									PtrCU[NbCU].PtrSourceFileDirectory = (char *)realloc(PtrCU[NbCU].PtrSourceFileDirectory, 2);
-									strcpy(PtrCU[NbCU].PtrSourceFileDirectory, ".");
-								}
-							}
-
 							// Conform slashes / backslashes for the filename
+							// The full filename, and the file status, are resolved in the background
 							DWARFManager_ConformSlachesBackslashes(PtrCU[NbCU].PtrSourceFilename);
-
-							// Check if filename contains already the complete directory
-							if (PtrCU[NbCU].PtrSourceFilename[1] == ':')
-							{
-								// Copy the filename as the full filename
-								PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + 1);
-								strcpy(PtrCU[NbCU].PtrFullFilename, PtrCU[NbCU].PtrSourceFilename);
-							}
-							else
-							{
-								// Create full filename and Conform slashes / backslashes
-								PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + strlen(PtrCU[NbCU].PtrSourceFileDirectory) + 2);
-#if defined(_WIN32)
-								sprintf(PtrCU[NbCU].PtrFullFilename, "%s\\%s", PtrCU[NbCU].PtrSourceFileDirectory, PtrCU[NbCU].PtrSourceFilename);
-#else
-								sprintf(PtrCU[NbCU].PtrFullFilename, "%s/%s", PtrCU[NbCU].PtrSourceFileDirectory, PtrCU[NbCU].PtrSourceFilename);
-#endif
-							}
-
-							DWARFManager_ConformSlachesBackslashes(PtrCU[NbCU].PtrFullFilename);
-
-							// Directory path clean-up
-#if defined(_WIN32)
-							while ((Ptr1 = Ptr = strstr(PtrCU[NbCU].PtrFullFilename, "\\..\\")))
-#else
-							while ((Ptr1 = Ptr = strstr(PtrCU[NbCU].PtrFullFilename, "/../")))
-#endif
-							{
-#if defined(_WIN32)
-								while (*--Ptr1 != '\\');
-#else
-								while (*--Ptr1 != '/');
-#endif
-								strcpy((Ptr1 + 1), (Ptr + 4));
-							}
-
-							// Get the source file information
-							if (!stat(PtrCU[NbCU].PtrFullFilename, &PtrCU[NbCU]._statbuf))
-							{
-								// check the time stamp with the executable
-								if (PtrCU[NbCU]._statbuf.st_mtime <= FileElfExeInfo.st_mtime)
-								{
-									// Open the source file as a binary file
-#if defined(_WIN32)
-									if (!fopen_s(&SrcFile, PtrCU[NbCU].PtrFullFilename, "rb"))
-#else
-                                    SrcFile = fopen(PtrCU[NbCU].PtrFullFilename, "rb");
-									if (SrcFile == NULL)
-#endif
-									{
-										if (!fseek(SrcFile, 0, SEEK_END))
-										{
-											if ((PtrCU[NbCU].SizeLoadSrc = ftell(SrcFile)) > 0)
-											{
-												if (!fseek(SrcFile, 0, SEEK_SET))
-												{
-													if (PtrCU[NbCU].PtrLoadSrc = Ptr = Ptr1 = (char *)calloc(1, (PtrCU[NbCU].SizeLoadSrc + 2)))
-													{
-														// Read whole file
-#if defined(_WIN32)	&& defined(_MSC_VER)													
-														if (fread_s(PtrCU[NbCU].PtrLoadSrc, PtrCU[NbCU].SizeLoadSrc, PtrCU[NbCU].SizeLoadSrc, 1, SrcFile) != 1)
-#else
-														if (fread(PtrCU[NbCU].PtrLoadSrc, PtrCU[NbCU].SizeLoadSrc, 1, SrcFile) != 1)
-#endif
-														{
-															free(PtrCU[NbCU].PtrLoadSrc);
-															PtrCU[NbCU].PtrLoadSrc = NULL;
-															PtrCU[NbCU].SizeLoadSrc = 0;
-														}
-														else
-														{
-															// Eliminate all carriage return code '\r' (oxd)
-															do
-															{
-																if ((*Ptr = *Ptr1) != '\r')
-																{
-																	Ptr++;
-																}
-															} while (*Ptr1++);
-
-															// Get back the new text file size
-															PtrCU[NbCU].SizeLoadSrc = strlen(Ptr = PtrCU[NbCU].PtrLoadSrc);
-
-															// Make sure the text file finish with a new line code '\n' (0xa)
-															if (PtrCU[NbCU].PtrLoadSrc[PtrCU[NbCU].SizeLoadSrc - 1] != '\n')
-															{
-																PtrCU[NbCU].PtrLoadSrc[PtrCU[NbCU].SizeLoadSrc++] = '\n';
-																PtrCU[NbCU].PtrLoadSrc[PtrCU[NbCU].SizeLoadSrc] = 0;
-															}
-
-															// Reallocate text file
-															if (PtrCU[NbCU].PtrLoadSrc = Ptr = (char *)realloc(PtrCU[NbCU].PtrLoadSrc, (PtrCU[NbCU].SizeLoadSrc + 1)))
-															{
-																// Count line numbers, based on the new line code '\n' (0xa), and finish each line with 0
-																do
-																{
-																	if (*Ptr == '\n')
-																	{
-																		PtrCU[NbCU].NbLinesLoadSrc++;
-																		*Ptr = 0;
-																	}
-																} while (*++Ptr);
-															}
-														}
-													}
-												}
-											}
-										}
-
-										fclose(SrcFile);
-									}
-									else
-									{
-										// Source file doesn't exist
-										PtrCU[NbCU].Status = DWARFSTATUS_NOFILE;
-									}
-								}
-								else
-								{
-									// Source file is outdated
-									PtrCU[NbCU].Status = DWARFSTATUS_OUTDATEDFILE;
-								}
-							}
-							else
-							{
-								// Source file doesn't have information
-								PtrCU[NbCU].Status = DWARFSTATUS_NOFILEINFO;
-							}
 							break;
 
 						default:
@@ -671,7 +540,7 @@ void DWARFManager_InitDMI(void)
 					}
 
 					// Get the source lines table located in the CU
-					if ((dwarf_srclines(return_sib, &linebuf, &cnt, &error) == DW_DLV_OK) && (PtrCU[NbCU].Status == DWARFSTATUS_OK))
+					if (dwarf_srclines(return_sib, &linebuf, &cnt, &error) == DW_DLV_OK)
 					{
 						if (cnt)
 						{
@@ -1231,148 +1100,401 @@ void DWARFManager_InitDMI(void)
 					}
 				}
 
-				// Set the source code lines
-				if (PtrCU[NbCU].NbLinesLoadSrc)
+				// Set information based on used line numbers
+				// The source code lines are set when the source file is loaded, at its first view
+				if (PtrCU[NbCU].PtrUsedLinesSrc)
 				{
-					if (PtrCU[NbCU].PtrLinesLoadSrc = (char **)calloc(PtrCU[NbCU].NbLinesLoadSrc, sizeof(char *)))
+					for (size_t i = 0; i < PtrCU[NbCU].NbUsedLinesSrc; i++)
 					{
-						for (size_t j = 0; j < PtrCU[NbCU].NbLinesLoadSrc; j++)
-						{
-							if (PtrCU[NbCU].PtrLinesLoadSrc[j] = (char *)calloc(10000, sizeof(char)))
-							{
-								if (Ptr = DWARFManager_GetLineSrcFromNumLine(PtrCU[NbCU].PtrLoadSrc, (j + 1)))
-								{
-#ifndef CONVERT_QT_HML
-									strcpy(PtrCU[NbCU].PtrLinesLoadSrc[j], Ptr);
+						PtrCU[NbCU].PtrUsedNumLines[i] = PtrCU[NbCU].PtrUsedLinesSrc[i].NumLineSrc - 1;
+					}
+
+					// Setup memory range for the code if CU doesn't have already this information
+					// It is taken from the used lines structure
+					if (!PtrCU[NbCU].LowPC && (!PtrCU[NbCU].HighPC || (PtrCU[NbCU].HighPC == ~0)))
+					{
+						PtrCU[NbCU].LowPC = PtrCU[NbCU].PtrUsedLinesSrc[0].StartPC;
+						PtrCU[NbCU].HighPC = PtrCU[NbCU].PtrUsedLinesSrc[PtrCU[NbCU].NbUsedLinesSrc - 1].StartPC;
+					}
+				}
+
+				// Init global variables information based on types information
+				for (size_t i = 0; i < PtrCU[NbCU].NbVariables; i++)
+				{
+					DWARFManager_InitInfosVariable(PtrCU[NbCU].PtrVariables + i);
+				}
+
+				// Init local variables information based on types information
+				for (size_t i = 0; i < PtrCU[NbCU].NbSubProgs; i++)
+				{
+					for (size_t j = 0; j < PtrCU[NbCU].PtrSubProgs[i].NbVariables; j++)
+					{
+						DWARFManager_InitInfosVariable(PtrCU[NbCU].PtrSubProgs[i].PtrVariables + j);
+					}
+				}
+			}
+
+			++NbCU;
+		}
+	} 
+
+	// Resolve the source files in the background
+	DWARFManager_ResolveSrcStart();
+}
+
+
+// Source files resolution start
+// The full filenames and the source files status are resolved by a host thread, with a copy of the search paths
+void DWARFManager_ResolveSrcStart(void)
+{
+	if ((ResolveSrcPaths = (char **)calloc((NbSearchPaths + 1), sizeof(char *))))
+	{
+		for (NbResolveSrcPaths = 0; NbResolveSrcPaths < NbSearchPaths; NbResolveSrcPaths++)
+		{
+			ResolveSrcPaths[NbResolveSrcPaths] = strdup(ListSearchPaths[NbResolveSrcPaths]);
+		}
+	}
+
+#ifndef NO_SDL
+	ResolveSrcQuit = false;
+
+	// Without the host thread, each source file is resolved at its first use
+	if ((ResolveSrcMutex = SDL_CreateMutex()))
+	{
+		ResolveSrcThread = SDL_CreateThread(DWARFManager_ResolveSrcThreadFunc, NULL);
+	}
+#endif
+}
+
+
+// Source files resolution stop
+void DWARFManager_ResolveSrcStop(void)
+{
+#ifndef NO_SDL
+	if (ResolveSrcThread)
+	{
+		ResolveSrcQuit = true;
+		SDL_WaitThread(ResolveSrcThread, NULL);
+		ResolveSrcThread = NULL;
+	}
+
+	if (ResolveSrcMutex)
+	{
+		SDL_DestroyMutex(ResolveSrcMutex);
+		ResolveSrcMutex = NULL;
+	}
+#endif
+
+	while (NbResolveSrcPaths)
+	{
+		free(ResolveSrcPaths[--NbResolveSrcPaths]);
+	}
+	free(ResolveSrcPaths);
+	ResolveSrcPaths = NULL;
+}
+
+
+#ifndef NO_SDL
+// Source files resolution host thread
+int DWARFManager_ResolveSrcThreadFunc(void *)
+{
+	for (size_t i = 0; (i < NbCU) && !ResolveSrcQuit; i++)
+	{
+		DWARFManager_ResolveSrc(i);
+	}
+
+	return 0;
+}
+#endif
+
+
+// Source file resolution, from the host thread or at the source file first use
+// Set the full filename, and the source file status
+void DWARFManager_ResolveSrc(size_t Index)
+{
+	struct stat _statbuf;
+	char *Ptr, *Ptr1;
+
+#ifndef NO_SDL
+	if (ResolveSrcMutex)
+	{
+		SDL_LockMutex(ResolveSrcMutex);
+	}
+#endif
+
+	if (!PtrCU[Index].Resolved && PtrCU[Index].PtrSourceFilename)
+	{
+		// Check directory presence
+		if (!PtrCU[Index].PtrSourceFileDirectory)
+		{
+			// Check if file exists in the search paths, the first one found is used
+			for (size_t i = 0; (i < NbResolveSrcPaths) && !PtrCU[Index].PtrSourceFileDirectory; i++)
+			{
+				PtrCU[Index].PtrFullFilename = (char *)realloc(PtrCU[Index].PtrFullFilename, strlen(PtrCU[Index].PtrSourceFilename) + strlen((const char *)ResolveSrcPaths[i]) + 2);
+#if defined(_WIN32)
+				sprintf(PtrCU[Index].PtrFullFilename, "%s\\%s", ResolveSrcPaths[i], PtrCU[Index].PtrSourceFilename);
 #else
-									size_t i = 0;
+				sprintf(PtrCU[Index].PtrFullFilename, "%s/%s", ResolveSrcPaths[i], PtrCU[Index].PtrSourceFilename);
+#endif
+				if (!stat(PtrCU[Index].PtrFullFilename, &_statbuf))
+				{
+					PtrCU[Index].PtrSourceFileDirectory = (char *)realloc(PtrCU[Index].PtrSourceFileDirectory, strlen(ResolveSrcPaths[i]) + 1);
+					strcpy(PtrCU[Index].PtrSourceFileDirectory, ResolveSrcPaths[i]);
+				}
+			}
 
-									while (*Ptr)
-									{
-										switch (*Ptr)
-										{
-										case 9:
-											strcat(PtrCU[NbCU].PtrLinesLoadSrc[j], "&nbsp;");
-											i += 6;
-											break;
+			// File directory doesn't exits
+			if (!PtrCU[Index].PtrSourceFileDirectory)
+			{
+				PtrCU[Index].PtrSourceFileDirectory = (char *)realloc(PtrCU[Index].PtrSourceFileDirectory, 2);
+				strcpy(PtrCU[Index].PtrSourceFileDirectory, ".");
+			}
+		}
 
-										case '<':
-											strcat(PtrCU[NbCU].PtrLinesLoadSrc[j], "&lt;");
-											i += 4;
-											break;
+		// Check if filename contains already the complete directory
+		if (PtrCU[Index].PtrSourceFilename[1] == ':')
+		{
+			// Copy the filename as the full filename
+			PtrCU[Index].PtrFullFilename = (char *)realloc(PtrCU[Index].PtrFullFilename, strlen(PtrCU[Index].PtrSourceFilename) + 1);
+			strcpy(PtrCU[Index].PtrFullFilename, PtrCU[Index].PtrSourceFilename);
+		}
+		else
+		{
+			// Create full filename and Conform slashes / backslashes
+			PtrCU[Index].PtrFullFilename = (char *)realloc(PtrCU[Index].PtrFullFilename, strlen(PtrCU[Index].PtrSourceFilename) + strlen(PtrCU[Index].PtrSourceFileDirectory) + 2);
+#if defined(_WIN32)
+			sprintf(PtrCU[Index].PtrFullFilename, "%s\\%s", PtrCU[Index].PtrSourceFileDirectory, PtrCU[Index].PtrSourceFilename);
+#else
+			sprintf(PtrCU[Index].PtrFullFilename, "%s/%s", PtrCU[Index].PtrSourceFileDirectory, PtrCU[Index].PtrSourceFilename);
+#endif
+		}
 
-										case '>':
-											strcat(PtrCU[NbCU].PtrLinesLoadSrc[j], "&gt;");
-											i += 4;
-											break;
-#if 0
-										case '&':
-											strcpy(PtrCU[NbCU].PtrLinesLoadSrc[j], "&amp;");
-											i += strlen("&amp;");
-											break;
+		DWARFManager_ConformSlachesBackslashes(PtrCU[Index].PtrFullFilename);
+
+		// Directory path clean-up
+#if defined(_WIN32)
+		while ((Ptr1 = Ptr = strstr(PtrCU[Index].PtrFullFilename, "\\..\\")))
+#else
+		while ((Ptr1 = Ptr = strstr(PtrCU[Index].PtrFullFilename, "/../")))
 #endif
-#if 0
-										case '"':
-											strcpy(PtrCU[NbCU].PtrLinesLoadSrc[j], "&quot;");
-											i += strlen("&quot;");
-											break;
+		{
+#if defined(_WIN32)
+			while (*--Ptr1 != '\\');
+#else
+			while (*--Ptr1 != '/');
 #endif
-										default:
-											PtrCU[NbCU].PtrLinesLoadSrc[j][i++] = *Ptr;
-											break;
-										}
-										Ptr++;
-									}
+			strcpy((Ptr1 + 1), (Ptr + 4));
+		}
+
+		// Get the source file information
+		if (!stat(PtrCU[Index].PtrFullFilename, &PtrCU[Index]._statbuf))
+		{
+			// check the time stamp with the executable
+			if (PtrCU[Index]._statbuf.st_mtime > FileElfExeInfo.st_mtime)
+			{
+				// Source file is outdated
+				PtrCU[Index].Status = DWARFSTATUS_OUTDATEDFILE;
+			}
+		}
+		else
+		{
+			// Source file doesn't have information
+			PtrCU[Index].Status = DWARFSTATUS_NOFILEINFO;
+		}
+	}
+
+	PtrCU[Index].Resolved = true;
+
+#ifndef NO_SDL
+	if (ResolveSrcMutex)
+	{
+		SDL_UnlockMutex(ResolveSrcMutex);
+	}
 #endif
-								}
-								PtrCU[NbCU].PtrLinesLoadSrc[j] = (char *)realloc(PtrCU[NbCU].PtrLinesLoadSrc[j], strlen(PtrCU[NbCU].PtrLinesLoadSrc[j]) + 1);
-							}
-						}
+}
+
+
+// Source file load, at its first view
+// The whole text is read, and each line is indexed in the text
+void DWARFManager_LoadSrc(size_t Index)
+{
+	FILE *SrcFile;
+	char *Ptr, *Ptr1;
+
+	if (PtrCU[Index].Loaded)
+	{
+		return;
+	}
+
+	PtrCU[Index].Loaded = true;
+	DWARFManager_ResolveSrc(Index);
 
-						// Init lines source information for each source code line numbers and for each subprogs
-						for (size_t j = 0; j < PtrCU[NbCU].NbSubProgs; j++)
+	if (PtrCU[Index].PtrFullFilename && (PtrCU[Index].Status == DWARFSTATUS_OK))
+	{
+		// Open the source file as a binary file
+#if defined(_WIN32)
+		if (!fopen_s(&SrcFile, PtrCU[Index].PtrFullFilename, "rb"))
+#else
+		if ((SrcFile = fopen(PtrCU[Index].PtrFullFilename, "rb")))
+#endif
+		{
+			if (!fseek(SrcFile, 0, SEEK_END))
+			{
+				if ((PtrCU[Index].SizeLoadSrc = ftell(SrcFile)) > 0)
+				{
+					if (!fseek(SrcFile, 0, SEEK_SET))
+					{
+						if (PtrCU[Index].PtrLoadSrc = Ptr = Ptr1 = (char *)calloc(1, (PtrCU[Index].SizeLoadSrc + 2)))
 						{
-							// Check if the subprog / function's line exists in the source code
-							if (PtrCU[NbCU].PtrSubProgs[j].NumLineSrc <= PtrCU[NbCU].NbLinesLoadSrc)
+							// Read whole file
+#if defined(_WIN32)	&& defined(_MSC_VER)
+							if (fread_s(PtrCU[Index].PtrLoadSrc, PtrCU[Index].SizeLoadSrc, PtrCU[Index].SizeLoadSrc, 1, SrcFile) != 1)
+#else
+							if (fread(PtrCU[Index].PtrLoadSrc, PtrCU[Index].SizeLoadSrc, 1, SrcFile) != 1)
+#endif
 							{
-								PtrCU[NbCU].PtrSubProgs[j].PtrLineSrc = PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].PtrSubProgs[j].NumLineSrc - 1];
+								free(PtrCU[Index].PtrLoadSrc);
+								PtrCU[Index].PtrLoadSrc = NULL;
+								PtrCU[Index].SizeLoadSrc = 0;
 							}
-
-							for (size_t k = 0; k < PtrCU[NbCU].PtrSubProgs[j].NbLinesSrc; k++)
+							else
 							{
-								if (PtrCU[NbCU].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc <= PtrCU[NbCU].NbLinesLoadSrc)
+								// Eliminate all carriage return code '\r' (oxd)
+								do
+								{
+									if ((*Ptr = *Ptr1) != '\r')
+									{
+										Ptr++;
+									}
+								} while (*Ptr1++);
+
+								// Get back the new text file size
+								PtrCU[Index].SizeLoadSrc = strlen(Ptr = PtrCU[Index].PtrLoadSrc);
+
+								// Make sure the text file finish with a new line code '\n' (0xa)
+								if (PtrCU[Index].PtrLoadSrc[PtrCU[Index].SizeLoadSrc - 1] != '\n')
 								{
-									PtrCU[NbCU].PtrSubProgs[j].PtrLinesSrc[k].PtrLineSrc = PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc - 1];
+									PtrCU[Index].PtrLoadSrc[PtrCU[Index].SizeLoadSrc++] = '\n';
+									PtrCU[Index].PtrLoadSrc[PtrCU[Index].SizeLoadSrc] = 0;
 								}
-							}
-						}
-					}
-				}
-				else
-				{
-					// Set each source lines pointer to NULL
-					if (PtrCU[NbCU].NbSubProgs)
-					{
-						// Check the presence of source lines dedicated to the sub progs
-						if (PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs - 1].NbLinesSrc)
-						{
-							size_t i = PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs - 1].PtrLinesSrc[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs - 1].NbLinesSrc - 1].NumLineSrc;
-							if (PtrCU[NbCU].PtrLinesLoadSrc = (char **)calloc(i, sizeof(char *)))
-							{
-								for (size_t j = 0; j < i; j++)
+
+								// Reallocate text file
+								if (PtrCU[Index].PtrLoadSrc = Ptr = (char *)realloc(PtrCU[Index].PtrLoadSrc, (PtrCU[Index].SizeLoadSrc + 1)))
 								{
-									PtrCU[NbCU].PtrLinesLoadSrc[j] = NULL;
+									// Count line numbers, based on the new line code '\n' (0xa), and finish each line with 0
+									do
+									{
+										if (*Ptr == '\n')
+										{
+											PtrCU[Index].NbLinesLoadSrc++;
+											*Ptr = 0;
+										}
+									} while (*++Ptr);
 								}
 							}
 						}
 					}
 				}
+			}
+
+			fclose(SrcFile);
+		}
+		else
+		{
+			// Source file doesn't exist
+			PtrCU[Index].Status = DWARFSTATUS_NOFILE;
+		}
+	}
 
-				// Check validity between used number lines and number lines in the source file
-				if (PtrCU[NbCU].LastNumUsedLinesSrc <= PtrCU[NbCU].NbLinesLoadSrc)
+	// Set the source code lines
+	if (PtrCU[Index].NbLinesLoadSrc)
+	{
+		if (PtrCU[Index].PtrLinesLoadSrc = (char **)calloc(PtrCU[Index].NbLinesLoadSrc, sizeof(char *)))
+		{
+			// Index each line in the text, in a single pass
+			Ptr = PtrCU[Index].PtrLoadSrc;
+
+			for (size_t j = 0; j < PtrCU[Index].NbLinesLoadSrc; j++)
+			{
+#ifndef CONVERT_QT_HML
+				PtrCU[Index].PtrLinesLoadSrc[j] = Ptr;
+#else
+				if (PtrCU[Index].PtrLinesLoadSrc[j] = (char *)calloc(((strlen(Ptr) * 6) + 1), sizeof(char)))
 				{
-					// Set information based on used line numbers
-					if (PtrCU[NbCU].PtrUsedLinesSrc)
+					size_t i = 0;
+
+					for (Ptr1 = Ptr; *Ptr1; Ptr1++)
 					{
-						// Set the line source pointers for each used line numbers
-						if (PtrCU[NbCU].PtrLinesLoadSrc)
+						switch (*Ptr1)
 						{
-							for (size_t i = 0; i < PtrCU[NbCU].NbUsedLinesSrc; i++)
-							{
-								PtrCU[NbCU].PtrUsedNumLines[i] = PtrCU[NbCU].PtrUsedLinesSrc[i].NumLineSrc - 1;
-								PtrCU[NbCU].PtrUsedLinesLoadSrc[i] = PtrCU[NbCU].PtrUsedLinesSrc[i].PtrLineSrc = PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].PtrUsedLinesSrc[i].NumLineSrc - 1];
-							}
+						case 9:
+							strcpy(PtrCU[Index].PtrLinesLoadSrc[j] + i, "&nbsp;");
+							i += 6;
+							break;
 
-							// Setup memory range for the code if CU doesn't have already this information
-							// It is taken from the used lines structure
-							if (!PtrCU[NbCU].LowPC && (!PtrCU[NbCU].HighPC || (PtrCU[NbCU].HighPC == ~0)))
-							{
-								PtrCU[NbCU].LowPC = PtrCU[NbCU].PtrUsedLinesSrc[0].StartPC;
-								PtrCU[NbCU].HighPC = PtrCU[NbCU].PtrUsedLinesSrc[PtrCU[NbCU].NbUsedLinesSrc - 1].StartPC;
-							}
+						case '<':
+							strcpy(PtrCU[Index].PtrLinesLoadSrc[j] + i, "&lt;");
+							i += 4;
+							break;
+
+						case '>':
+							strcpy(PtrCU[Index].PtrLinesLoadSrc[j] + i, "&gt;");
+							i += 4;
+							break;
+
+						default:
+							PtrCU[Index].PtrLinesLoadSrc[j][i++] = *Ptr1;
+							break;
 						}
 					}
+
+					PtrCU[Index].PtrLinesLoadSrc[j] = (char *)realloc(PtrCU[Index].PtrLinesLoadSrc[j], i + 1);
 				}
+#endif
+				while (*Ptr++);
+			}
 
-				// Init global variables information based on types information
-				for (size_t i = 0; i < PtrCU[NbCU].NbVariables; i++)
+			// Init lines source information for each source code line numbers and for each subprogs
+			for (size_t j = 0; j < PtrCU[Index].NbSubProgs; j++)
+			{
+				// Check if the subprog / function's line exists in the source code
+				if (PtrCU[Index].PtrSubProgs[j].NumLineSrc && (PtrCU[Index].PtrSubProgs[j].NumLineSrc <= PtrCU[Index].NbLinesLoadSrc))
 				{
-					DWARFManager_InitInfosVariable(PtrCU[NbCU].PtrVariables + i);
+					PtrCU[Index].PtrSubProgs[j].PtrLineSrc = PtrCU[Index].PtrLinesLoadSrc[PtrCU[Index].PtrSubProgs[j].NumLineSrc - 1];
 				}
 
-				// Init local variables information based on types information
-				for (size_t i = 0; i < PtrCU[NbCU].NbSubProgs; i++)
+				for (size_t k = 0; k < PtrCU[Index].PtrSubProgs[j].NbLinesSrc; k++)
 				{
-					for (size_t j = 0; j < PtrCU[NbCU].PtrSubProgs[i].NbVariables; j++)
+					if (PtrCU[Index].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc && (PtrCU[Index].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc <= PtrCU[Index].NbLinesLoadSrc))
 					{
-						DWARFManager_InitInfosVariable(PtrCU[NbCU].PtrSubProgs[i].PtrVariables + j);
+						PtrCU[Index].PtrSubProgs[j].PtrLinesSrc[k].PtrLineSrc = PtrCU[Index].PtrLinesLoadSrc[PtrCU[Index].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc - 1];
 					}
 				}
 			}
 
-			++NbCU;
+			// Set the line source pointers for each used line numbers
+			for (size_t i = 0; i < PtrCU[Index].NbUsedLinesSrc; i++)
+			{
+				if (PtrCU[Index].PtrUsedLinesSrc[i].NumLineSrc && (PtrCU[Index].PtrUsedLinesSrc[i].NumLineSrc <= PtrCU[Index].NbLinesLoadSrc))
+				{
+					PtrCU[Index].PtrUsedLinesLoadSrc[i] = PtrCU[Index].PtrUsedLinesSrc[i].PtrLineSrc = PtrCU[Index].PtrLinesLoadSrc[PtrCU[Index].PtrUsedLinesSrc[i].NumLineSrc - 1];
+				}
+			}
 		}
-	} 
+	}
+	else
+	{
+		// Set each source lines pointer to NULL
+		if (PtrCU[Index].NbSubProgs)
+		{
+			// Check the presence of source lines dedicated to the sub progs
+			if (PtrCU[Index].PtrSubProgs[PtrCU[Index].NbSubProgs - 1].NbLinesSrc)
+			{
+				size_t i = PtrCU[Index].PtrSubProgs[PtrCU[Index].NbSubProgs - 1].PtrLinesSrc[PtrCU[Index].PtrSubProgs[PtrCU[Index].NbSubProgs - 1].NbLinesSrc - 1].NumLineSrc;
+				PtrCU[Index].PtrLinesLoadSrc = (char **)calloc(i, sizeof(char *));
+			}
+		}
+	}
 }
 
 
@@ -1591,6 +1713,8 @@ char *DWARFManager_GetFullSourceFilenameFromAdr(size_t Adr, DWARFstatus *Status)
 	{
 		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
 		{
+			DWARFManager_ResolveSrc(i);
+
 			if (Status)
 			{
 				*Status = PtrCU[i].Status;
@@ -2076,6 +2200,8 @@ char *DWARFManager_GetLineSrcFromAdr(size_t Adr, size_t Tag)
 	{
 		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
 		{
+			DWARFManager_LoadSrc(i);
+
 			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
 			{
 				if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
@@ -2196,6 +2322,7 @@ size_t DWARFManager_GetSrcNbListPtrFromIndex(size_t Index, bool Used)
 {
 	if (!Used)
 	{
+		DWARFManager_LoadSrc(Index);
 		return PtrCU[Index].NbLinesLoadSrc;
 	}
 	else
@@ -2224,6 +2351,8 @@ size_t *DWARFManager_GetSrcNumLinesPtrFromIndex(size_t Index, bool Used)
 // Return NULL for the text source used list 
 char **DWARFManager_GetSrcListPtrFromIndex(size_t Index, bool Used)
 {
+	DWARFManager_LoadSrc(Index);
+
 	if (!Used)
 	{
 		return PtrCU[Index].PtrLinesLoadSrc;
@@ -2250,6 +2379,8 @@ char *DWARFManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine)
 	{
 		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
 		{
+			DWARFManager_LoadSrc(i);
+
 			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
 			{
 				if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
@@ -2285,7 +2416,9 @@ char *DWARFManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine)
 	{
 		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
 		{
-			if (NumLine <= PtrCU[i].NbLinesLoadSrc)
+			DWARFManager_LoadSrc(i);
+
+			if (NumLine && (NumLine <= PtrCU[i].NbLinesLoadSrc))
 			{
 				return PtrCU[i].PtrLinesLoadSrc[NumLine - 1];
 			}
@@ -2310,6 +2443,7 @@ size_t DWARFManager_GetNbSources(void)
 // Get source code filename, including his directory, based on index (starting from 0)
 char *DWARFManager_GetNumFullSourceFilename(size_t Index)
 {
+	DWARFManager_ResolveSrc(Index);
 	return (PtrCU[Index].PtrFullFilename);
 }
 
@@ -8,6 +8,7 @@
 // Who  When        What
 // ---  ----------  -------------------------------------------------------------
 // JPM  02/01/2017  Created this file
+// JPM   Oct./2026  Instructions from the disassembly cache
 //
 
 // STILL TO DO:
@@ -16,7 +17,7 @@
 #include "GPUDasmWin.h"
 #include "dsp.h"
 #include "gpu.h"
-#include "jagdasm.h"
+#include "machine.h"
 #include "settings.h"
 
 
@@ -37,8 +38,7 @@ void GPUDasmWindow::RefreshContents(void)
 {
 	char string[1024];
 	QString s;
-	char buffer[2048];
-	int pc = memBase, oldpc;
+	int pc = memBase;
 	uint32_t GPUPC = GPUReadLong(0xF02110, DEBUG);
 	bool GPUPCShow = false;
 
@@ -46,34 +46,20 @@ void GPUDasmWindow::RefreshContents(void)
 
 	for(uint32_t i=0; i<vjs.nbrdisasmlines; i++)
 	{
-		oldpc = pc;
-		pc += dasmjag(JAGUAR_GPU, buffer, pc);
+		DasmCacheEntry * entry = DasmCacheGet(DASMCACHE_GPU, pc);
 
-		if (GPUPC == oldpc)
+		if (GPUPC == pc)
 		{
-			sprintf(string, "=> %06X: %s<br>", oldpc, buffer);
+			sprintf(string, "=> %06X: %s<br>", pc, entry->text);
 			GPUPCShow = true;
 		}
 		else
 		{
-			sprintf(string, "   %06X: %s<br>", oldpc, buffer);
+			sprintf(string, "   %06X: %s<br>", pc, entry->text);
 		}
 
-		buffer[0] = 0;	// Clear string
-		char singleCharString[2] = { 0, 0 };
-
-		for(uint j=0; j<strlen(string); j++)
-		{
-			if (string[j] == 32)
-				strcat(buffer, "&nbsp;");
-			else
-			{
-				singleCharString[0] = string[j];
-				strcat(buffer, singleCharString);
-			}
-		}
-
-		s += QString(buffer);
+		pc += entry->length;
+		s += QString(string).replace(' ', "&nbsp;");
 	}
 
 	if (GPUPCShow)
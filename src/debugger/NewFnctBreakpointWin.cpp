@@ -9,6 +9,7 @@
 // ---  ----------  -----------------------------------------------------------
 // JPM  10/19/2018  Created this file
 // JPM  March/2021  Breakpoint list window refresh
+// JPM   Oct./2026  Added the breakpoint condition
 //
 
 // STILL TO DO:
@@ -17,6 +18,7 @@
 //
 
 #include "debugger/NewFnctBreakpointWin.h"
+#include "brkcond.h"
 #include "jaguar.h"
 #include "debugger/DBGManager.h"
 #include "m68000/m68kinterface.h"
@@ -27,21 +29,25 @@
 NewFnctBreakpointWindow::NewFnctBreakpointWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt::Dialog),
 layout(new QVBoxLayout),
 address(new QLineEdit),
+condition(new QLineEdit),
 add(new QPushButton(tr("Add")))
 {
 	setWindowTitle(tr("New function breakpoint"));
 
 	address->setPlaceholderText("0x<value>, decimal value or symbol name");
+	condition->setPlaceholderText("Condition (optional), such as: d0 == 3 && hits > 100");
 
 	QHBoxLayout * hbox1 = new QHBoxLayout;
 	hbox1->addWidget(address);
 	hbox1->addWidget(add);
 
 	layout->addLayout(hbox1);
+	layout->addWidget(condition);
 	setLayout(layout);
 
 	connect(add, SIGNAL(clicked()), this, SLOT(AddBreakpointAddress()));
 	connect(address, SIGNAL(cursorPositionChanged(int, int)), this, SLOT(SelectBreakpointAddress()));
+	connect(condition, SIGNAL(cursorPositionChanged(int, int)), this, SLOT(SelectBreakpointAddress()));
 }
 
 
@@ -72,11 +78,14 @@ void NewFnctBreakpointWindow::SetFnctBreakpointWin(BreakpointsWindow* BpW)
 void NewFnctBreakpointWindow::SelectBreakpointAddress(void)
 {
 	address->setStyleSheet("color: black");
+	condition->setStyleSheet("color: black");
+	condition->setToolTip("");
 }
 
 
 // Add a breakpoint to the address
 // Address can be an hexa, decimal or a symbol name
+// Condition is compiled here, its variables being looked up once
 void NewFnctBreakpointWindow::AddBreakpointAddress(void)
 {
 	bool ok;
@@ -84,10 +93,24 @@ void NewFnctBreakpointWindow::AddBreakpointAddress(void)
 	QString newAddress;
 	size_t adr;
 	S_BrkInfo Brk;
+	char error[64];
 
 	memset(&Brk, 0, sizeof(Brk));
 	newAddress = address->text();
 
+	if (!condition->text().trimmed().isEmpty())
+	{
+		if (!(Brk.Cond = BrkCondCompile(condition->text().toLatin1().data(), DBGManager_GetAdrFromName, error, sizeof(error))))
+		{
+			// Condition is not valid
+			condition->setStyleSheet("color: red");
+			condition->setToolTip(error);
+			return;
+		}
+
+		Brk.Condition = strdup(condition->text().trimmed().toLatin1().data());
+	}
+
 	if ((len = newAddress.size()))
 	{
 		if ((len > 1) && (newAddress.at(0) == QChar('0')) && (newAddress.at(1) == QChar('x')))
@@ -126,6 +149,9 @@ void NewFnctBreakpointWindow::AddBreakpointAddress(void)
 			else
 			{
 				address->setText("");
+				condition->setText("");
+				Brk.Condition = NULL;
+				Brk.Cond = NULL;
 			}
 		}
 		else
@@ -137,6 +163,10 @@ void NewFnctBreakpointWindow::AddBreakpointAddress(void)
 		// update the breakpoint functions window
 		BPWin->RefreshContents();
 	}
+
+	// Condition not used by a breakpoint
+	free(Brk.Condition);
+	BrkCondFree(Brk.Cond);
 }
 
 
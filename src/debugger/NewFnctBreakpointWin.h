@@ -32,6 +32,7 @@ class NewFnctBreakpointWindow: public QWidget
 	private:
 		QVBoxLayout *layout;
 		QLineEdit *address;
+		QLineEdit *condition;
 		QPushButton *add;
 		BreakpointsWindow* BPWin;
 };
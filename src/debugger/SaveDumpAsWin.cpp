@@ -15,6 +15,7 @@
 
 #include "debugger/SaveDumpAsWin.h"
 #include "jaguar.h"
+#include "machine.h"
 #include "debugger/DBGManager.h"
 #include "m68000/m68kinterface.h"
 #include "settings.h"
@@ -9,6 +9,7 @@
 // ---  ----------  -------------------------------------------------------------
 // JPM  08/23/2019  Created this file
 // JPM   Apr./2021  Fixed potential crash with the tabs reset
+// JPM   Oct./2026  Source code text is requested at the tab opening
 
 // STILL TO DO:
 // Use the CloseTab signal's value instead to close the current tab
@@ -75,7 +76,7 @@ void SourcesWindow::SelectTab(const int)
 // Prepare tabs for every available source code file
 void SourcesWindow::Init(void)
 {
-	size_t i, j;
+	size_t i;
 	char *Ptr, *Ptr1;
 
 	// get number of sources
@@ -93,13 +94,8 @@ void SourcesWindow::Init(void)
 			Ptr1 = sourcesinfostab[i].Filename = (char *)malloc(strlen(Ptr) + 1);
 			while (((*Ptr == '.') || ((*Ptr == '/') || (*Ptr == '\\'))) && Ptr++);
 			strcpy(Ptr1, Ptr);
-			// get texts dedicated information
-			for (j = 0; j < 2; j++)
-			{
-				sourcesinfostab[i].NbLinesText[j] = DBGManager_GetSrcNbListPtrFromIndex(i, j);
-			}
+			// get texts dedicated information, the source code text being loaded at the tab opening
 			sourcesinfostab[i].NumLinesUsed = DBGManager_GetSrcNumLinesPtrFromIndex(i, true);
-			sourcesinfostab[i].SourceText = DBGManager_GetSrcListPtrFromIndex(i, false);
 			// get remaining information
 			sourcesinfostab[i].Language = DBGManager_GetSrcLanguageFromIndex(i);
 			sourcesinfostab[i].IndexTab = -1;
@@ -189,6 +185,12 @@ void SourcesWindow::RefreshContents(void)
 						// open a new tab for a source code
 						if (sourcesinfostab[i].IndexTab == -1)
 						{
+							// get the source code text, loaded at its first view
+							for (size_t j = 0; j < 2; j++)
+							{
+								sourcesinfostab[i].NbLinesText[j] = DBGManager_GetSrcNbListPtrFromIndex(i, j);
+							}
+							sourcesinfostab[i].SourceText = DBGManager_GetSrcListPtrFromIndex(i, false);
 							sourcesinfostab[i].IndexTab = index = sourcestabWidget->addTab(sourcesinfostab[i].sourceCtab = new(SourceCWindow), tr(sourcesinfostab[i].Filename));
 							sourcesinfostab[i].sourceCtab->FillTab(i, sourcesinfostab[i].SourceText, sourcesinfostab[i].NbLinesText, sourcesinfostab[i].NumLinesUsed);
 						}
@@ -31,7 +31,7 @@
 
 
 #include "debugger/allwatchbrowser.h"
-#include "memory.h"
+#include "machine.h"
 #include "debugger/DBGManager.h"
 
 
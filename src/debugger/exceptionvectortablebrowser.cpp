@@ -18,7 +18,7 @@
 
 
 #include "debugger/exceptionvectortablebrowser.h"
-#include "memory.h"
+#include "machine.h"
 #include "debugger/DBGManager.h"
 
 
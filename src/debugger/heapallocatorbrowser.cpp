@@ -21,7 +21,7 @@
 
 #include "settings.h"
 #include "debugger/heapallocatorbrowser.h"
-#include "memory.h"
+#include "machine.h"
 #include "debugger/DBGManager.h"
 #include "m68000/m68kinterface.h"
 
@@ -0,0 +1,219 @@
+//
+// heatmapbrowser.cpp: Bus accesses heatmap
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -----------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+
+// STILL TO DO:
+// To name the buffers of the hottest buckets from the debug information
+//
+
+
+#include "debugger/heatmapbrowser.h"
+#include <math.h>
+#include "machine.h"
+#include "settings.h"
+
+
+//
+HeatmapBrowserWindow::HeatmapBrowserWindow(QWidget * parent/*= 0*/) : QWidget(parent, Qt::Dialog),
+layout(new QVBoxLayout),
+master(new QComboBox),
+kind(new QComboBox),
+total(new QCheckBox(tr("Totals"))),
+exportFile(new QPushButton(tr("Export"))),
+map(new QLabel),
+TableView(new QTableView),
+model(new QStandardItemModel),
+statusbar(new QStatusBar),
+heatmap((PerfHeatmap *)malloc(sizeof(PerfHeatmap)))
+{
+	setWindowTitle(tr("Bus Heatmap"));
+
+	// Set the font
+	QFont fixedFont("Lucida Console", 8, QFont::Normal);
+	fixedFont.setStyleHint(QFont::TypeWriter);
+
+	// Masters & kinds of accesses shown
+	master->addItem(tr("All masters"));
+	for (int i = 0; i < PERF_MASTERS; i++)
+	{
+		master->addItem(QString(PerfMasterName(i)).toUpper());
+	}
+	kind->addItem(tr("Reads & writes"));
+	kind->addItem(tr("Reads"));
+	kind->addItem(tr("Writes"));
+	total->setToolTip(tr("Accesses since the heatmap has been turned on, instead of the last frame ones"));
+
+	QHBoxLayout *hbox1 = new QHBoxLayout;
+	hbox1->addWidget(master);
+	hbox1->addWidget(kind);
+	hbox1->addWidget(total);
+	hbox1->addWidget(exportFile);
+	layout->addLayout(hbox1);
+
+	// Map of the 24 bit address space, a line by 256 KB
+	map->setFixedSize((HM_COLUMNS * HM_CELLSIZE), ((PERF_HEAT_BUCKETS / HM_COLUMNS) * HM_CELLSIZE));
+	map->setToolTip(tr("$000000 at the top left, a line by 256 KB, a cell by 4 KB"));
+	layout->addWidget(map);
+
+	// Hottest buckets
+	model->setColumnCount(3);
+	model->setHeaderData(0, Qt::Horizontal, QObject::tr("Bucket"));
+	model->setHeaderData(1, Qt::Horizontal, QObject::tr("Reads"));
+	model->setHeaderData(2, Qt::Horizontal, QObject::tr("Writes"));
+	TableView->setModel(model);
+	TableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	TableView->setShowGrid(0);
+	TableView->setFont(fixedFont);
+	TableView->verticalHeader()->setDefaultSectionSize(TableView->verticalHeader()->minimumSectionSize());
+	TableView->verticalHeader()->setDefaultAlignment(Qt::AlignRight);
+	layout->addWidget(TableView);
+
+	// Status bar
+	layout->addWidget(statusbar);
+	setLayout(layout);
+
+	connect(master, SIGNAL(currentIndexChanged(int)), this, SLOT(RefreshContents()));
+	connect(kind, SIGNAL(currentIndexChanged(int)), this, SLOT(RefreshContents()));
+	connect(total, SIGNAL(clicked()), this, SLOT(RefreshContents()));
+	connect(exportFile, SIGNAL(clicked()), this, SLOT(Export()));
+}
+
+
+//
+HeatmapBrowserWindow::~HeatmapBrowserWindow(void)
+{
+	free(heatmap);
+}
+
+
+// Refresh / Display the window contents
+void HeatmapBrowserWindow::RefreshContents(void)
+{
+	uint64_t value[PERF_HEAT_BUCKETS], reads[PERF_HEAT_BUCKETS], writes[PERF_HEAT_BUCKETS];
+	uint32_t hottest[HM_HOTTEST];
+	uint64_t maxValue = 0, sum = 0;
+	size_t nbHot = 0;
+
+	if (!isVisible() || !heatmap || !jaguarMachine)
+	{
+		return;
+	}
+
+	if (!PerfGetHeatmap(heatmap, total->isChecked()))
+	{
+		statusbar->showMessage(tr("Heatmap not available"));
+		return;
+	}
+
+	// Accesses of the selected masters, by bucket
+	int first = (master->currentIndex() ? (master->currentIndex() - 1) : 0);
+	int last = (master->currentIndex() ? master->currentIndex() : PERF_MASTERS);
+
+	for (uint32_t i = 0; i < PERF_HEAT_BUCKETS; i++)
+	{
+		reads[i] = writes[i] = 0;
+
+		for (int j = first; j < last; j++)
+		{
+			reads[i] += heatmap->accesses[PERF_HEAT_READ][j][i];
+			writes[i] += heatmap->accesses[PERF_HEAT_WRITE][j][i];
+		}
+
+		value[i] = ((kind->currentIndex() != 2) ? reads[i] : 0) + ((kind->currentIndex() != 1) ? writes[i] : 0);
+		maxValue = qMax(maxValue, value[i]);
+		sum += value[i];
+
+		// Hottest buckets kept in order
+		if (value[i] && ((nbHot < HM_HOTTEST) || (value[i] > value[hottest[HM_HOTTEST - 1]])))
+		{
+			size_t j = ((nbHot < HM_HOTTEST) ? nbHot++ : (HM_HOTTEST - 1));
+
+			for (; j && (value[hottest[j - 1]] < value[i]); j--)
+			{
+				hottest[j] = hottest[j - 1];
+			}
+
+			hottest[j] = i;
+		}
+	}
+
+	// Logarithmic scale, from black to red, yellow & white
+	QImage image(HM_COLUMNS, (PERF_HEAT_BUCKETS / HM_COLUMNS), QImage::Format_RGB32);
+	double scale = (maxValue ? log((double)maxValue + 1.0) : 1.0);
+
+	for (uint32_t i = 0; i < PERF_HEAT_BUCKETS; i++)
+	{
+		int heat = (int)((log((double)value[i] + 1.0) / scale) * 767.0);
+		int r = qMin(heat, 255), g = qBound(0, (heat - 256), 255), b = qMax((heat - 512), 0);
+		image.setPixel((i % HM_COLUMNS), (i / HM_COLUMNS), qRgb(r, g, b));
+	}
+
+	map->setPixmap(QPixmap::fromImage(image.scaled(map->size())));
+
+	// Hottest buckets first
+	model->setRowCount(0);
+
+	for (size_t i = 0; i < nbHot; i++)
+	{
+		model->insertRow(i);
+		model->setItem(i, 0, new QStandardItem(QString("$%1-$%2").arg(hottest[i] << PERF_HEAT_SHIFT, 6, 16, QChar('0')).arg(((hottest[i] + 1) << PERF_HEAT_SHIFT) - 1, 6, 16, QChar('0')).toUpper()));
+		model->setItem(i, 1, new QStandardItem(QString("%1").arg(reads[hottest[i]])));
+		model->setItem(i, 2, new QStandardItem(QString("%1").arg(writes[hottest[i]])));
+	}
+
+	statusbar->showMessage(QString(tr("%1 accesses in %2 frame(s)%3")).arg(sum).arg(heatmap->frames).arg(PerfHeatmapIsEnabled() ? "" : tr(", heatmap turned off")));
+}
+
+
+// Write the heatmap in a CSV file
+void HeatmapBrowserWindow::Export(void)
+{
+	QString filename = QFileDialog::getSaveFileName(this, tr("Export the bus heatmap"), "", tr("CSV files (*.csv)"));
+
+	if (!filename.isEmpty())
+	{
+		statusbar->showMessage(PerfHeatmapSave(filename.toUtf8().data()) ? tr("Heatmap exported") : tr("Heatmap cannot be exported"));
+	}
+}
+
+
+// The heatmap counts the accesses while the window is shown, or for the --heatmap file
+void HeatmapBrowserWindow::showEvent(QShowEvent * e)
+{
+	if (jaguarMachine && !PerfHeatmapIsEnabled())
+	{
+		PerfHeatmapEnable(true);
+	}
+
+	QWidget::showEvent(e);
+}
+
+
+//
+void HeatmapBrowserWindow::hideEvent(QHideEvent * e)
+{
+	if (jaguarMachine && !vjs.heatmapFile[0])
+	{
+		PerfHeatmapEnable(false);
+	}
+
+	QWidget::hideEvent(e);
+}
+
+
+//
+void HeatmapBrowserWindow::keyPressEvent(QKeyEvent * e)
+{
+	if (e->key() == Qt::Key_Escape)
+	{
+		hide();
+	}
+}
@@ -0,0 +1,50 @@
+//
+// heatmapbrowser.h: Bus accesses heatmap
+//
+// by Jean-Paul Mari
+//
+
+#ifndef __HEATMAPBROWSER_H__
+#define __HEATMAPBROWSER_H__
+
+#include <QtWidgets/QtWidgets>
+#include <stdint.h>
+#include "perfcounters.h"
+
+#define HM_COLUMNS							64		// Buckets by line of the map (256 KB)
+#define HM_CELLSIZE							6		// Pixels of a bucket
+#define HM_HOTTEST							16		// Buckets listed
+
+
+//
+class HeatmapBrowserWindow: public QWidget
+{
+	Q_OBJECT
+
+	public:
+		HeatmapBrowserWindow(QWidget *parent = 0);
+		~HeatmapBrowserWindow(void);
+
+	public slots:
+		void RefreshContents(void);
+		void Export(void);
+
+	protected:
+		void keyPressEvent(QKeyEvent *);
+		void showEvent(QShowEvent *);
+		void hideEvent(QHideEvent *);
+
+	private:
+		QVBoxLayout *layout;
+		QComboBox *master;
+		QComboBox *kind;
+		QCheckBox *total;
+		QPushButton *exportFile;
+		QLabel *map;
+		QTableView *TableView;
+		QStandardItemModel *model;
+		QStatusBar *statusbar;
+		PerfHeatmap *heatmap;
+};
+
+#endif	// __HEATMAPBROWSER_H__
@@ -26,7 +26,7 @@
 #include <stdlib.h>
 
 #include "debugger/localbrowser.h"
-#include "memory.h"
+#include "machine.h"
 #include "debugger/DBGManager.h"
 #include "settings.h"
 #include "m68000/m68kinterface.h"
@@ -11,6 +11,7 @@
 // JPM  12/04/2016  Suport ELF debug information
 // JPM              Replacing the ELF support by the debugger information manager calls
 // JPM   Aug./2020  Display only the code related to the traced function, added different layouts & a status bar, Qt/HTML text format support
+// JPM   Oct./2026  Instructions & their annotations from the disassembly cache
 //
 
 // STILL TO DO:
@@ -22,6 +23,7 @@
 #include "dsp.h"
 #include "gpu.h"
 #include "DBGManager.h"
+#include "machine.h"
 #include "settings.h"
 
 
@@ -58,24 +60,90 @@ memBase(0)
 }
 
 
+// Instruction as HTML, spaces escaped and its addresses replaced by their symbols
+static void m68KDasmHTML(const char *text, char *html)
+{
+	bool constant, adr, equal;
+	char adresse[16], *Symbol, *p;
+
+	adr = constant = equal = false;
+
+	for (size_t j = 0; text[j]; j++)
+	{
+		if (text[j] == ' ')
+		{
+			html += sprintf(html, "&nbsp;");
+			adr = constant = false;
+		}
+		else
+		{
+			switch (text[j])
+			{
+			case	'#':
+				constant = true;
+				break;
+
+			case	'$':
+				adr = true;
+				break;
+
+			case	',':
+				constant = adr = equal = false;
+				break;
+
+			case	'=':
+				equal = true;
+				break;
+			}
+
+			if (!constant && adr && !equal)
+			{
+				int l = 0;
+				do
+				{
+					adresse[l++] = text[++j];
+				} while ((l < 15) && ((text[(j + 1)] >= '0') && (text[(j + 1)] <= '9') || (text[(j + 1)] >= 'A') && (text[(j + 1)] <= 'F')));
+				adresse[l] = 0;
+
+				if (Symbol = DBGManager_GetSymbolNameFromAdr(strtoul(adresse, &p, 16)))
+				{
+					html += sprintf(html, "%s", Symbol);
+				}
+				else
+				{
+					html += sprintf(html, "$%s", adresse);
+				}
+
+				adr = false;
+			}
+			else
+			{
+				*html++ = text[j];
+			}
+		}
+	}
+
+	*html = 0;
+}
+
+
 //
 void m68KDasmWindow::RefreshContents(void)
 {
 	QString s;
-	char buffer[1024], string[1024], adresse[16];
+	char buffer[4096], string[1024];
 	size_t pc = memBase, oldpc;
 	size_t m68kPC = m68k_get_reg(NULL, M68K_REG_PC);
 	size_t m68KPCNbrDisasmLines = 0;
 	char *Symbol = NULL, *LineSrc, *CurrentLineSrc = NULL;
 	bool m68kPCShow = false;
-	bool constant, adr, equal;
 	DBGstatus Status;
-	size_t j, i;
+	size_t i;
 	size_t	nbr = vjs.nbrdisasmlines;
 	char *PtrFullSource, *CurrentPtrFullSource = (char *)calloc(1, 1);
 	size_t NumLine;	// , CurrentNumLine = 0;
 	size_t CurrentNumLine;
-	char singleCharString[2] = { 0, 0 };
+	DasmCacheEntry *entry;
 #if MD_LAYOUTFILE == 1
 	bool In = true;
 #else
@@ -85,10 +153,23 @@ void m68KDasmWindow::RefreshContents(void)
 	for (i = 0; (i < nbr) && In; i++)
 	{
 		oldpc = pc;
-		adr = constant = equal = false;
+
+		// Instruction & its debugger annotations, looked up once
+		entry = DasmCacheGet(DASMCACHE_M68K, (uint32_t)oldpc, vjs.disasmopcodes);
+
+		if (!entry->annotated)
+		{
+			entry->fullSource = DBGManager_GetFullSourceFilenameFromAdr(oldpc, &Status);
+			entry->status = Status;
+			entry->numLine = DBGManager_GetNumLineFromAdr(oldpc, DBG_NO_TAG);
+			entry->symbol = DBGManager_GetSymbolNameFromAdr(oldpc);
+			entry->annotated = true;
+		}
+
+		Status = (DBGstatus)entry->status;
 
 		// Display source filename based on the program address
-		if (vjs.displayFullSourceFilename && (PtrFullSource = DBGManager_GetFullSourceFilenameFromAdr(oldpc, &Status)) && strcmp(CurrentPtrFullSource, PtrFullSource))
+		if (vjs.displayFullSourceFilename && (PtrFullSource = entry->fullSource) && strcmp(CurrentPtrFullSource, PtrFullSource))
 		{
 #if defined(MD_LAYOUTFILE)
 			if (i)
@@ -106,7 +187,7 @@ void m68KDasmWindow::RefreshContents(void)
 #endif
 #endif
 			{
-				CurrentNumLine = DBGManager_GetNumLineFromAdr(pc, DBG_NO_TAG) - 1;
+				CurrentNumLine = entry->numLine - 1;
 				CurrentPtrFullSource = (char *)realloc(CurrentPtrFullSource, strlen(PtrFullSource) + 1);
 				strcpy(CurrentPtrFullSource, PtrFullSource);
 #if defined(MD_LAYOUTFILE)
@@ -146,7 +227,7 @@ void m68KDasmWindow::RefreshContents(void)
 		else
 		{
 			// Display line number based on the program address
-			if ((NumLine = DBGManager_GetNumLineFromAdr(oldpc, DBG_NO_TAG)) && ((signed)NumLine > (signed)CurrentNumLine) && !Status)
+			if ((NumLine = entry->numLine) && ((signed)NumLine > (signed)CurrentNumLine) && !Status)
 			{
 #if MD_LAYOUTFILE != 1
 				if ((signed)CurrentNumLine < 0)
@@ -180,7 +261,7 @@ void m68KDasmWindow::RefreshContents(void)
 			else
 			{
 				// Display symbol, or line source, based on the program address
-				if (!CurrentLineSrc && !Symbol && (Symbol = DBGManager_GetSymbolNameFromAdr(oldpc)))
+				if (!CurrentLineSrc && !Symbol && (Symbol = entry->symbol))
 				{
 					sprintf(string, "%s:<br>", Symbol);
 					s += QString(string);
@@ -189,81 +270,30 @@ void m68KDasmWindow::RefreshContents(void)
 				// Display the assembly line based on the current PC
 				else
 				{
-					pc += m68k_disassemble(buffer, (unsigned int)pc, 0, vjs.disasmopcodes);
+					pc += entry->length;
 
 					if (m68kPC == oldpc)
 					{
-						sprintf(string, "-> <u>%06X: %s</u><br>", (unsigned int)oldpc, buffer);
+						sprintf(string, "->&nbsp;<u>%06X:&nbsp;", (unsigned int)oldpc);
 						m68kPCShow = true;
 						m68KPCNbrDisasmLines = i;
 					}
 					else
 					{
-						sprintf(string, "   %06X: %s<br>", (unsigned int)oldpc, buffer);
+						sprintf(string, "&nbsp;&nbsp;&nbsp;%06X:&nbsp;", (unsigned int)oldpc);
 					}
 
-					buffer[0] = 0;	// Clear string
-
-					for (j = 0; j < strlen(string); j++)
+					// Instruction rendered once, as the symbols lookups are slow
+					if (!entry->html)
 					{
-						if (string[j] == ' ')
-						{
-							strcat(buffer, "&nbsp;");
-							adr = constant = false;
-						}
-						else
-						{
-							switch (string[j])
-							{
-							case	'#':
-								constant = true;
-								break;
-
-							case	'$':
-								adr = true;
-								break;
-
-							case	',':
-								constant = adr = equal = false;
-								break;
-
-							case	'=':
-								equal = true;
-								break;
-							}
-
-							if (!constant && adr && !equal)
-							{
-								int l = 0;
-								char *p;
-								do
-								{
-									adresse[l++] = string[++j];
-								} while ((string[(j + 1)] >= '0') && (string[(j + 1)] <= '9') || (string[(j + 1)] >= 'A') && (string[(j + 1)] <= 'F'));
-								adresse[l] = 0;
-
-								if (Symbol = DBGManager_GetSymbolNameFromAdr(strtoul(adresse, &p, 16)))
-								{
-									strcat(buffer, Symbol);
-								}
-								else
-								{
-									strcat(buffer, "$");
-									strcat(buffer, adresse);
-								}
-
-								adr = false;
-							}
-							else
-							{
-								singleCharString[0] = string[j];
-								strcat(buffer, singleCharString);
-							}
-						}
+						m68KDasmHTML(entry->text, buffer);
+						DasmCacheSetHTML(entry, buffer);
 					}
 
 					Symbol = NULL;
-					s += QString(buffer);
+					s += QString(string);
+					s += QString(entry->html);
+					s += QString((m68kPC == oldpc) ? "</u><br>" : "<br>");
 				}
 			}
 		}
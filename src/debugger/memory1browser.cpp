@@ -14,7 +14,7 @@
 //
 
 #include "memory1browser.h"
-#include "memory.h"
+#include "machine.h"
 #include "debugger/DBGManager.h"
 #include "settings.h"
 
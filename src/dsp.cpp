@@ -14,19 +14,33 @@
 // JLH  01/16/2010  Created this log ;-)
 // JLH  11/26/2011  Added fixes for LOAD/STORE alignment issues
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  DSP state moved in the machine context
+// JPM   Oct./2026  Idle loops skipped up to the end of the time slice
+// JPM   Oct./2026  Pipelined core stalls from instructions decoded once per DSP RAM word
+// JPM   Oct./2026  Idle cycles performance counters
+// JPM   Oct./2026  Interrupts left pending by an IMASK clear kept in a mask, instead of being polled
+// JPM   Oct./2026  Non pipelined core opcodes handlers from the RISC core shared with the GPU (risccore.h)
+// JPM   Oct./2026  Instructions, interrupts & idle loops recorded in the execution trace
+// JPM   Oct./2026  Long loads & stores done straight in the DRAM
 //
 
 #include "dsp.h"
 
+#ifndef NO_SDL
 #include <SDL.h>								// Used only for SDL_GetTicks...
+#endif
 #include <stdlib.h>
+#include <string.h>
 #include "dac.h"
 #include "gpu.h"
 #include "jagdasm.h"
 #include "jaguar.h"
 #include "jerry.h"
 #include "log.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
+#include "risccore.h"
+#include "trace.h"
 //#include "memory.h"
 
 
@@ -170,31 +184,24 @@ const bool affectsScoreboard[64] =
 	false, false, false,  true
 };
 
-struct PipelineStage
-{
-	uint16_t instruction;
-	uint8_t opcode, operand1, operand2;
-	uint32_t reg1, reg2, areg1, areg2;
-	uint32_t result;
-	uint8_t writebackRegister;
-	// General memory store...
-	uint32_t address;
-	uint32_t value;
-	uint8_t type;
-};
-
 #define TYPE_BYTE			0
 #define TYPE_WORD			1
 #define TYPE_DWORD			2
 #define PIPELINE_STALL		64						// Set to # of opcodes + 1
-#ifndef NEW_SCOREBOARD
-bool scoreboard[32];
-#else
-uint8_t scoreboard[32];
-#endif
-uint8_t plPtrFetch, plPtrRead, plPtrExec, plPtrWrite;
-PipelineStage pipeline[4];
-bool IMASKCleared = false;
+// Decoded instruction flags
+#define DSP_DECODED_VALID		0x01					// Cleared when the word is written
+#define DSP_DECODED_LOADSTORE	0x02					// Stalls after another load/store
+#define DSP_DECODED_SCOREBOARD	0x04					// Rn waits for its writeback
+// Pipeline state lives in the machine context (see dsp.h)
+#define scoreboard				(jaguarMachine->dsp.scoreboard)
+#define scoreboardMask			(jaguarMachine->dsp.scoreboardMask)
+#define dspDecoded				(jaguarMachine->dsp.decoded)
+#define plPtrFetch				(jaguarMachine->dsp.plPtrFetch)
+#define plPtrRead				(jaguarMachine->dsp.plPtrRead)
+#define plPtrExec				(jaguarMachine->dsp.plPtrExec)
+#define plPtrWrite				(jaguarMachine->dsp.plPtrWrite)
+#define pipeline				(jaguarMachine->dsp.pipeline)
+#define dspIRQPending			(jaguarMachine->dsp.dspIRQPending)
 
 // DSP flags (old--have to get rid of this crap)
 
@@ -246,72 +253,6 @@ bool IMASKCleared = false;
 
 extern uint32_t jaguar_mainRom_crc32;
 
-// Is opcode 62 *really* a NOP? Seems like it...
-static void dsp_opcode_abs(void);
-static void dsp_opcode_add(void);
-static void dsp_opcode_addc(void);
-static void dsp_opcode_addq(void);
-static void dsp_opcode_addqmod(void);
-static void dsp_opcode_addqt(void);
-static void dsp_opcode_and(void);
-static void dsp_opcode_bclr(void);
-static void dsp_opcode_bset(void);
-static void dsp_opcode_btst(void);
-static void dsp_opcode_cmp(void);
-static void dsp_opcode_cmpq(void);
-static void dsp_opcode_div(void);
-static void dsp_opcode_imacn(void);
-static void dsp_opcode_imult(void);
-static void dsp_opcode_imultn(void);
-static void dsp_opcode_jr(void);
-static void dsp_opcode_jump(void);
-static void dsp_opcode_load(void);
-static void dsp_opcode_loadb(void);
-static void dsp_opcode_loadw(void);
-static void dsp_opcode_load_r14_indexed(void);
-static void dsp_opcode_load_r14_ri(void);
-static void dsp_opcode_load_r15_indexed(void);
-static void dsp_opcode_load_r15_ri(void);
-static void dsp_opcode_mirror(void);
-static void dsp_opcode_mmult(void);
-static void dsp_opcode_move(void);
-static void dsp_opcode_movei(void);
-static void dsp_opcode_movefa(void);
-static void dsp_opcode_move_pc(void);
-static void dsp_opcode_moveq(void);
-static void dsp_opcode_moveta(void);
-static void dsp_opcode_mtoi(void);
-static void dsp_opcode_mult(void);
-static void dsp_opcode_neg(void);
-static void dsp_opcode_nop(void);
-static void dsp_opcode_normi(void);
-static void dsp_opcode_not(void);
-static void dsp_opcode_or(void);
-static void dsp_opcode_resmac(void);
-static void dsp_opcode_ror(void);
-static void dsp_opcode_rorq(void);
-static void dsp_opcode_xor(void);
-static void dsp_opcode_sat16s(void);
-static void dsp_opcode_sat32s(void);
-static void dsp_opcode_sh(void);
-static void dsp_opcode_sha(void);
-static void dsp_opcode_sharq(void);
-static void dsp_opcode_shlq(void);
-static void dsp_opcode_shrq(void);
-static void dsp_opcode_store(void);
-static void dsp_opcode_storeb(void);
-static void dsp_opcode_storew(void);
-static void dsp_opcode_store_r14_indexed(void);
-static void dsp_opcode_store_r14_ri(void);
-static void dsp_opcode_store_r15_indexed(void);
-static void dsp_opcode_store_r15_ri(void);
-static void dsp_opcode_sub(void);
-static void dsp_opcode_subc(void);
-static void dsp_opcode_subq(void);
-static void dsp_opcode_subqmod(void);
-static void dsp_opcode_subqt(void);
-static void dsp_opcode_illegal(void);
-
 /*uint8_t dsp_opcode_cycles[64] =
 {
 	3,  3,  3,  3,  3,  3,  3,  3,
@@ -342,28 +283,6 @@ uint8_t dsp_opcode_cycles[64] =
 	1,  1,  3,  3,  1,  1,  1,  1
 };//*/
 
-void (* dsp_opcode[64])() =
-{
-	dsp_opcode_add,					dsp_opcode_addc,				dsp_opcode_addq,				dsp_opcode_addqt,
-	dsp_opcode_sub,					dsp_opcode_subc,				dsp_opcode_subq,				dsp_opcode_subqt,
-	dsp_opcode_neg,					dsp_opcode_and,					dsp_opcode_or,					dsp_opcode_xor,
-	dsp_opcode_not,					dsp_opcode_btst,				dsp_opcode_bset,				dsp_opcode_bclr,
-	dsp_opcode_mult,				dsp_opcode_imult,				dsp_opcode_imultn,				dsp_opcode_resmac,
-	dsp_opcode_imacn,				dsp_opcode_div,					dsp_opcode_abs,					dsp_opcode_sh,
-	dsp_opcode_shlq,				dsp_opcode_shrq,				dsp_opcode_sha,					dsp_opcode_sharq,
-	dsp_opcode_ror,					dsp_opcode_rorq,				dsp_opcode_cmp,					dsp_opcode_cmpq,
-	dsp_opcode_subqmod,				dsp_opcode_sat16s,				dsp_opcode_move,				dsp_opcode_moveq,
-	dsp_opcode_moveta,				dsp_opcode_movefa,				dsp_opcode_movei,				dsp_opcode_loadb,
-	dsp_opcode_loadw,				dsp_opcode_load,				dsp_opcode_sat32s,				dsp_opcode_load_r14_indexed,
-	dsp_opcode_load_r15_indexed,	dsp_opcode_storeb,				dsp_opcode_storew,				dsp_opcode_store,
-	dsp_opcode_mirror,				dsp_opcode_store_r14_indexed,	dsp_opcode_store_r15_indexed,	dsp_opcode_move_pc,
-	dsp_opcode_jump,				dsp_opcode_jr,					dsp_opcode_mmult,				dsp_opcode_mtoi,
-	dsp_opcode_normi,				dsp_opcode_nop,					dsp_opcode_load_r14_ri,			dsp_opcode_load_r15_ri,
-	dsp_opcode_store_r14_ri,		dsp_opcode_store_r15_ri,		dsp_opcode_illegal,				dsp_opcode_addqmod,
-};
-
-uint32_t dsp_opcode_use[65];
-
 const char * dsp_opcode_str[65]=
 {
 	"add",				"addc",				"addq",				"addqt",
@@ -385,22 +304,38 @@ const char * dsp_opcode_str[65]=
 	"STALL"
 };
 
-uint32_t dsp_pc;
-static uint64_t dsp_acc;								// 40 bit register, NOT 32!
-static uint32_t dsp_remain;
-static uint32_t dsp_modulo;
-static uint32_t dsp_flags;
-static uint32_t dsp_matrix_control;
-static uint32_t dsp_pointer_to_matrix;
-static uint32_t dsp_data_organization;
-uint32_t dsp_control;
-static uint32_t dsp_div_control;
-static uint8_t dsp_flag_z, dsp_flag_n, dsp_flag_c;
-static uint32_t * dsp_reg = NULL, * dsp_alternate_reg = NULL;
-uint32_t dsp_reg_bank_0[32], dsp_reg_bank_1[32];
-
-static uint32_t dsp_opcode_first_parameter;
-static uint32_t dsp_opcode_second_parameter;
+// DSP state lives in the machine context (see dsp.h)
+#define dsp_ram_8				(jaguarMachine->dsp.dsp_ram_8)
+#define dsp_pc					(jaguarMachine->dsp.dsp_pc)
+#define dsp_acc					(jaguarMachine->dsp.dsp_acc)
+#define dsp_remain				(jaguarMachine->dsp.dsp_remain)
+#define dsp_modulo				(jaguarMachine->dsp.dsp_modulo)
+#define dsp_flags				(jaguarMachine->dsp.dsp_flags)
+#define dsp_matrix_control		(jaguarMachine->dsp.dsp_matrix_control)
+#define dsp_pointer_to_matrix	(jaguarMachine->dsp.dsp_pointer_to_matrix)
+#define dsp_data_organization	(jaguarMachine->dsp.dsp_data_organization)
+#define dsp_control				(jaguarMachine->dsp.dsp_control)
+#define dsp_div_control			(jaguarMachine->dsp.dsp_div_control)
+#define dsp_flag_z				(jaguarMachine->dsp.dsp_flag_z)
+#define dsp_flag_n				(jaguarMachine->dsp.dsp_flag_n)
+#define dsp_flag_c				(jaguarMachine->dsp.dsp_flag_c)
+#define dsp_reg					(jaguarMachine->dsp.dsp_reg)
+#define dsp_alternate_reg		(jaguarMachine->dsp.dsp_alternate_reg)
+#define dsp_opcode_first_parameter	(jaguarMachine->dsp.dsp_opcode_first_parameter)
+#define dsp_opcode_second_parameter	(jaguarMachine->dsp.dsp_opcode_second_parameter)
+#define dsp_opcode_use			(jaguarMachine->dsp.dsp_opcode_use)
+#define dsp_in_exec				(jaguarMachine->dsp.dsp_in_exec)
+#define dsp_releaseTimeSlice_flag	(jaguarMachine->dsp.dsp_releaseTimeSlice_flag)
+#define pcQueue1				(jaguarMachine->dsp.pcQueue1)
+#define pcQPtr1					(jaguarMachine->dsp.pcQPtr1)
+#define dspIdleSkip				(jaguarMachine->dsp.dspIdleSkip)
+#define dspIdleProbe			(jaguarMachine->dsp.dspIdleProbe)
+#define dspIdlePure				(jaguarMachine->dsp.dspIdlePure)
+#define dspIdlePC				(jaguarMachine->dsp.dspIdlePC)
+#define dspIdleFailPC			(jaguarMachine->dsp.dspIdleFailPC)
+#define dspIdleCycles			(jaguarMachine->dsp.dspIdleCycles)
+#define dspIdleFlags			(jaguarMachine->dsp.dspIdleFlags)
+#define dspIdleRegs				(jaguarMachine->dsp.dspIdleRegs)
 
 #define DSP_RUNNING			(dsp_control & 0x01)
 
@@ -429,13 +364,9 @@ uint32_t dsp_convert_zero[32] = {
 
 uint8_t dsp_branch_condition_table[32 * 8];
 static uint16_t mirror_table[65536];
-static uint8_t dsp_ram_8[0x2000];
 
 #define BRANCH_CONDITION(x)		dsp_branch_condition_table[(x) + ((jaguar_flags & 7) << 5)]
 
-static uint32_t dsp_in_exec = 0;
-static uint32_t dsp_releaseTimeSlice_flag = 0;
-
 FILE * dsp_fp;
 
 #ifdef DSP_DEBUG_CC
@@ -451,6 +382,9 @@ static uint32_t ctrl1[14], ctrl2[14];
 void DSPDumpRegisters(void);
 void DSPDumpDisassembly(void);
 void FlushDSPPipeline(void);
+static void DSPDecodeInvalidate(void);
+static inline void DSPScoreboardRelease(uint8_t reg);
+static inline uint32_t DSPIRQBits(void);
 
 
 void dsp_reset_stats(void)
@@ -621,8 +555,10 @@ void DSPWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 
 	if ((offset >= DSP_WORK_RAM_BASE) && (offset < DSP_WORK_RAM_BASE + 0x2000))
 	{
+		M68K_CODE_WRITE(offset);				// For the disassembly cache
 		offset -= DSP_WORK_RAM_BASE;
 		dsp_ram_8[offset] = data;
+		dspDecoded[offset >> 1].flags = 0;
 //This is rather stupid! !!! FIX !!!
 /*		if (dsp_in_exec == 0)
 		{
@@ -671,9 +607,10 @@ void DSPWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 {
 	WriteLog("DSP: %s is writing %04X at location 0xF1B2F4 (DSP_PC: %08X)...\n", whoName[who], data, dsp_pc);
 }//*/
+		M68K_CODE_WRITE(offset);				// For the disassembly cache
 		offset -= DSP_WORK_RAM_BASE;
-		dsp_ram_8[offset] = data >> 8;
-		dsp_ram_8[offset+1] = data & 0xFF;
+		SET16(dsp_ram_8, offset, data);
+		dspDecoded[offset >> 1].flags = 0;
 //This is rather stupid! !!! FIX !!!
 /*		if (dsp_in_exec == 0)
 		{
@@ -735,8 +672,10 @@ void DSPWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 {
 	WriteLog("DSP: %s is writing %08X at location 0xF1BE2C (DSP_PC: %08X)...\n", whoName[who], data, dsp_pc - 2);
 }//*/
+		M68K_CODE_WRITE(offset);				// For the disassembly cache
 		offset -= DSP_WORK_RAM_BASE;
 		SET32(dsp_ram_8, offset, data);
+		dspDecoded[offset >> 1].flags = dspDecoded[(offset >> 1) + 1].flags = 0;
 //CC only!
 #ifdef DSP_DEBUG_CC
 SET32(ram1, offset, data),
@@ -755,8 +694,7 @@ SET32(ram2, offset, data);
 #ifdef DSP_DEBUG
 			WriteLog("DSP: Writing %08X to DSP_FLAGS by %s (REGPAGE is %sset)...\n", data, whoName[who], (dsp_flags & REGPAGE ? "" : "not "));
 #endif
-//			bool IMASKCleared = (dsp_flags & IMASK) && !(data & IMASK);
-			IMASKCleared = (dsp_flags & IMASK) && !(data & IMASK);
+			bool IMASKCleared = (dsp_flags & IMASK) && !(data & IMASK);
 			// NOTE: According to the JTRM, writing a 1 to IMASK has no effect; only the
 			//       IRQ logic can set it. So we mask it out here to prevent problems...
 			dsp_flags = data & (~IMASK);
@@ -766,6 +704,8 @@ SET32(ram2, offset, data);
 			DSPUpdateRegisterBanks();
 			dsp_control &= ~((dsp_flags & CINT04FLAGS) >> 3);
 			dsp_control &= ~((dsp_flags & CINT5FLAG) >> 1);
+			// Interrupts latched & enabled are taken once the instruction clearing IMASK is done
+			dspIRQPending = (IMASKCleared ? DSPIRQBits() : 0);
 			break;
 		}
 		case 0x04:
@@ -923,6 +863,19 @@ void DSPUpdateRegisterBanks(void)
 }
 
 
+//
+// Active interrupt bits (latches) which are enabled (interrupt mask)
+//
+static inline uint32_t DSPIRQBits(void)
+{
+	uint32_t bits = ((dsp_control >> 10) & 0x20) | ((dsp_control >> 6) & 0x1F),
+		mask = ((dsp_flags >> 11) & 0x20) | ((dsp_flags >> 4) & 0x1F);
+
+//	WriteLog("dsp: bits=%.2x mask=%.2x\n",bits,mask);
+	return bits & mask;
+}
+
+
 //
 // Check for and handle any asserted DSP IRQs
 //
@@ -931,12 +884,7 @@ void DSPHandleIRQs(void)
 	if (dsp_flags & IMASK) 							// Bail if we're already inside an interrupt
 		return;
 
-	// Get the active interrupt bits (latches) & interrupt mask (enables)
-	uint32_t bits = ((dsp_control >> 10) & 0x20) | ((dsp_control >> 6) & 0x1F),
-		mask = ((dsp_flags >> 11) & 0x20) | ((dsp_flags >> 4) & 0x1F);
-
-//	WriteLog("dsp: bits=%.2x mask=%.2x\n",bits,mask);
-	bits &= mask;
+	uint32_t bits = DSPIRQBits();
 
 	if (!bits)										// Bail if nothing is enabled
 		return;
@@ -959,6 +907,9 @@ void DSPHandleIRQs(void)
 #ifdef DSP_DEBUG_IRQ
 	WriteLog("DSP: Generating interrupt #%i...", which);
 #endif
+
+	if (TRACE_ACTIVE)
+		TraceMarker(TRACE_DSP, TRACE_INTERRUPT, which, dsp_pc);
 //temp... !!!!!
 //if (which == 0)	doDSPDis = true;
 
@@ -1001,18 +952,12 @@ WriteLog("\tW -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", p
 			}
 		}
 
-#ifndef NEW_SCOREBOARD
-		if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-			scoreboard[pipeline[plPtrWrite].operand2] = false;
-#else
-//Yup, sequential MOVEQ # problem fixing (I hope!)...
 		if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-			if (scoreboard[pipeline[plPtrWrite].operand2])
-				scoreboard[pipeline[plPtrWrite].operand2]--;
-#endif
+			DSPScoreboardRelease(pipeline[plPtrWrite].operand2);
 	}
 
 	dsp_flags |= IMASK;
+	dspIRQPending = 0;
 //CC only!
 #ifdef DSP_DEBUG_CC
 ctrl2[4] = dsp_flags;
@@ -1089,7 +1034,7 @@ void DSPHandleIRQsNP(void)
 		dsp_data_organization	= ctrl1[7];
 		dsp_control				= ctrl1[8];
 		dsp_div_control			= ctrl1[9];
-		IMASKCleared			= ctrl1[10];
+		dspIRQPending			= ctrl1[10];
 		dsp_flag_z				= ctrl1[11];
 		dsp_flag_n				= ctrl1[12];
 		dsp_flag_c				= ctrl1[13];
@@ -1099,12 +1044,7 @@ DSPUpdateRegisterBanks();
 	if (dsp_flags & IMASK) 							// Bail if we're already inside an interrupt
 		return;
 
-	// Get the active interrupt bits (latches) & interrupt mask (enables)
-	uint32_t bits = ((dsp_control >> 10) & 0x20) | ((dsp_control >> 6) & 0x1F),
-		mask = ((dsp_flags >> 11) & 0x20) | ((dsp_flags >> 4) & 0x1F);
-
-//	WriteLog("dsp: bits=%.2x mask=%.2x\n",bits,mask);
-	bits &= mask;
+	uint32_t bits = DSPIRQBits();
 
 	if (!bits)										// Bail if nothing is enabled
 		return;
@@ -1123,7 +1063,11 @@ DSPUpdateRegisterBanks();
 	if (bits & 0x20)
 		which = 5;
 
+	if (TRACE_ACTIVE)
+		TraceMarker(TRACE_DSP, TRACE_INTERRUPT, which, dsp_pc);
+
 	dsp_flags |= IMASK;		// Force Bank #0
+	dspIRQPending = 0;
 //CC only!
 #ifdef DSP_DEBUG_CC
 ctrl1[4] = dsp_flags;
@@ -1226,7 +1170,14 @@ void DSPInit(void)
 //	memory_malloc_secure((void **)&dsp_reg_bank_0, 32 * sizeof(int32_t), "DSP bank 0 regs");
 //	memory_malloc_secure((void **)&dsp_reg_bank_1, 32 * sizeof(int32_t), "DSP bank 1 regs");
 
-	dsp_build_branch_condition_table();
+	static bool tablesBuilt = false;			// Shared by all the machines
+
+	if (!tablesBuilt)
+	{
+		dsp_build_branch_condition_table();
+		tablesBuilt = true;
+	}
+
 	DSPReset();
 }
 
@@ -1252,13 +1203,15 @@ void DSPReset(void)
 		dsp_reg[i] = dsp_alternate_reg[i] = 0x00000000;
 
 	CLR_ZNC;
-	IMASKCleared = false;
+	dspIRQPending = 0;
 	FlushDSPPipeline();
 	dsp_reset_stats();
 
 	// Contents of local RAM are quasi-stable; we simulate this by randomizing RAM contents
 	for(uint32_t i=0; i<8192; i+=4)
 		*((uint32_t *)(&dsp_ram_8[i])) = rand();
+
+	DSPDecodeInvalidate();
 }
 
 
@@ -1382,7 +1335,7 @@ void DSPExecComp(int32_t cycles)
 		dsp_data_organization	= ctrl1[7];
 		dsp_control				= ctrl1[8];
 		dsp_div_control			= ctrl1[9];
-		IMASKCleared			= ctrl1[10];
+		dspIRQPending			= ctrl1[10];
 		dsp_flag_z				= ctrl1[11];
 		dsp_flag_n				= ctrl1[12];
 		dsp_flag_c				= ctrl1[13];
@@ -1409,13 +1362,14 @@ DSPUpdateRegisterBanks();
 		ctrl1[7]  = dsp_data_organization;
 		ctrl1[8]  = dsp_control;
 		ctrl1[9]  = dsp_div_control;
-		ctrl1[10] = IMASKCleared;
+		ctrl1[10] = dspIRQPending;
 		ctrl1[11] = dsp_flag_z;
 		ctrl1[12] = dsp_flag_n;
 		ctrl1[13] = dsp_flag_c;
 
 		// Load up vars for pipelined core
 		memcpy(dsp_ram_8, ram2, 0x2000);
+		DSPDecodeInvalidate();
 		memcpy(dsp_reg_bank_0, regs2, 32 * 4);
 		memcpy(dsp_reg_bank_1, &regs2[32], 32 * 4);
 		dsp_pc					= ctrl2[0];
@@ -1428,7 +1382,7 @@ DSPUpdateRegisterBanks();
 		dsp_data_organization	= ctrl2[7];
 		dsp_control				= ctrl2[8];
 		dsp_div_control			= ctrl2[9];
-		IMASKCleared			= ctrl2[10];
+		dspIRQPending			= ctrl2[10];
 		dsp_flag_z				= ctrl2[11];
 		dsp_flag_n				= ctrl2[12];
 		dsp_flag_c				= ctrl2[13];
@@ -1451,7 +1405,7 @@ DSPUpdateRegisterBanks();
 		ctrl2[7]  = dsp_data_organization;
 		ctrl2[8]  = dsp_control;
 		ctrl2[9]  = dsp_div_control;
-		ctrl2[10] = IMASKCleared;
+		ctrl2[10] = dspIRQPending;
 		ctrl2[11] = dsp_flag_z;
 		ctrl2[12] = dsp_flag_n;
 		ctrl2[13] = dsp_flag_c;
@@ -1482,7 +1436,7 @@ DSPUpdateRegisterBanks();
 		ctrl2[7]  = dsp_data_organization;
 		ctrl2[8]  = dsp_control;
 		ctrl2[9]  = dsp_div_control;
-		ctrl2[10] = IMASKCleared;
+		ctrl2[10] = dspIRQPending;
 		ctrl2[11] = dsp_flag_z;
 		ctrl2[12] = dsp_flag_n;
 		ctrl2[13] = dsp_flag_c;
@@ -1505,7 +1459,7 @@ DSPUpdateRegisterBanks();
 		dsp_data_organization	= ctrl1[7];
 		dsp_control				= ctrl1[8];
 		dsp_div_control			= ctrl1[9];
-		IMASKCleared			= ctrl1[10];
+		dspIRQPending			= ctrl1[10];
 		dsp_flag_z				= ctrl1[11];
 		dsp_flag_n				= ctrl1[12];
 		dsp_flag_c				= ctrl1[13];
@@ -1535,7 +1489,7 @@ for(int k=0; k<2; k++)
 		ctrl1[7]  = dsp_data_organization;
 		ctrl1[8]  = dsp_control;
 		ctrl1[9]  = dsp_div_control;
-		ctrl1[10] = IMASKCleared;
+		ctrl1[10] = dspIRQPending;
 		ctrl1[11] = dsp_flag_z;
 		ctrl1[12] = dsp_flag_n;
 		ctrl1[13] = dsp_flag_c;
@@ -1559,1208 +1513,373 @@ for(int k=0; k<2; k++)
 #endif
 
 
+void DSPSetIdleSkip(bool enable)
+{
+	dspIdleSkip = enable;
+}
+
+
 //
-// DSP execution core
+// Idle loops (as done for the GPU)
 //
-//static bool R20Set = false, tripwire = false;
-//static uint32_t pcQueue[32], ptrPCQ = 0;
-void DSPExec(int32_t cycles)
+// An iteration starting with a short backward jump, which has only written registers
+// and read memory without side effect, and leaves the DSP in the same state, would be
+// the same as long as nothing writes what it reads; the next iterations are skipped.
+// The DSP runs on the host audio thread while the 68K & the GPU run, so one of their
+// writes can come during the skipped iterations: they are bounded to DSP_IDLE_SKIP_MAX
+// cycles, then an iteration is run again, so such a write is seen at most ~10 usec late.
+//
+#define DSP_IDLE_LOOP_SIZE		32				// Bytes, back from the jump
+#define DSP_IDLE_SKIP_MAX		256				// Cycles skipped at most before the next check
+#define DSP_IDLE_FLAGS			((dsp_flags & ~0x07) | ((dsp_flag_n ? 1 : 0) << 2) | ((dsp_flag_c ? 1 : 0) << 1) | (dsp_flag_z ? 1 : 0))
+
+// 0: Writes memory or uses a state not saved with the registers, 1: Registers only, 2: Load
+static const uint8_t dsp_idle_opcode[64] =
 {
-#ifdef DSP_SINGLE_STEPPING
-	if (dsp_control & 0x18)
+	1,  1,  1,  1,  1,  1,  1,  1,
+	1,  1,  1,  1,  1,  1,  1,  1,
+	1,  1,  0,  0,  0,  1,  1,  1,
+	1,  1,  1,  1,  1,  1,  1,  1,
+	1,  1,  1,  1,  1,  1,  1,  2,
+	2,  2,  1,  2,  2,  0,  0,  0,
+	1,  0,  0,  1,  1,  1,  0,  1,
+	1,  1,  2,  2,  0,  0,  0,  1
+};
+
+//
+// Check an instruction about to be run by the iteration
+//
+static void DSPIdleCheck(uint32_t index)
+{
+	uint32_t address;
+
+	if (dsp_idle_opcode[index] != 2)
 	{
-		cycles = 1;
-		dsp_control &= ~0x10;
+		dspIdlePure = dspIdlePure && dsp_idle_opcode[index];
+		return;
 	}
-#endif
-//There is *no* good reason to do this here!
-//	DSPHandleIRQs();
-	dsp_releaseTimeSlice_flag = 0;
-	dsp_in_exec++;
 
-	while (cycles > 0 && DSP_RUNNING)
+	switch (index)
 	{
-/*extern uint32_t totalFrames;
-//F1B2F6: LOAD   (R14+$04), R24 [NCZ:001, R14+$04=00F20018, R24=FFFFFFFF] -> Jaguar: Unknown word read at 00F20018 by DSP (M68K PC=00E32E)
-//-> 43 + 1 + 24 -> $2B + $01 + $18 -> 101011 00001 11000 -> 1010 1100 0011 1000 -> AC38
-//C470 -> 1100 0100 0111 0000 -> 110001 00011 10000 -> 49, 3, 16 -> STORE R16, (R14+$0C)
-//F1B140:
-if (totalFrames >= 377 && GET16(dsp_ram_8, 0x0002F6) == 0xAC38 && dsp_pc == 0xF1B140)
+	case 43:									// load (r14+n), Rn
+		address = dsp_reg[14] + (dsp_convert_zero[IMM_1] << 2);
+		break;
+	case 44:									// load (r15+n), Rn
+		address = dsp_reg[15] + (dsp_convert_zero[IMM_1] << 2);
+		break;
+	case 58:									// load (r14+Rm), Rn
+		address = dsp_reg[14] + RM;
+		break;
+	case 59:									// load (r15+Rm), Rn
+		address = dsp_reg[15] + RM;
+		break;
+	default:									// loadb, loadw & load (Rm), Rn
+		address = RM;
+		break;
+	}
+
+	dspIdlePure = dspIdlePure && JaguarIsIdleRead(address);
+}
+
+
+//
+// Backward jump from pc; returns the cycles left in the time slice
+//
+static int32_t DSPIdleLoop(uint32_t pc, int32_t cycles)
 {
-	doDSPDis = true;
-	WriteLog("Starting disassembly at frame #%u...\n", totalFrames);
+	if (((pc - dsp_pc) > DSP_IDLE_LOOP_SIZE) || (dsp_pc == dspIdleFailPC))
+		return cycles;
+
+	if (dspIdleProbe && (dsp_pc == dspIdlePC))
+	{
+		int32_t iteration = dspIdleCycles - cycles;
+		dspIdleProbe = false;
+
+		if (!dspIdlePure || (dspIdleFlags != DSP_IDLE_FLAGS)
+			|| memcmp(dspIdleRegs, dsp_reg_bank_0, 32 * sizeof(uint32_t)) || memcmp(dspIdleRegs + 32, dsp_reg_bank_1, 32 * sizeof(uint32_t)))
+		{
+			// Not idle, no need to check it again in this time slice
+			dspIdleFailPC = dsp_pc;
+			return cycles;
+		}
+
+		// The last iteration, maybe not complete, is run as usual
+		if ((iteration > 0) && (cycles > iteration))
+		{
+			int32_t skipped = ((((cycles - 1) < DSP_IDLE_SKIP_MAX) ? (cycles - 1) : DSP_IDLE_SKIP_MAX) / iteration) * iteration;
+			cycles -= skipped;
+			PERF_COUNT(dsp.idleCycles, skipped);
+
+			if (TRACE_ACTIVE)
+				TraceMarker(TRACE_DSP, TRACE_IDLE, dsp_pc, skipped);
+		}
+
+		return cycles;
+	}
+
+	dspIdleProbe = dspIdlePure = true;
+	dspIdlePC = dsp_pc;
+	dspIdleCycles = cycles;
+	dspIdleFlags = DSP_IDLE_FLAGS;
+	memcpy(dspIdleRegs, dsp_reg_bank_0, 32 * sizeof(uint32_t));
+	memcpy(dspIdleRegs + 32, dsp_reg_bank_1, 32 * sizeof(uint32_t));
+
+	return cycles;
 }
-if (dsp_pc == 0xF1B092)
-	doDSPDis = false;//*/
-/*if (dsp_pc == 0xF1B140)
-	doDSPDis = true;//*/
 
-		if (IMASKCleared)						// If IMASK was cleared,
+
+//
+// DSP side of the RISC core (see risccore.h)
+//
+struct DSPUnit
+{
+	typedef uint64_t Accumulator;				// 40 bit MAC
+
+	static const bool hasModulo = true;
+	static const bool hasMirror = true;
+	static const bool hasSat16s = true;
+	static const bool absSetsAllFlags = false;
+
+	static inline uint32_t * Reg(void) { return dsp_reg; }
+	static inline uint32_t * AlternateReg(void) { return dsp_alternate_reg; }
+	static inline uint8_t & FlagZ(void) { return dsp_flag_z; }
+	static inline uint8_t & FlagN(void) { return dsp_flag_n; }
+	static inline uint8_t & FlagC(void) { return dsp_flag_c; }
+	static inline uint32_t & PC(void) { return dsp_pc; }
+	static inline Accumulator & Acc(void) { return dsp_acc; }
+	static inline uint32_t & Remain(void) { return dsp_remain; }
+	static inline uint32_t Modulo(void) { return dsp_modulo; }
+	static inline uint32_t DivControl(void) { return dsp_div_control; }
+	static inline uint32_t MatrixControl(void) { return dsp_matrix_control; }
+	static inline uint32_t PointerToMatrix(void) { return dsp_pointer_to_matrix; }
+	static inline uint32_t ConvertZero(uint32_t imm) { return dsp_convert_zero[imm]; }
+	static inline uint32_t Mirror16(uint32_t data) { return mirror_table[data]; }
+	static inline bool BranchCondition(uint32_t cc, uint32_t flags) { return dsp_branch_condition_table[cc + ((flags & 7) << 5)]; }
+	static inline uint16_t ReadWord(uint32_t address) { return DSPReadWord(address, DSP); }
+
+	static inline bool Running(void)
+	{
+		return DSP_RUNNING;
+	}
+
+	static inline uint32_t Fetch(void)
+	{
+		if (dspIRQPending)						// If IMASK was cleared with interrupts pending,
 		{
 #ifdef DSP_DEBUG_IRQ
 			WriteLog("DSP: Finished interrupt. PC=$%06X\n", dsp_pc);
 #endif
-			DSPHandleIRQsNP();					// See if any other interrupts are pending!
-			IMASKCleared = false;
+			DSPHandleIRQsNP();					// take them!
+			dspIRQPending = 0;
 		}
 
-/*if (badWrite)
-{
-	WriteLog("\nDSP: Encountered bad write in Atari Synth module. PC=%08X, R15=%08X\n", dsp_pc, dsp_reg[15]);
-	for(int i=0; i<80; i+=4)
-		WriteLog("     %08X: %08X\n", dsp_reg[15]+i, JaguarReadLong(dsp_reg[15]+i));
-	WriteLog("\n");
-}//*/
-/*if (dsp_pc == 0xF1B55E)
-{
-	WriteLog("DSP: At $F1B55E--R15 = %08X at %u ms%s...\n", dsp_reg[15], SDL_GetTicks(), (dsp_flags & IMASK ? " (inside interrupt)" : ""));
-}//*/
-/*if (dsp_pc == 0xF1B7D2)	// Start here???
-	doDSPDis = true;
-pcQueue[ptrPCQ++] = dsp_pc;
-ptrPCQ %= 32;*/
 		uint16_t opcode = DSPReadWord(dsp_pc, DSP);
-		uint32_t index = opcode >> 10;
+		// Kept for the idle loops check & the pipelined core MMULT
 		dsp_opcode_first_parameter = (opcode >> 5) & 0x1F;
 		dsp_opcode_second_parameter = opcode & 0x1F;
-		dsp_pc += 2;
-		dsp_opcode[index]();
+
+		if (dspIdleProbe)
+			DSPIdleCheck(opcode >> 10);
+
+		if (TRACE_ACTIVE)
+			TraceInstruction(TRACE_DSP, dsp_pc, opcode, dsp_reg, dsp_flag_z | (dsp_flag_c << 1) | (dsp_flag_n << 2));
+
+		return opcode;
+	}
+
+	static inline int32_t Retire(uint32_t pc, uint32_t index, int32_t cycles)
+	{
 		dsp_opcode_use[index]++;
 		cycles -= dsp_opcode_cycles[index];
-/*if (dsp_reg_bank_0[20] == 0xF1A100 & !R20Set)
-{
-	WriteLog("DSP: R20 set to $F1A100 at %u ms%s...\n", SDL_GetTicks(), (dsp_flags & IMASK ? " (inside interrupt)" : ""));
-	R20Set = true;
-}
-if (dsp_reg_bank_0[20] != 0xF1A100 && R20Set)
-{
-	WriteLog("DSP: R20 corrupted at %u ms from starting%s!\nAborting!\n", SDL_GetTicks(), (dsp_flags & IMASK ? " (inside interrupt)" : ""));
-	DSPDumpRegisters();
-	DSPDumpDisassembly();
-	exit(1);
-}
-if ((dsp_pc < 0xF1B000 || dsp_pc > 0xF1CFFE) && !tripwire)
-{
-	char buffer[512];
-	WriteLog("DSP: Jumping outside of DSP RAM at %u ms. Register dump:\n", SDL_GetTicks());
-	DSPDumpRegisters();
-	tripwire = true;
-	WriteLog("\nBacktrace:\n");
-	for(int i=0; i<32; i++)
+
+		// Backward jump, which may be the one of an idle loop
+		if (dspIdleSkip && (dsp_pc < pc) && (dsp_in_exec == 1))
+			cycles = DSPIdleLoop(pc, cycles);
+
+		return cycles;
+	}
+
+	// There is a problem here with interrupt handlers the JUMP and JR instructions that
+	// can cause trouble because an interrupt can occur *before* the instruction following the
+	// jump can execute... !!! FIX !!!
+	static inline void DelaySlot(void)
 	{
-		dasmjag(JAGUAR_DSP, buffer, pcQueue[(ptrPCQ + i) % 32]);
-		WriteLog("\t%08X: %s\n", pcQueue[(ptrPCQ + i) % 32], buffer);
+		DSPExec(1);
 	}
-	WriteLog("\n");
-}*/
+
+	// Is opcode 62 *really* a NOP? Seems like it... Don't know what it does,
+	// but it does *something*...
+	static inline void Illegal(uint32_t m, uint32_t n)
+	{
+		WriteLog("%06X: illegal %u, %u [NCZ:%u%u%u]\n", dsp_pc-2, m, n, dsp_flag_n, dsp_flag_c, dsp_flag_z);
 	}
 
-	dsp_in_exec--;
-}
+	//
+	// Loads & stores
+	//
+	static inline bool InRAM(uint32_t address)
+	{
+		return (address >= DSP_WORK_RAM_BASE) && (address <= (DSP_WORK_RAM_BASE + 0x1FFF));
+	}
 
+	// Long accesses, aligned like DSPReadLong & DSPWriteLong do; the DRAM ones are
+	// done straight in the memory space
+	static inline uint32_t ReadLong(uint32_t address)
+	{
+		uint8_t * dram = RISCDRAM((address & 0xFFFFFFFC), 4);
 
-//
-// DSP opcode handlers
-//
+		if (dram)
+			return RISCDRAMReadLong(dram, (address & 0xFFFFFFFC), DSP);
 
-// There is a problem here with interrupt handlers the JUMP and JR instructions that
-// can cause trouble because an interrupt can occur *before* the instruction following the
-// jump can execute... !!! FIX !!!
-static void dsp_opcode_jump(void)
-{
-#ifdef DSP_DIS_JUMP
-const char * condition[32] =
-{	"T", "nz", "z", "???", "nc", "nc nz", "nc z", "???", "c", "c nz",
-	"c z", "???", "???", "???", "???", "???", "???", "???", "???",
-	"???", "nn", "nn nz", "nn z", "???", "n", "n nz", "n z", "???",
-	"???", "???", "???", "F" };
-	if (doDSPDis)
-		WriteLog("%06X: JUMP   %s, (R%02u) [NCZ:%u%u%u, R%02u=%08X] ", dsp_pc-2, condition[IMM_2], IMM_1, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM);
-#endif
-	// normalize flags
-/*	dsp_flag_c=dsp_flag_c?1:0;
-	dsp_flag_z=dsp_flag_z?1:0;
-	dsp_flag_n=dsp_flag_n?1:0;*/
-	// KLUDGE: Used by BRANCH_CONDITION
-	uint32_t jaguar_flags = (dsp_flag_n << 2) | (dsp_flag_c << 1) | dsp_flag_z;
+		return DSPReadLong(address, DSP);
+	}
 
-	if (BRANCH_CONDITION(IMM_2))
+	static inline void WriteLong(uint32_t address, uint32_t data)
 	{
-#ifdef DSP_DIS_JUMP
-	if (doDSPDis)
-		WriteLog("Branched!\n");
-#endif
-		uint32_t delayed_pc = RM;
-		DSPExec(1);
-		dsp_pc = delayed_pc;
+		uint8_t * dram = RISCDRAM((address & 0xFFFFFFFC), 4);
+
+		if (dram)
+			RISCDRAMWriteLong(dram, (address & 0xFFFFFFFC), data, DSP);
+		else
+			DSPWriteLong(address, data, DSP);
 	}
-#ifdef DSP_DIS_JUMP
-	else
-		if (doDSPDis)
-			WriteLog("Branch NOT taken.\n");
-#endif
-}
 
+	static inline void LoadB(uint32_t m, uint32_t n)
+	{
+		uint32_t address = dsp_reg[m];
 
-static void dsp_opcode_jr(void)
-{
-#ifdef DSP_DIS_JR
-const char * condition[32] =
-{	"T", "nz", "z", "???", "nc", "nc nz", "nc z", "???", "c", "c nz",
-	"c z", "???", "???", "???", "???", "???", "???", "???", "???",
-	"???", "nn", "nn nz", "nn z", "???", "n", "n nz", "n z", "???",
-	"???", "???", "???", "F" };
-	if (doDSPDis)
-		WriteLog("%06X: JR     %s, %06X [NCZ:%u%u%u] ", dsp_pc-2, condition[IMM_2], dsp_pc+((IMM_1 & 0x10 ? 0xFFFFFFF0 | IMM_1 : IMM_1) * 2), dsp_flag_n, dsp_flag_c, dsp_flag_z);
+		if (InRAM(address))
+			dsp_reg[n] = DSPReadLong(address, DSP) & 0xFF;
+		else
+			dsp_reg[n] = JaguarReadByte(address, DSP);
+	}
+
+	static inline void LoadW(uint32_t m, uint32_t n)
+	{
+		uint32_t address = dsp_reg[m];
+
+#ifdef DSP_CORRECT_ALIGNMENT
+		address &= 0xFFFFFFFE;
 #endif
-	// normalize flags
-/*	dsp_flag_c=dsp_flag_c?1:0;
-	dsp_flag_z=dsp_flag_z?1:0;
-	dsp_flag_n=dsp_flag_n?1:0;*/
-	// KLUDGE: Used by BRANCH_CONDITION
-	uint32_t jaguar_flags = (dsp_flag_n << 2) | (dsp_flag_c << 1) | dsp_flag_z;
+		if (InRAM(dsp_reg[m]))
+			dsp_reg[n] = DSPReadLong(address, DSP) & 0xFFFF;
+		else
+			dsp_reg[n] = JaguarReadWord(address, DSP);
+	}
 
-	if (BRANCH_CONDITION(IMM_2))
+	static inline void Load(uint32_t m, uint32_t n)
 	{
-#ifdef DSP_DIS_JR
-	if (doDSPDis)
-		WriteLog("Branched!\n");
+#ifdef DSP_CORRECT_ALIGNMENT
+		dsp_reg[n] = ReadLong(dsp_reg[m] & 0xFFFFFFFC);
+#else
+		dsp_reg[n] = ReadLong(dsp_reg[m]);
 #endif
-		int32_t offset = (IMM_1 & 0x10 ? 0xFFFFFFF0 | IMM_1 : IMM_1);		// Sign extend IMM_1
-		int32_t delayed_pc = dsp_pc + (offset * 2);
-		DSPExec(1);
-		dsp_pc = delayed_pc;
 	}
-#ifdef DSP_DIS_JR
-	else
-		if (doDSPDis)
-			WriteLog("Branch NOT taken.\n");
+
+	static inline void LoadIndexed(uint32_t base, uint32_t m, uint32_t n)
+	{
+#ifdef DSP_CORRECT_ALIGNMENT
+		dsp_reg[n] = ReadLong((dsp_reg[base] & 0xFFFFFFFC) + (dsp_convert_zero[m] << 2));
+#else
+		dsp_reg[n] = ReadLong(dsp_reg[base] + (dsp_convert_zero[m] << 2));
 #endif
-}
+	}
 
+	static inline void LoadR14Indexed(uint32_t m, uint32_t n) { LoadIndexed(14, m, n); }
+	static inline void LoadR15Indexed(uint32_t m, uint32_t n) { LoadIndexed(15, m, n); }
 
-static void dsp_opcode_add(void)
-{
-#ifdef DSP_DIS_ADD
-	if (doDSPDis)
-		WriteLog("%06X: ADD    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res = RN + RM;
-	SET_ZNC_ADD(RN, RM, res);
-	RN = res;
-#ifdef DSP_DIS_ADD
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
+	static inline void LoadRI(uint32_t base, uint32_t m, uint32_t n)
+	{
+#ifdef DSP_CORRECT_ALIGNMENT
+		dsp_reg[n] = ReadLong((dsp_reg[base] + dsp_reg[m]) & 0xFFFFFFFC);
+#else
+		dsp_reg[n] = ReadLong(dsp_reg[base] + dsp_reg[m]);
 #endif
-}
+	}
 
+	static inline void LoadR14RI(uint32_t m, uint32_t n) { LoadRI(14, m, n); }
+	static inline void LoadR15RI(uint32_t m, uint32_t n) { LoadRI(15, m, n); }
 
-static void dsp_opcode_addc(void)
-{
-#ifdef DSP_DIS_ADDC
-	if (doDSPDis)
-		WriteLog("%06X: ADDC   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res = RN + RM + dsp_flag_c;
-	uint32_t carry = dsp_flag_c;
-//	SET_ZNC_ADD(RN, RM, res); //???BUG??? Yes!
-	SET_ZNC_ADD(RN + carry, RM, res);
-//	SET_ZNC_ADD(RN, RM + carry, res);
-	RN = res;
-#ifdef DSP_DIS_ADDC
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
+	static inline void StoreB(uint32_t m, uint32_t n)
+	{
+		uint32_t address = dsp_reg[m];
 
+		if (InRAM(address))
+			DSPWriteLong(address, dsp_reg[n] & 0xFF, DSP);
+		else
+			JaguarWriteByte(address, dsp_reg[n], DSP);
+	}
 
-static void dsp_opcode_addq(void)
-{
-#ifdef DSP_DIS_ADDQ
-	if (doDSPDis)
-		WriteLog("%06X: ADDQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
+	static inline void StoreW(uint32_t m, uint32_t n)
+	{
+		uint32_t address = dsp_reg[m];
+
+#ifdef DSP_CORRECT_ALIGNMENT_STORE
+		address &= 0xFFFFFFFE;
 #endif
-	uint32_t r1 = dsp_convert_zero[IMM_1];
-	uint32_t res = RN + r1;
-	CLR_ZNC; SET_ZNC_ADD(RN, r1, res);
-	RN = res;
-#ifdef DSP_DIS_ADDQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
+		if (InRAM(dsp_reg[m]))
+			DSPWriteLong(address, dsp_reg[n] & 0xFFFF, DSP);
+		else
+			JaguarWriteWord(address, dsp_reg[n], DSP);
+	}
+
+	static inline void Store(uint32_t m, uint32_t n)
+	{
+#ifdef DSP_CORRECT_ALIGNMENT_STORE
+		WriteLong(dsp_reg[m] & 0xFFFFFFFC, dsp_reg[n]);
+#else
+		WriteLong(dsp_reg[m], dsp_reg[n]);
 #endif
-}
+	}
 
+	static inline void StoreIndexed(uint32_t base, uint32_t m, uint32_t n)
+	{
+#ifdef DSP_CORRECT_ALIGNMENT_STORE
+		WriteLong((dsp_reg[base] & 0xFFFFFFFC) + (dsp_convert_zero[m] << 2), dsp_reg[n]);
+#else
+		WriteLong(dsp_reg[base] + (dsp_convert_zero[m] << 2), dsp_reg[n]);
+#endif
+	}
 
-static void dsp_opcode_sub(void)
-{
-#ifdef DSP_DIS_SUB
-	if (doDSPDis)
-		WriteLog("%06X: SUB    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res = RN - RM;
-	SET_ZNC_SUB(RN, RM, res);
-	RN = res;
-#ifdef DSP_DIS_SUB
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_subc(void)
-{
-#ifdef DSP_DIS_SUBC
-	if (doDSPDis)
-		WriteLog("%06X: SUBC   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	// This is how the DSP ALU does it--Two's complement with inverted carry
-	uint64_t res = (uint64_t)RN + (uint64_t)(RM ^ 0xFFFFFFFF) + (dsp_flag_c ^ 1);
-	// Carry out of the result is inverted too
-	dsp_flag_c = ((res >> 32) & 0x01) ^ 1;
-	RN = (res & 0xFFFFFFFF);
-	SET_ZN(RN);
-#ifdef DSP_DIS_SUBC
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_subq(void)
-{
-#ifdef DSP_DIS_SUBQ
-	if (doDSPDis)
-		WriteLog("%06X: SUBQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t r1 = dsp_convert_zero[IMM_1];
-	uint32_t res = RN - r1;
-	SET_ZNC_SUB(RN, r1, res);
-	RN = res;
-#ifdef DSP_DIS_SUBQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_cmp(void)
-{
-#ifdef DSP_DIS_CMP
-	if (doDSPDis)
-		WriteLog("%06X: CMP    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res = RN - RM;
-	SET_ZNC_SUB(RN, RM, res);
-#ifdef DSP_DIS_CMP
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z);
-#endif
-}
-
-
-static void dsp_opcode_cmpq(void)
-{
-	static int32_t sqtable[32] =
-		{ 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,-16,-15,-14,-13,-12,-11,-10,-9,-8,-7,-6,-5,-4,-3,-2,-1 };
-#ifdef DSP_DIS_CMPQ
-	if (doDSPDis)
-		WriteLog("%06X: CMPQ   #%d, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, sqtable[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t r1 = sqtable[IMM_1 & 0x1F]; // I like this better -> (INT8)(jaguar.op >> 2) >> 3;
-	uint32_t res = RN - r1;
-	SET_ZNC_SUB(RN, r1, res);
-#ifdef DSP_DIS_CMPQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z);
-#endif
-}
-
-
-static void dsp_opcode_and(void)
-{
-#ifdef DSP_DIS_AND
-	if (doDSPDis)
-		WriteLog("%06X: AND    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RN & RM;
-	SET_ZN(RN);
-#ifdef DSP_DIS_AND
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_or(void)
-{
-#ifdef DSP_DIS_OR
-	if (doDSPDis)
-		WriteLog("%06X: OR     R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RN | RM;
-	SET_ZN(RN);
-#ifdef DSP_DIS_OR
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_xor(void)
-{
-#ifdef DSP_DIS_XOR
-	if (doDSPDis)
-		WriteLog("%06X: XOR    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RN ^ RM;
-	SET_ZN(RN);
-#ifdef DSP_DIS_XOR
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_not(void)
-{
-#ifdef DSP_DIS_NOT
-	if (doDSPDis)
-		WriteLog("%06X: NOT    R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	RN = ~RN;
-	SET_ZN(RN);
-#ifdef DSP_DIS_NOT
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_move_pc(void)
-{
-	RN = dsp_pc - 2;
-}
-
-
-static void dsp_opcode_store_r14_indexed(void)
-{
-#ifdef DSP_DIS_STORE14I
-	if (doDSPDis)
-		WriteLog("%06X: STORE  R%02u, (R14+$%02X) [NCZ:%u%u%u, R%02u=%08X, R14+$%02X=%08X]\n", dsp_pc-2, IMM_2, dsp_convert_zero[IMM_1] << 2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN, dsp_convert_zero[IMM_1] << 2, dsp_reg[14]+(dsp_convert_zero[IMM_1] << 2));
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT_STORE
-	DSPWriteLong((dsp_reg[14] & 0xFFFFFFFC) + (dsp_convert_zero[IMM_1] << 2), RN, DSP);
-#else
-	DSPWriteLong(dsp_reg[14] + (dsp_convert_zero[IMM_1] << 2), RN, DSP);
-#endif
-}
-
-
-static void dsp_opcode_store_r15_indexed(void)
-{
-#ifdef DSP_DIS_STORE15I
-	if (doDSPDis)
-		WriteLog("%06X: STORE  R%02u, (R15+$%02X) [NCZ:%u%u%u, R%02u=%08X, R15+$%02X=%08X]\n", dsp_pc-2, IMM_2, dsp_convert_zero[IMM_1] << 2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN, dsp_convert_zero[IMM_1] << 2, dsp_reg[15]+(dsp_convert_zero[IMM_1] << 2));
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT_STORE
-	DSPWriteLong((dsp_reg[15] & 0xFFFFFFFC) + (dsp_convert_zero[IMM_1] << 2), RN, DSP);
-#else
-	DSPWriteLong(dsp_reg[15] + (dsp_convert_zero[IMM_1] << 2), RN, DSP);
-#endif
-}
-
-
-static void dsp_opcode_load_r14_ri(void)
-{
-#ifdef DSP_DIS_LOAD14R
-	if (doDSPDis)
-		WriteLog("%06X: LOAD   (R14+R%02u), R%02u [NCZ:%u%u%u, R14+R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM+dsp_reg[14], IMM_2, RN);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT
-	RN = DSPReadLong((dsp_reg[14] + RM) & 0xFFFFFFFC, DSP);
-#else
-	RN = DSPReadLong(dsp_reg[14] + RM, DSP);
-#endif
-#ifdef DSP_DIS_LOAD14R
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_load_r15_ri(void)
-{
-#ifdef DSP_DIS_LOAD15R
-	if (doDSPDis)
-		WriteLog("%06X: LOAD   (R15+R%02u), R%02u [NCZ:%u%u%u, R15+R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM+dsp_reg[15], IMM_2, RN);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT
-	RN = DSPReadLong((dsp_reg[15] + RM) & 0xFFFFFFFC, DSP);
-#else
-	RN = DSPReadLong(dsp_reg[15] + RM, DSP);
-#endif
-#ifdef DSP_DIS_LOAD15R
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_store_r14_ri(void)
-{
-	DSPWriteLong(dsp_reg[14] + RM, RN, DSP);
-}
-
-
-static void dsp_opcode_store_r15_ri(void)
-{
-	DSPWriteLong(dsp_reg[15] + RM, RN, DSP);
-}
-
-
-static void dsp_opcode_nop(void)
-{
-#ifdef DSP_DIS_NOP
-	if (doDSPDis)
-		WriteLog("%06X: NOP    [NCZ:%u%u%u]\n", dsp_pc-2, dsp_flag_n, dsp_flag_c, dsp_flag_z);
-#endif
-}
-
-
-static void dsp_opcode_storeb(void)
-{
-#ifdef DSP_DIS_STOREB
-	if (doDSPDis)
-		WriteLog("%06X: STOREB R%02u, (R%02u) [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_pc-2, IMM_2, IMM_1, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN, IMM_1, RM);
-#endif
-	if (RM >= DSP_WORK_RAM_BASE && RM <= (DSP_WORK_RAM_BASE + 0x1FFF))
-		DSPWriteLong(RM, RN & 0xFF, DSP);
-	else
-		JaguarWriteByte(RM, RN, DSP);
-}
-
-
-static void dsp_opcode_storew(void)
-{
-#ifdef DSP_DIS_STOREW
-	if (doDSPDis)
-		WriteLog("%06X: STOREW R%02u, (R%02u) [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_pc-2, IMM_2, IMM_1, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN, IMM_1, RM);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT_STORE
-	if (RM >= DSP_WORK_RAM_BASE && RM <= (DSP_WORK_RAM_BASE + 0x1FFF))
-		DSPWriteLong(RM & 0xFFFFFFFE, RN & 0xFFFF, DSP);
-	else
-		JaguarWriteWord(RM & 0xFFFFFFFE, RN, DSP);
-#else
-	if (RM >= DSP_WORK_RAM_BASE && RM <= (DSP_WORK_RAM_BASE + 0x1FFF))
-		DSPWriteLong(RM, RN & 0xFFFF, DSP);
-	else
-		JaguarWriteWord(RM, RN, DSP);
-#endif
-}
-
-
-static void dsp_opcode_store(void)
-{
-#ifdef DSP_DIS_STORE
-	if (doDSPDis)
-		WriteLog("%06X: STORE  R%02u, (R%02u) [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_pc-2, IMM_2, IMM_1, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN, IMM_1, RM);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT_STORE
-	DSPWriteLong(RM & 0xFFFFFFFC, RN, DSP);
-#else
-	DSPWriteLong(RM, RN, DSP);
-#endif
-}
-
-
-static void dsp_opcode_loadb(void)
-{
-#ifdef DSP_DIS_LOADB
-	if (doDSPDis)
-		WriteLog("%06X: LOADB  (R%02u), R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	if (RM >= DSP_WORK_RAM_BASE && RM <= (DSP_WORK_RAM_BASE + 0x1FFF))
-		RN = DSPReadLong(RM, DSP) & 0xFF;
-	else
-		RN = JaguarReadByte(RM, DSP);
-#ifdef DSP_DIS_LOADB
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_loadw(void)
-{
-#ifdef DSP_DIS_LOADW
-	if (doDSPDis)
-		WriteLog("%06X: LOADW  (R%02u), R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT
-	if (RM >= DSP_WORK_RAM_BASE && RM <= (DSP_WORK_RAM_BASE + 0x1FFF))
-		RN = DSPReadLong(RM & 0xFFFFFFFE, DSP) & 0xFFFF;
-	else
-		RN = JaguarReadWord(RM & 0xFFFFFFFE, DSP);
-#else
-	if (RM >= DSP_WORK_RAM_BASE && RM <= (DSP_WORK_RAM_BASE + 0x1FFF))
-		RN = DSPReadLong(RM, DSP) & 0xFFFF;
-	else
-		RN = JaguarReadWord(RM, DSP);
-#endif
-#ifdef DSP_DIS_LOADW
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_load(void)
-{
-#ifdef DSP_DIS_LOAD
-	if (doDSPDis)
-		WriteLog("%06X: LOAD   (R%02u), R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT
-	RN = DSPReadLong(RM & 0xFFFFFFFC, DSP);
-#else
-	RN = DSPReadLong(RM, DSP);
-#endif
-#ifdef DSP_DIS_LOAD
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_load_r14_indexed(void)
-{
-#ifdef DSP_DIS_LOAD14I
-	if (doDSPDis)
-		WriteLog("%06X: LOAD   (R14+$%02X), R%02u [NCZ:%u%u%u, R14+$%02X=%08X, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1] << 2, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, dsp_convert_zero[IMM_1] << 2, dsp_reg[14]+(dsp_convert_zero[IMM_1] << 2), IMM_2, RN);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT
-	RN = DSPReadLong((dsp_reg[14] & 0xFFFFFFFC) + (dsp_convert_zero[IMM_1] << 2), DSP);
-#else
-	RN = DSPReadLong(dsp_reg[14] + (dsp_convert_zero[IMM_1] << 2), DSP);
-#endif
-#ifdef DSP_DIS_LOAD14I
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_load_r15_indexed(void)
-{
-#ifdef DSP_DIS_LOAD15I
-	if (doDSPDis)
-		WriteLog("%06X: LOAD   (R15+$%02X), R%02u [NCZ:%u%u%u, R15+$%02X=%08X, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1] << 2, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, dsp_convert_zero[IMM_1] << 2, dsp_reg[15]+(dsp_convert_zero[IMM_1] << 2), IMM_2, RN);
-#endif
-#ifdef DSP_CORRECT_ALIGNMENT
-	RN = DSPReadLong((dsp_reg[15] & 0xFFFFFFFC) + (dsp_convert_zero[IMM_1] << 2), DSP);
-#else
-	RN = DSPReadLong(dsp_reg[15] + (dsp_convert_zero[IMM_1] << 2), DSP);
-#endif
-#ifdef DSP_DIS_LOAD15I
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_movei(void)
-{
-#ifdef DSP_DIS_MOVEI
-	if (doDSPDis)
-		WriteLog("%06X: MOVEI  #$%08X, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, (uint32_t)DSPReadWord(dsp_pc) | ((uint32_t)DSPReadWord(dsp_pc + 2) << 16), IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	// This instruction is followed by 32-bit value in LSW / MSW format...
-	RN = (uint32_t)DSPReadWord(dsp_pc, DSP) | ((uint32_t)DSPReadWord(dsp_pc + 2, DSP) << 16);
-	dsp_pc += 4;
-#ifdef DSP_DIS_MOVEI
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_moveta(void)
-{
-#ifdef DSP_DIS_MOVETA
-	if (doDSPDis)
-		WriteLog("%06X: MOVETA R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u(alt)=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, ALTERNATE_RN);
-#endif
-	ALTERNATE_RN = RM;
-#ifdef DSP_DIS_MOVETA
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u(alt)=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, ALTERNATE_RN);
-#endif
-}
-
-
-static void dsp_opcode_movefa(void)
-{
-#ifdef DSP_DIS_MOVEFA
-	if (doDSPDis)
-		WriteLog("%06X: MOVEFA R%02u, R%02u [NCZ:%u%u%u, R%02u(alt)=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, ALTERNATE_RM, IMM_2, RN);
-#endif
-	RN = ALTERNATE_RM;
-#ifdef DSP_DIS_MOVEFA
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u(alt)=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, ALTERNATE_RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_move(void)
-{
-#ifdef DSP_DIS_MOVE
-	if (doDSPDis)
-		WriteLog("%06X: MOVE   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RM;
-#ifdef DSP_DIS_MOVE
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_moveq(void)
-{
-#ifdef DSP_DIS_MOVEQ
-	if (doDSPDis)
-		WriteLog("%06X: MOVEQ  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	RN = IMM_1;
-#ifdef DSP_DIS_MOVEQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_resmac(void)
-{
-#ifdef DSP_DIS_RESMAC
-	if (doDSPDis)
-		WriteLog("%06X: RESMAC R%02u [NCZ:%u%u%u, R%02u=%08X, DSP_ACC=%02X%08X] -> ", dsp_pc-2, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN, (uint8_t)(dsp_acc >> 32), (uint32_t)(dsp_acc & 0xFFFFFFFF));
-#endif
-	RN = (uint32_t)dsp_acc;
-#ifdef DSP_DIS_RESMAC
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_imult(void)
-{
-#ifdef DSP_DIS_IMULT
-	if (doDSPDis)
-		WriteLog("%06X: IMULT  R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = (int16_t)RN * (int16_t)RM;
-	SET_ZN(RN);
-#ifdef DSP_DIS_IMULT
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_mult(void)
-{
-#ifdef DSP_DIS_MULT
-	if (doDSPDis)
-		WriteLog("%06X: MULT   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = (uint16_t)RM * (uint16_t)RN;
-	SET_ZN(RN);
-#ifdef DSP_DIS_MULT
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_bclr(void)
-{
-#ifdef DSP_DIS_BCLR
-	if (doDSPDis)
-		WriteLog("%06X: BCLR   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = RN & ~(1 << IMM_1);
-	RN = res;
-	SET_ZN(res);
-#ifdef DSP_DIS_BCLR
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_btst(void)
-{
-#ifdef DSP_DIS_BTST
-	if (doDSPDis)
-		WriteLog("%06X: BTST   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	dsp_flag_z = (~RN >> IMM_1) & 1;
-#ifdef DSP_DIS_BTST
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_bset(void)
-{
-#ifdef DSP_DIS_BSET
-	if (doDSPDis)
-		WriteLog("%06X: BSET   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = RN | (1 << IMM_1);
-	RN = res;
-	SET_ZN(res);
-#ifdef DSP_DIS_BSET
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_subqt(void)
-{
-#ifdef DSP_DIS_SUBQT
-	if (doDSPDis)
-		WriteLog("%06X: SUBQT  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	RN -= dsp_convert_zero[IMM_1];
-#ifdef DSP_DIS_SUBQT
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_addqt(void)
-{
-#ifdef DSP_DIS_ADDQT
-	if (doDSPDis)
-		WriteLog("%06X: ADDQT  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	RN += dsp_convert_zero[IMM_1];
-#ifdef DSP_DIS_ADDQT
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_imacn(void)
-{
-#ifdef DSP_DIS_IMACN
-	if (doDSPDis)
-		WriteLog("%06X: IMACN  R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	int32_t res = (int16_t)RM * (int16_t)RN;
-	dsp_acc += (int64_t)res;
-//Should we AND the result to fit into 40 bits here???
-#ifdef DSP_DIS_IMACN
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, DSP_ACC=%02X%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, (uint8_t)(dsp_acc >> 32), (uint32_t)(dsp_acc & 0xFFFFFFFF));
-#endif
-}
-
-
-static void dsp_opcode_mtoi(void)
-{
-	RN = (((int32_t)RM >> 8) & 0xFF800000) | (RM & 0x007FFFFF);
-	SET_ZN(RN);
-}
-
-
-static void dsp_opcode_normi(void)
-{
-	uint32_t _Rm = RM;
-	uint32_t res = 0;
-
-	if (_Rm)
-	{
-		while ((_Rm & 0xffc00000) == 0)
-		{
-			_Rm <<= 1;
-			res--;
-		}
-		while ((_Rm & 0xff800000) != 0)
-		{
-			_Rm >>= 1;
-			res++;
-		}
-	}
-	RN = res;
-	SET_ZN(RN);
-}
-
-
-static void dsp_opcode_mmult(void)
-{
-	int count	= dsp_matrix_control&0x0f;
-	uint32_t addr = dsp_pointer_to_matrix; // in the dsp ram
-	int64_t accum = 0;
-	uint32_t res;
-
-	if (!(dsp_matrix_control & 0x10))
-	{
-		for (int i = 0; i < count; i++)
-		{
-			int16_t a;
-			if (i&0x01)
-				a=(int16_t)((dsp_alternate_reg[dsp_opcode_first_parameter + (i>>1)]>>16)&0xffff);
-			else
-				a=(int16_t)(dsp_alternate_reg[dsp_opcode_first_parameter + (i>>1)]&0xffff);
-			int16_t b=((int16_t)DSPReadWord(addr + 2, DSP));
-			accum += a*b;
-			addr += 4;
-		}
-	}
-	else
-	{
-		for (int i = 0; i < count; i++)
-		{
-			int16_t a;
-			if (i&0x01)
-				a=(int16_t)((dsp_alternate_reg[dsp_opcode_first_parameter + (i>>1)]>>16)&0xffff);
-			else
-				a=(int16_t)(dsp_alternate_reg[dsp_opcode_first_parameter + (i>>1)]&0xffff);
-			int16_t b=((int16_t)DSPReadWord(addr + 2, DSP));
-			accum += a*b;
-			addr += 4 * count;
-		}
-	}
-	RN = res = (int32_t)accum;
-	// carry flag to do
-//NOTE: The flags are set based upon the last add/multiply done...
-	SET_ZN(RN);
-}
-
-
-static void dsp_opcode_abs(void)
-{
-#ifdef DSP_DIS_ABS
-	if (doDSPDis)
-		WriteLog("%06X: ABS    R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t _Rn = RN;
-	uint32_t res;
-
-	if (_Rn == 0x80000000)
-		dsp_flag_n = 1;
-	else
-	{
-		dsp_flag_c = ((_Rn & 0x80000000) >> 31);
-		res = RN = (_Rn & 0x80000000 ? -_Rn : _Rn);
-		CLR_ZN; SET_Z(res);
-	}
-#ifdef DSP_DIS_ABS
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_div(void)
-{
-#if 0
-	if (RM)
-	{
-		if (dsp_div_control & 0x01)		// 16.16 division
-		{
-			dsp_remain = ((uint64_t)RN << 16) % RM;
-			RN = ((uint64_t)RN << 16) / RM;
-		}
-		else
-		{
-			// We calculate the remainder first because we destroy RN after
-			// this by assigning it to itself.
-			dsp_remain = RN % RM;
-			RN = RN / RM;
-		}
-
-	}
-	else
-	{
-		// This is what happens according to SCPCD. NYAN!
-		RN = 0xFFFFFFFF;
-		dsp_remain = 0;
-	}
-#else
-	// Real algorithm, courtesy of SCPCD: NYAN!
-	uint32_t q = RN;
-	uint32_t r = 0;
+	static inline void StoreR14Indexed(uint32_t m, uint32_t n) { StoreIndexed(14, m, n); }
+	static inline void StoreR15Indexed(uint32_t m, uint32_t n) { StoreIndexed(15, m, n); }
 
-	// If 16.16 division, stuff top 16 bits of RN into remainder and put the
-	// bottom 16 of RN in top 16 of quotient
-	if (dsp_div_control & 0x01)
-		q <<= 16, r = RN >> 16;
-
-	for(int i=0; i<32; i++)
+	static inline void StoreR14RI(uint32_t m, uint32_t n)
 	{
-//		uint32_t sign = (r >> 31) & 0x01;
-		uint32_t sign = r & 0x80000000;
-		r = (r << 1) | ((q >> 31) & 0x01);
-		r += (sign ? RM : -RM);
-		q = (q << 1) | (((~r) >> 31) & 0x01);
+		WriteLong(dsp_reg[14] + dsp_reg[m], dsp_reg[n]);
 	}
 
-	RN = q;
-	dsp_remain = r;
-#endif
-}
-
-
-static void dsp_opcode_imultn(void)
-{
-#ifdef DSP_DIS_IMULTN
-	if (doDSPDis)
-		WriteLog("%06X: IMULTN R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	// This is OK, since this multiply won't overflow 32 bits...
-	int32_t res = (int32_t)((int16_t)RN * (int16_t)RM);
-	dsp_acc = (int64_t)res;
-	SET_ZN(res);
-#ifdef DSP_DIS_IMULTN
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, DSP_ACC=%02X%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, (uint8_t)(dsp_acc >> 32), (uint32_t)(dsp_acc & 0xFFFFFFFF));
-#endif
-}
-
-
-static void dsp_opcode_neg(void)
-{
-#ifdef DSP_DIS_NEG
-	if (doDSPDis)
-		WriteLog("%06X: NEG    R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = -RN;
-	SET_ZNC_SUB(0, RN, res);
-	RN = res;
-#ifdef DSP_DIS_NEG
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_shlq(void)
-{
-#ifdef DSP_DIS_SHLQ
-	if (doDSPDis)
-		WriteLog("%06X: SHLQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, 32 - IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	// NB: This instruction is the *only* one that does (32 - immediate data).
-	int32_t r1 = 32 - IMM_1;
-	uint32_t res = RN << r1;
-	SET_ZN(res); dsp_flag_c = (RN >> 31) & 1;
-	RN = res;
-#ifdef DSP_DIS_SHLQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_shrq(void)
-{
-#ifdef DSP_DIS_SHRQ
-	if (doDSPDis)
-		WriteLog("%06X: SHRQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	int32_t r1 = dsp_convert_zero[IMM_1];
-	uint32_t res = RN >> r1;
-	SET_ZN(res); dsp_flag_c = RN & 1;
-	RN = res;
-#ifdef DSP_DIS_SHRQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_ror(void)
-{
-#ifdef DSP_DIS_ROR
-	if (doDSPDis)
-		WriteLog("%06X: ROR    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t r1 = RM & 0x1F;
-	uint32_t res = (RN >> r1) | (RN << (32 - r1));
-	SET_ZN(res); dsp_flag_c = (RN >> 31) & 1;
-	RN = res;
-#ifdef DSP_DIS_ROR
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_rorq(void)
-{
-#ifdef DSP_DIS_RORQ
-	if (doDSPDis)
-		WriteLog("%06X: RORQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t r1 = dsp_convert_zero[IMM_1 & 0x1F];
-	uint32_t r2 = RN;
-	uint32_t res = (r2 >> r1) | (r2 << (32 - r1));
-	RN = res;
-	SET_ZN(res); dsp_flag_c = (r2 >> 31) & 0x01;
-#ifdef DSP_DIS_RORQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void dsp_opcode_sha(void)
-{
-	int32_t sRm=(int32_t)RM;
-	uint32_t _Rn=RN;
-
-	if (sRm<0)
-	{
-		uint32_t shift=-sRm;
-		if (shift>=32) shift=32;
-		dsp_flag_c=(_Rn&0x80000000)>>31;
-		while (shift)
-		{
-			_Rn<<=1;
-			shift--;
-		}
-	}
-	else
+	static inline void StoreR15RI(uint32_t m, uint32_t n)
 	{
-		uint32_t shift=sRm;
-		if (shift>=32) shift=32;
-		dsp_flag_c=_Rn&0x1;
-		while (shift)
-		{
-			_Rn=((int32_t)_Rn)>>1;
-			shift--;
-		}
+		WriteLong(dsp_reg[15] + dsp_reg[m], dsp_reg[n]);
 	}
-	RN = _Rn;
-	SET_ZN(RN);
-}
-
-
-static void dsp_opcode_sharq(void)
-{
-#ifdef DSP_DIS_SHARQ
-	if (doDSPDis)
-		WriteLog("%06X: SHARQ  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = (int32_t)RN >> dsp_convert_zero[IMM_1];
-	SET_ZN(res); dsp_flag_c = RN & 0x01;
-	RN = res;
-#ifdef DSP_DIS_SHARQ
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
-#endif
-}
+};
 
 
-static void dsp_opcode_sh(void)
+//
+// DSP execution core
+//
+void DSPExec(int32_t cycles)
 {
-	int32_t sRm=(int32_t)RM;
-	uint32_t _Rn=RN;
-
-	if (sRm<0)
-	{
-		uint32_t shift=(-sRm);
-		if (shift>=32) shift=32;
-		dsp_flag_c=(_Rn&0x80000000)>>31;
-		while (shift)
-		{
-			_Rn<<=1;
-			shift--;
-		}
-	}
-	else
+#ifdef DSP_SINGLE_STEPPING
+	if (dsp_control & 0x18)
 	{
-		uint32_t shift=sRm;
-		if (shift>=32) shift=32;
-		dsp_flag_c=_Rn&0x1;
-		while (shift)
-		{
-			_Rn>>=1;
-			shift--;
-		}
+		cycles = 1;
+		dsp_control &= ~0x10;
 	}
-	RN = _Rn;
-	SET_ZN(RN);
-}
-
-void dsp_opcode_addqmod(void)
-{
-#ifdef DSP_DIS_ADDQMOD
-	if (doDSPDis)
-		WriteLog("%06X: ADDQMOD #%u, R%02u [NCZ:%u%u%u, R%02u=%08X, DSP_MOD=%08X] -> ", dsp_pc-2, dsp_convert_zero[IMM_1], IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN, dsp_modulo);
-#endif
-	uint32_t r1 = dsp_convert_zero[IMM_1];
-	uint32_t r2 = RN;
-	uint32_t res = r2 + r1;
-	res = (res & (~dsp_modulo)) | (r2 & dsp_modulo);
-	RN = res;
-	SET_ZNC_ADD(r2, r1, res);
-#ifdef DSP_DIS_ADDQMOD
-	if (doDSPDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", dsp_flag_n, dsp_flag_c, dsp_flag_z, IMM_2, RN);
 #endif
-}
-
-void dsp_opcode_subqmod(void)
-{
-	uint32_t r1 = dsp_convert_zero[IMM_1];
-	uint32_t r2 = RN;
-	uint32_t res = r2 - r1;
-	res = (res & (~dsp_modulo)) | (r2 & dsp_modulo);
-	RN = res;
-
-	SET_ZNC_SUB(r2, r1, res);
-}
+//There is *no* good reason to do this here!
+//	DSPHandleIRQs();
+	dsp_releaseTimeSlice_flag = 0;
 
-void dsp_opcode_mirror(void)
-{
-	uint32_t r1 = RN;
-	RN = (mirror_table[r1 & 0xFFFF] << 16) | mirror_table[r1 >> 16];
-	SET_ZN(RN);
-}
+	if (!dsp_in_exec++)
+		dspIdleProbe = false, dspIdleFailPC = 0;
 
-void dsp_opcode_sat32s(void)
-{
-	int32_t r2 = (uint32_t)RN;
-	int32_t temp = dsp_acc >> 32;
-	uint32_t res = (temp < -1) ? (int32_t)0x80000000 : (temp > 0) ? (int32_t)0x7FFFFFFF : r2;
-	RN = res;
-	SET_ZN(res);
-}
+	RISCCore<DSPUnit>::Run(cycles);
 
-void dsp_opcode_sat16s(void)
-{
-	int32_t r2 = RN;
-	uint32_t res = (r2 < -32768) ? -32768 : (r2 > 32767) ? 32767 : r2;
-	RN = res;
-	SET_ZN(res);
+	dsp_in_exec--;
 }
 
-void dsp_opcode_illegal(void)
-{
-	// Don't know what it does, but it does *something*...
-	WriteLog("%06X: illegal %u, %u [NCZ:%u%u%u]\n", dsp_pc-2, IMM_1, IMM_2, dsp_flag_n, dsp_flag_c, dsp_flag_z);
-}
 
 //
 // New pipelined DSP core
@@ -2901,6 +2020,71 @@ void FlushDSPPipeline(void)
 
 	for(int i=0; i<32; i++)
 		scoreboard[i] = 0;
+
+	scoreboardMask = 0;
+}
+
+
+//
+// Decode a DSP RAM word; the scoreboard reads & hazard class become a lookup
+//
+static void DSPDecodeInstruction(DSPDecodedInstruction * decoded, uint16_t instruction)
+{
+	uint8_t opcode = instruction >> 10;
+	decoded->instruction = instruction;
+	decoded->opcode = opcode;
+	decoded->operand1 = (instruction >> 5) & 0x1F;
+	decoded->operand2 = instruction & 0x1F;
+	decoded->readMask = (readAffected[opcode][0] ? 1 << decoded->operand1 : 0)
+		| (readAffected[opcode][1] ? 1 << decoded->operand2 : 0)
+		| ((opcode == 43 || opcode == 58) ? 1 << 14 : 0)
+		| ((opcode == 44 || opcode == 59) ? 1 << 15 : 0);
+	decoded->flags = DSP_DECODED_VALID | (isLoadStore[opcode] ? DSP_DECODED_LOADSTORE : 0)
+		| (affectsScoreboard[opcode] ? DSP_DECODED_SCOREBOARD : 0);
+}
+
+
+//
+// Decoded instruction at the PC; out of the DSP RAM, it is decoded in outside
+//
+static inline DSPDecodedInstruction * DSPDecode(uint32_t pc, DSPDecodedInstruction * outside)
+{
+	if ((pc >= DSP_WORK_RAM_BASE) && (pc < DSP_WORK_RAM_BASE + 0x2000))
+	{
+		DSPDecodedInstruction * decoded = &dspDecoded[(pc - DSP_WORK_RAM_BASE) >> 1];
+
+		if (!(decoded->flags & DSP_DECODED_VALID))
+			DSPDecodeInstruction(decoded, GET16(dsp_ram_8, pc - DSP_WORK_RAM_BASE));
+
+		return decoded;
+	}
+
+	DSPDecodeInstruction(outside, DSPReadWord(pc, DSP));
+	return outside;
+}
+
+
+// DSP RAM has been written behind the DSP write functions
+static void DSPDecodeInvalidate(void)
+{
+	for(int i=0; i<0x1000; i++)
+		dspDecoded[i].flags = 0;
+}
+
+
+// Writeback done, the register is no longer waited for once the scoreboard is clear
+static inline void DSPScoreboardRelease(uint8_t reg)
+{
+#ifndef NEW_SCOREBOARD
+	scoreboard[reg] = false;
+#else
+//Yup, sequential MOVEQ # problem fixing (I hope!)...
+	if (scoreboard[reg])
+		scoreboard[reg]--;
+#endif
+
+	if (!scoreboard[reg])
+		scoreboardMask &= ~(1 << reg);
 }
 
 //
@@ -3167,13 +2351,13 @@ F1B016: NOP    [NCZ:001]
 F1B1FC: MOVEI  #$00F1A100, R01 [NCZ:001, R01=00F1A100] -> [NCZ:001, R01=00F1A100]
 */
 
-uint32_t pcQueue1[0x400];
-uint32_t pcQPtr1 = 0;
 static uint32_t prevR1;
 //Let's try a 3 stage pipeline....
 //Looks like 3 stage is correct, otherwise bad things happen...
 void DSPExecP2(int32_t cycles)
 {
+	DSPDecodedInstruction outside;
+
 	dsp_releaseTimeSlice_flag = 0;
 	dsp_in_exec++;
 
@@ -3227,13 +2411,13 @@ if ((dsp_pc < 0xF1B000 || dsp_pc > 0xF1CFFF) && !doDSPDis)
 }//*/
 #endif
 
-		if (IMASKCleared)						// If IMASK was cleared,
+		if (dspIRQPending)						// If IMASK was cleared with interrupts pending,
 		{
 #ifdef DSP_DEBUG_IRQ
 			WriteLog("DSP: Finished interrupt.\n");
 #endif
-			DSPHandleIRQs();					// See if any other interrupts are pending!
-			IMASKCleared = false;
+			DSPHandleIRQs();					// take them!
+			dspIRQPending = 0;
 		}
 
 //if (dsp_flags & REGPAGE)
@@ -3252,19 +2436,27 @@ WriteLog("\n");
 }
 #endif
 		// Stage 1a: Instruction fetch
-		pipeline[plPtrRead].instruction = DSPReadWord(dsp_pc, DSP);
-		pipeline[plPtrRead].opcode = pipeline[plPtrRead].instruction >> 10;
-		pipeline[plPtrRead].operand1 = (pipeline[plPtrRead].instruction >> 5) & 0x1F;
-		pipeline[plPtrRead].operand2 = pipeline[plPtrRead].instruction & 0x1F;
-		if (pipeline[plPtrRead].opcode == 38)
-			pipeline[plPtrRead].result = (uint32_t)DSPReadWord(dsp_pc + 2, DSP)
-				| ((uint32_t)DSPReadWord(dsp_pc + 4, DSP) << 16);
+		PipelineStage * read = &pipeline[plPtrRead];
+		DSPDecodedInstruction * decoded = DSPDecode(dsp_pc, &outside);
+		read->instruction = decoded->instruction;
+		read->opcode = decoded->opcode;
+		read->operand1 = decoded->operand1;
+		read->operand2 = decoded->operand2;
+		if (read->opcode == 38)
+		{
+			if (decoded != &outside && dsp_pc < DSP_WORK_RAM_BASE + 0x2000 - 4)
+				read->result = (uint32_t)GET16(dsp_ram_8, dsp_pc + 2 - DSP_WORK_RAM_BASE)
+					| ((uint32_t)GET16(dsp_ram_8, dsp_pc + 4 - DSP_WORK_RAM_BASE) << 16);
+			else
+				read->result = (uint32_t)DSPReadWord(dsp_pc + 2, DSP)
+					| ((uint32_t)DSPReadWord(dsp_pc + 4, DSP) << 16);
+		}
 #ifdef DSP_DEBUG_PL2
 if (doDSPDis)
 {
-WriteLog("DSPExecP: Fetching instruction (%04X) from DSP_PC = %08X...\n", pipeline[plPtrRead].instruction, dsp_pc);
+WriteLog("DSPExecP: Fetching instruction (%04X) from DSP_PC = %08X...\n", read->instruction, dsp_pc);
 WriteLog("DSPExecP: Pipeline status (after stage 1a) [PC=%08X]...\n", dsp_pc);
-WriteLog("\tR -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", pipeline[plPtrRead].opcode, pipeline[plPtrRead].operand1, pipeline[plPtrRead].operand2, pipeline[plPtrRead].reg1, pipeline[plPtrRead].reg2, pipeline[plPtrRead].result, pipeline[plPtrRead].writebackRegister, dsp_opcode_str[pipeline[plPtrRead].opcode]);
+WriteLog("\tR -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", read->opcode, read->operand1, read->operand2, read->reg1, read->reg2, read->result, read->writebackRegister, dsp_opcode_str[read->opcode]);
 WriteLog("\tE -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", pipeline[plPtrExec].opcode, pipeline[plPtrExec].operand1, pipeline[plPtrExec].operand2, pipeline[plPtrExec].reg1, pipeline[plPtrExec].reg2, pipeline[plPtrExec].result, pipeline[plPtrExec].writebackRegister, dsp_opcode_str[pipeline[plPtrExec].opcode]);
 WriteLog("\tW -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", pipeline[plPtrWrite].opcode, pipeline[plPtrWrite].operand1, pipeline[plPtrWrite].operand2, pipeline[plPtrWrite].reg1, pipeline[plPtrWrite].reg2, pipeline[plPtrWrite].result, pipeline[plPtrWrite].writebackRegister, dsp_opcode_str[pipeline[plPtrWrite].opcode]);
 }
@@ -3275,54 +2467,63 @@ WriteLog("\tW -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", p
 //Ugly, but [DONE]
 //Another problem: Any sequential combination of LOAD and STORE operations will cause the
 //pipeline to stall, and we don't take care of that here. !!! FIX !!!
-		if ((scoreboard[pipeline[plPtrRead].operand1] && readAffected[pipeline[plPtrRead].opcode][0])
-			|| (scoreboard[pipeline[plPtrRead].operand2] && readAffected[pipeline[plPtrRead].opcode][1])
-			|| ((pipeline[plPtrRead].opcode == 43 || pipeline[plPtrRead].opcode == 58) && scoreboard[14])
-			|| ((pipeline[plPtrRead].opcode == 44 || pipeline[plPtrRead].opcode == 59) && scoreboard[15])
+		// Registers read (R14/R15 included for the indexed LOAD & STORE) are in the decoded mask
+		if ((scoreboardMask & decoded->readMask)
 //Not sure that this is the best way to fix the LOAD/STORE problem... But it seems to
 //work--somewhat...
-			|| (isLoadStore[pipeline[plPtrRead].opcode] && isLoadStore[pipeline[plPtrExec].opcode]))
+			|| ((decoded->flags & DSP_DECODED_LOADSTORE) && isLoadStore[pipeline[plPtrExec].opcode]))
 			// We have a hit in the scoreboard, so we have to stall the pipeline...
 #ifdef DSP_DEBUG_PL2
 {
 if (doDSPDis)
 {
 WriteLog("  --> Stalling pipeline: ");
-if (readAffected[pipeline[plPtrRead].opcode][0])
-	WriteLog("scoreboard[%u] = %s (reg 1) ", pipeline[plPtrRead].operand1, scoreboard[pipeline[plPtrRead].operand1] ? "true" : "false");
-if (readAffected[pipeline[plPtrRead].opcode][1])
-	WriteLog("scoreboard[%u] = %s (reg 2)", pipeline[plPtrRead].operand2, scoreboard[pipeline[plPtrRead].operand2] ? "true" : "false");
+if (readAffected[read->opcode][0])
+	WriteLog("scoreboard[%u] = %s (reg 1) ", read->operand1, scoreboard[read->operand1] ? "true" : "false");
+if (readAffected[read->opcode][1])
+	WriteLog("scoreboard[%u] = %s (reg 2)", read->operand2, scoreboard[read->operand2] ? "true" : "false");
 WriteLog("\n");
 }
 #endif
-			pipeline[plPtrRead].opcode = PIPELINE_STALL;
+			read->opcode = PIPELINE_STALL;
 #ifdef DSP_DEBUG_PL2
 }
 #endif
 		else
 		{
-			pipeline[plPtrRead].reg1 = dsp_reg[pipeline[plPtrRead].operand1];
-			pipeline[plPtrRead].reg2 = dsp_reg[pipeline[plPtrRead].operand2];
-			pipeline[plPtrRead].writebackRegister = pipeline[plPtrRead].operand2;	// Set it to RN
+			read->reg1 = dsp_reg[read->operand1];
+			read->reg2 = dsp_reg[read->operand2];
+			read->writebackRegister = read->operand2;	// Set it to RN
 
 			// Shouldn't we be more selective with the register scoreboarding?
 			// Yes, we should. !!! FIX !!! Kinda [DONE]
+			if (decoded->flags & DSP_DECODED_SCOREBOARD)
+			{
 #ifndef NEW_SCOREBOARD
-			scoreboard[pipeline[plPtrRead].operand2] = affectsScoreboard[pipeline[plPtrRead].opcode];
+				scoreboard[read->operand2] = true;
 #else
 //Hopefully this will fix the dual MOVEQ # problem...
-			scoreboard[pipeline[plPtrRead].operand2] += (affectsScoreboard[pipeline[plPtrRead].opcode] ? 1 : 0);
+				scoreboard[read->operand2]++;
+#endif
+				scoreboardMask |= 1 << read->operand2;
+			}
+#ifndef NEW_SCOREBOARD
+			else
+			{
+				scoreboard[read->operand2] = false;
+				scoreboardMask &= ~(1 << read->operand2);
+			}
 #endif
 
 //Advance PC here??? Yes.
-			dsp_pc += (pipeline[plPtrRead].opcode == 38 ? 6 : 2);
+			dsp_pc += (read->opcode == 38 ? 6 : 2);
 		}
 
 #ifdef DSP_DEBUG_PL2
 if (doDSPDis)
 {
 WriteLog("DSPExecP: Pipeline status (after stage 1b) [PC=%08X]...\n", dsp_pc);
-WriteLog("\tR -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", pipeline[plPtrRead].opcode, pipeline[plPtrRead].operand1, pipeline[plPtrRead].operand2, pipeline[plPtrRead].reg1, pipeline[plPtrRead].reg2, pipeline[plPtrRead].result, pipeline[plPtrRead].writebackRegister, dsp_opcode_str[pipeline[plPtrRead].opcode]);
+WriteLog("\tR -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", read->opcode, read->operand1, read->operand2, read->reg1, read->reg2, read->result, read->writebackRegister, dsp_opcode_str[read->opcode]);
 WriteLog("\tE -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", pipeline[plPtrExec].opcode, pipeline[plPtrExec].operand1, pipeline[plPtrExec].operand2, pipeline[plPtrExec].reg1, pipeline[plPtrExec].reg2, pipeline[plPtrExec].result, pipeline[plPtrExec].writebackRegister, dsp_opcode_str[pipeline[plPtrExec].opcode]);
 WriteLog("\tW -> %02u, %02u, %02u; r1=%08X, r2= %08X, res=%08X, wb=%u (%s)\n", pipeline[plPtrWrite].opcode, pipeline[plPtrWrite].operand1, pipeline[plPtrWrite].operand2, pipeline[plPtrWrite].reg1, pipeline[plPtrWrite].reg2, pipeline[plPtrWrite].result, pipeline[plPtrWrite].writebackRegister, dsp_opcode_str[pipeline[plPtrWrite].opcode]);
 }
@@ -3376,39 +2577,34 @@ WriteLog("\n");
 }
 #endif
 		// Stage 3: Write back register/memory address
-		if (pipeline[plPtrWrite].opcode != PIPELINE_STALL)
+		PipelineStage * write = &pipeline[plPtrWrite];
+
+		if (write->opcode != PIPELINE_STALL)
 		{
-/*if (pipeline[plPtrWrite].writebackRegister == 3
-	&& (pipeline[plPtrWrite].result < 0xF14000 || pipeline[plPtrWrite].result > 0xF1CFFF)
+/*if (write->writebackRegister == 3
+	&& (write->result < 0xF14000 || write->result > 0xF1CFFF)
 	&& !doDSPDis)
 {
 	WriteLog("DSP: Register R03 has stepped out of bounds...\n\n");
 	doDSPDis = true;
 }//*/
-			if (pipeline[plPtrWrite].writebackRegister != 0xFF)
+			if (write->writebackRegister != 0xFF)
 			{
-				if (pipeline[plPtrWrite].writebackRegister != 0xFE)
-					dsp_reg[pipeline[plPtrWrite].writebackRegister] = pipeline[plPtrWrite].result;
+				if (write->writebackRegister != 0xFE)
+					dsp_reg[write->writebackRegister] = write->result;
 				else
 				{
-					if (pipeline[plPtrWrite].type == TYPE_BYTE)
-						JaguarWriteByte(pipeline[plPtrWrite].address, pipeline[plPtrWrite].value);
-					else if (pipeline[plPtrWrite].type == TYPE_WORD)
-						JaguarWriteWord(pipeline[plPtrWrite].address, pipeline[plPtrWrite].value);
+					if (write->type == TYPE_BYTE)
+						JaguarWriteByte(write->address, write->value);
+					else if (write->type == TYPE_WORD)
+						JaguarWriteWord(write->address, write->value);
 					else
-						JaguarWriteLong(pipeline[plPtrWrite].address, pipeline[plPtrWrite].value);
+						JaguarWriteLong(write->address, write->value);
 				}
 			}
 
-#ifndef NEW_SCOREBOARD
-			if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-				scoreboard[pipeline[plPtrWrite].operand2] = false;
-#else
-//Yup, sequential MOVEQ # problem fixing (I hope!)...
-			if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-				if (scoreboard[pipeline[plPtrWrite].operand2])
-					scoreboard[pipeline[plPtrWrite].operand2]--;
-#endif
+			if (affectsScoreboard[write->opcode])
+				DSPScoreboardRelease(write->operand2);
 		}
 
 		// Push instructions through the pipeline...
@@ -3878,15 +3074,8 @@ const char * condition[32] =
 				}
 			}
 
-#ifndef NEW_SCOREBOARD
-			if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-				scoreboard[pipeline[plPtrWrite].operand2] = false;
-#else
-//Yup, sequential MOVEQ # problem fixing (I hope!)...
 			if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-				if (scoreboard[pipeline[plPtrWrite].operand2])
-					scoreboard[pipeline[plPtrWrite].operand2]--;
-#endif
+				DSPScoreboardRelease(pipeline[plPtrWrite].operand2);
 		}
 
 		// Step 2: Push instruction through pipeline & execute following instruction
@@ -3983,15 +3172,8 @@ const char * condition[32] =
 				}
 			}
 
-#ifndef NEW_SCOREBOARD
-			if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-				scoreboard[pipeline[plPtrWrite].operand2] = false;
-#else
-//Yup, sequential MOVEQ # problem fixing (I hope!)...
 			if (affectsScoreboard[pipeline[plPtrWrite].opcode])
-				if (scoreboard[pipeline[plPtrWrite].operand2])
-					scoreboard[pipeline[plPtrWrite].operand2]--;
-#endif
+				DSPScoreboardRelease(pipeline[plPtrWrite].operand2);
 		}
 
 		// Step 2: Push instruction through pipeline & execute following instruction
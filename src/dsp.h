@@ -17,6 +17,7 @@ void DSPDone(void);
 void DSPUpdateRegisterBanks(void);
 void DSPHandleIRQs(void);
 void DSPSetIRQLine(int irqline, int state);
+void DSPSetIdleSkip(bool enable);
 uint8_t DSPReadByte(uint32_t offset, uint32_t who = UNKNOWN);
 uint16_t DSPReadWord(uint32_t offset, uint32_t who = UNKNOWN);
 uint32_t DSPReadLong(uint32_t offset, uint32_t who = UNKNOWN);
@@ -31,10 +32,78 @@ void DSPExecP2(int32_t cycles);
 //void DSPExecP3(int32_t cycles);
 void DSPExecComp(int32_t cycles);
 
+// DSP pipeline stage
+
+struct PipelineStage
+{
+	uint16_t instruction;
+	uint8_t opcode, operand1, operand2;
+	uint32_t reg1, reg2, areg1, areg2;
+	uint32_t result;
+	uint8_t writebackRegister;
+	// General memory store...
+	uint32_t address;
+	uint32_t value;
+	uint8_t type;
+};
+
+// Instruction of a DSP RAM word, decoded once for the pipelined core
+struct DSPDecodedInstruction
+{
+	uint16_t instruction;
+	uint8_t opcode, operand1, operand2;
+	uint8_t flags;								// DSP_DECODED_xxx (see dsp.cpp)
+	uint32_t readMask;							// Registers whose scoreboard stalls the read
+};
+
+// DSP state of a machine
+
+struct DSPState
+{
+	uint8_t dsp_ram_8[0x2000];
+	uint32_t dsp_pc;
+	uint64_t dsp_acc;							// 40 bit register, NOT 32!
+	uint32_t dsp_remain;
+	uint32_t dsp_modulo;
+	uint32_t dsp_flags;
+	uint32_t dsp_matrix_control;
+	uint32_t dsp_pointer_to_matrix;
+	uint32_t dsp_data_organization;
+	uint32_t dsp_control;
+	uint32_t dsp_div_control;
+	uint8_t dsp_flag_z, dsp_flag_n, dsp_flag_c;
+	uint32_t * dsp_reg, * dsp_alternate_reg;
+	uint32_t dsp_reg_bank_0[32], dsp_reg_bank_1[32];
+	uint32_t dsp_opcode_first_parameter;
+	uint32_t dsp_opcode_second_parameter;
+	uint32_t dsp_opcode_use[65];
+	uint32_t dsp_in_exec;
+	uint32_t dsp_releaseTimeSlice_flag;
+	// Pipelined core
+	uint8_t scoreboard[32];
+	uint32_t scoreboardMask;					// Registers waiting for their writeback
+	DSPDecodedInstruction decoded[0x1000];		// One per DSP RAM word
+	uint8_t plPtrFetch, plPtrRead, plPtrExec, plPtrWrite;
+	PipelineStage pipeline[4];
+	uint32_t dspIRQPending;						// Interrupts to take once the instruction clearing IMASK is done
+	uint32_t pcQueue1[0x400];
+	uint32_t pcQPtr1;
+	// Idle loops skip
+	bool dspIdleSkip;
+	bool dspIdleProbe;							// An iteration of a loop is being checked
+	bool dspIdlePure;							// Registers written & memory read without side effect only
+	uint32_t dspIdlePC, dspIdleFailPC;
+	int32_t dspIdleCycles;
+	uint32_t dspIdleFlags;
+	uint32_t dspIdleRegs[64];
+};
+
 // Exported vars
 
 extern bool doDSPDis;
-extern uint32_t dsp_reg_bank_0[], dsp_reg_bank_1[];
+// Of the current machine (see machine.h)
+#define dsp_reg_bank_0	(jaguarMachine->dsp.dsp_reg_bank_0)
+#define dsp_reg_bank_1	(jaguarMachine->dsp.dsp_reg_bank_1)
 
 // DSP interrupt numbers (in $F1A100, bits 4-8 & 16)
 
@@ -14,6 +14,8 @@
 // JLH  01/16/2010       Created this log ;-)
 // JPM  10/11/2017       EEPROM directory detection and creation if missing
 // JPM  11/18/2020       EEPROM directory creation allowed only for Windows
+// JPM  10/19/2026       EEPROM state moved in the machine context
+// JPM  10/19/2026       EEPROM files written by the save data persistence, and saved after an erase
 //
 
 #include "eeprom.h"
@@ -26,23 +28,39 @@
 #include <string.h>								// For memset
 #include "jaguar.h"
 #include "log.h"
+#include "machine.h"
+#include "savedata.h"
 #include "settings.h"
 
 #define eeprom_LOG
 
-static uint16_t eeprom_ram[64];
-static uint16_t cdromEEPROM[64];
+// EEPROM state lives in the machine context (see eeprom.h)
+#define eeprom_ram				(jaguarMachine->eeprom.eeprom_ram)
+#define cdromEEPROM				(jaguarMachine->eeprom.cdromEEPROM)
+#define jerry_ee_state			(jaguarMachine->eeprom.jerry_ee_state)
+#define jerry_ee_op				(jaguarMachine->eeprom.jerry_ee_op)
+#define jerry_ee_rstate			(jaguarMachine->eeprom.jerry_ee_rstate)
+#define jerry_ee_address_data	(jaguarMachine->eeprom.jerry_ee_address_data)
+#define jerry_ee_address_cnt	(jaguarMachine->eeprom.jerry_ee_address_cnt)
+#define jerry_ee_data			(jaguarMachine->eeprom.jerry_ee_data)
+#define jerry_ee_data_cnt		(jaguarMachine->eeprom.jerry_ee_data_cnt)
+#define jerry_writes_enabled	(jaguarMachine->eeprom.jerry_writes_enabled)
+#define jerry_ee_direct_jump	(jaguarMachine->eeprom.jerry_ee_direct_jump)
+#define eeprom_filename			(jaguarMachine->eeprom.eeprom_filename)
+#define cdromEEPROMFilename		(jaguarMachine->eeprom.cdromEEPROMFilename)
+#define haveEEPROM				(jaguarMachine->eeprom.haveEEPROM)
+#define haveCDROMEEPROM			(jaguarMachine->eeprom.haveCDROMEEPROM)
 
 //
 // Private function prototypes
 //
 
 static void EEPROMSave(void);
+static void EEPROMSaveFile(const char * filename, uint16_t * ram);
 static void eeprom_set_di(uint32_t state);
 static void eeprom_set_cs(uint32_t state);
 static uint32_t eeprom_get_do(void);
 void ReadEEPROMFromFile(FILE * file, uint16_t * ram);
-void WriteEEPROMToFile(FILE * file, uint16_t * ram);
 
 
 enum { EE_STATE_START = 1, EE_STATE_OP_A, EE_STATE_OP_B, EE_STATE_0, EE_STATE_1,
@@ -50,29 +68,17 @@ enum { EE_STATE_START = 1, EE_STATE_OP_A, EE_STATE_OP_B, EE_STATE_0, EE_STATE_1,
 	EE_STATE_0_0_1, EE_STATE_0_0_2, EE_STATE_0_0_3, EE_STATE_0_0_1_0, EE_READ_DATA,
 	EE_STATE_BUSY, EE_STATE_1_0, EE_STATE_1_1, EE_STATE_2_0, EE_STATE_3_0 };
 
-// Local global variables
-
-static uint16_t jerry_ee_state = EE_STATE_START;
-static uint16_t jerry_ee_op = 0;
-static uint16_t jerry_ee_rstate = 0;
-static uint16_t jerry_ee_address_data = 0;
-static uint16_t jerry_ee_address_cnt = 6;
-static uint16_t jerry_ee_data = 0;
-static uint16_t jerry_ee_data_cnt = 16;
-static uint16_t jerry_writes_enabled = 0;
-static uint16_t jerry_ee_direct_jump = 0;
-
-static char eeprom_filename[MAX_PATH];
-static char cdromEEPROMFilename[MAX_PATH];
-static bool haveEEPROM = false;
-static bool haveCDROMEEPROM = false;
-
-
 // EEPROM initialisations
 void EepromInit(void)
 {
 	FILE * fp;
 
+	jerry_ee_state = EE_STATE_START;
+	jerry_ee_op = jerry_ee_rstate = jerry_ee_address_data = jerry_ee_data = 0;
+	jerry_ee_address_cnt = 6;
+	jerry_ee_data_cnt = 16;
+	jerry_writes_enabled = jerry_ee_direct_jump = 0;
+
 	// No need for EEPROM for the Memory Track device :-P
 	if (jaguarMainROMCRC32 == 0xFDF37F47)
 	{
@@ -133,73 +139,58 @@ void EepromReset(void)
 //
 void EepromDone(void)
 {
+	SaveDataFlush();
 	WriteLog("EEPROM: Done.\n");
 }
 
 
+//
 // EEPROM save
+// Files are written later, by the save data persistence, once the writes are over
+//
 static void EEPROMSave(void)
 {
-	FILE * fp;
-
 	// Check if EEPROM directory exists and try to create it if not
 	if (_mkdir(vjs.EEPROMPath))
 	{
 		WriteLog("EEPROM: Could not create directory \"%s!\"\n", vjs.EEPROMPath);
 	}
 
-	// Write out regular cartridge EEPROM data
-	fp = fopen(eeprom_filename, "wb");
-	if (fp)
-	{
-		WriteEEPROMToFile(fp, eeprom_ram);
-		fclose(fp);
-	}
-	else
-	{
-		WriteLog("EEPROM: Could not create file \"%s!\"\n", eeprom_filename);
-	}
+	// Regular cartridge EEPROM data
+	EEPROMSaveFile(eeprom_filename, eeprom_ram);
 
-	// Write out JagCD EEPROM data
-	fp = fopen(cdromEEPROMFilename, "wb");
-	if (fp)
-	{
-		WriteEEPROMToFile(fp, cdromEEPROM);
-		fclose(fp);
-	}
-	else
-	{
-		WriteLog("EEPROM: Could not create file \"%s!\"\n", cdromEEPROMFilename);
-	}
+	// JagCD EEPROM data
+	EEPROMSaveFile(cdromEEPROMFilename, cdromEEPROM);
 }
 
 
-//
-// Read/write EEPROM files to disk in an endian safe manner
-//
-void ReadEEPROMFromFile(FILE * file, uint16_t * ram)
+// Written in the same endian safe manner as it is read
+static void EEPROMSaveFile(const char * filename, uint16_t * ram)
 {
 	uint8_t buffer[128];
-	size_t ignored = fread(buffer, 1, 128, file);
 
-	for (int i = 0; i < 64; i++)
+	for(int i=0; i<64; i++)
 	{
-		ram[i] = (buffer[(i * 2) + 0] << 8) | buffer[(i * 2) + 1];
+		buffer[(i * 2) + 0] = ram[i] >> 8;
+		buffer[(i * 2) + 1] = ram[i] & 0xFF;
 	}
+
+	SaveDataUpdate(filename, buffer, 128, 0, 128);
 }
 
 
-void WriteEEPROMToFile(FILE * file, uint16_t * ram)
+//
+// Read EEPROM files from disk in an endian safe manner (see EEPROMSaveFile)
+//
+void ReadEEPROMFromFile(FILE * file, uint16_t * ram)
 {
 	uint8_t buffer[128];
+	size_t ignored = fread(buffer, 1, 128, file);
 
-	for(int i=0; i<64; i++)
+	for (int i = 0; i < 64; i++)
 	{
-		buffer[(i * 2) + 0] = ram[i] >> 8;
-		buffer[(i * 2) + 1] = ram[i] & 0xFF;
+		ram[i] = (buffer[(i * 2) + 0] << 8) | buffer[(i * 2) + 1];
 	}
-
-	fwrite(buffer, 1, 128, file);
 }
 
 
@@ -375,9 +366,13 @@ static void eeprom_set_di(uint32_t data)
 		WriteLog("eeprom: erasing eeprom\n");
 #endif
 		if (jerry_writes_enabled)
+		{
 			for(int i=0; i<64; i++)
 				eeprom_ram[i] = 0xFFFF;
 
+			EEPROMSave();
+		}
+
 		jerry_ee_state = EE_STATE_BUSY;
 		break;
 	case EE_STATE_0_0_3:
@@ -6,6 +6,28 @@
 #define __EEPROM_H__
 
 #include <stdint.h>
+#include "settings.h"
+
+// EEPROM state of a machine
+
+struct EEPROMState
+{
+	uint16_t eeprom_ram[64];
+	uint16_t cdromEEPROM[64];
+	uint16_t jerry_ee_state;
+	uint16_t jerry_ee_op;
+	uint16_t jerry_ee_rstate;
+	uint16_t jerry_ee_address_data;
+	uint16_t jerry_ee_address_cnt;
+	uint16_t jerry_ee_data;
+	uint16_t jerry_ee_data_cnt;
+	uint16_t jerry_writes_enabled;
+	uint16_t jerry_ee_direct_jump;
+	char eeprom_filename[MAX_PATH];
+	char cdromEEPROMFilename[MAX_PATH];
+	bool haveEEPROM;
+	bool haveCDROMEEPROM;
+};
 
 extern void EepromInit(void);
 extern void EepromReset(void);
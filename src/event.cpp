@@ -9,6 +9,9 @@
 // Who  When        What
 // ---  ----------  -------------------------------------------------------------
 // JLH  01/16/2010  Created this log ;-)
+// JPM   Oct./2026  Events lists moved in the machine context
+// JPM   Oct./2026  Callbacks performance counters
+// JPM   Oct./2026  Callbacks recorded in the execution trace
 //
 
 //
@@ -21,10 +24,7 @@
 
 #include <stdint.h>
 #include "log.h"
-
-
-//#define EVENT_LIST_SIZE       512
-#define EVENT_LIST_SIZE       32
+#include "machine.h"
 
 
 // Now, a bit of weirdness: It seems that the number of lines displayed on the screen
@@ -39,20 +39,12 @@
 // Although if we used an insertion sort we could, but it wouldn't work for adjusting
 // times... (For that, you would have to remove the event then reinsert it.)
 
-struct Event
-{
-	bool valid;
-	int eventType;
-	double eventTime;
-	void (* timerCallback)(void);
-};
-
-
-static Event eventList[EVENT_LIST_SIZE];
-static Event eventListJERRY[EVENT_LIST_SIZE];
-static uint32_t nextEvent;
-static uint32_t nextEventJERRY;
-static uint32_t numberOfEvents;
+// The events lists live in the machine context (see event.h)
+#define eventList		(jaguarMachine->event.eventList)
+#define eventListJERRY	(jaguarMachine->event.eventListJERRY)
+#define nextEvent		(jaguarMachine->event.nextEvent)
+#define nextEventJERRY	(jaguarMachine->event.nextEventJERRY)
+#define numberOfEvents	(jaguarMachine->event.numberOfEvents)
 
 
 void InitializeEventList(void)
@@ -217,6 +209,8 @@ double GetTimeToNextEvent(int type/*= EVENT_MAIN*/)
 
 void HandleNextEvent(int type/*= EVENT_MAIN*/)
 {
+	PERF_COUNT(events[type], 1);
+
 	if (type == EVENT_MAIN)
 	{
 		double elapsedTime = eventList[nextEvent].eventTime;
@@ -233,6 +227,9 @@ void HandleNextEvent(int type/*= EVENT_MAIN*/)
 		eventList[nextEvent].valid = false;			// Remove event from list...
 		numberOfEvents--;
 
+		if (TRACE_ACTIVE)
+			TraceMarker(TRACE_M68K, TRACE_EVENT, EVENT_MAIN, (uint32_t)(elapsedTime * 1000.0));
+
 		(*event)();
 	}
 	else
@@ -251,6 +248,9 @@ void HandleNextEvent(int type/*= EVENT_MAIN*/)
 		eventListJERRY[nextEventJERRY].valid = false;	// Remove event from list...
 		numberOfEvents--;
 
+		if (TRACE_ACTIVE)
+			TraceMarker(TRACE_DSP, TRACE_EVENT, EVENT_JERRY, (uint32_t)(elapsedTime * 1000.0));
+
 		(*event)();
 	}
 }
@@ -7,8 +7,13 @@
 #ifndef __EVENT_H__
 #define __EVENT_H__
 
+#include <stdint.h>
+
 enum { EVENT_MAIN, EVENT_JERRY };
 
+//#define EVENT_LIST_SIZE       512
+#define EVENT_LIST_SIZE       32
+
 //NTSC Timings...
 #define RISC_CYCLE_IN_USEC			0.03760684198
 #define M68K_CYCLE_IN_USEC			(RISC_CYCLE_IN_USEC * 2)
@@ -22,6 +27,25 @@ enum { EVENT_MAIN, EVENT_JERRY };
 #define USEC_TO_RISC_CYCLES(u) (uint32_t)(((u) / (vjs.hardwareTypeNTSC ? RISC_CYCLE_IN_USEC : RISC_CYCLE_PAL_IN_USEC)) + 0.5)
 #define USEC_TO_M68K_CYCLES(u) (uint32_t)(((u) / (vjs.hardwareTypeNTSC ? M68K_CYCLE_IN_USEC : M68K_CYCLE_PAL_IN_USEC)) + 0.5)
 
+struct Event
+{
+	bool valid;
+	int eventType;
+	double eventTime;
+	void (* timerCallback)(void);
+};
+
+// Events state of a machine
+
+struct EventState
+{
+	Event eventList[EVENT_LIST_SIZE];
+	Event eventListJERRY[EVENT_LIST_SIZE];
+	uint32_t nextEvent;
+	uint32_t nextEventJERRY;
+	uint32_t numberOfEvents;
+};
+
 void InitializeEventList(void);
 void SetCallbackTime(void (* callback)(void), double time, int type = EVENT_MAIN);
 void RemoveCallback(void (* callback)(void));
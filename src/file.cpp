@@ -35,7 +35,7 @@
 #include "eeprom.h"
 #include "jaguar.h"
 #include "log.h"
-#include "memory.h"
+#include "machine.h"
 #include "universalhdr.h"
 #include "unzip.h"
 #include "zlib.h"
@@ -172,6 +172,7 @@ bool JaguarLoadFile(char * path)
 	int fileType = ParseFileType(buffer, jaguarROMSize);
 	jaguarCartInserted = false;
 	DBGManager_Reset();
+	DasmCacheFlush();
 
 	if (fileType == JST_ROM)
 	{
@@ -9,6 +9,7 @@
 // Who  When        What
 // ---  ----------  ------------------------------------------------------------
 // JLH  02/15/2010  Created this file
+// JPM   Oct./2026  Idle loops skip disabled for the titles relying on their timing
 //
 
 #include "filedb.h"
@@ -83,7 +84,7 @@ RomIdentifier romList[] = {
 	{ 0x817A2273, "Pitfall - The Mayan Adventure (World)", FF_ROM | FF_VERIFIED },
 	{ 0x83A3FB5D, "Towers II", FF_ROM | FF_VERIFIED },
 	{ 0x85919165, "Superfly DX (v1.1)", FF_ROM | FF_VERIFIED },
-	{ 0x892BC67C, "Flip Out! (World)", FF_ROM | FF_VERIFIED },
+	{ 0x892BC67C, "Flip Out! (World)", FF_ROM | FF_VERIFIED | FF_NO_IDLE_SKIP },
 	{ 0x8975F48B, "Zool 2 (World)", FF_ROM | FF_VERIFIED },
 	{ 0x89DA21FF, "Phase Zero", FF_ALPINE | FF_VERIFIED | FF_REQ_DSP },
 	{ 0x8D15DBC6, "[BIOS] Atari Jaguar Stubulator '94 (World)", FF_BIOS },
@@ -127,7 +128,7 @@ RomIdentifier romList[] = {
 	{ 0xEEE8D61D, "Club Drive (World)", FF_ROM | FF_VERIFIED },
 	{ 0xF4ACBB04, "Tiny Toon Adventures (World)", FF_ROM | FF_VERIFIED },
 	{ 0xFA7775AE, "Checkered Flag (World)", FF_ROM | FF_VERIFIED },
-	{ 0xFAE31DD0, "Flip Out! (World) (alt)", FF_ROM },
+	{ 0xFAE31DD0, "Flip Out! (World) (alt)", FF_ROM | FF_NO_IDLE_SKIP },
 	{ 0xFB731AAA, "[BIOS] Atari Jaguar (World)", FF_BIOS },
 // is this really a BIOS???
 // No, it's really a cart, complete with RSA header. So need to fix so it can load.
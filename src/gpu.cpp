@@ -16,6 +16,16 @@
 // JLH  01/16/2010  Created this log ;-)
 // JLH  11/26/2011  Added fixes for LOAD/STORE alignment issues
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  Added optional GPU host thread running in lockstep with the 68K
+// JPM   Oct./2026  GPU state moved in the machine context
+// JPM   Oct./2026  GPU host thread is not available in a build without SDL (NO_SDL)
+// JPM   Oct./2026  Idle loops skipped up to the end of the time slice
+// JPM   Oct./2026  Idle cycles performance counters
+// JPM   Oct./2026  Interrupts checked from a pending mask, updated on the latches & enables changes
+// JPM   Oct./2026  Opcodes handlers from the RISC core shared with the DSP (risccore.h)
+// JPM   Oct./2026  Instructions, interrupts & idle loops recorded in the execution trace
+// JPM   Oct./2026  Long & phrase loads & stores done straight in the DRAM
+// JPM   Oct./2026  GPU slice rewound on the accesses of any host thread but the GPU one
 
 //
 // Note: Endian wrongness probably stems from the MAME origins of this emu and
@@ -28,15 +38,21 @@
 
 #include "gpu.h"
 
+#ifndef NO_SDL
+#include <SDL.h>								// For the GPU host thread
+#endif
 #include <stdlib.h>
 #include <string.h>								// For memset
 #include "dsp.h"
 #include "jagdasm.h"
 #include "jaguar.h"
 #include "log.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
+#include "risccore.h"
 #include "tom.h"
+#include "trace.h"
 
 
 // Seems alignment in loads & stores was off...
@@ -186,71 +202,6 @@ void GPUDumpDisassembly(void);
 void GPUDumpRegisters(void);
 void GPUDumpMemory(void);
 
-static void gpu_opcode_add(void);
-static void gpu_opcode_addc(void);
-static void gpu_opcode_addq(void);
-static void gpu_opcode_addqt(void);
-static void gpu_opcode_sub(void);
-static void gpu_opcode_subc(void);
-static void gpu_opcode_subq(void);
-static void gpu_opcode_subqt(void);
-static void gpu_opcode_neg(void);
-static void gpu_opcode_and(void);
-static void gpu_opcode_or(void);
-static void gpu_opcode_xor(void);
-static void gpu_opcode_not(void);
-static void gpu_opcode_btst(void);
-static void gpu_opcode_bset(void);
-static void gpu_opcode_bclr(void);
-static void gpu_opcode_mult(void);
-static void gpu_opcode_imult(void);
-static void gpu_opcode_imultn(void);
-static void gpu_opcode_resmac(void);
-static void gpu_opcode_imacn(void);
-static void gpu_opcode_div(void);
-static void gpu_opcode_abs(void);
-static void gpu_opcode_sh(void);
-static void gpu_opcode_shlq(void);
-static void gpu_opcode_shrq(void);
-static void gpu_opcode_sha(void);
-static void gpu_opcode_sharq(void);
-static void gpu_opcode_ror(void);
-static void gpu_opcode_rorq(void);
-static void gpu_opcode_cmp(void);
-static void gpu_opcode_cmpq(void);
-static void gpu_opcode_sat8(void);
-static void gpu_opcode_sat16(void);
-static void gpu_opcode_move(void);
-static void gpu_opcode_moveq(void);
-static void gpu_opcode_moveta(void);
-static void gpu_opcode_movefa(void);
-static void gpu_opcode_movei(void);
-static void gpu_opcode_loadb(void);
-static void gpu_opcode_loadw(void);
-static void gpu_opcode_load(void);
-static void gpu_opcode_loadp(void);
-static void gpu_opcode_load_r14_indexed(void);
-static void gpu_opcode_load_r15_indexed(void);
-static void gpu_opcode_storeb(void);
-static void gpu_opcode_storew(void);
-static void gpu_opcode_store(void);
-static void gpu_opcode_storep(void);
-static void gpu_opcode_store_r14_indexed(void);
-static void gpu_opcode_store_r15_indexed(void);
-static void gpu_opcode_move_pc(void);
-static void gpu_opcode_jump(void);
-static void gpu_opcode_jr(void);
-static void gpu_opcode_mmult(void);
-static void gpu_opcode_mtoi(void);
-static void gpu_opcode_normi(void);
-static void gpu_opcode_nop(void);
-static void gpu_opcode_load_r14_ri(void);
-static void gpu_opcode_load_r15_ri(void);
-static void gpu_opcode_store_r14_ri(void);
-static void gpu_opcode_store_r15_ri(void);
-static void gpu_opcode_sat24(void);
-static void gpu_opcode_pack(void);
-
 // This is wrong, since it doesn't take pipeline effects into account. !!! FIX !!!
 /*uint8_t gpu_opcode_cycles[64] =
 {
@@ -290,50 +241,35 @@ uint8_t gpu_opcode_cycles[64] =
 	1,  1,  1,  1,  1,  1,  1,  1
 };//*/
 
-void (*gpu_opcode[64])()=
-{
-	gpu_opcode_add,					gpu_opcode_addc,				gpu_opcode_addq,				gpu_opcode_addqt,
-	gpu_opcode_sub,					gpu_opcode_subc,				gpu_opcode_subq,				gpu_opcode_subqt,
-	gpu_opcode_neg,					gpu_opcode_and,					gpu_opcode_or,					gpu_opcode_xor,
-	gpu_opcode_not,					gpu_opcode_btst,				gpu_opcode_bset,				gpu_opcode_bclr,
-	gpu_opcode_mult,				gpu_opcode_imult,				gpu_opcode_imultn,				gpu_opcode_resmac,
-	gpu_opcode_imacn,				gpu_opcode_div,					gpu_opcode_abs,					gpu_opcode_sh,
-	gpu_opcode_shlq,				gpu_opcode_shrq,				gpu_opcode_sha,					gpu_opcode_sharq,
-	gpu_opcode_ror,					gpu_opcode_rorq,				gpu_opcode_cmp,					gpu_opcode_cmpq,
-	gpu_opcode_sat8,				gpu_opcode_sat16,				gpu_opcode_move,				gpu_opcode_moveq,
-	gpu_opcode_moveta,				gpu_opcode_movefa,				gpu_opcode_movei,				gpu_opcode_loadb,
-	gpu_opcode_loadw,				gpu_opcode_load,				gpu_opcode_loadp,				gpu_opcode_load_r14_indexed,
-	gpu_opcode_load_r15_indexed,	gpu_opcode_storeb,				gpu_opcode_storew,				gpu_opcode_store,
-	gpu_opcode_storep,				gpu_opcode_store_r14_indexed,	gpu_opcode_store_r15_indexed,	gpu_opcode_move_pc,
-	gpu_opcode_jump,				gpu_opcode_jr,					gpu_opcode_mmult,				gpu_opcode_mtoi,
-	gpu_opcode_normi,				gpu_opcode_nop,					gpu_opcode_load_r14_ri,			gpu_opcode_load_r15_ri,
-	gpu_opcode_store_r14_ri,		gpu_opcode_store_r15_ri,		gpu_opcode_sat24,				gpu_opcode_pack,
-};
-
-static uint8_t gpu_ram_8[0x1000];
-uint32_t gpu_pc;
-static uint32_t gpu_acc;
-static uint32_t gpu_remain;
-static uint32_t gpu_hidata;
-static uint32_t gpu_flags;
-static uint32_t gpu_matrix_control;
-static uint32_t gpu_pointer_to_matrix;
-static uint32_t gpu_data_organization;
-static uint32_t gpu_control;
-static uint32_t gpu_div_control;
-// There is a distinct advantage to having these separated out--there's no need
+// GPU state lives in the machine context (see gpu.h)
+// There is a distinct advantage to having the flags separated out--there's no need
 // to clear a bit before writing a result. I.e., if the result of an operation
 // leaves a zero in the carry flag, you don't have to zero gpu_flag_c before
 // you can write that zero!
-static uint8_t gpu_flag_z, gpu_flag_n, gpu_flag_c;
-uint32_t gpu_reg_bank_0[32];
-uint32_t gpu_reg_bank_1[32];
-static uint32_t * gpu_reg;
-static uint32_t * gpu_alternate_reg;
-
-static uint32_t gpu_instruction;
-static uint32_t gpu_opcode_first_parameter;
-static uint32_t gpu_opcode_second_parameter;
+#define gpu_ram_8				(jaguarMachine->gpu.gpu_ram_8)
+#define gpu_pc					(jaguarMachine->gpu.gpu_pc)
+#define gpu_acc					(jaguarMachine->gpu.gpu_acc)
+#define gpu_remain				(jaguarMachine->gpu.gpu_remain)
+#define gpu_hidata				(jaguarMachine->gpu.gpu_hidata)
+#define gpu_flags				(jaguarMachine->gpu.gpu_flags)
+#define gpu_matrix_control		(jaguarMachine->gpu.gpu_matrix_control)
+#define gpu_pointer_to_matrix	(jaguarMachine->gpu.gpu_pointer_to_matrix)
+#define gpu_data_organization	(jaguarMachine->gpu.gpu_data_organization)
+#define gpu_control				(jaguarMachine->gpu.gpu_control)
+#define gpu_div_control			(jaguarMachine->gpu.gpu_div_control)
+#define gpu_flag_z				(jaguarMachine->gpu.gpu_flag_z)
+#define gpu_flag_n				(jaguarMachine->gpu.gpu_flag_n)
+#define gpu_flag_c				(jaguarMachine->gpu.gpu_flag_c)
+#define gpu_reg					(jaguarMachine->gpu.gpu_reg)
+#define gpu_alternate_reg		(jaguarMachine->gpu.gpu_alternate_reg)
+#define gpu_instruction			(jaguarMachine->gpu.gpu_instruction)
+#define gpu_opcode_first_parameter	(jaguarMachine->gpu.gpu_opcode_first_parameter)
+#define gpu_opcode_second_parameter	(jaguarMachine->gpu.gpu_opcode_second_parameter)
+#define gpu_opcode_use			(jaguarMachine->gpu.gpu_opcode_use)
+#define gpu_in_exec				(jaguarMachine->gpu.gpu_in_exec)
+#define gpu_releaseTimeSlice_flag	(jaguarMachine->gpu.gpu_releaseTimeSlice_flag)
+#define gpuIRQPending			(jaguarMachine->gpu.gpuIRQPending)
+#define tripwire				(jaguarMachine->gpu.tripwire)
 
 #define GPU_RUNNING		(gpu_control & 0x01)
 
@@ -368,8 +304,6 @@ uint32_t gpu_convert_zero[32] =
 uint8_t * branch_condition_table = 0;
 #define BRANCH_CONDITION(x)	branch_condition_table[(x) + ((jaguar_flags & 7) << 5)]
 
-uint32_t gpu_opcode_use[64];
-
 const char * gpu_opcode_str[64]=
 {
 	"add",				"addc",				"addq",				"addqt",
@@ -390,9 +324,6 @@ const char * gpu_opcode_str[64]=
 	"store_r14_ri",		"store_r15_ri",		"sat24",			"pack",
 };
 
-static uint32_t gpu_in_exec = 0;
-static uint32_t gpu_releaseTimeSlice_flag = 0;
-
 void GPUReleaseTimeslice(void)
 {
 	gpu_releaseTimeSlice_flag = 1;
@@ -440,11 +371,373 @@ void build_branch_condition_table(void)
 	}
 }
 
+//
+// Threaded GPU support
+//
+// The GPU can run its slice on a host thread of its own, while the 68K runs the
+// same slice on the emulation thread. In the serial mode the 68K executes the
+// whole slice first, then the GPU; we keep that ordering this way:
+//  - The GPU thread runs freely as long as it only touches its local RAM and
+//    registers. Any other access (DRAM, TOM, JERRY, IRQ lines...) makes it wait
+//    until the 68K is done with its slice.
+//  - Every local RAM write done before that point is recorded in an undo log.
+//  - If another host thread touches the GPU (68K reading a semaphore in GPU
+//    RAM, blitter IRQ, DSP on the host audio thread, etc.) while the GPU is
+//    ahead, the GPU slice is aborted,
+//    the GPU state is restored from the snapshot & the undo log, and the slice
+//    is executed serially once the 68K is done.
+//
+enum { GPU_SLICE_IDLE = 0, GPU_SLICE_START, GPU_SLICE_RUNNING, GPU_SLICE_DONE };
+
+#define gpuThread				(jaguarMachine->gpu.gpuThread)
+#define gpuMutex				(jaguarMachine->gpu.gpuMutex)
+#define gpuCond					(jaguarMachine->gpu.gpuCond)
+#define gpuThreadQuit			(jaguarMachine->gpu.gpuThreadQuit)
+#define gpuSliceState			(jaguarMachine->gpu.gpuSliceState)
+#define gpuSliceCycles			(jaguarMachine->gpu.gpuSliceCycles)
+#define gpuSliceActive			(jaguarMachine->gpu.gpuSliceActive)
+#define gpuSliceRewound			(jaguarMachine->gpu.gpuSliceRewound)
+#define gpuM68KDone				(jaguarMachine->gpu.gpuM68KDone)
+#define gpuSliceAbort			(jaguarMachine->gpu.gpuSliceAbort)
+#define gpuBusGranted			(jaguarMachine->gpu.gpuBusGranted)
+#define gpuSnapshot				(jaguarMachine->gpu.gpuSnapshot)
+#define gpuUndoLog				(jaguarMachine->gpu.gpuUndoLog)
+#define gpuUndoCount			(jaguarMachine->gpu.gpuUndoCount)
+#define gpuSliceCount			(jaguarMachine->gpu.gpuSliceCount)
+#define gpuRewindCount			(jaguarMachine->gpu.gpuRewindCount)
+#define gpuIdleSkip				(jaguarMachine->gpu.gpuIdleSkip)
+#define gpuIdleProbe			(jaguarMachine->gpu.gpuIdleProbe)
+#define gpuIdlePure				(jaguarMachine->gpu.gpuIdlePure)
+#define gpuIdlePC				(jaguarMachine->gpu.gpuIdlePC)
+#define gpuIdleFailPC			(jaguarMachine->gpu.gpuIdleFailPC)
+#define gpuIdleCycles			(jaguarMachine->gpu.gpuIdleCycles)
+#define gpuIdleFlags			(jaguarMachine->gpu.gpuIdleFlags)
+#define gpuIdleRegs				(jaguarMachine->gpu.gpuIdleRegs)
+
+static bool GPUSyncBus(void);
+
+#ifndef NO_SDL
+static int GPUThreadFunc(void *);
+
+// Set on the GPU host threads (one by machine, running its GPU only)
+static THREAD_LOCAL bool gpuHostThread = false;
+
+#define GPU_ON_THREAD	(gpuSliceActive && gpuHostThread)
+
+//
+// Create the GPU host thread
+//
+static bool GPUThreadInit(void)
+{
+	gpuMutex = SDL_CreateMutex();
+	gpuCond = SDL_CreateCond();
+
+	if (gpuMutex && gpuCond)
+	{
+		gpuThreadQuit = false;
+		gpuSliceState = GPU_SLICE_IDLE;
+		gpuSliceCount = gpuRewindCount = 0;
+
+		if ((gpuThread = SDL_CreateThread(GPUThreadFunc, jaguarMachine)))
+		{
+			WriteLog("GPU: Host thread started\n");
+			return true;
+		}
+	}
+
+	WriteLog("GPU: Unable to start the host thread (%s), GPU will run serially\n", SDL_GetError());
+
+	if (gpuCond)
+		SDL_DestroyCond(gpuCond);
+
+	if (gpuMutex)
+		SDL_DestroyMutex(gpuMutex);
+
+	gpuCond = NULL;
+	gpuMutex = NULL;
+	return false;
+}
+
+//
+// Stop & destroy the GPU host thread
+//
+static void GPUThreadDone(void)
+{
+	if (!gpuThread)
+		return;
+
+	SDL_LockMutex(gpuMutex);
+	gpuThreadQuit = true;
+	SDL_CondBroadcast(gpuCond);
+	SDL_UnlockMutex(gpuMutex);
+	SDL_WaitThread(gpuThread, NULL);
+	SDL_DestroyCond(gpuCond);
+	SDL_DestroyMutex(gpuMutex);
+	gpuThread = NULL;
+	gpuCond = NULL;
+	gpuMutex = NULL;
+
+	WriteLog("GPU: Host thread stopped (%u slices, %u rewound)\n", gpuSliceCount, gpuRewindCount);
+}
+
+//
+// GPU host thread: execute the slices requested by GPUExecAsync()
+//
+static int GPUThreadFunc(void * data)
+{
+	// The GPU thread runs the GPU of the machine that has started it
+	JaguarMachineSetCurrent((JaguarMachine *)data);
+
+	gpuHostThread = true;
+	SDL_LockMutex(gpuMutex);
+
+	while (true)
+	{
+		while ((gpuSliceState != GPU_SLICE_START) && !gpuThreadQuit)
+			SDL_CondWait(gpuCond, gpuMutex);
+
+		if (gpuThreadQuit)
+			break;
+
+		gpuSliceState = GPU_SLICE_RUNNING;
+		gpuBusGranted = false;
+		SDL_UnlockMutex(gpuMutex);
+
+		GPUExec(gpuSliceCycles);
+
+		SDL_LockMutex(gpuMutex);
+		gpuSliceState = GPU_SLICE_DONE;
+		SDL_CondBroadcast(gpuCond);
+	}
+
+	SDL_UnlockMutex(gpuMutex);
+	return 0;
+}
+
+//
+// Called by the GPU thread before any access outside the GPU; wait for the 68K
+// to finish its slice. Returns false if the slice has been aborted meanwhile, in
+// which case the access must not be done.
+//
+static bool GPUSyncBus(void)
+{
+	if (!GPU_ON_THREAD || gpuBusGranted)
+		return true;
+
+	SDL_LockMutex(gpuMutex);
+
+	while (!gpuM68KDone && !gpuSliceAbort)
+		SDL_CondWait(gpuCond, gpuMutex);
+
+	gpuBusGranted = !gpuSliceAbort;
+	SDL_UnlockMutex(gpuMutex);
+
+	return gpuBusGranted;
+}
+#else
+// Without SDL, there is no GPU host thread and the GPU always runs serially
+#define GPU_ON_THREAD	false
+
+static void GPUThreadDone(void)
+{
+}
+
+static bool GPUSyncBus(void)
+{
+	return true;
+}
+#endif
+
+//
+// Keep the old contents of a GPU RAM long, so the slice can be rewound
+//
+static inline void GPUUndoSave(uint32_t offset)
+{
+	offset &= 0xFFC;
+
+	// When the log is full, stop running ahead of the 68K
+	if ((gpuUndoCount == GPU_UNDO_LOG_SIZE) && !GPUSyncBus())
+		return;
+
+	if (!gpuBusGranted)
+	{
+		gpuUndoLog[gpuUndoCount].offset = offset;
+		gpuUndoLog[gpuUndoCount++].data = GET32(gpu_ram_8, offset);
+	}
+}
+
+#define GPU_UNDO_SAVE(o, n)	if (GPU_ON_THREAD && !gpuBusGranted) \
+	{ GPUUndoSave(o); if (((o) & 0xFFC) != (((o) + (n) - 1) & 0xFFC)) GPUUndoSave((o) + (n) - 1); }
+
+#ifndef NO_SDL
+//
+// Abort the running GPU slice and put the GPU back in its state from the slice start
+// The GPU is put back under the lock, as several threads may want to rewind the slice;
+// once the 68K is done, the GPU runs as it would serially, and is left running
+//
+static void GPURewindSlice(void)
+{
+	SDL_LockMutex(gpuMutex);
+
+	if (!gpuSliceActive || gpuM68KDone)
+	{
+		SDL_UnlockMutex(gpuMutex);
+		return;
+	}
+
+	gpuSliceAbort = true;
+	SDL_CondBroadcast(gpuCond);
+
+	while (gpuSliceState != GPU_SLICE_DONE)
+		SDL_CondWait(gpuCond, gpuMutex);
+
+	gpuSliceAbort = false;
+
+	while (gpuUndoCount)
+	{
+		gpuUndoCount--;
+		SET32(gpu_ram_8, gpuUndoLog[gpuUndoCount].offset, gpuUndoLog[gpuUndoCount].data);
+	}
+
+	gpu_pc = gpuSnapshot.pc;
+	gpu_acc = gpuSnapshot.acc;
+	gpu_remain = gpuSnapshot.remain;
+	gpu_hidata = gpuSnapshot.hidata;
+	gpu_flags = gpuSnapshot.flags;
+	gpu_matrix_control = gpuSnapshot.matrix_control;
+	gpu_pointer_to_matrix = gpuSnapshot.pointer_to_matrix;
+	gpu_data_organization = gpuSnapshot.data_organization;
+	gpu_control = gpuSnapshot.control;
+	gpu_div_control = gpuSnapshot.div_control;
+	gpu_flag_z = gpuSnapshot.flag_z;
+	gpu_flag_n = gpuSnapshot.flag_n;
+	gpu_flag_c = gpuSnapshot.flag_c;
+	gpu_instruction = gpuSnapshot.instruction;
+	gpu_releaseTimeSlice_flag = gpuSnapshot.releaseTimeSlice_flag;
+	tripwire = gpuSnapshot.tripwireSet;
+	memcpy(gpu_reg_bank_0, gpuSnapshot.reg_bank_0, sizeof(gpu_reg_bank_0));
+	memcpy(gpu_reg_bank_1, gpuSnapshot.reg_bank_1, sizeof(gpu_reg_bank_1));
+	memcpy(gpu_opcode_use, gpuSnapshot.opcode_use, sizeof(gpu_opcode_use));
+	GPUUpdateRegisterBanks();
+	GPUUpdateIRQPending();
+
+	gpuSliceActive = false;
+	gpuSliceRewound = true;
+	gpuRewindCount++;
+	SDL_UnlockMutex(gpuMutex);
+}
+
+//
+// Called on every access to the GPU from outside; if it comes from another host
+// thread than the GPU one (the 68K one, or the DSP one) while the GPU thread is
+// ahead, the GPU slice has to be rewound
+//
+static inline void GPUCheckConflict(void)
+{
+	if (gpuSliceActive && !gpuHostThread)
+		GPURewindSlice();
+}
+
+//
+// Start the GPU slice on the GPU host thread
+// Returns false if the slice has to be executed with GPUExec()
+//
+bool GPUExecAsync(int32_t cycles)
+{
+	if (!GPU_RUNNING || gpuSliceActive)
+		return false;
+
+	if (!gpuThread && !GPUThreadInit())
+		return false;
+
+	gpuSnapshot.pc = gpu_pc;
+	gpuSnapshot.acc = gpu_acc;
+	gpuSnapshot.remain = gpu_remain;
+	gpuSnapshot.hidata = gpu_hidata;
+	gpuSnapshot.flags = gpu_flags;
+	gpuSnapshot.matrix_control = gpu_matrix_control;
+	gpuSnapshot.pointer_to_matrix = gpu_pointer_to_matrix;
+	gpuSnapshot.data_organization = gpu_data_organization;
+	gpuSnapshot.control = gpu_control;
+	gpuSnapshot.div_control = gpu_div_control;
+	gpuSnapshot.flag_z = gpu_flag_z;
+	gpuSnapshot.flag_n = gpu_flag_n;
+	gpuSnapshot.flag_c = gpu_flag_c;
+	gpuSnapshot.instruction = gpu_instruction;
+	gpuSnapshot.releaseTimeSlice_flag = gpu_releaseTimeSlice_flag;
+	gpuSnapshot.tripwireSet = tripwire;
+	memcpy(gpuSnapshot.reg_bank_0, gpu_reg_bank_0, sizeof(gpu_reg_bank_0));
+	memcpy(gpuSnapshot.reg_bank_1, gpu_reg_bank_1, sizeof(gpu_reg_bank_1));
+	memcpy(gpuSnapshot.opcode_use, gpu_opcode_use, sizeof(gpu_opcode_use));
+	gpuUndoCount = 0;
+
+	SDL_LockMutex(gpuMutex);
+	gpuSliceCycles = cycles;
+	gpuSliceAbort = false;
+	gpuSliceRewound = false;
+	gpuM68KDone = false;
+	gpuSliceActive = true;
+	gpuSliceState = GPU_SLICE_START;
+	SDL_CondBroadcast(gpuCond);
+	SDL_UnlockMutex(gpuMutex);
+
+	gpuSliceCount++;
+	return true;
+}
+
+//
+// Let the GPU thread finish its slice, once the 68K is done with its own
+//
+void GPUExecAsyncWait(void)
+{
+	SDL_LockMutex(gpuMutex);
+
+	if (gpuSliceState == GPU_SLICE_IDLE)
+	{
+		SDL_UnlockMutex(gpuMutex);
+		return;
+	}
+
+	gpuM68KDone = true;
+	SDL_CondBroadcast(gpuCond);
+
+	while (gpuSliceState != GPU_SLICE_DONE)
+		SDL_CondWait(gpuCond, gpuMutex);
+
+	gpuSliceState = GPU_SLICE_IDLE;
+	gpuSliceActive = false;
+	SDL_UnlockMutex(gpuMutex);
+
+	// The slice has been thrown away, so run it the serial way
+	if (gpuSliceRewound)
+	{
+		gpuSliceRewound = false;
+		GPUExec(gpuSliceCycles);
+	}
+}
+#else
+static inline void GPUCheckConflict(void)
+{
+}
+
+bool GPUExecAsync(int32_t cycles)
+{
+	return false;
+}
+
+void GPUExecAsyncWait(void)
+{
+}
+#endif
+
 //
 // GPU byte access (read)
 //
 uint8_t GPUReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
+	if (gpuSliceActive && (who != GPU))
+		GPUCheckConflict();
+
 	if (offset >= 0xF02000 && offset <= 0xF020FF)
 		WriteLog("GPU: ReadByte--Attempt to read from GPU register file by %s!\n", whoName[who]);
 
@@ -464,6 +757,9 @@ uint8_t GPUReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 			return data & 0xFF;
 	}
 
+	if (gpuSliceActive && !GPUSyncBus())
+		return 0;
+
 	return JaguarReadByte(offset, who);
 }
 
@@ -472,14 +768,16 @@ uint8_t GPUReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 //
 uint16_t GPUReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
+	if (gpuSliceActive && (who != GPU))
+		GPUCheckConflict();
+
 	if (offset >= 0xF02000 && offset <= 0xF020FF)
 		WriteLog("GPU: ReadWord--Attempt to read from GPU register file by %s!\n", whoName[who]);
 
 	if ((offset >= GPU_WORK_RAM_BASE) && (offset < GPU_WORK_RAM_BASE+0x1000))
 	{
 		offset &= 0xFFF;
-		uint16_t data = ((uint16_t)gpu_ram_8[offset] << 8) | (uint16_t)gpu_ram_8[offset+1];
-		return data;
+		return GET16(gpu_ram_8, offset);
 	}
 	else if ((offset >= GPU_CONTROL_RAM_BASE) && (offset < GPU_CONTROL_RAM_BASE+0x20))
 	{
@@ -500,6 +798,9 @@ uint16_t GPUReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 //if (offset >= 0xF0B000 && offset <= 0xF0BFFF)
 //WriteLog("[GPUR16] --> Possible GPU RAM mirror access by %s!", whoName[who]);
 
+	if (gpuSliceActive && !GPUSyncBus())
+		return 0;
+
 	return JaguarReadWord(offset, who);
 }
 
@@ -508,6 +809,9 @@ uint16_t GPUReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 //
 uint32_t GPUReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
+	if (gpuSliceActive && (who != GPU))
+		GPUCheckConflict();
+
 	if (offset >= 0xF02000 && offset <= 0xF020FF)
 	{
 		WriteLog("GPU: ReadLong--Attempt to read from GPU register file (%X) by %s!\n", offset, whoName[who]);
@@ -519,9 +823,7 @@ uint32_t GPUReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 	if ((offset >= GPU_WORK_RAM_BASE) && (offset <= GPU_WORK_RAM_BASE + 0x0FFC))
 	{
 		offset &= 0xFFF;
-		return ((uint32_t)gpu_ram_8[offset] << 24) | ((uint32_t)gpu_ram_8[offset+1] << 16)
-			| ((uint32_t)gpu_ram_8[offset+2] << 8) | (uint32_t)gpu_ram_8[offset+3];//*/
-//		return GET32(gpu_ram_8, offset);
+		return GET32(gpu_ram_8, offset);
 	}
 //	else if ((offset >= GPU_CONTROL_RAM_BASE) && (offset < GPU_CONTROL_RAM_BASE+0x20))
 	else if ((offset >= GPU_CONTROL_RAM_BASE) && (offset <= GPU_CONTROL_RAM_BASE + 0x1C))
@@ -564,6 +866,9 @@ uint32_t GPUReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 /*if (offset >= 0xF1D000 && offset <= 0xF1DFFF)
 	WriteLog("[GPUR32] --> Reading from Wavetable ROM!\n");//*/
 
+	if (gpuSliceActive && !GPUSyncBus())
+		return 0;
+
 	return (JaguarReadWord(offset, who) << 16) | JaguarReadWord(offset + 2, who);
 }
 
@@ -572,12 +877,17 @@ uint32_t GPUReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 //
 void GPUWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 {
+	if (gpuSliceActive && (who != GPU))
+		GPUCheckConflict();
+
 	if (offset >= 0xF02000 && offset <= 0xF020FF)
 		WriteLog("GPU: WriteByte--Attempt to write to GPU register file by %s!\n", whoName[who]);
 
 	if ((offset >= GPU_WORK_RAM_BASE) && (offset <= GPU_WORK_RAM_BASE + 0x0FFF))
 	{
+		GPU_UNDO_SAVE(offset & 0xFFF, 1);
 		gpu_ram_8[offset & 0xFFF] = data;
+		M68K_CODE_WRITE(offset);				// For the disassembly cache
 
 //This is the same stupid worthless code that was in the DSP!!! AARRRGGGGHHHHH!!!!!!
 /*		if (!gpu_in_exec)
@@ -605,6 +915,9 @@ void GPUWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 		return;
 	}
 //	WriteLog("gpu: writing %.2x at 0x%.8x\n",data,offset);
+	if (gpuSliceActive && !GPUSyncBus())
+		return;
+
 	JaguarWriteByte(offset, data, who);
 }
 
@@ -613,15 +926,18 @@ void GPUWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 //
 void GPUWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 {
+	if (gpuSliceActive && (who != GPU))
+		GPUCheckConflict();
+
 	if (offset >= 0xF02000 && offset <= 0xF020FF)
 		WriteLog("GPU: WriteWord--Attempt to write to GPU register file by %s!\n", whoName[who]);
 
 	if ((offset >= GPU_WORK_RAM_BASE) && (offset <= GPU_WORK_RAM_BASE + 0x0FFE))
 	{
-		gpu_ram_8[offset & 0xFFF] = (data>>8) & 0xFF;
-		gpu_ram_8[(offset+1) & 0xFFF] = data & 0xFF;//*/
-/*		offset &= 0xFFF;
-		SET16(gpu_ram_8, offset, data);//*/
+		GPU_UNDO_SAVE(offset & 0xFFF, 2);
+		M68K_CODE_WRITE(offset);				// For the disassembly cache
+		offset &= 0xFFF;
+		SET16(gpu_ram_8, offset, data);
 
 /*if (offset >= 0xF03214 && offset < 0xF0321F)
 	WriteLog("GPU: Writing WORD (%04X) to GPU RAM (%08X)...\n", data, offset);//*/
@@ -679,6 +995,9 @@ void GPUWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 		return;
 	}
 
+	if (gpuSliceActive && !GPUSyncBus())
+		return;
+
 	// Have to be careful here--this can cause an infinite loop!
 	JaguarWriteWord(offset, data, who);
 }
@@ -688,6 +1007,9 @@ void GPUWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 //
 void GPUWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 {
+	if (gpuSliceActive && (who != GPU))
+		GPUCheckConflict();
+
 	if (offset >= 0xF02000 && offset <= 0xF020FF)
 		WriteLog("GPU: WriteLong--Attempt to write to GPU register file by %s!\n", whoName[who]);
 
@@ -702,7 +1024,9 @@ void GPUWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 		}
 #endif	// GPU_DEBUG
 
+		M68K_CODE_WRITE(offset);				// For the disassembly cache
 		offset &= 0xFFF;
+		GPU_UNDO_SAVE(offset, 4);
 		SET32(gpu_ram_8, offset, data);
 		return;
 	}
@@ -723,6 +1047,7 @@ void GPUWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 			gpu_flag_n = (gpu_flags & NEGA_FLAG) >> 2;
 			GPUUpdateRegisterBanks();
 			gpu_control &= ~((gpu_flags & CINT04FLAGS) >> 3);	// Interrupt latch clear bits
+			GPUUpdateIRQPending();
 //Writing here is only an interrupt enable--this approach is just plain wrong!
 //			GPUHandleIRQs();
 //This, however, is A-OK! ;-)
@@ -753,6 +1078,10 @@ WriteLog("GPU: %s setting GPU PC to %08X %s\n", whoName[who], gpu_pc, (GPU_RUNNI
 			break;
 		case 0x14:
 		{
+			// Interrupts & time slice handling reach the 68K & the DSP
+			if (gpuSliceActive && !GPUSyncBus())
+				return;
+
 //			uint32_t gpu_was_running = GPU_RUNNING;
 			data &= ~0xF7C0;		// Disable writes to INT_LAT0-4 & TOM version number
 
@@ -926,6 +1255,9 @@ if (GPU_RUNNING && effect_start5 && gpu_pc == 0xF035D8)
 //	JaguarWriteWord(offset, (data >> 16) & 0xFFFF, who);
 //	JaguarWriteWord(offset+2, data & 0xFFFF, who);
 // We're a 32-bit processor, we can do a long write...!
+	if (gpuSliceActive && !GPUSyncBus())
+		return;
+
 	JaguarWriteLong(offset, data, who);
 }
 
@@ -945,17 +1277,21 @@ void GPUUpdateRegisterBanks(void)
 		gpu_reg = gpu_reg_bank_0, gpu_alternate_reg = gpu_reg_bank_1;
 }
 
-void GPUHandleIRQs(void)
+//
+// Interrupts which can be taken: latched & enabled, when not in an interrupt already.
+// Only updated when the latches, the enables or IMASK change, so the GPU looks at
+// nothing else to know if it has to take an interrupt.
+//
+void GPUUpdateIRQPending(void)
 {
-	// Bail out if we're already in an interrupt!
-	if (gpu_flags & IMASK)
-		return;
+	gpuIRQPending = ((gpu_flags & IMASK) ? 0 : ((gpu_control >> 6) & (gpu_flags >> 4) & 0x1F));
+}
 
-	// Get the interrupt latch & enable bits
-	uint32_t bits = (gpu_control >> 6) & 0x1F, mask = (gpu_flags >> 4) & 0x1F;
+void GPUHandleIRQs(void)
+{
+	// Bail out if we're already in an interrupt, or if latched interrupts aren't enabled
+	uint32_t bits = gpuIRQPending;
 
-	// Bail out if latched interrupts aren't enabled
-	bits &= mask;
 	if (!bits)
 		return;
 
@@ -975,8 +1311,12 @@ void GPUHandleIRQs(void)
 	if (start_logging)
 		WriteLog("GPU: Generating IRQ #%i\n", which);
 
+	if (TRACE_ACTIVE)
+		TraceMarker(TRACE_GPU, TRACE_INTERRUPT, which, gpu_pc);
+
 	// set the interrupt flag
 	gpu_flags |= IMASK;
+	gpuIRQPending = 0;
 	GPUUpdateRegisterBanks();
 
 	// subqt  #4,r31		; pre-decrement stack pointer
@@ -996,14 +1336,19 @@ void GPUSetIRQLine(int irqline, int state)
 	if (start_logging)
 		WriteLog("GPU: Setting GPU IRQ line #%i\n", irqline);
 
+	if (gpuSliceActive)
+		GPUCheckConflict();
+
 	uint32_t mask = 0x0040 << irqline;
 	gpu_control &= ~mask;				// Clear the interrupt latch
 
 	if (state)
-	{
 		gpu_control |= mask;			// Assert the interrupt latch
+
+	GPUUpdateIRQPending();
+
+	if (state)
 		GPUHandleIRQs();				// And handle the interrupt...
-	}
 }
 
 //TEMPORARY: Testing only!
@@ -1034,6 +1379,7 @@ void GPUReset(void)
 	gpu_data_organization = 0xFFFFFFFF;
 	gpu_pc				  = 0x00F03000;
 	gpu_control			  = 0x00002800;			// Correctly sets this as TOM Rev. 2
+	gpuIRQPending		  = 0;
 	gpu_hidata			  = 0x00000000;
 	gpu_remain			  = 0x00000000;			// These two registers are RO/WO
 	gpu_div_control		  = 0x00000000;
@@ -1123,6 +1469,8 @@ void GPUDumpMemory(void)
 
 void GPUDone(void)
 {
+	GPUThreadDone();
+
 	WriteLog("\n\n---------------------------------------------------------------------\n");
 	WriteLog("GPU I/O Registers\n");
 	WriteLog("---------------------------------------------------------------------\n");
@@ -1156,1530 +1504,511 @@ void GPUDone(void)
 }
 
 
+void GPUSetIdleSkip(bool enable)
+{
+	gpuIdleSkip = enable;
+}
+
+
 //
-// Main GPU execution core
+// Idle loops
 //
-static int testCount = 1;
-static int len = 0;
-static bool tripwire = false;
-void GPUExec(int32_t cycles)
+// A short backward jump starts the check of the next iteration, which has to only
+// write registers, and read memory without side effect. If the GPU is back in the
+// same state, the next iterations would do the same up to the end of the time slice,
+// as the 68K & the blitter do not run meanwhile, and they are skipped. It is not done
+// on the GPU host thread, as the 68K may be writing what the GPU is waiting for. A write
+// of the DSP, run by the host audio thread, is seen at the next time slice, a halfline at most.
+//
+#define GPU_IDLE_LOOP_SIZE		32				// Bytes, back from the jump
+#define GPU_IDLE_FLAGS			((gpu_flags & ~0x07) | ((gpu_flag_n ? 1 : 0) << 2) | ((gpu_flag_c ? 1 : 0) << 1) | (gpu_flag_z ? 1 : 0))
+
+// 0: Writes memory or uses a state not saved with the registers, 1: Registers only, 2: Load
+static const uint8_t gpu_idle_opcode[64] =
 {
-	if (!GPU_RUNNING)
-		return;
+	1,  1,  1,  1,  1,  1,  1,  1,
+	1,  1,  1,  1,  1,  1,  1,  1,
+	1,  1,  0,  0,  0,  1,  1,  1,
+	1,  1,  1,  1,  1,  1,  1,  1,
+	1,  1,  1,  1,  1,  1,  1,  2,
+	2,  2,  0,  2,  2,  0,  0,  0,
+	0,  0,  0,  1,  1,  1,  0,  1,
+	1,  1,  2,  2,  0,  0,  1,  1
+};
 
-#ifdef GPU_SINGLE_STEPPING
-	if (gpu_control & 0x18)
+//
+// Check an instruction about to be run by the iteration
+//
+static void GPUIdleCheck(uint32_t index)
+{
+	uint32_t address;
+
+	if (gpu_idle_opcode[index] != 2)
 	{
-		cycles = 1;
-		gpu_control &= ~0x10;
+		gpuIdlePure = gpuIdlePure && gpu_idle_opcode[index];
+		return;
 	}
-#endif
-	GPUHandleIRQs();
-	gpu_releaseTimeSlice_flag = 0;
-	gpu_in_exec++;
 
-	while (cycles > 0 && GPU_RUNNING)
+	switch (index)
 	{
-if (gpu_ram_8[0x054] == 0x98 && gpu_ram_8[0x055] == 0x0A && gpu_ram_8[0x056] == 0x03
-	&& gpu_ram_8[0x057] == 0x00 && gpu_ram_8[0x058] == 0x00 && gpu_ram_8[0x059] == 0x00)
+	case 43:									// load (r14+n), Rn
+		address = gpu_reg[14] + (gpu_convert_zero[IMM_1] << 2);
+		break;
+	case 44:									// load (r15+n), Rn
+		address = gpu_reg[15] + (gpu_convert_zero[IMM_1] << 2);
+		break;
+	case 58:									// load (r14+Rm), Rn
+		address = gpu_reg[14] + RM;
+		break;
+	case 59:									// load (r15+Rm), Rn
+		address = gpu_reg[15] + RM;
+		break;
+	default:									// loadb, loadw & load (Rm), Rn
+		address = RM;
+		break;
+	}
+
+	gpuIdlePure = gpuIdlePure && JaguarIsIdleRead(address);
+}
+
+
+//
+// Backward jump from pc; returns the cycles left in the time slice
+//
+static int32_t GPUIdleLoop(uint32_t pc, int32_t cycles)
 {
-	if (gpu_pc == 0xF03000)
+	if (((pc - gpu_pc) > GPU_IDLE_LOOP_SIZE) || (gpu_pc == gpuIdleFailPC) || gpuSliceActive)
+		return cycles;
+
+	if (gpuIdleProbe && (gpu_pc == gpuIdlePC))
 	{
-		extern uint32_t starCount;
-		starCount = 0;
-/*		WriteLog("GPU: Starting starfield generator... Dump of [R03=%08X]:\n", gpu_reg_bank_0[03]);
-		uint32_t base = gpu_reg_bank_0[3];
-		for(uint32_t i=0; i<0x100; i+=16)
+		int32_t iteration = gpuIdleCycles - cycles;
+		gpuIdleProbe = false;
+
+		if (!gpuIdlePure || (gpuIdleFlags != GPU_IDLE_FLAGS)
+			|| memcmp(gpuIdleRegs, gpu_reg_bank_0, 32 * sizeof(uint32_t)) || memcmp(gpuIdleRegs + 32, gpu_reg_bank_1, 32 * sizeof(uint32_t)))
 		{
-			WriteLog("%02X: ", i);
-			for(uint32_t j=0; j<16; j++)
-			{
-				WriteLog("%02X ", JaguarReadByte(base + i + j));
-			}
-			WriteLog("\n");
-		}*/
+			// Not idle, no need to check it again in this time slice
+			gpuIdleFailPC = gpu_pc;
+			return cycles;
+		}
+
+		// The last iteration, maybe not complete, is run as usual
+		if ((iteration > 0) && (cycles > iteration))
+		{
+			int32_t skipped = ((cycles - 1) / iteration) * iteration;
+			cycles -= skipped;
+			PERF_COUNT(gpu.idleCycles, skipped);
+
+			if (TRACE_ACTIVE)
+				TraceMarker(TRACE_GPU, TRACE_IDLE, gpu_pc, skipped);
+		}
+
+		return cycles;
 	}
-//	if (gpu_pc == 0xF03)
+
+	gpuIdleProbe = gpuIdlePure = true;
+	gpuIdlePC = gpu_pc;
+	gpuIdleCycles = cycles;
+	gpuIdleFlags = GPU_IDLE_FLAGS;
+	memcpy(gpuIdleRegs, gpu_reg_bank_0, 32 * sizeof(uint32_t));
+	memcpy(gpuIdleRegs + 32, gpu_reg_bank_1, 32 * sizeof(uint32_t));
+
+	return cycles;
+}
+
+
+//
+// GPU side of the RISC core (see risccore.h)
+//
+struct GPUUnit
+{
+	typedef uint32_t Accumulator;				// 32 bit MAC
+
+	static const bool hasModulo = false;
+	static const bool hasMirror = false;
+	static const bool hasSat16s = false;
+	static const bool absSetsAllFlags = true;	// ABS of $80000000 also sets C & clears Z
+
+	static inline uint32_t * Reg(void) { return gpu_reg; }
+	static inline uint32_t * AlternateReg(void) { return gpu_alternate_reg; }
+	static inline uint8_t & FlagZ(void) { return gpu_flag_z; }
+	static inline uint8_t & FlagN(void) { return gpu_flag_n; }
+	static inline uint8_t & FlagC(void) { return gpu_flag_c; }
+	static inline uint32_t & PC(void) { return gpu_pc; }
+	static inline Accumulator & Acc(void) { return gpu_acc; }
+	static inline uint32_t & Remain(void) { return gpu_remain; }
+	static inline uint32_t DivControl(void) { return gpu_div_control; }
+	static inline uint32_t MatrixControl(void) { return gpu_matrix_control; }
+	static inline uint32_t PointerToMatrix(void) { return gpu_pointer_to_matrix; }
+	static inline uint32_t ConvertZero(uint32_t imm) { return gpu_convert_zero[imm]; }
+	static inline bool BranchCondition(uint32_t cc, uint32_t flags) { return branch_condition_table[cc + ((flags & 7) << 5)]; }
+	static inline uint16_t ReadWord(uint32_t address) { return GPUReadWord(address, GPU); }
+
+	static inline bool Running(void)
 	{
+		return GPU_RUNNING && !gpuSliceAbort;
 	}
-}//*/
-/*if (gpu_pc == 0xF03B9E && gpu_reg_bank_0[01] == 0)
-{
-	GPUDumpRegisters();
-	WriteLog("GPU: Starting disassembly log...\n");
-	doGPUDis = true;
-}//*/
-/*if (gpu_pc == 0xF0359A)
-{
-	doGPUDis = true;
-	GPUDumpRegisters();
-}*/
-/*		gpu_flag_c = (gpu_flag_c ? 1 : 0);
-		gpu_flag_z = (gpu_flag_z ? 1 : 0);
-		gpu_flag_n = (gpu_flag_n ? 1 : 0);*/
-#if 0
-if (gpu_pc == 0xF03200)
-	doGPUDis = true;
-#endif
+
+	static inline uint32_t Fetch(void)
+	{
+		if (gpu_ram_8[0x054] == 0x98 && gpu_ram_8[0x055] == 0x0A && gpu_ram_8[0x056] == 0x03
+			&& gpu_ram_8[0x057] == 0x00 && gpu_ram_8[0x058] == 0x00 && gpu_ram_8[0x059] == 0x00
+			&& gpu_pc == 0xF03000)
+		{
+			extern uint32_t starCount;
+			starCount = 0;
+		}
 
 		uint16_t opcode = GPUReadWord(gpu_pc, GPU);
-		uint32_t index = opcode >> 10;
-		gpu_instruction = opcode;				// Added for GPU #3...
+		gpu_instruction = opcode;
+		// Kept for the idle loops check & the debugger
 		gpu_opcode_first_parameter = (opcode >> 5) & 0x1F;
 		gpu_opcode_second_parameter = opcode & 0x1F;
-/*if (gpu_pc == 0xF03BE8)
-WriteLog("Start of OP frame write...\n");
-if (gpu_pc == 0xF03EEE)
-WriteLog("--> Writing BRANCH object ---\n");
-if (gpu_pc == 0xF03F62)
-WriteLog("--> Writing BITMAP object ***\n");//*/
-/*if (gpu_pc == 0xF03546)
-{
-	WriteLog("\n--> GPU PC: F03546\n");
-	GPUDumpRegisters();
-	GPUDumpDisassembly();
-}//*/
-/*if (gpu_pc == 0xF033F6)
-{
-	WriteLog("\n--> GPU PC: F033F6\n");
-	GPUDumpRegisters();
-	GPUDumpDisassembly();
-}//*/
-/*if (gpu_pc == 0xF033CC)
-{
-	WriteLog("\n--> GPU PC: F033CC\n");
-	GPUDumpRegisters();
-	GPUDumpDisassembly();
-}//*/
-/*if (gpu_pc == 0xF033D6)
-{
-	WriteLog("\n--> GPU PC: F033D6 (#%d)\n", testCount++);
-	GPUDumpRegisters();
-	GPUDumpMemory();
-}//*/
-/*if (gpu_pc == 0xF033D8)
-{
-	WriteLog("\n--> GPU PC: F033D8 (#%d)\n", testCount++);
-	GPUDumpRegisters();
-	GPUDumpMemory();
-}//*/
-/*if (gpu_pc == 0xF0358E)
-{
-	WriteLog("\n--> GPU PC: F0358E (#%d)\n", testCount++);
-	GPUDumpRegisters();
-	GPUDumpMemory();
-}//*/
-/*if (gpu_pc == 0xF034CA)
-{
-	WriteLog("\n--> GPU PC: F034CA (#%d)\n", testCount++);
-	GPUDumpRegisters();
-}//*/
-/*if (gpu_pc == 0xF034CA)
-{
-	len = gpu_reg[1] + 4;//, r9save = gpu_reg[9];
-	WriteLog("\nAbout to subtract [#%d] (R14=%08X, R15=%08X, R9=%08X):\n   ", testCount++, gpu_reg[14], gpu_reg[15], gpu_reg[9]);
-	for(int i=0; i<len; i+=4)
-		WriteLog(" %08X", GPUReadLong(gpu_reg[15]+i));
-	WriteLog("\n   ");
-	for(int i=0; i<len; i+=4)
-		WriteLog(" %08X", GPUReadLong(gpu_reg[14]+i));
-	WriteLog("\n\n");
-}
-if (gpu_pc == 0xF034DE)
-{
-	WriteLog("\nSubtracted! (R14=%08X, R15=%08X):\n   ", gpu_reg[14], gpu_reg[15]);
-	for(int i=0; i<len; i+=4)
-		WriteLog(" %08X", GPUReadLong(gpu_reg[15]+i));
-	WriteLog("\n   ");
-	for(int i=0; i<len; i+=4)
-		WriteLog(" %08X", GPUReadLong(gpu_reg[14]+i));
-	WriteLog("\n   ");
-	for(int i=0; i<len; i+=4)
-		WriteLog(" --------");
-	WriteLog("\n   ");
-	for(int i=0; i<len; i+=4)
-		WriteLog(" %08X", GPUReadLong(gpu_reg[9]+4+i));
-	WriteLog("\n\n");
-}//*/
-/*if (gpu_pc == 0xF035C8)
-{
-	WriteLog("\n--> GPU PC: F035C8 (#%d)\n", testCount++);
-	GPUDumpRegisters();
-	GPUDumpDisassembly();
-}//*/
-
-if (gpu_start_log)
-{
-//	gpu_reset_stats();
-static char buffer[512];
-dasmjag(JAGUAR_GPU, buffer, gpu_pc);
-WriteLog("GPU: [%08X] %s (RM=%08X, RN=%08X) -> ", gpu_pc, buffer, RM, RN);
-}//*/
-//$E400 -> 1110 01 -> $39 -> 57
-//GPU #1
-		gpu_pc += 2;
-		gpu_opcode[index]();
-//GPU #2
-//		gpu2_opcode[index]();
-//		gpu_pc += 2;
-//GPU #3				(Doesn't show ATARI logo! #1 & #2 do...)
-//		gpu_pc += 2;
-//		gpu3_opcode[index]();
-
-// BIOS hacking
-//GPU: [00F03548] jr      nz,00F03560 (0xd561) (RM=00F03114, RN=00000004) ->     --> JR: Branch taken.
-/*static bool firstTime = true;
-if (gpu_pc == 0xF03548 && firstTime)
-{
-	gpu_flag_z = 1;
-//	firstTime = false;
-
-//static char buffer[512];
-//int k=0xF03548;
-//while (k<0xF0356C)
-//{
-//int oldk = k;
-//k += dasmjag(JAGUAR_GPU, buffer, k);
-//WriteLog("GPU: [%08X] %s\n", oldk, buffer);
-//}
-//	gpu_start_log = 1;
-}//*/
-//GPU: [00F0354C] jump    nz,(r29) (0xd3a1) (RM=00F03314, RN=00000004) -> (RM=00F03314, RN=00000004)
-/*if (gpu_pc == 0xF0354C)
-	gpu_flag_z = 0;//, gpu_start_log = 1;//*/
-
-		cycles -= gpu_opcode_cycles[index];
-		gpu_opcode_use[index]++;
-if (gpu_start_log)
-	WriteLog("(RM=%08X, RN=%08X)\n", RM, RN);//*/
-if ((gpu_pc < 0xF03000 || gpu_pc > 0xF03FFF) && !tripwire)
-{
-	WriteLog("GPU: Executing outside local RAM! GPU_PC: %08X\n", gpu_pc);
-	tripwire = true;
-}
-	}
-
-	gpu_in_exec--;
-}
-
-//
-// GPU opcodes
-//
-
-/*
-GPU opcodes use (offset punch--vertically below bad guy):
-	              add 18686
-	             addq 32621
-	              sub 7483
-	             subq 10252
-	              and 21229
-	               or 15003
-	             btst 1822
-	             bset 2072
-	             mult 141
-	              div 2392
-	             shlq 13449
-	             shrq 10297
-	            sharq 11104
-	              cmp 6775
-	             cmpq 5944
-	             move 31259
-	            moveq 4473
-	            movei 23277
-	            loadb 46
-	            loadw 4201
-	             load 28580
-	 load_r14_indexed 1183
-	 load_r15_indexed 1125
-	           storew 178
-	            store 10144
-	store_r14_indexed 320
-	store_r15_indexed 1
-	          move_pc 1742
-	             jump 24467
-	               jr 18090
-	              nop 41362
-*/
-
-
-static void gpu_opcode_jump(void)
-{
-#ifdef GPU_DIS_JUMP
-const char * condition[32] =
-{	"T", "nz", "z", "???", "nc", "nc nz", "nc z", "???", "c", "c nz",
-	"c z", "???", "???", "???", "???", "???", "???", "???", "???",
-	"???", "nn", "nn nz", "nn z", "???", "n", "n nz", "n z", "???",
-	"???", "???", "???", "F" };
-	if (doGPUDis)
-		WriteLog("%06X: JUMP   %s, (R%02u) [NCZ:%u%u%u, R%02u=%08X] ", gpu_pc-2, condition[IMM_2], IMM_1, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM);
-#endif
-	// normalize flags
-/*	gpu_flag_c = (gpu_flag_c ? 1 : 0);
-	gpu_flag_z = (gpu_flag_z ? 1 : 0);
-	gpu_flag_n = (gpu_flag_n ? 1 : 0);*/
-	// KLUDGE: Used by BRANCH_CONDITION
-	uint32_t jaguar_flags = (gpu_flag_n << 2) | (gpu_flag_c << 1) | gpu_flag_z;
-
-	if (BRANCH_CONDITION(IMM_2))
-	{
-#ifdef GPU_DIS_JUMP
-	if (doGPUDis)
-		WriteLog("Branched!\n");
-#endif
-if (gpu_start_log)
-	WriteLog("    --> JUMP: Branch taken.\n");
-		uint32_t delayed_pc = RM;
-		GPUExec(1);
-		gpu_pc = delayed_pc;
-/*		uint16_t opcode = GPUReadWord(gpu_pc, GPU);
-		gpu_opcode_first_parameter = (opcode >> 5) & 0x1F;
-		gpu_opcode_second_parameter = opcode & 0x1F;
-
-		gpu_pc = delayed_pc;
-		gpu_opcode[opcode>>10]();//*/
-	}
-#ifdef GPU_DIS_JUMP
-	else
-		if (doGPUDis)
-			WriteLog("Branch NOT taken.\n");
-#endif
-}
-
-
-static void gpu_opcode_jr(void)
-{
-#ifdef GPU_DIS_JR
-const char * condition[32] =
-{	"T", "nz", "z", "???", "nc", "nc nz", "nc z", "???", "c", "c nz",
-	"c z", "???", "???", "???", "???", "???", "???", "???", "???",
-	"???", "nn", "nn nz", "nn z", "???", "n", "n nz", "n z", "???",
-	"???", "???", "???", "F" };
-	if (doGPUDis)
-		WriteLog("%06X: JR     %s, %06X [NCZ:%u%u%u] ", gpu_pc-2, condition[IMM_2], gpu_pc+((IMM_1 & 0x10 ? 0xFFFFFFF0 | IMM_1 : IMM_1) * 2), gpu_flag_n, gpu_flag_c, gpu_flag_z);
-#endif
-/*	if (CONDITION(jaguar.op & 31))
-	{
-		int32_t r1 = (INT8)((jaguar.op >> 2) & 0xF8) >> 2;
-		uint32_t newpc = jaguar.PC + r1;
-		CALL_MAME_DEBUG;
-		jaguar.op = ROPCODE(jaguar.PC);
-		jaguar.PC = newpc;
-		(*jaguar.table[jaguar.op >> 10])();
-
-		jaguar_icount -= 3;	// 3 wait states guaranteed
-	}*/
-	// normalize flags
-/*	gpu_flag_n = (gpu_flag_n ? 1 : 0);
-	gpu_flag_c = (gpu_flag_c ? 1 : 0);
-	gpu_flag_z = (gpu_flag_z ? 1 : 0);*/
-	// KLUDGE: Used by BRANCH_CONDITION
-	uint32_t jaguar_flags = (gpu_flag_n << 2) | (gpu_flag_c << 1) | gpu_flag_z;
-
-	if (BRANCH_CONDITION(IMM_2))
-	{
-#ifdef GPU_DIS_JR
-	if (doGPUDis)
-		WriteLog("Branched!\n");
-#endif
-if (gpu_start_log)
-	WriteLog("    --> JR: Branch taken.\n");
-		int32_t offset = (IMM_1 & 0x10 ? 0xFFFFFFF0 | IMM_1 : IMM_1);		// Sign extend IMM_1
-		int32_t delayed_pc = gpu_pc + (offset * 2);
-		GPUExec(1);
-		gpu_pc = delayed_pc;
-/*		uint16_t opcode = GPUReadWord(gpu_pc, GPU);
-		gpu_opcode_first_parameter = (opcode >> 5) & 0x1F;
-		gpu_opcode_second_parameter = opcode & 0x1F;
-
-		gpu_pc = delayed_pc;
-		gpu_opcode[opcode>>10]();//*/
-	}
-#ifdef GPU_DIS_JR
-	else
-		if (doGPUDis)
-			WriteLog("Branch NOT taken.\n");
-#endif
-}
-
-
-static void gpu_opcode_add(void)
-{
-#ifdef GPU_DIS_ADD
-	if (doGPUDis)
-		WriteLog("%06X: ADD    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res = RN + RM;
-	CLR_ZNC; SET_ZNC_ADD(RN, RM, res);
-	RN = res;
-#ifdef GPU_DIS_ADD
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_addc(void)
-{
-#ifdef GPU_DIS_ADDC
-	if (doGPUDis)
-		WriteLog("%06X: ADDC   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-/*	int dreg = jaguar.op & 31;
-	uint32_t r1 = jaguar.r[(jaguar.op >> 5) & 31];
-	uint32_t r2 = jaguar.r[dreg];
-	uint32_t res = r2 + r1 + ((jaguar.FLAGS >> 1) & 1);
-	jaguar.r[dreg] = res;
-	CLR_ZNC; SET_ZNC_ADD(r2,r1,res);*/
-
-	uint32_t res = RN + RM + gpu_flag_c;
-	uint32_t carry = gpu_flag_c;
-//	SET_ZNC_ADD(RN, RM, res); //???BUG??? Yes!
-	SET_ZNC_ADD(RN + carry, RM, res);
-//	SET_ZNC_ADD(RN, RM + carry, res);
-	RN = res;
-#ifdef GPU_DIS_ADDC
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_addq(void)
-{
-#ifdef GPU_DIS_ADDQ
-	if (doGPUDis)
-		WriteLog("%06X: ADDQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t r1 = gpu_convert_zero[IMM_1];
-	uint32_t res = RN + r1;
-	CLR_ZNC; SET_ZNC_ADD(RN, r1, res);
-	RN = res;
-#ifdef GPU_DIS_ADDQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_addqt(void)
-{
-#ifdef GPU_DIS_ADDQT
-	if (doGPUDis)
-		WriteLog("%06X: ADDQT  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	RN += gpu_convert_zero[IMM_1];
-#ifdef GPU_DIS_ADDQT
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_sub(void)
-{
-#ifdef GPU_DIS_SUB
-	if (doGPUDis)
-		WriteLog("%06X: SUB    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res = RN - RM;
-	SET_ZNC_SUB(RN, RM, res);
-	RN = res;
-#ifdef GPU_DIS_SUB
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_subc(void)
-{
-#ifdef GPU_DIS_SUBC
-	if (doGPUDis)
-		WriteLog("%06X: SUBC   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	// This is how the GPU ALU does it--Two's complement with inverted carry
-	uint64_t res = (uint64_t)RN + (uint64_t)(RM ^ 0xFFFFFFFF) + (gpu_flag_c ^ 1);
-	// Carry out of the result is inverted too
-	gpu_flag_c = ((res >> 32) & 0x01) ^ 1;
-	RN = (res & 0xFFFFFFFF);
-	SET_ZN(RN);
-#ifdef GPU_DIS_SUBC
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_subq(void)
-{
-#ifdef GPU_DIS_SUBQ
-	if (doGPUDis)
-		WriteLog("%06X: SUBQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t r1 = gpu_convert_zero[IMM_1];
-	uint32_t res = RN - r1;
-	SET_ZNC_SUB(RN, r1, res);
-	RN = res;
-#ifdef GPU_DIS_SUBQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_subqt(void)
-{
-#ifdef GPU_DIS_SUBQT
-	if (doGPUDis)
-		WriteLog("%06X: SUBQT  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	RN -= gpu_convert_zero[IMM_1];
-#ifdef GPU_DIS_SUBQT
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_cmp(void)
-{
-#ifdef GPU_DIS_CMP
-	if (doGPUDis)
-		WriteLog("%06X: CMP    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res = RN - RM;
-	SET_ZNC_SUB(RN, RM, res);
-#ifdef GPU_DIS_CMP
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z);
-#endif
-}
-
-
-static void gpu_opcode_cmpq(void)
-{
-	static int32_t sqtable[32] =
-		{ 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,-16,-15,-14,-13,-12,-11,-10,-9,-8,-7,-6,-5,-4,-3,-2,-1 };
-#ifdef GPU_DIS_CMPQ
-	if (doGPUDis)
-		WriteLog("%06X: CMPQ   #%d, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, sqtable[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t r1 = sqtable[IMM_1 & 0x1F]; // I like this better -> (INT8)(jaguar.op >> 2) >> 3;
-	uint32_t res = RN - r1;
-	SET_ZNC_SUB(RN, r1, res);
-#ifdef GPU_DIS_CMPQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z);
-#endif
-}
-
-
-static void gpu_opcode_and(void)
-{
-#ifdef GPU_DIS_AND
-	if (doGPUDis)
-		WriteLog("%06X: AND    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RN & RM;
-	SET_ZN(RN);
-#ifdef GPU_DIS_AND
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_or(void)
-{
-#ifdef GPU_DIS_OR
-	if (doGPUDis)
-		WriteLog("%06X: OR     R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RN | RM;
-	SET_ZN(RN);
-#ifdef GPU_DIS_OR
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_xor(void)
-{
-#ifdef GPU_DIS_XOR
-	if (doGPUDis)
-		WriteLog("%06X: XOR    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RN ^ RM;
-	SET_ZN(RN);
-#ifdef GPU_DIS_XOR
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_not(void)
-{
-#ifdef GPU_DIS_NOT
-	if (doGPUDis)
-		WriteLog("%06X: NOT    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = ~RN;
-	SET_ZN(RN);
-#ifdef GPU_DIS_NOT
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_move_pc(void)
-{
-#ifdef GPU_DIS_MOVEPC
-	if (doGPUDis)
-		WriteLog("%06X: MOVE   PC, R%02u [NCZ:%u%u%u, PC=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, gpu_pc-2, IMM_2, RN);
-#endif
-	// Should be previous PC--this might not always be previous instruction!
-	// Then again, this will point right at the *current* instruction, i.e., MOVE PC,R!
-	RN = gpu_pc - 2;
-#ifdef GPU_DIS_MOVEPC
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_sat8(void)
-{
-#ifdef GPU_DIS_SAT8
-	if (doGPUDis)
-		WriteLog("%06X: SAT8   R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	RN = ((int32_t)RN < 0 ? 0 : (RN > 0xFF ? 0xFF : RN));
-	SET_ZN(RN);
-#ifdef GPU_DIS_SAT8
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_sat16(void)
-{
-	RN = ((int32_t)RN < 0 ? 0 : (RN > 0xFFFF ? 0xFFFF : RN));
-	SET_ZN(RN);
-}
-
-static void gpu_opcode_sat24(void)
-{
-	RN = ((int32_t)RN < 0 ? 0 : (RN > 0xFFFFFF ? 0xFFFFFF : RN));
-	SET_ZN(RN);
-}
-
-
-static void gpu_opcode_store_r14_indexed(void)
-{
-#ifdef GPU_DIS_STORE14I
-	if (doGPUDis)
-		WriteLog("%06X: STORE  R%02u, (R14+$%02X) [NCZ:%u%u%u, R%02u=%08X, R14+$%02X=%08X]\n", gpu_pc-2, IMM_2, gpu_convert_zero[IMM_1] << 2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN, gpu_convert_zero[IMM_1] << 2, gpu_reg[14]+(gpu_convert_zero[IMM_1] << 2));
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t address = gpu_reg[14] + (gpu_convert_zero[IMM_1] << 2);
-	
-	if (address >= 0xF03000 && address <= 0xF03FFF)
-		GPUWriteLong(address & 0xFFFFFFFC, RN, GPU);
-	else
-		GPUWriteLong(address, RN, GPU);
-#else
-	GPUWriteLong(gpu_reg[14] + (gpu_convert_zero[IMM_1] << 2), RN, GPU);
-#endif
-}
-
-
-static void gpu_opcode_store_r15_indexed(void)
-{
-#ifdef GPU_DIS_STORE15I
-	if (doGPUDis)
-		WriteLog("%06X: STORE  R%02u, (R15+$%02X) [NCZ:%u%u%u, R%02u=%08X, R15+$%02X=%08X]\n", gpu_pc-2, IMM_2, gpu_convert_zero[IMM_1] << 2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN, gpu_convert_zero[IMM_1] << 2, gpu_reg[15]+(gpu_convert_zero[IMM_1] << 2));
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t address = gpu_reg[15] + (gpu_convert_zero[IMM_1] << 2);
-
-	if (address >= 0xF03000 && address <= 0xF03FFF)
-		GPUWriteLong(address & 0xFFFFFFFC, RN, GPU);
-	else
-		GPUWriteLong(address, RN, GPU);
-#else
-	GPUWriteLong(gpu_reg[15] + (gpu_convert_zero[IMM_1] << 2), RN, GPU);
-#endif
-}
-
-
-static void gpu_opcode_load_r14_ri(void)
-{
-#ifdef GPU_DIS_LOAD14R
-	if (doGPUDis)
-		WriteLog("%06X: LOAD   (R14+R%02u), R%02u [NCZ:%u%u%u, R14+R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM+gpu_reg[14], IMM_2, RN);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t address = gpu_reg[14] + RM;
-
-	if (address >= 0xF03000 && address <= 0xF03FFF)
-		RN = GPUReadLong(address & 0xFFFFFFFC, GPU);
-	else
-		RN = GPUReadLong(address, GPU);
-#else
-	RN = GPUReadLong(gpu_reg[14] + RM, GPU);
-#endif
-#ifdef GPU_DIS_LOAD14R
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_load_r15_ri(void)
-{
-#ifdef GPU_DIS_LOAD15R
-	if (doGPUDis)
-		WriteLog("%06X: LOAD   (R15+R%02u), R%02u [NCZ:%u%u%u, R15+R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM+gpu_reg[15], IMM_2, RN);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t address = gpu_reg[15] + RM;
-
-	if (address >= 0xF03000 && address <= 0xF03FFF)
-		RN = GPUReadLong(address & 0xFFFFFFFC, GPU);
-	else
-		RN = GPUReadLong(address, GPU);
-#else
-	RN = GPUReadLong(gpu_reg[15] + RM, GPU);
-#endif
-#ifdef GPU_DIS_LOAD15R
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_store_r14_ri(void)
-{
-#ifdef GPU_DIS_STORE14R
-	if (doGPUDis)
-		WriteLog("%06X: STORE  R%02u, (R14+R%02u) [NCZ:%u%u%u, R%02u=%08X, R14+R%02u=%08X]\n", gpu_pc-2, IMM_2, IMM_1, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN, IMM_1, RM+gpu_reg[14]);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t address = gpu_reg[14] + RM;
-
-	if (address >= 0xF03000 && address <= 0xF03FFF)
-		GPUWriteLong(address & 0xFFFFFFFC, RN, GPU);
-	else
-		GPUWriteLong(address, RN, GPU);
-#else
-	GPUWriteLong(gpu_reg[14] + RM, RN, GPU);
-#endif
-}
-
-
-static void gpu_opcode_store_r15_ri(void)
-{
-#ifdef GPU_DIS_STORE15R
-	if (doGPUDis)
-		WriteLog("%06X: STORE  R%02u, (R15+R%02u) [NCZ:%u%u%u, R%02u=%08X, R15+R%02u=%08X]\n", gpu_pc-2, IMM_2, IMM_1, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN, IMM_1, RM+gpu_reg[15]);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT_STORE
-	uint32_t address = gpu_reg[15] + RM;
-
-	if (address >= 0xF03000 && address <= 0xF03FFF)
-		GPUWriteLong(address & 0xFFFFFFFC, RN, GPU);
-	else
-		GPUWriteLong(address, RN, GPU);
-#else
-	GPUWriteLong(gpu_reg[15] + RM, RN, GPU);
-#endif
-}
-
-
-static void gpu_opcode_nop(void)
-{
-#ifdef GPU_DIS_NOP
-	if (doGPUDis)
-		WriteLog("%06X: NOP    [NCZ:%u%u%u]\n", gpu_pc-2, gpu_flag_n, gpu_flag_c, gpu_flag_z);
-#endif
-}
-
-
-static void gpu_opcode_pack(void)
-{
-#ifdef GPU_DIS_PACK
-	if (doGPUDis)
-		WriteLog("%06X: %s R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, (!IMM_1 ? "PACK  " : "UNPACK"), IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t val = RN;
-
-//BUG!	if (RM == 0)				// Pack
-	if (IMM_1 == 0)				// Pack
-		RN = ((val >> 10) & 0x0000F000) | ((val >> 5) & 0x00000F00) | (val & 0x000000FF);
-	else						// Unpack
-		RN = ((val & 0x0000F000) << 10) | ((val & 0x00000F00) << 5) | (val & 0x000000FF);
-#ifdef GPU_DIS_PACK
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_storeb(void)
-{
-#ifdef GPU_DIS_STOREB
-	if (doGPUDis)
-		WriteLog("%06X: STOREB R%02u, (R%02u) [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_pc-2, IMM_2, IMM_1, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN, IMM_1, RM);
-#endif
-//Is this right???
-// Would appear to be so...!
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		GPUWriteLong(RM, RN & 0xFF, GPU);
-	else
-		JaguarWriteByte(RM, RN, GPU);
-}
-
-
-static void gpu_opcode_storew(void)
-{
-#ifdef GPU_DIS_STOREW
-	if (doGPUDis)
-		WriteLog("%06X: STOREW R%02u, (R%02u) [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_pc-2, IMM_2, IMM_1, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN, IMM_1, RM);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		GPUWriteLong(RM & 0xFFFFFFFE, RN & 0xFFFF, GPU);
-	else
-		JaguarWriteWord(RM, RN, GPU);
-#else
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		GPUWriteLong(RM, RN & 0xFFFF, GPU);
-	else
-		JaguarWriteWord(RM, RN, GPU);
-#endif
-}
-
-
-static void gpu_opcode_store(void)
-{
-#ifdef GPU_DIS_STORE
-	if (doGPUDis)
-		WriteLog("%06X: STORE  R%02u, (R%02u) [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_pc-2, IMM_2, IMM_1, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN, IMM_1, RM);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		GPUWriteLong(RM & 0xFFFFFFFC, RN, GPU);
-	else
-		GPUWriteLong(RM, RN, GPU);
-#else
-	GPUWriteLong(RM, RN, GPU);
-#endif
-}
-
-
-static void gpu_opcode_storep(void)
-{
-#ifdef GPU_CORRECT_ALIGNMENT
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-	{
-		GPUWriteLong((RM & 0xFFFFFFF8) + 0, gpu_hidata, GPU);
-		GPUWriteLong((RM & 0xFFFFFFF8) + 4, RN, GPU);
-	}
-	else
-	{
-		GPUWriteLong(RM + 0, gpu_hidata, GPU);
-		GPUWriteLong(RM + 4, RN, GPU);
-	}
-#else
-	GPUWriteLong(RM + 0, gpu_hidata, GPU);
-	GPUWriteLong(RM + 4, RN, GPU);
-#endif
-}
-
-static void gpu_opcode_loadb(void)
-{
-#ifdef GPU_DIS_LOADB
-	if (doGPUDis)
-		WriteLog("%06X: LOADB  (R%02u), R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		RN = GPUReadLong(RM, GPU) & 0xFF;
-	else
-		RN = JaguarReadByte(RM, GPU);
-#ifdef GPU_DIS_LOADB
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_loadw(void)
-{
-#ifdef GPU_DIS_LOADW
-	if (doGPUDis)
-		WriteLog("%06X: LOADW  (R%02u), R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		RN = GPUReadLong(RM & 0xFFFFFFFE, GPU) & 0xFFFF;
-	else
-		RN = JaguarReadWord(RM, GPU);
-#else
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		RN = GPUReadLong(RM, GPU) & 0xFFFF;
-	else
-		RN = JaguarReadWord(RM, GPU);
-#endif
-#ifdef GPU_DIS_LOADW
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-// According to the docs, & "Do The Same", this address is long aligned...
-// So let's try it:
-// And it works!!! Need to fix all instances...
-// Also, Power Drive Rally seems to contradict the idea that only LOADs in
-// the $F03000-$F03FFF range are aligned...
-#ifdef _MSC_VER
-#pragma message("Warning: !!! Alignment issues, need to find definitive final word on this !!!")
-#else
-#warning "!!! Alignment issues, need to find definitive final word on this !!!"
-#endif // _MSC_VER
-/*
-Preliminary testing on real hardware seems to confirm that something strange goes on
-with unaligned reads in main memory. When the address is off by 1, the result is the
-same as the long address with the top byte replaced by something. So if the read is
-from $401, and $400 has 12 34 56 78, the value read will be $nn345678, where nn is a currently unknown vlaue.
-When the address is off by 2, the result would be $nnnn5678, where nnnn is unknown.
-When the address is off by 3, the result would be $nnnnnn78, where nnnnnn is unknown.
-It may be that the "unknown" values come from the prefetch queue, but not sure how
-to test that. They seem to be stable, though, which would indicate such a mechanism.
-Sometimes, however, the off by 2 case returns $12345678!
-*/
-static void gpu_opcode_load(void)
-{
-#ifdef GPU_DIS_LOAD
-	if (doGPUDis)
-		WriteLog("%06X: LOAD   (R%02u), R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t mask[4] = { 0x00000000, 0xFF000000, 0xFFFF0000, 0xFFFFFF00 };
-//	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		RN = GPUReadLong(RM & 0xFFFFFFFC, GPU);
-//		RN = GPUReadLong(RM & 0x00FFFFFC, GPU);
-//	else
-//		RN = GPUReadLong(RM, GPU);
-	// Simulate garbage in unaligned reads...
-//seems that this behavior is different in GPU mem vs. main mem...
-//	if ((RM < 0xF03000) || (RM > 0xF0BFFF))
-//		RN |= mask[RM & 0x03];
-#else
-	RN = GPUReadLong(RM, GPU);
-#endif
-#ifdef GPU_DIS_LOAD
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_loadp(void)
-{
-#ifdef GPU_CORRECT_ALIGNMENT
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-	{
-		gpu_hidata = GPUReadLong((RM & 0xFFFFFFF8) + 0, GPU);
-		RN		   = GPUReadLong((RM & 0xFFFFFFF8) + 4, GPU);
-	}
-	else
-	{
-		gpu_hidata = GPUReadLong(RM + 0, GPU);
-		RN		   = GPUReadLong(RM + 4, GPU);
-	}
-#else
-	gpu_hidata = GPUReadLong(RM + 0, GPU);
-	RN		   = GPUReadLong(RM + 4, GPU);
-#endif
-}
-
-
-static void gpu_opcode_load_r14_indexed(void)
-{
-#ifdef GPU_DIS_LOAD14I
-	if (doGPUDis)
-		WriteLog("%06X: LOAD   (R14+$%02X), R%02u [NCZ:%u%u%u, R14+$%02X=%08X, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1] << 2, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, gpu_convert_zero[IMM_1] << 2, gpu_reg[14]+(gpu_convert_zero[IMM_1] << 2), IMM_2, RN);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t address = gpu_reg[14] + (gpu_convert_zero[IMM_1] << 2);
-
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		RN = GPUReadLong(address & 0xFFFFFFFC, GPU);
-	else
-		RN = GPUReadLong(address, GPU);
-#else
-	RN = GPUReadLong(gpu_reg[14] + (gpu_convert_zero[IMM_1] << 2), GPU);
-#endif
-#ifdef GPU_DIS_LOAD14I
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
-
-
-static void gpu_opcode_load_r15_indexed(void)
-{
-#ifdef GPU_DIS_LOAD15I
-	if (doGPUDis)
-		WriteLog("%06X: LOAD   (R15+$%02X), R%02u [NCZ:%u%u%u, R15+$%02X=%08X, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1] << 2, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, gpu_convert_zero[IMM_1] << 2, gpu_reg[15]+(gpu_convert_zero[IMM_1] << 2), IMM_2, RN);
-#endif
-#ifdef GPU_CORRECT_ALIGNMENT
-	uint32_t address = gpu_reg[15] + (gpu_convert_zero[IMM_1] << 2);
-
-	if ((RM >= 0xF03000) && (RM <= 0xF03FFF))
-		RN = GPUReadLong(address & 0xFFFFFFFC, GPU);
-	else
-		RN = GPUReadLong(address, GPU);
-#else
-	RN = GPUReadLong(gpu_reg[15] + (gpu_convert_zero[IMM_1] << 2), GPU);
-#endif
-#ifdef GPU_DIS_LOAD15I
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
 
+		if (gpuIdleProbe)
+			GPUIdleCheck(opcode >> 10);
 
-static void gpu_opcode_movei(void)
-{
-#ifdef GPU_DIS_MOVEI
-	if (doGPUDis)
-		WriteLog("%06X: MOVEI  #$%08X, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, (uint32_t)GPUReadWord(gpu_pc) | ((uint32_t)GPUReadWord(gpu_pc + 2) << 16), IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	// This instruction is followed by 32-bit value in LSW / MSW format...
-	RN = (uint32_t)GPUReadWord(gpu_pc, GPU) | ((uint32_t)GPUReadWord(gpu_pc + 2, GPU) << 16);
-	gpu_pc += 4;
-#ifdef GPU_DIS_MOVEI
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
+		if (TRACE_ACTIVE)
+			TraceInstruction(TRACE_GPU, gpu_pc, opcode, gpu_reg, gpu_flag_z | (gpu_flag_c << 1) | (gpu_flag_n << 2));
 
+		return opcode;
+	}
 
-static void gpu_opcode_moveta(void)
-{
-#ifdef GPU_DIS_MOVETA
-	if (doGPUDis)
-		WriteLog("%06X: MOVETA R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u(alt)=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, ALTERNATE_RN);
-#endif
-	ALTERNATE_RN = RM;
-#ifdef GPU_DIS_MOVETA
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u(alt)=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, ALTERNATE_RN);
-#endif
-}
+	static inline int32_t Retire(uint32_t pc, uint32_t index, int32_t cycles)
+	{
+		cycles -= gpu_opcode_cycles[index];
+		gpu_opcode_use[index]++;
 
+		// Backward jump, which may be the one of an idle loop
+		if (gpuIdleSkip && (gpu_pc < pc) && (gpu_in_exec == 1))
+			cycles = GPUIdleLoop(pc, cycles);
 
-static void gpu_opcode_movefa(void)
-{
-#ifdef GPU_DIS_MOVEFA
-	if (doGPUDis)
-		WriteLog("%06X: MOVEFA R%02u, R%02u [NCZ:%u%u%u, R%02u(alt)=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, ALTERNATE_RM, IMM_2, RN);
-#endif
-	RN = ALTERNATE_RM;
-#ifdef GPU_DIS_MOVEFA
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u(alt)=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, ALTERNATE_RM, IMM_2, RN);
-#endif
-}
+		if (gpu_start_log)
+			WriteLog("(RM=%08X, RN=%08X)\n", RM, RN);
 
+		if ((gpu_pc < 0xF03000 || gpu_pc > 0xF03FFF) && !tripwire)
+		{
+			WriteLog("GPU: Executing outside local RAM! GPU_PC: %08X\n", gpu_pc);
+			tripwire = true;
+		}
 
-static void gpu_opcode_move(void)
-{
-#ifdef GPU_DIS_MOVE
-	if (doGPUDis)
-		WriteLog("%06X: MOVE   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = RM;
-#ifdef GPU_DIS_MOVE
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
+		return cycles;
+	}
 
+	static inline void DelaySlot(void)
+	{
+		if (gpu_start_log)
+			WriteLog("    --> Branch taken.\n");
 
-static void gpu_opcode_moveq(void)
-{
-#ifdef GPU_DIS_MOVEQ
-	if (doGPUDis)
-		WriteLog("%06X: MOVEQ  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	RN = IMM_1;
-#ifdef GPU_DIS_MOVEQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
+		GPUExec(1);
+	}
 
+	//
+	// Loads & stores; GPU RAM accesses are aligned, other ones going through the bus
+	// but the DRAM ones, done straight in the memory space
+	//
+	static inline uint32_t ReadLong(uint32_t address)
+	{
+		uint8_t * dram = RISCDRAM(address, 4);
 
-static void gpu_opcode_resmac(void)
-{
-	RN = gpu_acc;
-}
+		if (!dram)
+			return GPUReadLong(address, GPU);
 
+		if (gpuSliceActive && !GPUSyncBus())
+			return 0;
 
-static void gpu_opcode_imult(void)
-{
-#ifdef GPU_DIS_IMULT
-	if (doGPUDis)
-		WriteLog("%06X: IMULT  R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = (int16_t)RN * (int16_t)RM;
-	SET_ZN(RN);
-#ifdef GPU_DIS_IMULT
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
+		return RISCDRAMReadLong(dram, address, GPU);
+	}
 
+	static inline void WriteLong(uint32_t address, uint32_t data)
+	{
+		uint8_t * dram = RISCDRAM(address, 4);
 
-static void gpu_opcode_mult(void)
-{
-#ifdef GPU_DIS_MULT
-	if (doGPUDis)
-		WriteLog("%06X: MULT   R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	RN = (uint16_t)RM * (uint16_t)RN;
-//	RN = (RM & 0xFFFF) * (RN & 0xFFFF);
-	SET_ZN(RN);
-#ifdef GPU_DIS_MULT
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
+		if (!dram)
+			GPUWriteLong(address, data, GPU);
+		else if (!gpuSliceActive || GPUSyncBus())
+			RISCDRAMWriteLong(dram, address, data, GPU);
+	}
 
+	static inline void LoadB(uint32_t m, uint32_t n)
+	{
+		uint32_t address = gpu_reg[m];
 
-static void gpu_opcode_bclr(void)
-{
-#ifdef GPU_DIS_BCLR
-	if (doGPUDis)
-		WriteLog("%06X: BCLR   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = RN & ~(1 << IMM_1);
-	RN = res;
-	SET_ZN(res);
-#ifdef GPU_DIS_BCLR
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			gpu_reg[n] = GPUReadLong(address, GPU) & 0xFF;
+		else if (!gpuSliceActive || GPUSyncBus())
+			gpu_reg[n] = JaguarReadByte(address, GPU);
+	}
 
+	static inline void LoadW(uint32_t m, uint32_t n)
+	{
+		uint32_t address = gpu_reg[m];
 
-static void gpu_opcode_btst(void)
-{
-#ifdef GPU_DIS_BTST
-	if (doGPUDis)
-		WriteLog("%06X: BTST   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	gpu_flag_z = (~RN >> IMM_1) & 1;
-#ifdef GPU_DIS_BTST
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
+#ifdef GPU_CORRECT_ALIGNMENT
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			gpu_reg[n] = GPUReadLong(address & 0xFFFFFFFE, GPU) & 0xFFFF;
+#else
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			gpu_reg[n] = GPUReadLong(address, GPU) & 0xFFFF;
 #endif
-}
-
+		else if (!gpuSliceActive || GPUSyncBus())
+			gpu_reg[n] = JaguarReadWord(address, GPU);
+	}
 
-static void gpu_opcode_bset(void)
-{
-#ifdef GPU_DIS_BSET
-	if (doGPUDis)
-		WriteLog("%06X: BSET   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = RN | (1 << IMM_1);
-	RN = res;
-	SET_ZN(res);
-#ifdef GPU_DIS_BSET
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
+	// According to the docs, & "Do The Same", this address is long aligned...
+	// So let's try it:
+	// And it works!!! Need to fix all instances...
+	// Also, Power Drive Rally seems to contradict the idea that only LOADs in
+	// the $F03000-$F03FFF range are aligned...
+#ifdef _MSC_VER
+#pragma message("Warning: !!! Alignment issues, need to find definitive final word on this !!!")
+#else
+#warning "!!! Alignment issues, need to find definitive final word on this !!!"
+#endif // _MSC_VER
+	/*
+	Preliminary testing on real hardware seems to confirm that something strange goes on
+	with unaligned reads in main memory. When the address is off by 1, the result is the
+	same as the long address with the top byte replaced by something. So if the read is
+	from $401, and $400 has 12 34 56 78, the value read will be $nn345678, where nn is a currently unknown vlaue.
+	When the address is off by 2, the result would be $nnnn5678, where nnnn is unknown.
+	When the address is off by 3, the result would be $nnnnnn78, where nnnnnn is unknown.
+	It may be that the "unknown" values come from the prefetch queue, but not sure how
+	to test that. They seem to be stable, though, which would indicate such a mechanism.
+	Sometimes, however, the off by 2 case returns $12345678!
+	*/
+	static inline void Load(uint32_t m, uint32_t n)
+	{
+#ifdef GPU_CORRECT_ALIGNMENT
+		gpu_reg[n] = ReadLong(gpu_reg[m] & 0xFFFFFFFC);
+#else
+		gpu_reg[n] = ReadLong(gpu_reg[m]);
 #endif
-}
-
-
-static void gpu_opcode_imacn(void)
-{
-	uint32_t res = (int16_t)RM * (int16_t)(RN);
-	gpu_acc += res;
-}
-
-
-static void gpu_opcode_mtoi(void)
-{
-	uint32_t _RM = RM;
-	uint32_t res = RN = (((int32_t)_RM >> 8) & 0xFF800000) | (_RM & 0x007FFFFF);
-	SET_ZN(res);
-}
+	}
 
+	static inline void LoadP(uint32_t m, uint32_t n)
+	{
+		uint32_t address = gpu_reg[m];
 
-static void gpu_opcode_normi(void)
-{
-	uint32_t _RM = RM;
-	uint32_t res = 0;
+#ifdef GPU_CORRECT_ALIGNMENT
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			address &= 0xFFFFFFF8;
+#endif
+		uint8_t * dram = RISCDRAM(address, 8);
 
-	if (_RM)
-	{
-		while ((_RM & 0xFFC00000) == 0)
+		// The phrase is read at once from the DRAM
+		if (dram)
 		{
-			_RM <<= 1;
-			res--;
+			if (!gpuSliceActive || GPUSyncBus())
+			{
+				uint64_t phrase = RISCDRAMReadPhrase(dram, address, GPU);
+				gpu_hidata = (uint32_t)(phrase >> 32);
+				gpu_reg[n] = (uint32_t)phrase;
+			}
+			else
+				gpu_hidata = gpu_reg[n] = 0;
 		}
-		while ((_RM & 0xFF800000) != 0)
+		else
 		{
-			_RM >>= 1;
-			res++;
+			gpu_hidata = GPUReadLong(address + 0, GPU);
+			gpu_reg[n] = GPUReadLong(address + 4, GPU);
 		}
 	}
-	RN = res;
-	SET_ZN(res);
-}
-
-static void gpu_opcode_mmult(void)
-{
-	int count	= gpu_matrix_control & 0x0F;	// Matrix width
-	uint32_t addr = gpu_pointer_to_matrix;		// In the GPU's RAM
-	int64_t accum = 0;
-	uint32_t res;
 
-	if (gpu_matrix_control & 0x10)				// Column stepping
+	// NB: The alignment is decided on RM, not on the address
+	static inline void LoadIndexed(uint32_t base, uint32_t m, uint32_t n)
 	{
-		for(int i=0; i<count; i++)
-		{
-			int16_t a;
-			if (i & 0x01)
-				a = (int16_t)((gpu_alternate_reg[IMM_1 + (i >> 1)] >> 16) & 0xFFFF);
-			else
-				a = (int16_t)(gpu_alternate_reg[IMM_1 + (i >> 1)] & 0xFFFF);
+		uint32_t address = gpu_reg[base] + (gpu_convert_zero[m] << 2);
 
-			int16_t b = ((int16_t)GPUReadWord(addr + 2, GPU));
-			accum += a * b;
-			addr += 4 * count;
-		}
+#ifdef GPU_CORRECT_ALIGNMENT
+		if ((gpu_reg[m] >= 0xF03000) && (gpu_reg[m] <= 0xF03FFF))
+			address &= 0xFFFFFFFC;
+#endif
+		gpu_reg[n] = ReadLong(address);
 	}
-	else										// Row stepping
+
+	static inline void LoadR14Indexed(uint32_t m, uint32_t n) { LoadIndexed(14, m, n); }
+	static inline void LoadR15Indexed(uint32_t m, uint32_t n) { LoadIndexed(15, m, n); }
+
+	static inline void LoadRI(uint32_t base, uint32_t m, uint32_t n)
 	{
-		for(int i=0; i<count; i++)
-		{
-			int16_t a;
-			if (i & 0x01)
-				a = (int16_t)((gpu_alternate_reg[IMM_1 + (i >> 1)] >> 16) & 0xFFFF);
-			else
-				a = (int16_t)(gpu_alternate_reg[IMM_1 + (i >> 1)] & 0xFFFF);
+		uint32_t address = gpu_reg[base] + gpu_reg[m];
 
-			int16_t b = ((int16_t)GPUReadWord(addr + 2, GPU));
-			accum += a * b;
-			addr += 4;
-		}
+#ifdef GPU_CORRECT_ALIGNMENT
+		if (address >= 0xF03000 && address <= 0xF03FFF)
+			address &= 0xFFFFFFFC;
+#endif
+		gpu_reg[n] = ReadLong(address);
 	}
-	RN = res = (int32_t)accum;
-	// carry flag to do (out of the last add)
-	SET_ZN(res);
-}
 
+	static inline void LoadR14RI(uint32_t m, uint32_t n) { LoadRI(14, m, n); }
+	static inline void LoadR15RI(uint32_t m, uint32_t n) { LoadRI(15, m, n); }
 
-static void gpu_opcode_abs(void)
-{
-#ifdef GPU_DIS_ABS
-	if (doGPUDis)
-		WriteLog("%06X: ABS    R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	gpu_flag_c = RN >> 31;
-	if (RN == 0x80000000)
-	//Is 0x80000000 a positive number? If so, then we need to set C to 0 as well!
-		gpu_flag_n = 1, gpu_flag_z = 0;
-	else
+	static inline void StoreB(uint32_t m, uint32_t n)
 	{
-		if (gpu_flag_c)
-			RN = -RN;
-		gpu_flag_n = 0; SET_FLAG_Z(RN);
+		uint32_t address = gpu_reg[m];
+
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			GPUWriteLong(address, gpu_reg[n] & 0xFF, GPU);
+		else if (!gpuSliceActive || GPUSyncBus())
+			JaguarWriteByte(address, gpu_reg[n], GPU);
 	}
-#ifdef GPU_DIS_ABS
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
+
+	static inline void StoreW(uint32_t m, uint32_t n)
+	{
+		uint32_t address = gpu_reg[m];
+
+#ifdef GPU_CORRECT_ALIGNMENT
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			GPUWriteLong(address & 0xFFFFFFFE, gpu_reg[n] & 0xFFFF, GPU);
+#else
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			GPUWriteLong(address, gpu_reg[n] & 0xFFFF, GPU);
 #endif
-}
+		else if (!gpuSliceActive || GPUSyncBus())
+			JaguarWriteWord(address, gpu_reg[n], GPU);
+	}
 
+	static inline void Store(uint32_t m, uint32_t n)
+	{
+		uint32_t address = gpu_reg[m];
 
-static void gpu_opcode_div(void)	// RN / RM
-{
-#ifdef GPU_DIS_DIV
-	if (doGPUDis)
-		WriteLog("%06X: DIV    R%02u, R%02u (%s) [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, (gpu_div_control & 0x01 ? "16.16" : "32"), gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
+#ifdef GPU_CORRECT_ALIGNMENT
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			address &= 0xFFFFFFFC;
 #endif
-#if 0
-	if (RM)
+		WriteLong(address, gpu_reg[n]);
+	}
+
+	static inline void StoreP(uint32_t m, uint32_t n)
 	{
-		if (gpu_div_control & 0x01)		// 16.16 division
+		uint32_t address = gpu_reg[m];
+
+#ifdef GPU_CORRECT_ALIGNMENT
+		if ((address >= 0xF03000) && (address <= 0xF03FFF))
+			address &= 0xFFFFFFF8;
+#endif
+		uint8_t * dram = RISCDRAM(address, 8);
+
+		// The phrase is written at once in the DRAM
+		if (dram)
 		{
-			gpu_remain = ((uint64_t)RN << 16) % RM;
-			RN = ((uint64_t)RN << 16) / RM;
+			if (!gpuSliceActive || GPUSyncBus())
+				RISCDRAMWritePhrase(dram, address, ((uint64_t)gpu_hidata << 32) | gpu_reg[n], GPU);
 		}
 		else
 		{
-			// We calculate the remainder first because we destroy RN after
-			// this by assigning it to itself.
-			gpu_remain = RN % RM;
-			RN = RN / RM;
+			GPUWriteLong(address + 0, gpu_hidata, GPU);
+			GPUWriteLong(address + 4, gpu_reg[n], GPU);
 		}
 	}
-	else
-	{
-		// This is what happens according to SCPCD. NYAN!
-		RN = 0xFFFFFFFF;
-		gpu_remain = 0;
-	}
-#else
-	// Real algorithm, courtesy of SCPCD: NYAN!
-	uint32_t q = RN;
-	uint32_t r = 0;
 
-	// If 16.16 division, stuff top 16 bits of RN into remainder and put the
-	// bottom 16 of RN in top 16 of quotient
-	if (gpu_div_control & 0x01)
-		q <<= 16, r = RN >> 16;
-
-	for(int i=0; i<32; i++)
+	static inline void StoreIndexed(uint32_t base, uint32_t m, uint32_t n)
 	{
-//		uint32_t sign = (r >> 31) & 0x01;
-		uint32_t sign = r & 0x80000000;
-		r = (r << 1) | ((q >> 31) & 0x01);
-		r += (sign ? RM : -RM);
-		q = (q << 1) | (((~r) >> 31) & 0x01);
-	}
-
-	RN = q;
-	gpu_remain = r;
-#endif
-
-#ifdef GPU_DIS_DIV
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] Remainder: %08X\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN, gpu_remain);
-#endif
-}
-
-
-static void gpu_opcode_imultn(void)
-{
-	uint32_t res = (int32_t)((int16_t)RN * (int16_t)RM);
-	gpu_acc = (int32_t)res;
-	SET_FLAG_Z(res);
-	SET_FLAG_N(res);
-}
-
-
-static void gpu_opcode_neg(void)
-{
-#ifdef GPU_DIS_NEG
-	if (doGPUDis)
-		WriteLog("%06X: NEG    R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = -RN;
-	SET_ZNC_SUB(0, RN, res);
-	RN = res;
-#ifdef GPU_DIS_NEG
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
+		uint32_t address = gpu_reg[base] + (gpu_convert_zero[m] << 2);
 
-
-static void gpu_opcode_shlq(void)
-{
-#ifdef GPU_DIS_SHLQ
-	if (doGPUDis)
-		WriteLog("%06X: SHLQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, 32 - IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-// Was a bug here...
-// (Look at Aaron's code: If r1 = 32, then 32 - 32 = 0 which is wrong!)
-	int32_t r1 = 32 - IMM_1;
-	uint32_t res = RN << r1;
-	SET_ZN(res); gpu_flag_c = (RN >> 31) & 1;
-	RN = res;
-#ifdef GPU_DIS_SHLQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
+#ifdef GPU_CORRECT_ALIGNMENT
+		if (address >= 0xF03000 && address <= 0xF03FFF)
+			address &= 0xFFFFFFFC;
 #endif
-}
-
+		WriteLong(address, gpu_reg[n]);
+	}
 
-static void gpu_opcode_shrq(void)
-{
-#ifdef GPU_DIS_SHRQ
-	if (doGPUDis)
-		WriteLog("%06X: SHRQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	int32_t r1 = gpu_convert_zero[IMM_1];
-	uint32_t res = RN >> r1;
-	SET_ZN(res); gpu_flag_c = RN & 1;
-	RN = res;
-#ifdef GPU_DIS_SHRQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-}
+	static inline void StoreR14Indexed(uint32_t m, uint32_t n) { StoreIndexed(14, m, n); }
+	static inline void StoreR15Indexed(uint32_t m, uint32_t n) { StoreIndexed(15, m, n); }
 
+	static inline void StoreR14RI(uint32_t m, uint32_t n)
+	{
+		uint32_t address = gpu_reg[14] + gpu_reg[m];
 
-static void gpu_opcode_ror(void)
-{
-#ifdef GPU_DIS_ROR
-	if (doGPUDis)
-		WriteLog("%06X: ROR    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t r1 = RM & 0x1F;
-	uint32_t res = (RN >> r1) | (RN << (32 - r1));
-	SET_ZN(res); gpu_flag_c = (RN >> 31) & 1;
-	RN = res;
-#ifdef GPU_DIS_ROR
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
+#ifdef GPU_CORRECT_ALIGNMENT
+		if (address >= 0xF03000 && address <= 0xF03FFF)
+			address &= 0xFFFFFFFC;
 #endif
-}
+		WriteLong(address, gpu_reg[n]);
+	}
 
+	static inline void StoreR15RI(uint32_t m, uint32_t n)
+	{
+		uint32_t address = gpu_reg[15] + gpu_reg[m];
 
-static void gpu_opcode_rorq(void)
-{
-#ifdef GPU_DIS_RORQ
-	if (doGPUDis)
-		WriteLog("%06X: RORQ   #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t r1 = gpu_convert_zero[IMM_1 & 0x1F];
-	uint32_t r2 = RN;
-	uint32_t res = (r2 >> r1) | (r2 << (32 - r1));
-	RN = res;
-	SET_ZN(res); gpu_flag_c = (r2 >> 31) & 0x01;
-#ifdef GPU_DIS_RORQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
+#ifdef GPU_CORRECT_ALIGNMENT_STORE
+		if (address >= 0xF03000 && address <= 0xF03FFF)
+			address &= 0xFFFFFFFC;
 #endif
-}
+		WriteLong(address, gpu_reg[n]);
+	}
+};
 
 
-static void gpu_opcode_sha(void)
+//
+// Main GPU execution core
+//
+static int testCount = 1;
+static int len = 0;
+void GPUExec(int32_t cycles)
 {
-/*	int dreg = jaguar.op & 31;
-	int32_t r1 = (int32_t)jaguar.r[(jaguar.op >> 5) & 31];
-	uint32_t r2 = jaguar.r[dreg];
-	uint32_t res;
-
-	CLR_ZNC;
-	if (r1 < 0)
-	{
-		res = (r1 <= -32) ? 0 : (r2 << -r1);
-		jaguar.FLAGS |= (r2 >> 30) & 2;
-	}
-	else
-	{
-		res = (r1 >= 32) ? ((int32_t)r2 >> 31) : ((int32_t)r2 >> r1);
-		jaguar.FLAGS |= (r2 << 1) & 2;
-	}
-	jaguar.r[dreg] = res;
-	SET_ZN(res);*/
-
-#ifdef GPU_DIS_SHA
-	if (doGPUDis)
-		WriteLog("%06X: SHA    R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	uint32_t res;
+	if (!GPU_RUNNING)
+		return;
 
-	if ((int32_t)RM < 0)
-	{
-		res = ((int32_t)RM <= -32) ? 0 : (RN << -(int32_t)RM);
-		gpu_flag_c = RN >> 31;
-	}
-	else
+#ifdef GPU_SINGLE_STEPPING
+	if (gpu_control & 0x18)
 	{
-		res = ((int32_t)RM >= 32) ? ((int32_t)RN >> 31) : ((int32_t)RN >> (int32_t)RM);
-		gpu_flag_c = RN & 0x01;
+		cycles = 1;
+		gpu_control &= ~0x10;
 	}
-	RN = res;
-	SET_ZN(res);
-#ifdef GPU_DIS_SHA
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
 #endif
+	if (gpuIRQPending)
+		GPUHandleIRQs();
 
-/*	int32_t sRM=(int32_t)RM;
-	uint32_t _RN=RN;
+	gpu_releaseTimeSlice_flag = 0;
 
-	if (sRM<0)
-	{
-		uint32_t shift=-sRM;
-		if (shift>=32) shift=32;
-		gpu_flag_c=(_RN&0x80000000)>>31;
-		while (shift)
-		{
-			_RN<<=1;
-			shift--;
-		}
-	}
-	else
-	{
-		uint32_t shift=sRM;
-		if (shift>=32) shift=32;
-		gpu_flag_c=_RN&0x1;
-		while (shift)
-		{
-			_RN=((int32_t)_RN)>>1;
-			shift--;
-		}
-	}
-	RN=_RN;
-	SET_FLAG_Z(_RN);
-	SET_FLAG_N(_RN);*/
-}
+	if (!gpu_in_exec++)
+		gpuIdleProbe = false, gpuIdleFailPC = 0;
 
+	RISCCore<GPUUnit>::Run(cycles);
 
-static void gpu_opcode_sharq(void)
-{
-#ifdef GPU_DIS_SHARQ
-	if (doGPUDis)
-		WriteLog("%06X: SHARQ  #%u, R%02u [NCZ:%u%u%u, R%02u=%08X] -> ", gpu_pc-2, gpu_convert_zero[IMM_1], IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
-	uint32_t res = (int32_t)RN >> gpu_convert_zero[IMM_1];
-	SET_ZN(res); gpu_flag_c = RN & 0x01;
-	RN = res;
-#ifdef GPU_DIS_SHARQ
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_2, RN);
-#endif
+	gpu_in_exec--;
 }
 
+//
+// GPU opcodes
+//
 
-static void gpu_opcode_sh(void)
-{
-#ifdef GPU_DIS_SH
-	if (doGPUDis)
-		WriteLog("%06X: SH     R%02u, R%02u [NCZ:%u%u%u, R%02u=%08X, R%02u=%08X] -> ", gpu_pc-2, IMM_1, IMM_2, gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-	if (RM & 0x80000000)		// Shift left
-	{
-		gpu_flag_c = RN >> 31;
-		RN = ((int32_t)RM <= -32 ? 0 : RN << -(int32_t)RM);
-	}
-	else						// Shift right
-	{
-		gpu_flag_c = RN & 0x01;
-		RN = (RM >= 32 ? 0 : RN >> RM);
-	}
-	SET_ZN(RN);
-#ifdef GPU_DIS_SH
-	if (doGPUDis)
-		WriteLog("[NCZ:%u%u%u, R%02u=%08X, R%02u=%08X]\n", gpu_flag_n, gpu_flag_c, gpu_flag_z, IMM_1, RM, IMM_2, RN);
-#endif
-}
+/*
+GPU opcodes use (offset punch--vertically below bad guy):
+	              add 18686
+	             addq 32621
+	              sub 7483
+	             subq 10252
+	              and 21229
+	               or 15003
+	             btst 1822
+	             bset 2072
+	             mult 141
+	              div 2392
+	             shlq 13449
+	             shrq 10297
+	            sharq 11104
+	              cmp 6775
+	             cmpq 5944
+	             move 31259
+	            moveq 4473
+	            movei 23277
+	            loadb 46
+	            loadw 4201
+	             load 28580
+	 load_r14_indexed 1183
+	 load_r15_indexed 1125
+	           storew 178
+	            store 10144
+	store_r14_indexed 320
+	store_r15_indexed 1
+	          move_pc 1742
+	             jump 24467
+	               jr 18090
+	              nop 41362
+*/
 
 
 //Temporary: Testing only!
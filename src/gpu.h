@@ -7,6 +7,7 @@
 
 //#include "types.h"
 #include "memory.h"
+#include <atomic>
 
 #define GPU_CONTROL_RAM_BASE    0x00F02100
 #define GPU_WORK_RAM_BASE		0x00F03000
@@ -14,10 +15,14 @@
 void GPUInit(void);
 void GPUReset(void);
 void GPUExec(int32_t);
+bool GPUExecAsync(int32_t);
+void GPUExecAsyncWait(void);
 void GPUDone(void);
 void GPUUpdateRegisterBanks(void);
+void GPUUpdateIRQPending(void);
 void GPUHandleIRQs(void);
 void GPUSetIRQLine(int irqline, int state);
+void GPUSetIdleSkip(bool enable);
 
 uint8_t GPUReadByte(uint32_t offset, uint32_t who = UNKNOWN);
 uint16_t GPUReadWord(uint32_t offset, uint32_t who = UNKNOWN);
@@ -36,8 +41,88 @@ bool	GPUIsRunning(void);
 
 enum { GPUIRQ_CPU = 0, GPUIRQ_DSP, GPUIRQ_TIMER, GPUIRQ_OBJECT, GPUIRQ_BLITTER };
 
-// Exported vars
+// Threaded GPU support
 
-extern uint32_t gpu_reg_bank_0[], gpu_reg_bank_1[];
+#define GPU_UNDO_LOG_SIZE	1024
+
+struct GPUUndoEntry
+{
+	uint32_t offset;
+	uint32_t data;
+};
+
+struct GPUSnapshot
+{
+	uint32_t pc, acc, remain, hidata, flags, matrix_control, pointer_to_matrix;
+	uint32_t data_organization, control, div_control;
+	uint8_t flag_z, flag_n, flag_c;
+	uint32_t instruction, releaseTimeSlice_flag;
+	bool tripwireSet;
+	uint32_t reg_bank_0[32], reg_bank_1[32];
+	uint32_t opcode_use[64];
+};
+
+struct SDL_Thread;
+struct SDL_mutex;
+struct SDL_cond;
+
+// GPU state of a machine
+
+struct GPUState
+{
+	uint8_t gpu_ram_8[0x1000];
+	uint32_t gpu_pc;
+	uint32_t gpu_acc;
+	uint32_t gpu_remain;
+	uint32_t gpu_hidata;
+	uint32_t gpu_flags;
+	uint32_t gpu_matrix_control;
+	uint32_t gpu_pointer_to_matrix;
+	uint32_t gpu_data_organization;
+	uint32_t gpu_control;
+	uint32_t gpu_div_control;
+	uint8_t gpu_flag_z, gpu_flag_n, gpu_flag_c;
+	uint32_t gpu_reg_bank_0[32];
+	uint32_t gpu_reg_bank_1[32];
+	uint32_t * gpu_reg;
+	uint32_t * gpu_alternate_reg;
+	uint32_t gpu_instruction;
+	uint32_t gpu_opcode_first_parameter;
+	uint32_t gpu_opcode_second_parameter;
+	uint32_t gpu_opcode_use[64];
+	uint32_t gpu_in_exec;
+	uint32_t gpu_releaseTimeSlice_flag;
+	uint32_t gpuIRQPending;						// Interrupts latched & enabled, out of an interrupt
+	bool tripwire;
+	// Host thread
+	SDL_Thread * gpuThread;
+	SDL_mutex * gpuMutex;
+	SDL_cond * gpuCond;
+	bool gpuThreadQuit;
+	int gpuSliceState;
+	int32_t gpuSliceCycles;
+	std::atomic<bool> gpuSliceActive;			// Set while the GPU thread may be ahead of the 68K; read by any thread
+	bool gpuSliceRewound;
+	bool gpuM68KDone;
+	std::atomic<bool> gpuSliceAbort;
+	bool gpuBusGranted;							// Only used by the GPU thread
+	GPUSnapshot gpuSnapshot;
+	GPUUndoEntry gpuUndoLog[GPU_UNDO_LOG_SIZE];
+	uint32_t gpuUndoCount;
+	uint32_t gpuSliceCount, gpuRewindCount;
+	// Idle loops skip
+	bool gpuIdleSkip;
+	bool gpuIdleProbe;							// An iteration of a loop is being checked
+	bool gpuIdlePure;							// Registers written & memory read without side effect only
+	uint32_t gpuIdlePC, gpuIdleFailPC;
+	int32_t gpuIdleCycles;
+	uint32_t gpuIdleFlags;
+	uint32_t gpuIdleRegs[64];
+};
+
+// Exported vars (of the current machine, see machine.h)
+
+#define gpu_reg_bank_0	(jaguarMachine->gpu.gpu_reg_bank_0)
+#define gpu_reg_bank_1	(jaguarMachine->gpu.gpu_reg_bank_1)
 
 #endif	// __GPU_H__
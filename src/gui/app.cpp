@@ -19,6 +19,16 @@
 // JPM  Sept./2017  Added the 'Rx' word to the emulator name, updated the credits line, added option (--es-all, --es-ui, --es-alpine & --es-debugger) to support the erase settings
 // JPM   Oct./2018  Added the Rx version's contact in the help text, added timer initialisation in the SDL_Init
 // JPM   Apr./2019  Fixed a command line option duplication
+// JPM   Oct./2026  Added options (--gpu-thread & --no-gpu-thread) to run the GPU on its own host thread, and (--render-thread & --no-render-thread)
+// JPM   Oct./2026  The emulated machine context is created before the GUI
+// JPM   Oct./2026  Added options (--capture-y4m & --capture-png) to capture audio & video
+// JPM   Oct./2026  Added options (--idle-skip & --no-idle-skip) to fast-forward the idle loops
+// JPM   Oct./2026  Added options (--stats-socket & --stats-csv) to get the performance counters
+// JPM   Oct./2026  Added options (--trace, --no-trace & --trace-dump) for the execution trace
+// JPM   Oct./2026  Added option (--heatmap) for the bus heatmap
+// JPM   Oct./2026  Added options (--op-thread & --no-op-thread) to render the next line ahead on the OP host thread
+// JPM   Oct./2026  Added options (--sync-audio & --sync-clock) for the frames pacing, and (--turbo & --uncapped) for the speed
+// JPM   Oct./2026  Gamepads input thread started with the application
 //
 
 #include "app.h"
@@ -27,6 +37,7 @@
 #include <QtWidgets/QApplication>
 #include "gamepad.h"
 #include "log.h"
+#include "machine.h"
 #include "mainwin.h"
 #include "profile.h"
 #include "settings.h"
@@ -111,6 +122,11 @@ int main(int argc, char * argv[])
 	{
 		WriteLog("VJ: Could not initialize the SDL library: %s\n", SDL_GetError());
 	}
+	else if (!JaguarMachineCreate())
+	{
+		WriteLog("VJ: Could not create the emulated machine!\n");
+		SDL_Quit();
+	}
 	else
 	{
 		WriteLog("VJ: SDL (joystick, audio) successfully initialized.\n");
@@ -118,9 +134,12 @@ int main(int argc, char * argv[])
 		App app(argc, argv);					// Declare an instance of the application
 		Gamepad::AllocateJoysticks();
 		AutoConnectProfiles();
+		Gamepad::StartInputThread(jaguarMachine);
 		retVal = app.exec();					// And run it!
+		Gamepad::StopInputThread();
 		DBGManager_Close();
 		Gamepad::DeallocateJoysticks();
+		JaguarMachineDestroy(jaguarMachine);
 
 		// Free SDL components last...!
 		SDL_QuitSubSystem(SDL_INIT_JOYSTICK | SDL_INIT_AUDIO);
@@ -196,11 +215,39 @@ bool ParseCommandLine(int argc, char * argv[])
 				"   --no-bios         Do not use Jaguar BIOS\n"
 				"   --gpu         -g  Enable GPU\n"
 				"   --no-gpu          Disable GPU\n"
+				"   --gpu-thread      Run GPU on its own host thread\n"
+				"   --no-gpu-thread   Run GPU along with the 68K (default)\n"
+				"   --op-thread       Render the next line ahead on the OP host thread\n"
+				"   --no-op-thread    Render the lines when they are reached (default)\n"
+				"   --sync-audio      Pace the frames on the host audio (default)\n"
+				"   --sync-clock      Pace the frames on the host clock\n"
+				"   --turbo=<n>       Run <n> times faster (1 to 8)\n"
+				"   --uncapped        Run as fast as possible\n"
 				"   --dsp         -d  Enable DSP\n"
 				"   --no-dsp          Disable DSP\n"
+				"   --idle-skip       Fast-forward the idle loops (default)\n"
+				"   --no-idle-skip    Run the idle loops cycle by cycle\n"
 				"   --fullscreen  -f  Start in full screen mode\n"
 				"   --blur        -B  Enable GL bilinear filter\n"
 				"   --no-blur         Disable GL bilinear filtering\n"
+				"   --render-thread   Display video output from its own thread\n"
+				"   --no-render-thread\n"
+				"                     Display video output from the GUI (default)\n"
+				"   --capture-y4m     Capture audio & video in WAV & Y4M files\n"
+				"   --capture-png     Capture audio & video in WAV & PNG files\n"
+				"   --stats-socket=<path>\n"
+				"                     Give the performance counters of the last frame,\n"
+				"                     in JSON, on a UNIX socket\n"
+				"   --stats-csv=<file>\n"
+				"                     Write the performance counters of each frame in a\n"
+				"                     CSV file\n"
+				"   --trace           Record the execution trace (default)\n"
+				"   --no-trace        Do not record the execution trace\n"
+				"   --trace-dump=<file>\n"
+				"                     Write the execution trace in a file on a 68K\n"
+				"                     exception or a breakpoint\n"
+				"   --heatmap=<file>  Write the bus accesses of each master, by 4 KB\n"
+				"                     buckets, in a CSV file at the end\n"
 				"   --log         -l  Create and use log file\n"
 				"   --no-log          Do not use log file (default)\n"
 				"   --help        -h  Show this message\n"
@@ -286,6 +333,20 @@ bool ParseCommandLine(int argc, char * argv[])
 			vjs.DRAM_size = 0x800000;
 		}
 
+		// Performance counters endpoint
+		if (strncmp(argv[i], "--stats-socket=", 15) == 0)
+		{
+			strncpy(vjs.statsSocket, argv[i] + 15, MAX_PATH - 1);
+			printf("Performance counters on socket \"%s\".\n", vjs.statsSocket);
+		}
+
+		// Performance counters time series
+		if (strncmp(argv[i], "--stats-csv=", 12) == 0)
+		{
+			strncpy(vjs.statsCSV, argv[i] + 12, MAX_PATH - 1);
+			printf("Performance counters written to \"%s\".\n", vjs.statsCSV);
+		}
+
 		// Check for filename
 		if (argv[i][0] != '-')
 		{
@@ -343,6 +404,93 @@ void ParseOptions(int argc, char * argv[])
 			vjs.GPUEnabled = false;
 		}
 
+		// GPU host thread enable
+		if (strcmp(argv[i], "--gpu-thread") == 0)
+		{
+			vjs.threadedGPU = true;
+		}
+
+		// GPU host thread disable
+		if (strcmp(argv[i], "--no-gpu-thread") == 0)
+		{
+			vjs.threadedGPU = false;
+		}
+
+		// OP host thread enable
+		if (strcmp(argv[i], "--op-thread") == 0)
+		{
+			vjs.threadedOP = true;
+		}
+
+		// OP host thread disable
+		if (strcmp(argv[i], "--no-op-thread") == 0)
+		{
+			vjs.threadedOP = false;
+		}
+
+		// Frames paced by the host audio
+		if (strcmp(argv[i], "--sync-audio") == 0)
+		{
+			vjs.frameSync = FS_AUDIO;
+		}
+
+		// Frames paced by the host clock
+		if (strcmp(argv[i], "--sync-clock") == 0)
+		{
+			vjs.frameSync = FS_CLOCK;
+		}
+
+		// Speed multiplier
+		if (strncmp(argv[i], "--turbo=", 8) == 0)
+		{
+			uint32_t turbo = (uint32_t)atoi(argv[i] + 8);
+			vjs.turbo = ((turbo < 1) ? 1 : ((turbo > TURBO_MAX) ? TURBO_MAX : turbo));
+		}
+
+		// No speed limit
+		if (strcmp(argv[i], "--uncapped") == 0)
+		{
+			vjs.turbo = 0;
+		}
+
+		// Idle loops skip enable
+		if (strcmp(argv[i], "--idle-skip") == 0)
+		{
+			vjs.idleSkip = true;
+		}
+
+		// Idle loops skip disable
+		if (strcmp(argv[i], "--no-idle-skip") == 0)
+		{
+			vjs.idleSkip = false;
+		}
+
+		// Execution trace enable
+		if (strcmp(argv[i], "--trace") == 0)
+		{
+			vjs.trace = true;
+		}
+
+		// Execution trace disable
+		if (strcmp(argv[i], "--no-trace") == 0)
+		{
+			vjs.trace = false;
+		}
+
+		// Execution trace file
+		if (strncmp(argv[i], "--trace-dump=", 13) == 0)
+		{
+			strncpy(vjs.traceDump, argv[i] + 13, MAX_PATH - 1);
+			printf("Execution trace written to \"%s\" on a crash or a breakpoint.\n", vjs.traceDump);
+		}
+
+		// Bus heatmap file
+		if (strncmp(argv[i], "--heatmap=", 10) == 0)
+		{
+			strncpy(vjs.heatmapFile, argv[i] + 10, MAX_PATH - 1);
+			printf("Bus heatmap written to \"%s\".\n", vjs.heatmapFile);
+		}
+
 		// DSP enable
 		if ((strcmp(argv[i], "--dsp") == 0) || (strcmp(argv[i], "-d") == 0))
 		{
@@ -374,6 +522,30 @@ void ParseOptions(int argc, char * argv[])
 		{
 			vjs.glFilter = 0;
 		}
+
+		// Render thread enable
+		if (strcmp(argv[i], "--render-thread") == 0)
+		{
+			vjs.threadedRendering = true;
+		}
+
+		// Render thread disable
+		if (strcmp(argv[i], "--no-render-thread") == 0)
+		{
+			vjs.threadedRendering = false;
+		}
+
+		// Audio & video capture in Y4M
+		if (strcmp(argv[i], "--capture-y4m") == 0)
+		{
+			vjs.captureType = CT_Y4M;
+		}
+
+		// Audio & video capture in PNG
+		if (strcmp(argv[i], "--capture-png") == 0)
+		{
+			vjs.captureType = CT_PNG;
+		}
 	}
 }
 
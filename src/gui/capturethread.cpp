@@ -0,0 +1,312 @@
+//
+// capturethread.cpp - Audio & video capture thread
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+
+#include "capturethread.h"
+
+#include <QtGui/QImage>
+#include <string.h>
+#include <time.h>
+#include "dac.h"
+#include "log.h"
+#include "settings.h"
+
+
+// Capture receiving the samples of the host audio (there is only one)
+static CaptureThread * audioCapture = NULL;
+
+static void CaptureAudioSamples(uint16_t * buffer, int length)
+{
+	audioCapture->PushAudio(buffer, length);
+}
+
+
+CaptureThread::CaptureThread(void): QThread(), abort(false), captureType(CT_NONE), ntscRate(true),
+	videoFile(NULL), audioFile(NULL), videoWidth(0), videoHeight(0), frameCount(0), audioBytes(0)
+{
+	basename[0] = 0;
+}
+
+
+CaptureThread::~CaptureThread()
+{
+	Stop();
+}
+
+
+//
+// Open the capture files and start the thread
+// Files are named as the screenshots, with a .y4m (or _nnnnnn.png) and a .wav extension
+//
+bool CaptureThread::Start(int type, const char * path, bool ntsc)
+{
+	time_t now = time(0);
+	struct tm tstruct = *localtime(&now);
+	char filename[300];
+
+	captureType = type;
+	ntscRate = ntsc;
+	abort = false;
+	videoWidth = videoHeight = frameCount = audioBytes = 0;
+	snprintf(basename, sizeof(basename), "%svj_%i%i%i_%i%i%i", path, tstruct.tm_year, tstruct.tm_mon, tstruct.tm_mday, tstruct.tm_hour, tstruct.tm_min, tstruct.tm_sec);
+
+	if (captureType == CT_Y4M)
+	{
+		sprintf(filename, "%s.y4m", basename);
+
+		if (!(videoFile = fopen(filename, "wb")))
+		{
+			WriteLog("Capture: Could not create %s\n", filename);
+			return false;
+		}
+	}
+
+	// WAV header is written again, with the right sizes, once the capture is over
+	sprintf(filename, "%s.wav", basename);
+
+	if (!(audioFile = fopen(filename, "wb")))
+	{
+		WriteLog("Capture: Could not create %s\n", filename);
+		CloseFiles();
+		return false;
+	}
+
+	static const uint8_t blankHeader[44] = { 0 };
+	fwrite(blankHeader, 1, sizeof(blankHeader), audioFile);
+
+	WriteLog("Capture: Started to %s%s & %s.wav\n", basename, (captureType == CT_Y4M ? ".y4m" : "_*.png"), basename);
+	start();
+	audioCapture = this;
+	DACSetCaptureCallback(CaptureAudioSamples);
+	return true;
+}
+
+
+//
+// Stop the thread once everything in the queue has been written, and close the files
+//
+void CaptureThread::Stop(void)
+{
+	mutex.lock();
+	abort = true;
+	notEmpty.wakeOne();
+	notFull.wakeAll();
+	mutex.unlock();
+
+	// Audio thread may have been waiting in Push(), so this is done once abort is set
+	if (audioCapture == this)
+	{
+		DACSetCaptureCallback(NULL);
+		audioCapture = NULL;
+	}
+
+	wait();
+	CloseFiles();
+}
+
+
+//
+// Queue a copy of a completed frame; pitch is in pixels
+//
+void CaptureThread::PushFrame(const uint32_t * buffer, uint32_t width, uint32_t height, uint32_t pitch)
+{
+	CaptureItem item;
+	item.audio = false;
+	item.width = (width < pitch ? width : pitch);
+	item.height = height;
+	item.data.resize(item.width * item.height * sizeof(uint32_t));
+	uint32_t * pixels = (uint32_t *)item.data.data();
+
+	for(uint32_t y=0; y<item.height; y++)
+		memcpy(pixels + (y * item.width), buffer + (y * pitch), item.width * sizeof(uint32_t));
+
+	Push(item);
+}
+
+
+//
+// Queue a copy of the samples played by the host audio; length is in bytes
+//
+void CaptureThread::PushAudio(const uint16_t * buffer, int length)
+{
+	CaptureItem item;
+	item.audio = true;
+	item.width = item.height = 0;
+	item.data = QByteArray((const char *)buffer, length);
+	Push(item);
+}
+
+
+// The emulation only waits for the thread when the queue is full
+void CaptureThread::Push(CaptureItem & item)
+{
+	QMutexLocker locker(&mutex);
+
+	while ((queue.size() >= CAPTURE_QUEUE_SIZE) && !abort)
+		notFull.wait(&mutex);
+
+	if (abort)
+		return;
+
+	queue.enqueue(item);
+	notEmpty.wakeOne();
+}
+
+
+//
+// Conversion & compression of the frames are done here, away from the emulation
+//
+void CaptureThread::run(void)
+{
+	while (true)
+	{
+		mutex.lock();
+
+		while (queue.isEmpty() && !abort)
+			notEmpty.wait(&mutex);
+
+		if (queue.isEmpty())
+		{
+			mutex.unlock();
+			break;
+		}
+
+		CaptureItem item = queue.dequeue();
+		notFull.wakeOne();
+		mutex.unlock();
+
+		if (item.audio)
+			WriteAudio(item);
+		else if (captureType == CT_Y4M)
+			WriteFrameY4M(item);
+		else
+			WriteFramePNG(item);
+	}
+}
+
+
+//
+// Y4M frame, in 4:4:4 studio range YCbCr (BT.601)
+// The frame size is the one of the first frame; the next ones are cropped or padded with black
+//
+void CaptureThread::WriteFrameY4M(CaptureItem & item)
+{
+	if (!videoWidth)
+	{
+		videoWidth = item.width;
+		videoHeight = item.height;
+		// A Jaguar frame is a field, at 59.94 or 50 Hz
+		fprintf(videoFile, "YUV4MPEG2 W%u H%u F%s Ip A1:1 C444\n", videoWidth, videoHeight, (ntscRate ? "60000:1001" : "50:1"));
+		planes.resize(videoWidth * videoHeight * 3);
+	}
+
+	uint32_t planeSize = videoWidth * videoHeight;
+	uint8_t * yPlane = (uint8_t *)planes.data();
+	uint8_t * cbPlane = yPlane + planeSize;
+	uint8_t * crPlane = cbPlane + planeSize;
+	const uint32_t * pixels = (const uint32_t *)item.data.constData();
+
+	for(uint32_t y=0; y<videoHeight; y++)
+	{
+		for(uint32_t x=0; x<videoWidth; x++)
+		{
+			uint32_t offset = (y * videoWidth) + x;
+
+			if ((x >= item.width) || (y >= item.height))
+			{
+				yPlane[offset] = 16;
+				cbPlane[offset] = crPlane[offset] = 128;
+				continue;
+			}
+
+			// Pixels are 0xRRGGBBAA
+			uint32_t pixel = pixels[(y * item.width) + x];
+			int r = pixel >> 24, g = (pixel >> 16) & 0xFF, b = (pixel >> 8) & 0xFF;
+			yPlane[offset] = (uint8_t)((((66 * r) + (129 * g) + (25 * b) + 128) >> 8) + 16);
+			cbPlane[offset] = (uint8_t)((((-38 * r) - (74 * g) + (112 * b) + 128) >> 8) + 128);
+			crPlane[offset] = (uint8_t)((((112 * r) - (94 * g) - (18 * b) + 128) >> 8) + 128);
+		}
+	}
+
+	fputs("FRAME\n", videoFile);
+	fwrite(planes.constData(), 1, planes.size(), videoFile);
+	frameCount++;
+}
+
+
+void CaptureThread::WriteFramePNG(CaptureItem & item)
+{
+	char filename[300];
+	QImage image(item.width, item.height, QImage::Format_RGB32);
+	const uint32_t * pixels = (const uint32_t *)item.data.constData();
+
+	for(uint32_t y=0; y<item.height; y++)
+	{
+		QRgb * line = (QRgb *)image.scanLine(y);
+
+		for(uint32_t x=0; x<item.width; x++)
+			line[x] = 0xFF000000 | (pixels[(y * item.width) + x] >> 8);
+	}
+
+	sprintf(filename, "%s_%06u.png", basename, frameCount++);
+
+	if (!image.save(filename, "PNG"))
+		WriteLog("Capture: Could not write %s\n", filename);
+}
+
+
+// WAV samples are little endian
+void CaptureThread::WriteAudio(CaptureItem & item)
+{
+	int16_t * samples = (int16_t *)item.data.data();
+	int count = item.data.size() / sizeof(int16_t);
+
+	for(int i=0; i<count; i++)
+		samples[i] = qToLittleEndian(samples[i]);
+
+	fwrite(samples, sizeof(int16_t), count, audioFile);
+	audioBytes += count * sizeof(int16_t);
+}
+
+
+//
+// Write the WAV header (16 bit stereo PCM), now that the data size is known
+//
+void CaptureThread::CloseFiles(void)
+{
+	if (videoFile)
+	{
+		fclose(videoFile);
+		videoFile = NULL;
+	}
+
+	if (audioFile)
+	{
+		uint8_t header[44];
+		memcpy(header, "RIFF", 4);
+		qToLittleEndian<quint32>(36 + audioBytes, header + 4);
+		memcpy(header + 8, "WAVEfmt ", 8);
+		qToLittleEndian<quint32>(16, header + 16);
+		qToLittleEndian<quint16>(1, header + 20);
+		qToLittleEndian<quint16>(2, header + 22);
+		qToLittleEndian<quint32>(DAC_AUDIO_RATE, header + 24);
+		qToLittleEndian<quint32>(DAC_AUDIO_RATE * 4, header + 28);
+		qToLittleEndian<quint16>(4, header + 32);
+		qToLittleEndian<quint16>(16, header + 34);
+		memcpy(header + 36, "data", 4);
+		qToLittleEndian<quint32>(audioBytes, header + 40);
+		fseek(audioFile, 0, SEEK_SET);
+		fwrite(header, 1, sizeof(header), audioFile);
+		fclose(audioFile);
+		audioFile = NULL;
+		WriteLog("Capture: Stopped after %u frames & %u audio samples\n", frameCount, audioBytes / 4);
+	}
+}
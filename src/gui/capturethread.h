@@ -0,0 +1,57 @@
+//
+// capturethread.h: Audio & video capture thread class definition
+//
+
+#ifndef __CAPTURETHREAD_H__
+#define __CAPTURETHREAD_H__
+
+#include <QtCore/QtCore>
+#include <stdio.h>
+#include <stdint.h>
+
+#define CAPTURE_QUEUE_SIZE	32					// Frames & audio chunks waiting to be written
+
+struct CaptureItem
+{
+	bool audio;
+	uint32_t width, height;						// Frame size in pixels (video only)
+	QByteArray data;							// Packed pixels, or 16 bit left/right samples pairs
+};
+
+class CaptureThread: public QThread
+{
+	public:
+		CaptureThread(void);
+		~CaptureThread();
+		bool Start(int type, const char * path, bool ntsc);
+		void Stop(void);
+		void PushFrame(const uint32_t * buffer, uint32_t width, uint32_t height, uint32_t pitch);
+		void PushAudio(const uint16_t * buffer, int length);
+
+	protected:
+		void run(void);
+
+	private:
+		void Push(CaptureItem & item);
+		void WriteFrameY4M(CaptureItem & item);
+		void WriteFramePNG(CaptureItem & item);
+		void WriteAudio(CaptureItem & item);
+		void CloseFiles(void);
+
+	private:
+		QQueue<CaptureItem> queue;
+		QMutex mutex;
+		QWaitCondition notEmpty, notFull;
+		bool abort;
+		int captureType;
+		bool ntscRate;
+		char basename[256];
+		FILE * videoFile;
+		FILE * audioFile;
+		uint32_t videoWidth, videoHeight;		// Y4M frame size, set by the first frame
+		uint32_t frameCount;
+		uint32_t audioBytes;
+		QByteArray planes;						// Y, Cb & Cr planes of a Y4M frame
+};
+
+#endif	// __CAPTURETHREAD_H__
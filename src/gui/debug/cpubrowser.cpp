@@ -12,6 +12,7 @@
 // JLH  08/14/2012  Created this file
 // JPM  08/09/2017  Added windows display detection in order to avoid the refresh
 // JPM  10/13/2018  Added BPM hit counts
+// JPM   Oct./2026  Added BPM condition
 //
 
 // STILL TO DO:
@@ -20,16 +21,19 @@
 #include "cpubrowser.h"
 //#include "memory.h"
 #include "m68000/m68kinterface.h"
+#include "brkcond.h"
+#include "debugger/DBGManager.h"
 #include "dsp.h"
 #include "gpu.h"
 #include "jaguar.h"
+#include "machine.h"
 
 
 CPUBrowserWindow::CPUBrowserWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt::Dialog),
 	layout(new QVBoxLayout), text(new QLabel),
 	refresh(new QPushButton(tr("Refresh"))),
 	bpm(new QCheckBox(tr("BPM"))), bpmAddress(new QLineEdit),
-	bpmContinue(new QPushButton(tr("Resume")))
+	bpmCond(new QLineEdit), bpmContinue(new QPushButton(tr("Resume")))
 {
 	setWindowTitle(tr("CPU Browser"));
 
@@ -38,9 +42,11 @@ CPUBrowserWindow::CPUBrowserWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt:
 
 	// Limit input to 6 hex digits
 	bpmAddress->setInputMask("hhhhhh");
+	bpmCond->setPlaceholderText("Condition (optional)");
 	QHBoxLayout * hbox1 = new QHBoxLayout;
 	hbox1->addWidget(bpm);
 	hbox1->addWidget(bpmAddress);
+	hbox1->addWidget(bpmCond);
 	hbox1->addWidget(bpmContinue);
 
 	QFont fixedFont("Lucida Console", 8, QFont::Normal);
@@ -57,6 +63,7 @@ CPUBrowserWindow::CPUBrowserWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt:
 	connect(refresh, SIGNAL(clicked()), this, SLOT(RefreshContents()));
 	connect(bpm, SIGNAL(clicked(bool)), this, SLOT(HandleBPM(bool)));
 	connect(bpmAddress, SIGNAL(textChanged(const QString &)), this, SLOT(HandleBPMAddress(const QString &)));
+	connect(bpmCond, SIGNAL(textChanged(const QString &)), this, SLOT(HandleBPMCondition(const QString &)));
 	connect(bpmContinue, SIGNAL(clicked()), this, SLOT(HandleBPMContinue()));
 }
 
@@ -287,6 +294,7 @@ void CPUBrowserWindow::ResetBPM(void)
 {
 	DisableBPM();
 	bpmAddress->setText("");
+	bpmCond->setText("");
 }
 
 
@@ -315,6 +323,27 @@ void CPUBrowserWindow::HandleBPMAddress(const QString & newText)
 }
 
 
+// Breakpoint condition compiled, and kept only if it is valid
+void CPUBrowserWindow::HandleBPMCondition(const QString & newText)
+{
+	char error[64];
+	BrkCondition * condition = NULL;
+
+	if (!newText.trimmed().isEmpty() && !(condition = BrkCondCompile(newText.toLatin1().data(), DBGManager_GetAdrFromName, error, sizeof(error))))
+	{
+		bpmCond->setStyleSheet("color: red");
+		bpmCond->setToolTip(error);
+	}
+	else
+	{
+		bpmCond->setStyleSheet("color: black");
+		bpmCond->setToolTip("");
+		BrkCondFree(bpmCondition);
+		bpmCondition = condition;
+	}
+}
+
+
 void CPUBrowserWindow::HandleBPMContinue(void)
 {
 	M68KDebugResume();
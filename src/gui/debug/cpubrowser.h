@@ -30,6 +30,7 @@ class CPUBrowserWindow: public QWidget
 //		void DefineAllKeys(void);
 		void HandleBPM(bool);
 		void HandleBPMAddress(const QString &);
+		void HandleBPMCondition(const QString &);
 
 	protected:
 		void keyPressEvent(QKeyEvent *);
@@ -41,6 +42,7 @@ class CPUBrowserWindow: public QWidget
 		QPushButton * refresh;
 		QCheckBox * bpm;
 		QLineEdit * bpmAddress;
+		QLineEdit * bpmCond;
 		QPushButton * bpmContinue;
 
 //		int32_t memBase;
@@ -9,6 +9,7 @@
 // Who  When        What
 // ---  ----------  -------------------------------------------------------------
 // JLH  12/01/2012  Created this file
+// JPM   Oct./2026  Instructions from the disassembly cache
 //
 
 // STILL TO DO:
@@ -19,6 +20,7 @@
 #include "m68000/m68kinterface.h"
 #include "dsp.h"
 #include "gpu.h"
+#include "machine.h"
 
 
 M68KDasmBrowserWindow::M68KDasmBrowserWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt::Dialog),
@@ -61,34 +63,17 @@ void M68KDasmBrowserWindow::RefreshContents(void)
 	char string[1024];//, buf[64];
 	QString s;
 
-	char buffer[2048];
-	int pc = memBase, oldpc;
+	int pc = memBase;
 
 	if (isVisible())
 	{
 		for (uint32_t i = 0; i < 32; i++)
 		{
-			oldpc = pc;
-			pc += m68k_disassemble(buffer, pc, 0, 1);
-			//		WriteLog("%06X: %s\n", oldpc, buffer);
-			sprintf(string, "%06X: %s<br>", oldpc, buffer);
-
-			buffer[0] = 0;	// Clear string
-			char singleCharString[2] = { 0, 0 };
-
-			for (int j = 0; j < strlen(string); j++)
-			{
-				if (string[j] == 32)
-					strcat(buffer, "&nbsp;");
-				else
-				{
-					singleCharString[0] = string[j];
-					strcat(buffer, singleCharString);
-				}
-			}
-
-			//		s += QString(string);
-			s += QString(buffer);
+			DasmCacheEntry * entry = DasmCacheGet(DASMCACHE_M68K, pc, 1);
+			//		WriteLog("%06X: %s\n", pc, entry->text);
+			sprintf(string, "%06X: %s<br>", pc, entry->text);
+			pc += entry->length;
+			s += QString(string).replace(' ', "&nbsp;");
 		}
 
 		text->clear();
@@ -15,7 +15,7 @@
 //
 
 #include "memorybrowser.h"
-#include "memory.h"
+#include "machine.h"
 
 
 MemoryBrowserWindow::MemoryBrowserWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt::Dialog),
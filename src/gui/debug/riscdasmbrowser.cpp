@@ -9,6 +9,7 @@
 // Who  When        What
 // ---  ----------  -------------------------------------------------------------
 // JLH  01/22/2012  Created this file
+// JPM   Oct./2026  Instructions from the disassembly cache
 //
 
 // STILL TO DO:
@@ -18,7 +19,7 @@
 //#include "memory.h"
 #include "dsp.h"
 #include "gpu.h"
-#include "jagdasm.h"
+#include "machine.h"
 
 
 RISCDasmBrowserWindow::RISCDasmBrowserWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt::Dialog),
@@ -63,32 +64,16 @@ void RISCDasmBrowserWindow::RefreshContents(void)
 	char string[1024];//, buf[64];
 	QString s;
 
-	char buffer[2048];
-	int pc = memBase, oldpc;
+	int pc = memBase;
 
 	if (isVisible())
 	{
 		for (uint32_t i = 0; i < 32; i++)
 		{
-			oldpc = pc;
-			pc += dasmjag(JAGUAR_GPU, buffer, pc);
-			sprintf(string, "%06X: %s<br>", oldpc, buffer);
-
-			buffer[0] = 0;	// Clear string
-			char singleCharString[2] = { 0, 0 };
-
-			for (uint j = 0; j < strlen(string); j++)
-			{
-				if (string[j] == 32)
-					strcat(buffer, "&nbsp;");
-				else
-				{
-					singleCharString[0] = string[j];
-					strcat(buffer, singleCharString);
-				}
-			}
-
-			s += QString(buffer);
+			DasmCacheEntry * entry = DasmCacheGet(DASMCACHE_GPU, pc);
+			sprintf(string, "%06X: %s<br>", pc, entry->text);
+			pc += entry->length;
+			s += QString(string).replace(' ', "&nbsp;");
 		}
 
 		text->clear();
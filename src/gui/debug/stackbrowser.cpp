@@ -15,7 +15,7 @@
 //
 
 #include "stackbrowser.h"
-#include "memory.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
 #include "settings.h"
 
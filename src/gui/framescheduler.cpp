@@ -0,0 +1,152 @@
+//
+// framescheduler.cpp - Frames pacing
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// The frames are due at fixed times from the frame 0, counted in nanoseconds on
+// the host monotonic clock (PerfHostTime): a frame lasts 525 halflines of 31.777... usec in
+// NTSC (59.94 Hz), 625 halflines of 32 usec in PAL (50 Hz). As the times do not
+// depend on the previous frame, the timer granularity gives jitter, but no drift.
+// At the normal speed, the host clock is pulled toward the audio clock, so the
+// DSP (run by the host audio) & the other processors stay together.
+//
+
+#include "framescheduler.h"
+
+#include "dac.h"
+#include "perfcounters.h"
+#include "settings.h"
+
+#define FRAME_LATE			4					// Frames late before the backlog is dropped
+#define AUDIO_LOCK_GAIN		16					// Frames to catch up the audio clock
+#define AUDIO_STALE_TIME	200000000			// Audio clock left (ns) without a buffer asked (one is asked every 42.67 msec)
+
+
+FrameScheduler::FrameScheduler(void): frequency(PerfHostFrequency()), startTicks(PerfHostTime()),
+	start(0), frames(0), ntsc(true), turbo(1), audioLocked(false), audioOffset(0), lastFrame(0), frameTimePointer(0)
+{
+	for(int i=0; i<FRAME_TIMES_SIZE; i++)
+		frameTimes[i] = 0;
+
+	Reset();
+}
+
+
+// Host time in nanoseconds
+int64_t FrameScheduler::Now(void)
+{
+	int64_t ticks = (int64_t)(PerfHostTime() - startTicks);
+	return ((ticks / (int64_t)frequency) * 1000000000) + (((ticks % (int64_t)frequency) * 1000000000) / (int64_t)frequency);
+}
+
+
+// Time (ns) of a frame from the frame 0, at the current speed
+int64_t FrameScheduler::FrameTime(int64_t frame)
+{
+	return (frame * (ntsc ? 50050000 : 60000000)) / (3 * turbo);
+}
+
+
+//
+// Audio clock (ns), extrapolated from the last buffer asked by the host audio
+// Returns false if there is no host audio playing
+//
+bool FrameScheduler::AudioTime(int64_t now, int64_t * time)
+{
+	uint64_t samples, hostTicks;
+
+	if (!DACGetClock(&samples, &hostTicks))
+		return false;
+
+	int64_t ticks = (int64_t)(hostTicks - startTicks);
+	int64_t bufferTime = ((ticks / (int64_t)frequency) * 1000000000) + (((ticks % (int64_t)frequency) * 1000000000) / (int64_t)frequency);
+
+	if ((now - bufferTime) > AUDIO_STALE_TIME)
+		return false;
+
+	*time = (int64_t)((samples * 1000000000) / DAC_AUDIO_RATE) + (now - bufferTime);
+	return true;
+}
+
+
+// Count the frames again from now (start, resume, speed or video standard change)
+void FrameScheduler::Reset(void)
+{
+	start = lastFrame = Now();
+	frames = 0;
+	ntsc = vjs.hardwareTypeNTSC;
+	turbo = vjs.turbo;
+	audioLocked = false;
+}
+
+
+//
+// A frame has been emulated; returns the time (ns) to wait before the next one
+//
+int64_t FrameScheduler::FrameDone(void)
+{
+	int64_t now = Now();
+
+	// Frames times for the FPS
+	frameTimePointer = (frameTimePointer + 1) % FRAME_TIMES_SIZE;
+	frameTimes[frameTimePointer] = now - lastFrame;
+	lastFrame = now;
+
+	if ((ntsc != vjs.hardwareTypeNTSC) || (turbo != vjs.turbo))
+		Reset();
+
+	frames++;
+
+	// Uncapped: the next frame is run at once
+	if (!turbo)
+		return 0;
+
+	int64_t audioTime;
+
+	if ((vjs.frameSync == FS_AUDIO) && (turbo == 1) && AudioTime(now, &audioTime))
+	{
+		if (!audioLocked)
+		{
+			audioOffset = (now - start) - audioTime;
+			audioLocked = true;
+		}
+		else
+			start -= ((audioTime + audioOffset) - (now - start)) / AUDIO_LOCK_GAIN;
+	}
+	else
+		audioLocked = false;
+
+	int64_t wait = FrameTime(frames) - (now - start);
+
+	// Too late to catch up (slow host, or emulation held), the late frames are not run faster
+	if (wait < -FrameTime(FRAME_LATE))
+	{
+		start = now - FrameTime(frames);
+		audioOffset += wait;
+		wait = 0;
+	}
+
+	return (wait < 0 ? 0 : (wait > FrameTime(2) ? FrameTime(2) : wait));
+}
+
+
+// Frames per 10 seconds, over the last frames (so we can have 1 decimal)
+uint32_t FrameScheduler::FramesPerSecond(void)
+{
+	int64_t elapsedTime = 0;
+
+	for(int i=0; i<FRAME_TIMES_SIZE; i++)
+		elapsedTime += frameTimes[i];
+
+	// elapsedTime must be non-zero
+	if (elapsedTime <= 0)
+		return 0;
+
+	return (uint32_t)(((int64_t)FRAME_TIMES_SIZE * 10000000000LL) / elapsedTime);
+}
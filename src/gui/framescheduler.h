@@ -0,0 +1,40 @@
+//
+// framescheduler.h: Frames pacing class definition
+//
+
+#ifndef __FRAMESCHEDULER_H__
+#define __FRAMESCHEDULER_H__
+
+#include <stdint.h>
+
+#define FRAME_TIMES_SIZE	32					// Frames times kept for the FPS
+
+class FrameScheduler
+{
+	public:
+		FrameScheduler(void);
+		void Reset(void);
+		int64_t FrameDone(void);
+		uint32_t FramesPerSecond(void);
+		bool AudioLocked(void) { return audioLocked; }
+
+	private:
+		int64_t Now(void);
+		int64_t FrameTime(int64_t frame);
+		bool AudioTime(int64_t now, int64_t * time);
+
+	private:
+		uint64_t frequency;						// Host ticks per second
+		uint64_t startTicks;
+		int64_t start;							// Host time (ns) of the frame 0
+		int64_t frames;							// Frames since the frame 0
+		bool ntsc;
+		uint32_t turbo;
+		bool audioLocked;
+		int64_t audioOffset;					// Host time (ns) of the first audio sample
+		int64_t lastFrame;
+		uint32_t frameTimePointer;
+		int64_t frameTimes[FRAME_TIMES_SIZE];
+};
+
+#endif	// __FRAMESCHEDULER_H__
@@ -9,10 +9,15 @@
 // Who  When        What
 // ---  ----------  ------------------------------------------------------------
 // JLH  01/05/2013  Created this file
+// JPM   Oct./2026  Gamepads polled by an input thread, their buttons given to the machine on a change
 //
 
 #include "gamepad.h"
+#include "joystick.h"
 #include "log.h"
+#include "machine.h"
+#include "profile.h"
+#include "settings.h"
 
 
 // Class member initialization
@@ -25,6 +30,10 @@
 /*static*/ bool Gamepad::button[8][256];
 /*static*/ uint8_t Gamepad::hat[8][32];
 /*static*/ int32_t Gamepad::axis[8][32];
+/*static*/ SDL_Thread * Gamepad::inputThread = NULL;
+/*static*/ volatile bool Gamepad::inputThreadQuit = false;
+/*static*/ uint32_t Gamepad::inputPolls = 0;
+/*static*/ uint32_t Gamepad::inputChanges = 0;
 
 
 Gamepad::Gamepad(void)//: numJoysticks(0)
@@ -202,22 +211,147 @@ int Gamepad::GetJoystickID(void)
 }
 
 
+//
+// Without the input thread, poll the gamepads & give their buttons to the current machine;
+// with it, the states are already the last ones
+//
 void Gamepad::Update(void)
 {
+	if (inputThread)
+		return;
+
+	Poll();
+	Publish(jaguarMachine);
+}
+
+
+//
+// Read the gamepads states; returns true if one has changed
+//
+bool Gamepad::Poll(void)
+{
+	bool changed = false;
+
 //	SDL_PollEvent(&event);
 	SDL_JoystickUpdate();
 
 	for(int i=0; i<numJoysticks; i++)
 	{
 		for(int j=0; j<numButtons[i]; j++)
-			button[i][j] = SDL_JoystickGetButton(pad[i], j);
+		{
+			bool state = (SDL_JoystickGetButton(pad[i], j) ? true : false);
+			changed |= (button[i][j] != state);
+			button[i][j] = state;
+		}
 
 		for(int j=0; j<numHats[i]; j++)
-			hat[i][j] = SDL_JoystickGetHat(pad[i], j);
+		{
+			uint8_t state = SDL_JoystickGetHat(pad[i], j);
+			changed |= (hat[i][j] != state);
+			hat[i][j] = state;
+		}
 
 		for(int j=0; j<numAxes[i]; j++)
-			axis[i][j] = SDL_JoystickGetAxis(pad[i], j);
+		{
+			int32_t state = SDL_JoystickGetAxis(pad[i], j);
+			changed |= (axis[i][j] != state);
+			axis[i][j] = state;
+		}
 	}
+
+	return changed;
+}
+
+
+//
+// Jaguar buttons (bit by button) held on a gamepad, from the bindings of a joypad
+//
+uint32_t Gamepad::GetButtons(int joystickID, const uint32_t * keyBindings)
+{
+	uint32_t buttons = 0;
+
+	if ((joystickID < 0) || (joystickID >= numJoysticks))
+		return 0;
+
+	for(int i=BUTTON_FIRST; i<=BUTTON_LAST; i++)
+	{
+		if ((keyBindings[i] & (JOY_BUTTON | JOY_HAT | JOY_AXIS)) && GetState(joystickID, keyBindings[i]))
+			buttons |= (1 << i);
+	}
+
+	return buttons;
+}
+
+
+//
+// Give the buttons held on the gamepads to the joypads of a machine
+// N.B.: The profile system AutoConnect functionality sets the gamepad IDs.
+//
+void Gamepad::Publish(JaguarMachine * machine)
+{
+	JoystickSetHostButtons(machine, 0, GetButtons(gamepadIDSlot1, vjs.p1KeyBindings));
+	JoystickSetHostButtons(machine, 1, GetButtons(gamepadIDSlot2, vjs.p2KeyBindings));
+}
+
+
+//
+// Start the input thread, giving the gamepads buttons to a machine as soon as they change
+//
+void Gamepad::StartInputThread(JaguarMachine * machine)
+{
+	if (inputThread || !numJoysticks)
+		return;
+
+	inputThreadQuit = false;
+	inputPolls = inputChanges = 0;
+
+	if ((inputThread = SDL_CreateThread(InputThreadFunc, machine)))
+		WriteLog("Gamepad: Input thread started\n");
+	else
+		WriteLog("Gamepad: Unable to start the input thread (%s), gamepads will be polled by frame\n", SDL_GetError());
+}
+
+
+//
+// Stop the input thread
+//
+void Gamepad::StopInputThread(void)
+{
+	if (!inputThread)
+		return;
+
+	inputThreadQuit = true;
+	SDL_WaitThread(inputThread, NULL);
+	inputThread = NULL;
+
+	WriteLog("Gamepad: Input thread stopped (%u polls, %u changes)\n", inputPolls, inputChanges);
+}
+
+
+//
+// Input thread: poll the gamepads, and give their buttons to the machine when they change
+// (SDL joystick events need the video subsystem, which is not used)
+//
+int Gamepad::InputThreadFunc(void * data)
+{
+	JaguarMachine * machine = (JaguarMachine *)data;
+	uint32_t idle = INPUT_REFRESH;
+
+	while (!inputThreadQuit)
+	{
+		inputPolls++;
+
+		if (Poll() || (++idle >= INPUT_REFRESH))
+		{
+			inputChanges += (idle < INPUT_REFRESH);
+			Publish(machine);
+			idle = 0;
+		}
+
+		SDL_Delay(INPUT_POLL_TIME);
+	}
+
+	return 0;
 }
 
 
@@ -23,6 +23,11 @@
 #include <stdint.h>
 #include "SDL.h"
 
+#define INPUT_POLL_TIME		1					// Gamepads polled by the input thread every msec
+#define INPUT_REFRESH		100					// Polls before the buttons are given again, for the bindings changes
+
+struct JaguarMachine;
+
 // buttonID is the combination of the type (BUTTON, HAT) and the button #
 // (0-255 for buttons, 0-31 for hats). Hats also have 0-7 for a button #
 // that corresponds to a direction.
@@ -45,6 +50,11 @@ class Gamepad
 		static int GetJoystickID(void);
 		static void Update(void);
 		static void DumpJoystickStatesToLog(void);
+		static bool Poll(void);
+		static uint32_t GetButtons(int joystickID, const uint32_t * keyBindings);
+		static void Publish(JaguarMachine * machine);
+		static void StartInputThread(JaguarMachine * machine);
+		static void StopInputThread(void);
 
 		// Support up to 8 gamepads
 		static int numJoysticks;
@@ -56,6 +66,13 @@ class Gamepad
 		static bool button[8][256];
 		static uint8_t hat[8][32];
 		static int32_t axis[8][32];
+
+	private:
+		static int InputThreadFunc(void * data);
+
+		static SDL_Thread * inputThread;
+		static volatile bool inputThreadQuit;
+		static uint32_t inputPolls, inputChanges;
 };
 
 #endif	// __GAMEPAD_H__
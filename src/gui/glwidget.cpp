@@ -12,11 +12,16 @@
 // JLH  01/14/2010  Created this file
 // JLH  02/03/2013  Added "centered" fullscreen mode with correct aspect ratio
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  Added screen buffers rotation, dirty lines upload and the render thread
 //
 
 #include "glwidget.h"
 
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QResizeEvent>
+#include <string.h>
 #include "jaguar.h"
+#include "renderthread.h"
 #include "settings.h"
 #include "tom.h"
 
@@ -28,28 +33,57 @@
 #include <GL/glext.h>
 #endif
 
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER		0x88EC
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW				0x88E0
+#endif
+
 
 GLWidget::GLWidget(QWidget * parent/*= 0*/): QGLWidget(parent), texture(0),
-	textureWidth(0), textureHeight(0), buffer(0), rasterWidth(326), rasterHeight(240),
-	offset(0), hideMouseTimeout(60)
+	textureWidth(1024), textureHeight(512), buffer(0), rasterWidth(326), rasterHeight(240),
+	offset(0), hideMouseTimeout(60), emuBuffer(0), readyBuffer(-1), shownBuffer(1), pbo(0),
+	renderThread(0), glInitialized(false), frameWidth(326), frameHeight(240), viewWidth(0),
+	viewHeight(0)
 {
+	// The emulation renders in one buffer while the last completed frame is
+	// displayed from another one; the third buffer lets the render thread keep
+	// the frame it is uploading while the next one is completed.
+	// Seems that power of 2 sizes are still mandatory...
+	for(int i=0; i<GLWIDGET_SCREEN_BUFFERS; i++)
+	{
+		screenBuffers[i] = new uint32_t[textureWidth * textureHeight];
+		memset(screenBuffers[i], 0, textureWidth * textureHeight * sizeof(uint32_t));
+	}
+
+	// The texture is created with the same (black) contents
+	textureShadow = new uint32_t[textureWidth * textureHeight];
+	memset(textureShadow, 0, textureWidth * textureHeight * sizeof(uint32_t));
+
+	buffer = screenBuffers[shownBuffer];
+	JaguarSetScreenBuffer(screenBuffers[emuBuffer]);
 	// Screen pitch has to be the texture width (in 32-bit pixels)...
-	JaguarSetScreenPitch(1024);
+	JaguarSetScreenPitch(textureWidth);
 	setMouseTracking(true);
 }
 
 
 GLWidget::~GLWidget()
 {
-	if (buffer)
-		delete[] buffer;
+	StopRenderThread();
+
+	for(int i=0; i<GLWIDGET_SCREEN_BUFFERS; i++)
+		delete[] screenBuffers[i];
+
+	delete[] textureShadow;
 }
 
 
 void GLWidget::initializeGL()
 {
 	format().setDoubleBuffer(true);
-	resizeGL(rasterWidth, rasterHeight);
+	resizeGL(width(), height());
 
 	glDisable(GL_ALPHA_TEST);
 	glDisable(GL_BLEND);
@@ -60,24 +94,47 @@ void GLWidget::initializeGL()
 	glEnable(GL_TEXTURE_2D);
 	glClearColor(0.0, 0.0, 0.0, 0.0);
 
+	initializeGLFunctions(context());
 	CreateTextures();
+	glInitialized = true;
 }
 
 
 void GLWidget::paintGL()
 {
+	RenderFrame();
+}
+
+
+//
+// Upload the lines which have changed since the last frame, and draw the frame
+// Called by paintGL(), or by the render thread which owns the GL context then.
+//
+void GLWidget::RenderFrame(void)
+{
+	// Take the last completed frame, if any
+	bufferMutex.lock();
+
+	if (readyBuffer >= 0)
+	{
+		shownBuffer = readyBuffer;
+		readyBuffer = -1;
+	}
+
+	uint32_t * frame = screenBuffers[shownBuffer];
+	unsigned frameW = frameWidth, frameH = frameHeight;
+	bufferMutex.unlock();
+
 	// If we're in fullscreen mode, we take the value of the screen width as
 	// set by MainWin, since it may be wider than what our aspect ratio allows.
 	// In that case, we adjust the viewport over so that it's centered on the
-	// screen. Otherwise, we simply take the width from our width() funtion
-	// which will always be correct in windowed mode.
+	// screen. Otherwise, we simply take the width from the last resize which
+	// will always be correct in windowed mode.
 
 	if (!fullscreen)
-		outputWidth = width();
+		outputWidth = viewWidth;
 
-	// Bit 0 in VP is interlace flag. 0 = interlace, 1 = non-interlaced
-	double multiplier = (TOMGetVP() & 0x0001 ? 1.0 : 2.0);
-	unsigned outputHeight = height();
+	unsigned outputHeight = viewHeight;
 
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
@@ -89,24 +146,207 @@ void GLWidget::paintGL()
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (vjs.glFilter ? GL_LINEAR : GL_NEAREST));
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (vjs.glFilter ? GL_LINEAR : GL_NEAREST));
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, TOMGetVideoModeWidth(), rasterHeight * multiplier, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, buffer);
 
-	double w = (double)TOMGetVideoModeWidth()  / (double)textureWidth;
-	double h = ((double)rasterHeight * multiplier) / (double)textureHeight;
-	unsigned u = outputWidth;
-	unsigned v = outputHeight;
+	// Most of the time, only a few lines change from one frame to the next one
+	bool orphaned = false;
+	uint32_t y = 0;
+
+	while (y < frameH)
+	{
+		uint32_t start = y;
+
+		while ((y < frameH) && memcmp(frame + (y * textureWidth), textureShadow + (y * textureWidth), frameW * sizeof(uint32_t)))
+		{
+			memcpy(textureShadow + (y * textureWidth), frame + (y * textureWidth), frameW * sizeof(uint32_t));
+			y++;
+		}
+
+		if (y > start)
+		{
+			// Give a new storage to the PBO for this frame, so we don't wait for the previous upload
+			if (pbo && !orphaned)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+				glBufferData(GL_PIXEL_UNPACK_BUFFER, textureWidth * textureHeight * sizeof(uint32_t), NULL, GL_STREAM_DRAW);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				orphaned = true;
+			}
+
+			UploadLines(frame, start, y - start, frameW);
+		}
+
+		y++;
+	}
+
+	GLfloat w = (GLfloat)frameW / (GLfloat)textureWidth;
+	GLfloat h = (GLfloat)frameH / (GLfloat)textureHeight;
+	GLint u = outputWidth;
+	GLint v = outputHeight;
+	GLfloat texCoords[8] = { 0, 0, w, 0, 0, h, w, h };
+	GLint vertices[8] = { 0, v, u, v, 0, 0, u, 0 };
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(2, GL_INT, 0, vertices);
+	glTexCoordPointer(2, GL_FLOAT, 0, texCoords);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+
+// Send a range of lines to the texture, through the PBO if we have one
+void GLWidget::UploadLines(uint32_t * frame, unsigned y, unsigned count, unsigned width)
+{
+	uint32_t * lines = frame + (y * textureWidth);
+
+	if (pbo)
+	{
+		uintptr_t pboOffset = y * textureWidth * sizeof(uint32_t);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+		glBufferSubData(GL_PIXEL_UNPACK_BUFFER, pboOffset, count * textureWidth * sizeof(uint32_t), lines);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, count, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, (const GLvoid *)pboOffset);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+	else
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, count, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, lines);
+}
+
+
+//
+// Called by the emulation once a frame is done: the frame becomes the one to
+// display, and the emulation gets a free buffer to render the next one.
+// Use keepContents when the frame is not complete (tracing in debugger mode), so
+// the emulation keeps on rendering over the same picture.
+//
+void GLWidget::SwapScreenBuffers(bool keepContents/*= false*/)
+{
+	bufferMutex.lock();
+	int completed = emuBuffer;
+
+	// If the previous frame hasn't been displayed yet, we drop it
+	if (readyBuffer >= 0)
+		emuBuffer = readyBuffer;
+	else
+		emuBuffer = (0 + 1 + 2) - completed - shownBuffer;
+
+	readyBuffer = completed;
+	buffer = screenBuffers[completed];
+	bufferMutex.unlock();
+
+	if (keepContents)
+		memcpy(screenBuffers[emuBuffer], screenBuffers[completed], textureWidth * textureHeight * sizeof(uint32_t));
+
+	JaguarSetScreenBuffer(screenBuffers[emuBuffer]);
+}
+
 
-	glBegin(GL_TRIANGLE_STRIP);
-	glTexCoord2f(0, 0); glVertex3i(0, v, 0);
-	glTexCoord2f(w, 0); glVertex3i(u, v, 0);
-	glTexCoord2f(0, h); glVertex3i(0, 0, 0);
-	glTexCoord2f(w, h); glVertex3i(u, 0, 0);
-	glEnd();
+//
+// Display the last completed frame
+// The render thread does the work if there is one; otherwise it is done here, in the GUI thread.
+//
+void GLWidget::updateGL(void)
+{
+	// Bit 0 in VP is interlace flag. 0 = interlace, 1 = non-interlaced
+	double multiplier = (TOMGetVP() & 0x0001 ? 1.0 : 2.0);
+
+	bufferMutex.lock();
+	frameWidth = TOMGetVideoModeWidth();
+	frameHeight = rasterHeight * multiplier;
+	bufferMutex.unlock();
+
+	if (vjs.threadedRendering && !renderThread && glInitialized)
+		StartRenderThread();
+	else if (!vjs.threadedRendering && renderThread)
+		StopRenderThread();
+
+	if (renderThread)
+		renderThread->Present();
+	else
+		QGLWidget::updateGL();
+}
+
+
+void GLWidget::paintEvent(QPaintEvent * event)
+{
+	if (renderThread)
+		renderThread->Present();
+	else
+		QGLWidget::paintEvent(event);
+}
+
+
+void GLWidget::resizeEvent(QResizeEvent * event)
+{
+	if (renderThread)
+		renderThread->Resize(event->size().width(), event->size().height());
+	else
+		QGLWidget::resizeEvent(event);
+}
+
+
+// Give the GL context to the render thread
+void GLWidget::StartRenderThread(void)
+{
+	if (!QOpenGLContext::supportsThreadedOpenGL())
+	{
+		vjs.threadedRendering = false;
+		return;
+	}
+
+	renderThread = new RenderThread(this);
+	doneCurrent();
+	context()->moveToThread(renderThread);
+	renderThread->start();
+	renderThread->Resize(width(), height());
 }
 
 
-void GLWidget::resizeGL(int /*width*/, int /*height*/)
+// Stop the render thread, the GL context is back to the GUI thread then
+void GLWidget::StopRenderThread(void)
 {
+	if (!renderThread)
+		return;
+
+	renderThread->Stop();
+	delete renderThread;
+	renderThread = 0;
+}
+
+
+//
+// Screenshot of the video output
+// The GL context is not available from the GUI thread when the render thread is running, so
+// we rebuild the picture from the last completed frame.
+//
+QImage GLWidget::GrabScreen(void)
+{
+	if (!renderThread)
+		return grabFrameBuffer();
+
+	bufferMutex.lock();
+	QImage image(frameWidth, frameHeight, QImage::Format_RGB32);
+
+	for(unsigned y=0; y<frameHeight; y++)
+	{
+		for(unsigned x=0; x<frameWidth; x++)
+		{
+			uint32_t pixel = buffer[(y * textureWidth) + x];
+			image.setPixel(x, y, qRgb(pixel >> 24, (pixel >> 16) & 0xFF, (pixel >> 8) & 0xFF));
+		}
+	}
+
+	bufferMutex.unlock();
+
+	return image.scaled(outputWidth, height());
+}
+
+
+void GLWidget::resizeGL(int width, int height)
+{
+	viewWidth = width;
+	viewHeight = height;
+
 //kludge [No, this is where it belongs!]
 	rasterHeight = (vjs.hardwareTypeNTSC ? VIRTUAL_SCREEN_HEIGHT_NTSC : VIRTUAL_SCREEN_HEIGHT_PAL);
 
@@ -120,18 +360,21 @@ void GLWidget::resizeGL(int /*width*/, int /*height*/)
 // interlaced screens; we won't have to change much here to support it.)
 void GLWidget::CreateTextures(void)
 {
-	// Seems that power of 2 sizes are still mandatory...
-	textureWidth  = 1024;
-	textureHeight = 512;
-	buffer = new uint32_t[textureWidth * textureHeight];
-	JaguarSetScreenBuffer(buffer);
-
 	glGenTextures(1, &texture);
 	glBindTexture(GL_TEXTURE_2D, texture);
 	glPixelStorei(GL_UNPACK_ROW_LENGTH, textureWidth);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, NULL);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, textureShadow);
+
+	// Pixel buffer object is used for the lines upload, if available
+	if ((QGLFormat::openGLVersionFlags() & QGLFormat::OpenGL_Version_2_1) && hasOpenGLFeature(QGLFunctions::Buffers))
+	{
+		glGenBuffers(1, &pbo);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, textureWidth * textureHeight * sizeof(uint32_t), NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
 }
 
 
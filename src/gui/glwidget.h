@@ -7,21 +7,35 @@
 #define __GLWIDGET_H__
 
 #include <QtOpenGL/QGLWidget>
+#include <QtOpenGL/QGLFunctions>
+#include <QtCore/QMutex>
 #include <stdint.h>
 
-class GLWidget: public QGLWidget
+// Screen buffers used by the emulation & the presentation
+#define GLWIDGET_SCREEN_BUFFERS		3
+
+class RenderThread;
+
+class GLWidget: public QGLWidget, protected QGLFunctions
 {
 	Q_OBJECT
 
+	friend class RenderThread;
+
 	public:
 		GLWidget(QWidget * parent = 0);
 		~GLWidget();
 
 		void HandleMouseHiding(void);
 		void CheckAndRestoreMouseCursor(void);
+		void SwapScreenBuffers(bool keepContents = false);
+		QImage GrabScreen(void);
 //		QSize minimumSizeHint() const;
 //		QSize sizeHint() const;
 
+	public slots:
+		void updateGL(void);
+
 //	signals:
 //		void clicked();
 
@@ -29,18 +43,24 @@ class GLWidget: public QGLWidget
 		void initializeGL(void);
 		void paintGL(void);
 		void resizeGL(int width, int height);
+		void paintEvent(QPaintEvent *);
+		void resizeEvent(QResizeEvent *);
 		void mouseMoveEvent(QMouseEvent *);
 //		void mousePressEvent(QMouseEvent * event);
 //		void mouseReleaseEvent(QMouseEvent * event);
 
 	private:
 		void CreateTextures(void);
+		void RenderFrame(void);
+		void UploadLines(uint32_t * frame, unsigned y, unsigned count, unsigned width);
+		void StartRenderThread(void);
+		void StopRenderThread(void);
 
 	public:
 		GLuint texture;
 		int textureWidth, textureHeight;
 
-		uint32_t * buffer;
+		uint32_t * buffer;							// Last frame completed by the emulation
 		unsigned rasterWidth, rasterHeight;
 
 		bool synchronize;
@@ -49,6 +69,17 @@ class GLWidget: public QGLWidget
 		bool fullscreen;
 		int outputWidth;
 		int32_t hideMouseTimeout;
+
+	private:
+		uint32_t * screenBuffers[GLWIDGET_SCREEN_BUFFERS];
+		int emuBuffer, readyBuffer, shownBuffer;	// readyBuffer is -1 when no new frame is waiting
+		uint32_t * textureShadow;					// Copy of the texture contents, for the dirty lines check
+		GLuint pbo;
+		QMutex bufferMutex;
+		RenderThread * renderThread;
+		bool glInitialized;
+		unsigned frameWidth, frameHeight;
+		int viewWidth, viewHeight;
 };
 
 #endif	// __GLWIDGET_H__
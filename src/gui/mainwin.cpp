@@ -29,6 +29,15 @@
 // JPM  Marc./2020  Added the step over for source level tracing
 //  RG   Jan./2021  Linux build fixes
 // JPM   Apr./2021  Handle number of M68K cycles used in tracing mode, added video output display in a window
+// JPM   Oct./2026  Added the threaded GPU & rendering settings, screen buffers swap at the end of the frame
+// JPM   Oct./2026  Added the audio & video capture
+// JPM   Oct./2026  Added the idle loops skip setting
+// JPM   Oct./2026  BIOS images copied from their compressed images
+// JPM   Oct./2026  Added the execution trace setting
+// JPM   Oct./2026  Added the bus heatmap window
+// JPM   Oct./2026  Added the threaded OP setting
+// JPM   Oct./2026  Frames paced by the frame scheduler, added the frames pacing & turbo settings
+// JPM   Oct./2026  Gamepads buttons given by the input thread
 //
 
 // FIXED:
@@ -58,10 +67,12 @@
 #include "SDL.h"
 #include "app.h"
 #include "about.h"
+#include "capturethread.h"
 #include "configdialog.h"
 #include "controllertab.h"
 #include "keybindingstab.h"
 #include "filepicker.h"
+#include "framescheduler.h"
 #include "gamepad.h"
 #include "generaltab.h"
 #include "glwidget.h"
@@ -80,16 +91,10 @@
 
 #include "dac.h"
 #include "jaguar.h"
+#include "machine.h"
 #include "log.h"
 #include "file.h"
-#ifndef NEWMODELSBIOSHANDLER
-#include "jagbios.h"
-#include "jagbios2.h"
-#include "jagstub2bios.h"
-#else
 #include "modelsBIOS.h"
-#endif
-#include "jagcdbios.h"
 #include "joystick.h"
 #include "m68000/m68kinterface.h"
 
@@ -108,6 +113,7 @@
 #include "debugger/allwatchbrowser.h"
 #include "debugger/localbrowser.h"
 #include "debugger/heapallocatorbrowser.h"
+#include "debugger/heatmapbrowser.h"
 #include "debugger/callstackbrowser.h"
 #include "debugger/CartFilesListWin.h"
 #include "debugger/SaveDumpAsWin.h"
@@ -142,15 +148,13 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	ReadSettings();
 
 	debugbar = NULL;
+	captureThread = NULL;
 
 	for(int i=0; i<8; i++)
 		keyHeld[i] = false;
 
-	// FPS management
-	for(int i=0; i<RING_BUFFER_SIZE; i++)
-		ringBuffer[i] = 0;
-
-	ringBufferPointer = RING_BUFFER_SIZE - 1;
+	// Frames pacing & FPS
+	frameScheduler = new FrameScheduler();
 
 	// main window
 	//if (vjs.softTypeDebugger)
@@ -214,6 +218,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 		allWatchBrowseWin = new AllWatchBrowserWindow(this);
 		LocalBrowseWin = new LocalBrowserWindow(this);
 		heapallocatorBrowseWin = new HeapAllocatorBrowserWindow(this);
+		heatmapBrowseWin = new HeatmapBrowserWindow(this);
 		BreakpointsWin = new BreakpointsWindow(this);
 		NewFunctionBreakpointWin = new NewFnctBreakpointWindow(this);
 		SaveDumpAsWin = new SaveDumpAsWindow(this);
@@ -304,6 +309,12 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	screenshotAct->setDisabled(false);
 	connect(screenshotAct, SIGNAL(triggered()), this, SLOT(MakeScreenshot()));
 
+	// Capture action
+	captureAct = new QAction(tr("&Capture audio && video"), this);
+	captureAct->setStatusTip(tr("Starts/stops the audio & video capture in the screenshots folder"));
+	captureAct->setCheckable(true);
+	connect(captureAct, SIGNAL(triggered()), this, SLOT(ToggleCapture()));
+
 	// Zoom actions
 	zoomActs = new QActionGroup(this);
 	x1Act = new QAction(QIcon(":/res/zoom100.png"), tr("Zoom 100%"), zoomActs);
@@ -471,6 +482,11 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 		heapallocatorBrowseAct->setStatusTip(tr("Shows the heap allocator browser window"));
 		connect(heapallocatorBrowseAct, SIGNAL(triggered()), this, SLOT(ShowHeapAllocatorBrowserWin()));
 
+		// Bus heatmap window
+		heatmapBrowseAct = new QAction(QIcon(""), tr("Bus heatmap"), this);
+		heatmapBrowseAct->setStatusTip(tr("Shows the bus accesses heatmap window"));
+		connect(heatmapBrowseAct, SIGNAL(triggered()), this, SLOT(ShowHeatmapBrowserWin()));
+
 		// Call stack window
 		CallStackBrowseAct = new QAction(QIcon(":/res/debug-callstack.png"), tr("Call Stack"), this);
 		CallStackBrowseAct->setStatusTip(tr("Shows Call Stack browser window"));
@@ -553,6 +569,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	fileMenu->addAction(useCDAct);
 	fileMenu->addAction(configAct);
 	fileMenu->addAction(emustatusAct);
+	fileMenu->addAction(captureAct);
 	fileMenu->addSeparator();
 	fileMenu->addAction(quitAppAct);
 
@@ -593,6 +610,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 			debugWindowsMenu->addSeparator();
 			debugWindowsMemoryMenu = debugWindowsMenu->addMenu(tr("&Memory"));
 			debugWindowsMemoryMenu->addAction(heapallocatorBrowseAct);
+			debugWindowsMemoryMenu->addAction(heatmapBrowseAct);
 			debugWindowsMemoryMenu->addSeparator();
 			for (int i = 0; i < vjs.nbrmemory1browserwindow; i++)
 			{
@@ -748,16 +766,13 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	}
 
 	// Set up timer based loop for animation...
+	// The timer is armed after each frame, for the time left until the next one
+	// given by the frame scheduler (see framescheduler.cpp)
 	timer = new QTimer(this);
+	timer->setTimerType(Qt::PreciseTimer);
+	timer->setSingleShot(true);
 	connect(timer, SIGNAL(timeout()), this, SLOT(Timer()));
 
-	// This isn't very accurate for NTSC: This is early by 40 msec per frame.
-	// This is because it's discarding the 0.6666... on the end of the fraction.
-	// Alas, 6 doesn't divide cleanly into 10. :-P
-//Should we defer this until SyncUI? Probably.
-//No, it doesn't work, because it uses setInterval() instead of start()...
-//	timer->start(vjs.hardwareTypeNTSC ? 16 : 20);
-
 	// We set this initially, to make VJ behave somewhat as it would if no
 	// cart were inserted and the BIOS was set as active...
 	jaguarCartInserted = true;
@@ -767,7 +782,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 
 #ifndef NEWMODELSBIOSHANDLER
 	//	memcpy(jagMemSpace + 0xE00000, jaguarBootROM, 0x20000);	// Use the stock BIOS
-	memcpy(jagMemSpace + 0xE00000, (vjs.biosType == BT_K_SERIES ? jaguarBootROM : jaguarBootROM2), 0x20000);	// Use the stock BIOS
+	CopyBIOSImage((vjs.biosType == BT_K_SERIES ? BI_K_SERIES : BI_M_SERIES), jagMemSpace + 0xE00000);	// Use the stock BIOS
 #else
 	SelectBIOS(vjs.biosType);
 #endif
@@ -795,7 +810,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 		// Attempt to load/run the ABS file...
 		LoadSoftware(vjs.absROMPath);
 #ifndef NEWMODELSBIOSHANDLER
-		memcpy(jagMemSpace + 0xE00000, jaguarDevBootROM2, 0x20000);	// Use the stub BIOS
+		CopyBIOSImage(BI_STUBULATOR_2, jagMemSpace + 0xE00000);	// Use the stub BIOS
 #else
 		SelectBIOS(vjs.biosType);
 #endif
@@ -821,8 +836,8 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 		// Attempt to load/run the ABS file...
 		LoadSoftware(vjs.absROMPath);
 #ifndef NEWMODELSBIOSHANDLER
-		memcpy(jagMemSpace + 0xE00000, jaguarDevBootROM2, 0x20000);	// Use the stub BIOS
-																	// Prevent the scanner from running...
+		CopyBIOSImage(BI_STUBULATOR_2, jagMemSpace + 0xE00000);	// Use the stub BIOS
+																// Prevent the scanner from running...
 #else
 		SelectBIOS(vjs.biosType);
 #endif
@@ -855,13 +870,17 @@ void MainWin::SyncUI(void)
 	palAct->setChecked(!vjs.hardwareTypeNTSC);
 	powerAct->setIcon(vjs.hardwareTypeNTSC ? powerRed : powerGreen);
 
+	// Capture asked by the command line
+	if ((vjs.captureType != CT_NONE) && !captureThread)
+		ToggleCapture();
+
 	fullScreenAct->setChecked(vjs.fullscreen);
 	fullScreen = vjs.fullscreen;
 	SetFullScreen(fullScreen);
 
-	// Reset the timer to be what was set in the command line (if any):
-//	timer->setInterval(vjs.hardwareTypeNTSC ? 16 : 20);
-	timer->start(vjs.hardwareTypeNTSC ? 16 : 20);
+	// Frames are counted from the first one
+	frameScheduler->Reset();
+	timer->start(0);
 }
 
 
@@ -878,6 +897,9 @@ void MainWin::SelectdasmtabWidget(const int Index)
 
 void MainWin::closeEvent(QCloseEvent * event)
 {
+	if (captureThread)
+		ToggleCapture();
+
 	JaguarDone();
 // This should only be done by the config dialog
 //	WriteSettings();
@@ -1017,20 +1039,13 @@ void MainWin::HandleKeys(QKeyEvent * e, bool state)
 
 
 //
-// N.B.: The profile system AutoConnect functionality sets the gamepad IDs here.
+// The gamepads buttons are given to the machine by the input thread as soon as they
+// change, and read at the time of the joypads registers read; without the thread,
+// they are polled here, before each frame (see Gamepad::Update)
 //
 void MainWin::HandleGamepads(void)
 {
 	Gamepad::Update();
-
-	for(int i=BUTTON_FIRST; i<=BUTTON_LAST; i++)
-	{
-		if (vjs.p1KeyBindings[i] & (JOY_BUTTON | JOY_HAT | JOY_AXIS))
-			joypad0Buttons[i] = (Gamepad::GetState(gamepadIDSlot1, vjs.p1KeyBindings[i]) ? 0x01 : 0x00);
-
-		if (vjs.p2KeyBindings[i] & (JOY_BUTTON | JOY_HAT | JOY_AXIS))
-			joypad1Buttons[i] = (Gamepad::GetState(gamepadIDSlot2, vjs.p2KeyBindings[i]) ? 0x01 : 0x00);
-	}
 }
 
 
@@ -1126,18 +1141,13 @@ void MainWin::Configure(void)
 //
 void MainWin::Timer(void)
 {
-#if 0
-static uint32_t ntscTickCount;
-	if (vjs.hardwareTypeNTSC)
-	{
-		ntscTickCount++;
-		ntscTickCount %= 3;
-		timer->start(16 + (ntscTickCount == 0 ? 1 : 0));
-	}
-#endif
-
+	// Paused: the frames are counted again from the resume
 	if (!running)
+	{
+		frameScheduler->Reset();
+		timer->start(vjs.hardwareTypeNTSC ? 16 : 20);
 		return;
+	}
 
 	if (showUntunedTankCircuit)
 	{
@@ -1163,6 +1173,13 @@ static uint32_t ntscTickCount;
 		// Otherwise, run the Jaguar simulation
 		HandleGamepads();
 		JaguarExecuteNew();
+
+		// Completed frame is copied before its buffer is given back to the emulation
+		if (captureThread && !M68KDebugHaltStatus())
+			captureThread->PushFrame(screenBuffer, TOMGetVideoModeWidth(), (vjs.hardwareTypeNTSC ? VIRTUAL_SCREEN_HEIGHT_NTSC : VIRTUAL_SCREEN_HEIGHT_PAL) * (TOMGetVP() & 0x0001 ? 1 : 2), screenPitch);
+
+		// Frame is done, unless a breakpoint has stopped the emulation
+		videoWidget->SwapScreenBuffers(M68KDebugHaltStatus());
 		//if (!vjs.softTypeDebugger)
 			videoWidget->HandleMouseHiding();
 
@@ -1190,32 +1207,19 @@ static uint32_t refresh = 0;
 		videoWidget->updateGL();
 		//vjs.softTypeDebugger ? VideoOutputWin->RefreshContents(videoWidget) : NULL;
 
-	// FPS handling
-	// Approach: We use a ring buffer to store times (in ms) over a given
-	// amount of frames, then sum them to figure out the FPS.
-	uint32_t timestamp = SDL_GetTicks();
-	// This assumes the ring buffer size is a power of 2
-//	ringBufferPointer = (ringBufferPointer + 1) & (RING_BUFFER_SIZE - 1);
-	// Doing it this way is better. Ring buffer size can be arbitrary then.
-	ringBufferPointer = (ringBufferPointer + 1) % RING_BUFFER_SIZE;
-	ringBuffer[ringBufferPointer] = timestamp - oldTimestamp;
-	uint32_t elapsedTime = 0;
-
-	for(uint32_t i=0; i<RING_BUFFER_SIZE; i++)
-		elapsedTime += ringBuffer[i];
-
-	// elapsedTime must be non-zero
-	if (elapsedTime == 0)
-		elapsedTime = 1;
+	// Next frame, at the time given by the frame scheduler (rounded to the msec)
+	int64_t wait = frameScheduler->FrameDone();
+	timer->start((int)((wait + 500000) / 1000000));
 
+	// FPS handling
 	// This is in frames per 10 seconds, so we can have 1 decimal
-	uint32_t framesPerSecond = (uint32_t)(((float)RING_BUFFER_SIZE / (float)elapsedTime) * 10000.0);
+	uint32_t framesPerSecond = frameScheduler->FramesPerSecond();
 	uint32_t fpsIntegerPart = framesPerSecond / 10;
 	uint32_t fpsDecimalPart = framesPerSecond % 10;
+	QString speed = (vjs.turbo == 1 ? QString() : (vjs.turbo ? QString(" (x%1)").arg(vjs.turbo) : QString(" (uncapped)")));
 	// If this is updated too frequently to be useful, we can throttle it down
 	// so that it only updates every 10th frame or so
-	statusBar()->showMessage(QString("%1.%2 FPS").arg(fpsIntegerPart).arg(fpsDecimalPart));
-	oldTimestamp = timestamp;
+	statusBar()->showMessage(QString("%1.%2 FPS%3").arg(fpsIntegerPart).arg(fpsDecimalPart).arg(speed));
 
 	if (M68KDebugHaltStatus())
 		ToggleRunState();
@@ -1385,7 +1389,6 @@ void MainWin::SetZoom300(void)
 void MainWin::SetNTSC(void)
 {
 	powerAct->setIcon(powerRed);
-	timer->setInterval(16);
 	vjs.hardwareTypeNTSC = true;
 	ResizeMainWindow();
 	WriteSettings();
@@ -1395,7 +1398,6 @@ void MainWin::SetNTSC(void)
 void MainWin::SetPAL(void)
 {
 	powerAct->setIcon(powerGreen);
-	timer->setInterval(20);
 	vjs.hardwareTypeNTSC = false;
 	ResizeMainWindow();
 	WriteSettings();
@@ -1465,14 +1467,14 @@ void MainWin::LoadSoftware(QString file)
 
 	// Setup BIOS in his own dedicated Jaguar memory
 #ifndef NEWMODELSBIOSHANDLER
-	uint8_t * biosPointer = jaguarBootROM;
+	int biosImage = BI_K_SERIES;
 
 	if (vjs.hardwareTypeAlpine || vjs.softTypeDebugger)
 	{
-		biosPointer = jaguarDevBootROM2;
+		biosImage = BI_STUBULATOR_2;
 	}
 
-	memcpy(jagMemSpace + 0xE00000, biosPointer, 0x20000);
+	CopyBIOSImage(biosImage, jagMemSpace + 0xE00000);
 #else
 	SelectBIOS(vjs.biosType);
 #endif
@@ -1531,7 +1533,7 @@ void MainWin::ToggleCDUsage(void)
 
 	// Set up the Jaguar CD for execution, otherwise, clear memory
 	if (CDActive)
-		memcpy(jagMemSpace + 0x800000, jaguarCDBootROM, 0x40000);
+		CopyBIOSImage(BI_CD, jagMemSpace + 0x800000);
 	else
 		memset(jagMemSpace + 0x800000, 0xFF, 0x40000);
 }
@@ -1602,6 +1604,7 @@ void MainWin::DebuggerTraceStepInto(void)
 		emuStatusWin->UpdateM68KCycles(JaguarStepInto());
 	}
 
+	videoWidget->SwapScreenBuffers(true);
 	videoWidget->updateGL();
 	RefreshWindows();
 #ifdef _MSC_VER
@@ -1653,6 +1656,7 @@ void MainWin::DebuggerTraceStepOver(void)
 		emuStatusWin->UpdateM68KCycles(JaguarStepOver(0));
 	}
 
+	videoWidget->SwapScreenBuffers(true);
 	videoWidget->updateGL();
 	RefreshWindows();
 #ifdef _MSC_VER
@@ -1670,6 +1674,7 @@ void MainWin::FrameAdvance(void)
 	ToggleRunState();
 	// Execute 1 frame, then exit (only useful in Pause mode)
 	JaguarExecuteNew();
+	videoWidget->SwapScreenBuffers(M68KDebugHaltStatus());
 	//if (!vjs.softTypeDebugger)
 		videoWidget->updateGL();
 		//vjs.softTypeDebugger ? VideoOutputWin->RefreshContents(videoWidget) : NULL;
@@ -1785,6 +1790,13 @@ void MainWin::ShowHeapAllocatorBrowserWin(void)
 }
 
 
+void MainWin::ShowHeatmapBrowserWin(void)
+{
+	heatmapBrowseWin->show();
+	heatmapBrowseWin->RefreshContents();
+}
+
+
 void MainWin::ShowMemoryBrowserWin(void)
 {
 	memBrowseWin->show();
@@ -1922,13 +1934,20 @@ void MainWin::ReadSettings(void)
 	vjs.joyport = settings.value("joyport", 0).toInt();
 	vjs.hardwareTypeNTSC = settings.value("hardwareTypeNTSC", true).toBool();
 	vjs.frameSkip = settings.value("frameSkip", 0).toInt();
+	vjs.frameSync = settings.value("frameSync", FS_AUDIO).toUInt();
+	vjs.turbo = qMin(settings.value("turbo", 1).toUInt(), (uint)TURBO_MAX);
 	vjs.useJaguarBIOS = settings.value("useJaguarBIOS", false).toBool();
 	vjs.useRetailBIOS = settings.value("useRetailBIOS", false).toBool();
 	vjs.useDevBIOS = settings.value("useDevBIOS", false).toBool();
 	vjs.GPUEnabled = settings.value("GPUEnabled", true).toBool();
+	vjs.threadedGPU = settings.value("threadedGPU", false).toBool();
+	vjs.threadedOP = settings.value("threadedOP", false).toBool();
+	vjs.threadedRendering = settings.value("threadedRendering", false).toBool();
 	vjs.DSPEnabled = settings.value("DSPEnabled", true).toBool();
 	vjs.audioEnabled = settings.value("audioEnabled", true).toBool();
 	vjs.usePipelinedDSP = settings.value("usePipelinedDSP", false).toBool();
+	vjs.idleSkip = settings.value("idleSkip", true).toBool();
+	vjs.trace = settings.value("trace", true).toBool();
 	vjs.fullscreen = settings.value("fullscreen", false).toBool();
 	vjs.useOpenGL = settings.value("useOpenGL", true).toBool();
 	vjs.glFilter = settings.value("glFilterType", 1).toInt();
@@ -2153,6 +2172,13 @@ void MainWin::ReadUISettings(void)
 		size = settings.value("heapallocatorBrowseWinSize", QSize(400, 400)).toSize();
 		heapallocatorBrowseWin->resize(size);
 
+		// Bus heatmap UI information
+		pos = settings.value("heatmapBrowseWinPos", QPoint(200, 200)).toPoint();
+		heatmapBrowseWin->move(pos);
+		settings.value("heatmapBrowseWinIsVisible", false).toBool() ? ShowHeatmapBrowserWin() : void();
+		size = settings.value("heatmapBrowseWinSize", QSize(400, 600)).toSize();
+		heatmapBrowseWin->resize(size);
+
 		// Exception Vector Table UI Information
 		pos = settings.value("exceptionVectorTableBrowseWinPos", QPoint(200, 200)).toPoint();
 		exceptionvectortableBrowseWin->move(pos);
@@ -2240,13 +2266,20 @@ void MainWin::WriteSettings(void)
 	settings.setValue("joyport", vjs.joyport);
 	settings.setValue("hardwareTypeNTSC", vjs.hardwareTypeNTSC);
 	settings.setValue("frameSkip", vjs.frameSkip);
+	settings.setValue("frameSync", vjs.frameSync);
+	settings.setValue("turbo", vjs.turbo);
 	settings.setValue("useJaguarBIOS", vjs.useJaguarBIOS);
 	settings.setValue("useRetailBIOS", vjs.useRetailBIOS);
 	settings.setValue("useDevBIOS", vjs.useDevBIOS);
 	settings.setValue("GPUEnabled", vjs.GPUEnabled);
+	settings.setValue("threadedGPU", vjs.threadedGPU);
+	settings.setValue("threadedOP", vjs.threadedOP);
+	settings.setValue("threadedRendering", vjs.threadedRendering);
 	settings.setValue("DSPEnabled", vjs.DSPEnabled);
 	settings.setValue("audioEnabled", vjs.audioEnabled);
 	settings.setValue("usePipelinedDSP", vjs.usePipelinedDSP);
+	settings.setValue("idleSkip", vjs.idleSkip);
+	settings.setValue("trace", vjs.trace);
 	settings.setValue("fullscreen", vjs.fullscreen);
 	settings.setValue("useOpenGL", vjs.useOpenGL);
 	settings.setValue("glFilterType", vjs.glFilter);
@@ -2402,6 +2435,9 @@ void MainWin::WriteUISettings(void)
 		settings.setValue("heapallocatorBrowseWinPos", heapallocatorBrowseWin->pos());
 		settings.setValue("heapallocatorBrowseWinIsVisible", heapallocatorBrowseWin->isVisible());
 		settings.setValue("heapallocatorBrowseWinSize", heapallocatorBrowseWin->size());
+		settings.setValue("heatmapBrowseWinPos", heatmapBrowseWin->pos());
+		settings.setValue("heatmapBrowseWinIsVisible", heatmapBrowseWin->isVisible());
+		settings.setValue("heatmapBrowseWinSize", heatmapBrowseWin->size());
 		settings.setValue("exceptionVectorTableBrowseWinPos", exceptionvectortableBrowseWin->pos());
 		settings.setValue("exceptionVectorTableBrowseWinIsVisible", exceptionvectortableBrowseWin->isVisible());
 		settings.setValue("exceptionVectorTableBrowseWinSize", exceptionvectortableBrowseWin->size());
@@ -2494,6 +2530,12 @@ void MainWin::DebuggerResetWindows(void)
 void MainWin::CommonRefreshWindows(void)
 {
 	emuStatusWin->RefreshContents();
+
+	// Bus heatmap follows the frames
+	if (vjs.softTypeDebugger)
+	{
+		heatmapBrowseWin->RefreshContents();
+	}
 }
 
 
@@ -2527,6 +2569,7 @@ void MainWin::DebuggerRefreshWindows(void)
 		LocalBrowseWin->RefreshContents();
 		CallStackBrowseWin->RefreshContents();
 		heapallocatorBrowseWin->RefreshContents();
+		heatmapBrowseWin->RefreshContents();
 		BreakpointsWin->RefreshContents();
 		for (size_t i = 0; i < vjs.nbrmemory1browserwindow; i++)
 		{
@@ -2552,7 +2595,33 @@ void MainWin::MakeScreenshot(void)
 	sprintf(Text, "%svj_%i%i%i_%i%i%i.jpg", vjs.screenshotPath, tstruct.tm_year, tstruct.tm_mon, tstruct.tm_mday, tstruct.tm_hour, tstruct.tm_min, tstruct.tm_sec);
 
 	// Create screenshot
-	screenshot = videoWidget->grabFrameBuffer();
+	screenshot = videoWidget->GrabScreen();
 	screenshot.save((char *)Text, "JPG", 100);
 }
 
+
+//
+// Start/stop the audio & video capture
+// Frames & samples are written by the capture thread, so the emulation only waits if it can't keep up
+//
+void MainWin::ToggleCapture(void)
+{
+	if (captureThread)
+	{
+		delete captureThread;
+		captureThread = NULL;
+	}
+	else
+	{
+		captureThread = new CaptureThread();
+
+		if (!captureThread->Start((vjs.captureType == CT_PNG ? CT_PNG : CT_Y4M), vjs.screenshotPath, vjs.hardwareTypeNTSC))
+		{
+			delete captureThread;
+			captureThread = NULL;
+		}
+	}
+
+	captureAct->setChecked(captureThread != NULL);
+}
+
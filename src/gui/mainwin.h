@@ -14,8 +14,6 @@
 #include <QtWidgets/QtWidgets>
 #include "tom.h"
 
-#define RING_BUFFER_SIZE 32
-
 // Main windows
 class GLWidget;
 //class VideoWindow;
@@ -25,6 +23,8 @@ class FilePickerWindow;
 class VideoOutputWindow;
 //class DasmWindow;
 class EmuStatusWindow;
+class CaptureThread;
+class FrameScheduler;
 
 // Alpine
 class MemoryBrowserWindow;
@@ -44,6 +44,7 @@ class AllWatchBrowserWindow;
 class LocalBrowserWindow;
 class CallStackBrowserWindow;
 class HeapAllocatorBrowserWindow;
+class HeatmapBrowserWindow;
 class Memory1BrowserWindow;
 class BreakpointsWindow;
 class NewFnctBreakpointWindow;
@@ -101,6 +102,7 @@ class MainWin: public QMainWindow
 		void ToggleFullScreen(void);
 		void ShowEmuStatusWin(void);
 		void MakeScreenshot(void);
+		void ToggleCapture(void);
 		// Debugger
 		void DebuggerTraceStepOver(void);
 		void DebuggerTraceStepInto(void);
@@ -109,6 +111,7 @@ class MainWin: public QMainWindow
 		void ShowLocalBrowserWin(void);
 		void ShowCallStackBrowserWin(void);
 		void ShowHeapAllocatorBrowserWin(void);
+		void ShowHeatmapBrowserWin(void);
 		void ShowMemory1BrowserWin(int NumWin);
 		void ShowExceptionVectorTableBrowserWin(void);
 		void ShowNewFunctionBreakpointWin(void);
@@ -160,6 +163,7 @@ class MainWin: public QMainWindow
 		CallStackBrowserWindow *CallStackBrowseWin;
 		ExceptionVectorTableBrowserWindow *exceptionvectortableBrowseWin;
 		HeapAllocatorBrowserWindow *heapallocatorBrowseWin;
+		HeatmapBrowserWindow *heatmapBrowseWin;
 		Memory1BrowserWindow **mem1BrowseWin;
 		//DasmWindow * DasmWin;
 		QTabWidget *dasmtabWidget;
@@ -173,6 +177,8 @@ class MainWin: public QMainWindow
 		NewFnctBreakpointWindow *NewFunctionBreakpointWin;
 		CartFilesListWindow *CartFilesListWin;
 		SaveDumpAsWindow *SaveDumpAsWin;
+		CaptureThread *captureThread;
+		FrameScheduler *frameScheduler;
 		QTimer *timer;
 		bool running;
 		int zoomLevel;
@@ -194,9 +200,6 @@ class MainWin: public QMainWindow
 
 	public:
 		bool plzDontKillMyComputer;
-		uint32_t oldTimestamp;
-		uint32_t ringBufferPointer;
-		uint32_t ringBuffer[RING_BUFFER_SIZE];
 
 	private:
 		QPoint mainWinPosition;
@@ -232,6 +235,7 @@ class MainWin: public QMainWindow
 		QAction *fullScreenAct;
 		//QAction *DasmAct;
 		QAction *screenshotAct;
+		QAction *captureAct;
 
 		// Alpine
 		QAction *memBrowseAct;
@@ -248,6 +252,7 @@ class MainWin: public QMainWindow
 		QAction *restartAct;
 		QAction *VideoOutputAct;
 		QAction *heapallocatorBrowseAct;
+		QAction *heatmapBrowseAct;
 		QAction *allWatchBrowseAct;
 		QAction *LocalBrowseAct;
 		QAction *CallStackBrowseAct;
@@ -0,0 +1,97 @@
+//
+// renderthread.cpp - Video presentation thread
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+
+#include "renderthread.h"
+
+#include "glwidget.h"
+
+
+RenderThread::RenderThread(GLWidget * parent): QThread(), gl(parent), abort(false),
+	presentPending(false), resizePending(false), newWidth(0), newHeight(0)
+{
+}
+
+
+RenderThread::~RenderThread()
+{
+	Stop();
+}
+
+
+// Ask for the last completed frame to be displayed
+void RenderThread::Present(void)
+{
+	QMutexLocker locker(&mutex);
+	presentPending = true;
+	condition.wakeOne();
+}
+
+
+// Widget has been resized; the viewport will be updated before the next frame
+void RenderThread::Resize(int width, int height)
+{
+	QMutexLocker locker(&mutex);
+	newWidth = width;
+	newHeight = height;
+	resizePending = presentPending = true;
+	condition.wakeOne();
+}
+
+
+// Stop the thread, and wait for the GL context to be given back to the GUI thread
+void RenderThread::Stop(void)
+{
+	mutex.lock();
+	abort = true;
+	condition.wakeOne();
+	mutex.unlock();
+
+	wait();
+}
+
+
+//
+// The GL context belongs to this thread until it exits, so the texture upload
+// and the buffers swap (which may wait for the vertical sync) never block the GUI
+//
+void RenderThread::run(void)
+{
+	gl->makeCurrent();
+
+	while (true)
+	{
+		mutex.lock();
+
+		while (!presentPending && !abort)
+			condition.wait(&mutex);
+
+		if (abort)
+		{
+			mutex.unlock();
+			break;
+		}
+
+		bool resize = resizePending;
+		int width = newWidth, height = newHeight;
+		presentPending = resizePending = false;
+		mutex.unlock();
+
+		if (resize)
+			gl->resizeGL(width, height);
+
+		gl->RenderFrame();
+		gl->swapBuffers();
+	}
+
+	gl->doneCurrent();
+	gl->context()->moveToThread(QCoreApplication::instance()->thread());
+}
@@ -0,0 +1,36 @@
+//
+// renderthread.h: Video presentation thread class definition
+//
+
+#ifndef __RENDERTHREAD_H__
+#define __RENDERTHREAD_H__
+
+#include <QtCore/QtCore>
+
+class GLWidget;
+
+class RenderThread: public QThread
+{
+	Q_OBJECT
+
+	public:
+		RenderThread(GLWidget * parent);
+		~RenderThread();
+		void Present(void);
+		void Resize(int width, int height);
+		void Stop(void);
+
+	protected:
+		void run(void);
+
+	private:
+		GLWidget * gl;
+		QMutex mutex;
+		QWaitCondition condition;
+		bool abort;
+		bool presentPending;
+		bool resizePending;
+		int newWidth, newHeight;
+};
+
+#endif	// __RENDERTHREAD_H__
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
-extern uint8_t jaguarBootROM[];
+// Image size is 0x20000 bytes once decompressed
+extern const uint8_t jaguarBootROMCompressed[];
+extern const uint32_t jaguarBootROMCompressedSize;
 
 #endif	// __JAGBIOS_H__
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
-extern uint8_t jaguarBootROM2[];
+// Image size is 0x20000 bytes once decompressed
+extern const uint8_t jaguarBootROM2Compressed[];
+extern const uint32_t jaguarBootROM2CompressedSize;
 
 #endif	// __JAGBIOS2_H__
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
-extern uint8_t jaguarCDBootROM[];
+// Image size is 0x40000 bytes once decompressed
+extern const uint8_t jaguarCDBootROMCompressed[];
+extern const uint32_t jaguarCDBootROMCompressedSize;
 
 #endif	// __JAGCDBIOS_H__
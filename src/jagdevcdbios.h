@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
-extern uint8_t jaguarDevCDBootROM[];
+// Image size is 0x40000 bytes once decompressed
+extern const uint8_t jaguarDevCDBootROMCompressed[];
+extern const uint32_t jaguarDevCDBootROMCompressedSize;
 
 #endif	// __JAGDEVCDBIOS_H__
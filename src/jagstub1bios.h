@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
-extern uint8_t jaguarDevBootROM1[];
+// Image size is 0x20000 bytes once decompressed
+extern const uint8_t jaguarDevBootROM1Compressed[];
+extern const uint32_t jaguarDevBootROM1CompressedSize;
 
 #endif	// __JAGSTUB1BIOS_H__
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
-extern uint8_t jaguarDevBootROM2[];
+// Image size is 0x20000 bytes once decompressed
+extern const uint8_t jaguarDevBootROM2Compressed[];
+extern const uint32_t jaguarDevBootROM2CompressedSize;
 
-#endif	// __JAGSTUB1BIOS_H__
+#endif	// __JAGSTUB2BIOS_H__
@@ -19,6 +19,19 @@
 // JPM   Aug./2019  Fix potential emulator freeze after an exception has occured
 // JPM   Feb./2021  Added a specific breakpoint for the M68K bus error exception, and a M68K exception catch detection
 // JPM   Apr./2021  Keep number of M68K cycles used in tracing mode
+// JPM   Oct./2026  Added the optional threaded GPU execution
+// JPM   Oct./2026  Jaguar state moved in the machine context
+// JPM   Oct./2026  Alert messages are written in the log in a build without Qt (NO_QT)
+// JPM   Oct./2026  Main RAM & ROM read/written by words & longs at once
+// JPM   Oct./2026  68K code analysis dropped by the main RAM & ROM writes
+// JPM   Oct./2026  68K blocks of code run as threaded code, out of the debugger
+// JPM   Oct./2026  Idle loops skip of the 68K, GPU & DSP, unless the title relies on their timing
+// JPM   Oct./2026  Save data persistence started & stopped with the Jaguar
+// JPM   Oct./2026  Performance counters of the frames
+// JPM   Oct./2026  Execution trace recorded, and written on an odd PC or a breakpoint
+// JPM   Oct./2026  Breakpoints conditions, evaluated when their address is reached
+// JPM   Oct./2026  RAM & ROM writes marked for the lines rendered ahead by the OP
+// JPM   Oct./2026  Machines initialised & done under the machines lock
 //
 
 
@@ -27,27 +40,37 @@
 
 #include "jaguar.h"
 //#include <QApplication>
+#ifndef NO_QT
 #include <QtWidgets/QMessageBox>
+#endif
+#include <string.h>
 #include <time.h>
+#ifndef NO_SDL
 #include <SDL.h>
 #include "SDL_opengl.h"
+#endif
 #include "blitter.h"
+#include "brkcond.h"
 #include "cdrom.h"
 #include "dac.h"
 #include "dsp.h"
 #include "eeprom.h"
 #include "event.h"
+#include "filedb.h"
 #include "foooked.h"
 #include "gpu.h"
 #include "jerry.h"
 #include "joystick.h"
 #include "log.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
 #include "memtrack.h"
 #include "mmu.h"
+#include "savedata.h"
 #include "settings.h"
 #include "tom.h"
+#include "trace.h"
 //#include "debugger/BreakpointsWin.h"
 #ifdef NEWMODELSBIOSHANDLER
 #include "modelsBIOS.h"
@@ -83,42 +106,38 @@ extern int effect_start;
 extern int effect_start2, effect_start3, effect_start4, effect_start5, effect_start6;
 #endif
 
-// Really, need to include memory.h for this, but it might interfere with some stuff...
-extern uint8_t jagMemSpace[];
-
 // Internal variables
 
 uint32_t jaguar_active_memory_dumps = 0;
 
-uint32_t jaguarMainROMCRC32, jaguarROMSize, jaguarRunAddress;
-bool jaguarCartInserted = false;
-bool lowerField = false;
-
 #ifdef CPU_DEBUG_MEMORY
 uint8_t writeMemMax[0x400000], writeMemMin[0x400000];
 uint8_t readMem[0x400000];
 uint32_t returnAddr[4000], raPtr = 0xFFFFFFFF;
 #endif
 
-uint32_t pcQueue[0x400];
-uint32_t a0Queue[0x400];
-uint32_t a1Queue[0x400];
-uint32_t a2Queue[0x400];
-uint32_t a3Queue[0x400];
-uint32_t a4Queue[0x400];
-uint32_t a5Queue[0x400];
-uint32_t a6Queue[0x400];
-uint32_t a7Queue[0x400];
-uint32_t d0Queue[0x400];
-uint32_t d1Queue[0x400];
-uint32_t d2Queue[0x400];
-uint32_t d3Queue[0x400];
-uint32_t d4Queue[0x400];
-uint32_t d5Queue[0x400];
-uint32_t d6Queue[0x400];
-uint32_t d7Queue[0x400];
-uint32_t srQueue[0x400];
-uint32_t pcQPtr = 0;
+// These live in the machine context (see jaguar.h)
+#define lowerField	(jaguarMachine->jaguar.lowerField)
+#define frameDone	(jaguarMachine->jaguar.frameDone)
+#define pcQueue		(jaguarMachine->jaguar.pcQueue)
+#define a0Queue		(jaguarMachine->jaguar.a0Queue)
+#define a1Queue		(jaguarMachine->jaguar.a1Queue)
+#define a2Queue		(jaguarMachine->jaguar.a2Queue)
+#define a3Queue		(jaguarMachine->jaguar.a3Queue)
+#define a4Queue		(jaguarMachine->jaguar.a4Queue)
+#define a5Queue		(jaguarMachine->jaguar.a5Queue)
+#define a6Queue		(jaguarMachine->jaguar.a6Queue)
+#define a7Queue		(jaguarMachine->jaguar.a7Queue)
+#define d0Queue		(jaguarMachine->jaguar.d0Queue)
+#define d1Queue		(jaguarMachine->jaguar.d1Queue)
+#define d2Queue		(jaguarMachine->jaguar.d2Queue)
+#define d3Queue		(jaguarMachine->jaguar.d3Queue)
+#define d4Queue		(jaguarMachine->jaguar.d4Queue)
+#define d5Queue		(jaguarMachine->jaguar.d5Queue)
+#define d6Queue		(jaguarMachine->jaguar.d6Queue)
+#define d7Queue		(jaguarMachine->jaguar.d7Queue)
+#define srQueue		(jaguarMachine->jaguar.srQueue)
+#define pcQPtr		(jaguarMachine->jaguar.pcQPtr)
 bool startM68KTracing = false;
 
 // Breakpoint on memory access vars (exported)
@@ -126,11 +145,10 @@ bool bpmActive = false;
 bool bpmSaveActive = false;
 size_t bpmHitCounts;
 uint32_t bpmAddress1;
+BrkCondition *bpmCondition;
 S_BrkInfo *brkInfo;
 size_t brkNbr;
 
-bool frameDone;
-
 //
 // Callback function to detect illegal instructions
 //
@@ -227,6 +245,7 @@ if (inRoutine)
 			WriteLog("%06X: %08X\n", topOfStack - (i * 4), JaguarReadLong(topOfStack - (i * 4)));
 		WriteLog("Jaguar: VBL interrupt is %s\n", ((TOMIRQEnabled(IRQ_VIDEO)) && (JaguarInterruptHandlerIsValid(64))) ? "enabled" : "disabled");
 		M68K_show_context();
+		TraceTrigger("68K odd PC");
 		LogDone();
 		exit(0);
 	}
@@ -1064,10 +1083,25 @@ void m68k_brk_init(void)
 }
 
 
+// Free the condition of a M68000 breakpoint
+static void m68k_brk_free(S_BrkInfo *Ptr)
+{
+	free(Ptr->Condition);
+	BrkCondFree(Ptr->Cond);
+	Ptr->Condition = NULL;
+	Ptr->Cond = NULL;
+}
+
+
 // Reset the M68000 breakpoints structures
 void m68k_brk_reset(void)
 {
 	// Reset the breakpoints
+	for (size_t i = 0; i < brkNbr; i++)
+	{
+		m68k_brk_free(&brkInfo[i]);
+	}
+
 	free(brkInfo);
 	brkInfo = NULL;
 	brkNbr = 0;
@@ -1078,12 +1112,14 @@ void m68k_brk_reset(void)
 void m68k_brk_del(unsigned int NumBrk)
 {
 	// Remove the breakpoint
+	m68k_brk_free(brkInfo + (NumBrk - 1));
 	memset((void *)(brkInfo + (NumBrk - 1)), 0, sizeof(S_BrkInfo));
 }
 
 
 // Add a M68000 breakpoint
 // return true if breakpoint has been added, and false if breakpoint already exists
+// The condition, if any, belongs then to the breakpoint
 unsigned int m68k_brk_add(void *PtrInfo)
 {
 	S_BrkInfo *Ptr = NULL;
@@ -1130,6 +1166,13 @@ unsigned int m68k_brk_check(unsigned int adr)
 	if ((adr == bpmAddress1) && bpmActive)
 	{
 		bpmHitCounts++;
+
+		if (bpmCondition && !BrkCondEvaluate(bpmCondition, bpmHitCounts))
+			return false;
+
+		if (!M68KDebugHaltStatus())
+			TraceTrigger("Memory breakpoint");
+
 		return true;
 	}
 	else
@@ -1142,6 +1185,14 @@ unsigned int m68k_brk_check(unsigned int adr)
 				if (brkInfo[i].Adr == adr)
 				{
 					brkInfo[i].HitCounts++;
+
+					// Halt only if the condition is true
+					if (brkInfo[i].Cond && !BrkCondEvaluate(brkInfo[i].Cond, brkInfo[i].HitCounts))
+						return false;
+
+					if (!M68KDebugHaltStatus())
+						TraceTrigger("Breakpoint");
+
 					return true;
 				}
 			}
@@ -1178,6 +1229,13 @@ void m68k_brk_hitcounts_reset(void)
 // Close the M68000 breakpoints structures
 void m68k_brk_close(void)
 {
+	for (size_t i = 0; i < brkNbr; i++)
+	{
+		m68k_brk_free(&brkInfo[i]);
+	}
+
+	BrkCondFree(bpmCondition);
+	bpmCondition = NULL;
 	free(brkInfo);
 }
 
@@ -1196,6 +1254,7 @@ unsigned int m68k_read_memory_8(unsigned int address)
 
 	// Musashi does this automagically for you, UAE core does not :-P
 	address &= 0x00FFFFFF;
+	PERF_BUS(M68K, address, 1, PERF_HEAT_READ);
 #ifdef CPU_DEBUG_MEMORY
 	// Note that the Jaguar only has 2M of RAM, not 4!
 	if ((address >= 0x000000) && (address <= 0x1FFFFF))
@@ -1288,6 +1347,7 @@ unsigned int m68k_read_memory_16(unsigned int address)
 
 	// Musashi does this automagically for you, UAE core does not :-P
 	address &= 0x00FFFFFF;
+	PERF_BUS(M68K, address, 1, PERF_HEAT_READ);
 #ifdef CPU_DEBUG_MEMORY
 /*	if ((address >= 0x000000) && (address <= 0x3FFFFE))
 	{
@@ -1369,7 +1429,7 @@ unsigned int m68k_read_memory_16(unsigned int address)
 			}
 			else
 			{
-				retVal = (jaguarMainROM[address - 0x800000] << 8) | jaguarMainROM[address - 0x800000 + 1];
+				retVal = GET16(jaguarMainROM, address - 0x800000);
 			}
 		}
 		else
@@ -1378,7 +1438,7 @@ unsigned int m68k_read_memory_16(unsigned int address)
 			{
 				//		retVal = (jaguarBootROM[address - 0xE00000] << 8) | jaguarBootROM[address - 0xE00000 + 1];
 				//		retVal = (jaguarDevBootROM1[address - 0xE00000] << 8) | jaguarDevBootROM1[address - 0xE00000 + 1];
-				retVal = (jagMemSpace[address] << 8) | jagMemSpace[address + 1];
+				retVal = GET16(jagMemSpace, address);
 			}
 			else
 			{
@@ -1426,6 +1486,7 @@ unsigned int m68k_read_memory_16(unsigned int address)
 // Alert message in case of exception vector request
 bool m68k_read_exception_vector(unsigned int address, char *text)
 {
+#ifndef NO_QT
 	QString msg;
 	QMessageBox msgBox;
 
@@ -1438,6 +1499,9 @@ bool m68k_read_exception_vector(unsigned int address, char *text)
 	msgBox.setStandardButtons(QMessageBox::Abort);
 	msgBox.setDefaultButton(QMessageBox::Abort);
 	msgBox.exec();
+#else
+	WriteLog("M68K: 68000 exception, $%06x: %s\n", pcQueue[pcQPtr ? (pcQPtr - 1) : 0x3FF], text);
+#endif
 	return M68KDebugHalt();
 }
 
@@ -1493,9 +1557,25 @@ unsigned int m68k_read_memory_32(unsigned int address)
 	}
 	else
 	{
+		// Main RAM is read at once (note that the Jaguar only has 2M of RAM, not 4!)
+		if (address <= (vjs.DRAM_size - 4))
+		{
+#ifdef ALPINE_FUNCTIONS
+			// Breakpoint on the second word
+			if (!startM68KTracing && m68k_brk_check(address + 2))
+			{
+				M68KDebugHalt();
+			}
+#endif
+			PERF_BUS(M68K, address, 2, PERF_HEAT_READ);
+			return GET32(jaguarMainRAM, address);
+		}
+
 		// check ROM or Memory Track access
 		if ((address >= 0x800000) && (address <= 0xDFFEFE))
 		{
+			PERF_BUS(M68K, address, 2, PERF_HEAT_READ);
+
 			// Memory Track reading...
 			if (((TOMGetMEMCON1() & 0x0006) == (2 << 1)) && (jaguarMainROMCRC32 == 0xFDF37F47))
 			{
@@ -1519,6 +1599,7 @@ unsigned int m68k_read_memory_32(unsigned int address)
 // Alert message in case of writing to unknown memory location
 bool m68k_write_unknown_alert(unsigned int address, char *bits, unsigned int value)
 {
+#ifndef NO_QT
 	QString msg;
 	QMessageBox msgBox;
 
@@ -1527,6 +1608,9 @@ bool m68k_write_unknown_alert(unsigned int address, char *bits, unsigned int val
 	msgBox.setStandardButtons(QMessageBox::Abort);
 	msgBox.setDefaultButton(QMessageBox::Abort);
 	msgBox.exec();
+#else
+	WriteLog("M68K: $%06x: Writing at this unknown memory location $%06x with a (%s bits) value of $%0x\n", pcQueue[pcQPtr ? (pcQPtr - 1) : 0x3FF], address, bits, value);
+#endif
 	return M68KDebugHalt();
 }
 
@@ -1536,6 +1620,7 @@ bool m68k_write_cartridge_alert(unsigned int address, char *bits, unsigned int v
 {
 	if (!M68KDebugHaltStatus())
 	{
+#ifndef NO_QT
 		QString msg;
 		QMessageBox msgBox;
 
@@ -1556,6 +1641,11 @@ bool m68k_write_cartridge_alert(unsigned int address, char *bits, unsigned int v
 		{
 			return M68KDebugHalt();
 		}
+#else
+		// Nobody to ask, so the default answer (No) is used
+		WriteLog("M68K: $%06x: Writing at this ROM cartridge location $%06x with a (%s bits) value of $%0x\n", pcQueue[pcQPtr ? (pcQPtr - 1) : 0x3FF], address, bits, value);
+		return M68KDebugHalt();
+#endif
 	}
 	else
 	{
@@ -1574,6 +1664,7 @@ bool m68k_write_memory_check(unsigned int address, char *bits, unsigned int valu
 	// Check if breakpoint on memory is active, and deal with it
 	if (!M68KDebugHaltStatus() && bpmActive && (address == bpmAddress1))
 	{
+		TraceTrigger("Memory breakpoint");
 		return M68KDebugHalt();
 	}
 	else
@@ -1617,6 +1708,7 @@ void m68k_write_memory_8(unsigned int address, unsigned int value)
 	// Check memory write location on 8 bits
 	if (!m68k_write_memory_check(address, "8", value))
 	{
+		PERF_BUS(M68K, address, 1, PERF_HEAT_WRITE);
 		// Musashi does this automagically for you, UAE core does not :-P
 		//address &= 0x00FFFFFF;
 #ifdef CPU_DEBUG_MEMORY
@@ -1653,6 +1745,8 @@ void m68k_write_memory_8(unsigned int address, unsigned int value)
 		if ((address >= 0x000000) && (address <= (vjs.DRAM_size - 1)))
 		{
 			jaguarMainRAM[address] = value;
+			M68K_CODE_WRITE(address);
+			OP_BUS_WRITE(address);
 		}
 		else
 		{
@@ -1677,6 +1771,8 @@ void m68k_write_memory_8(unsigned int address, unsigned int value)
 						if ((address >= 0x800000) && (address <= 0xDFFEFF))
 						{
 							jagMemSpace[address] = (uint8_t)value;
+							M68K_CODE_WRITE(address);
+							OP_BUS_WRITE(address);
 						}
 						else
 						{
@@ -1699,6 +1795,7 @@ void m68k_write_memory_16(unsigned int address, unsigned int value)
 	// Check memory write location on 16 bits
 	if (!m68k_write_memory_check(address, "16", value))
 	{
+		PERF_BUS(M68K, address, 1, PERF_HEAT_WRITE);
 		// Musashi does this automagically for you, UAE core does not :-P
 		//address &= 0x00FFFFFF;
 #ifdef CPU_DEBUG_MEMORY
@@ -1764,6 +1861,8 @@ void m68k_write_memory_16(unsigned int address, unsigned int value)
 			/*		jaguar_mainRam[address] = value >> 8;
 					jaguar_mainRam[address + 1] = value & 0xFF;*/
 			SET16(jaguarMainRAM, address, value);
+			M68K_CODE_WRITE(address);
+			OP_BUS_WRITE(address);
 		}
 		else
 		{
@@ -1798,6 +1897,8 @@ void m68k_write_memory_16(unsigned int address, unsigned int value)
 						if ((address >= 0x800000) && (address <= 0xDFFEFE))
 						{
 							SET16(jagMemSpace, address, value);
+							M68K_CODE_WRITE(address);
+							OP_BUS_WRITE(address);
 						}
 						else
 						{
@@ -2013,6 +2114,74 @@ unsigned jaguar_unknown_readword(unsigned address, uint32_t who/*=UNKNOWN*/)
 // Disassemble M68K instructions at the given offset
 //
 
+//
+// Code analysed by the 68K core: only RAM, cartridge ROM & boot ROM are plain memory
+//
+unsigned int m68k_read_code_16(unsigned int address)
+{
+	address &= 0x00FFFFFF;
+
+	if (address <= (vjs.DRAM_size - 2))
+		return GET16(jaguarMainRAM, address);
+
+	if ((address >= 0x800000) && (address <= 0xDFFEFE)
+		&& !(((TOMGetMEMCON1() & 0x0006) == (2 << 1)) && (jaguarMainROMCRC32 == 0xFDF37F47)))
+		return GET16(jaguarMainROM, address - 0x800000);
+
+	if ((address >= 0xE00000) && (address <= 0xE3FFFE))
+		return GET16(jagMemSpace, address);
+
+	return 0x10000;
+}
+
+
+//
+// Tell if a read has no side effect, and returns a value which can only be changed
+// by another processor or by an event; the idle loops skip is based on it
+//
+bool JaguarIsIdleRead(uint32_t address)
+{
+	address &= 0x00FFFFFF;
+
+	// Main RAM & ROM
+	if (m68k_read_code_16(address & 0xFFFFFE) <= 0xFFFF)
+		return true;
+
+	return ((address >= 0xF00006) && (address <= 0xF00007))			// VC (HC is random)
+		|| ((address >= 0xF000E0) && (address <= 0xF000E1))			// INT1
+		|| ((address >= 0xF02100) && (address <= 0xF0211F))			// GPU control registers
+		|| ((address >= 0xF02238) && (address <= 0xF0223B))			// Blitter status
+		|| ((address >= GPU_WORK_RAM_BASE) && (address <= (GPU_WORK_RAM_BASE + 0x0FFF)))
+		|| ((address >= 0xF10020) && (address <= 0xF10021))			// JINTCTRL
+		|| ((address >= 0xF1A100) && (address <= 0xF1A11F))			// DSP control registers
+		|| ((address >= DSP_WORK_RAM_BASE) && (address <= (DSP_WORK_RAM_BASE + 0x1FFF)));
+}
+
+
+int m68k_is_idle_read(unsigned int address)
+{
+	return JaguarIsIdleRead(address);
+}
+
+
+//
+// Idle loops skip, unless the title is known to rely on the timing of its loops
+//
+static bool JaguarIdleSkip(void)
+{
+	if (!vjs.idleSkip || vjs.hardwareTypeAlpine || vjs.softTypeDebugger)
+		return false;
+
+	for(int i=0; romList[i].crc32 != 0xFFFFFFFF; i++)
+	{
+		if (romList[i].crc32 == jaguarMainROMCRC32)
+			return !(romList[i].flags & FF_NO_IDLE_SKIP);
+	}
+
+	return true;
+}
+
+
 unsigned int m68k_read_disassembler_8(unsigned int address)
 {
 	return m68k_read_memory_8(address);
@@ -2057,6 +2226,7 @@ uint8_t JaguarReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
 	uint8_t data = 0x00;
 	offset &= 0xFFFFFF;
+	PERF_BUS(who, offset, 1, PERF_HEAT_READ);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset < 0x800000)
@@ -2083,16 +2253,22 @@ uint8_t JaguarReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 uint16_t JaguarReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
 	offset &= 0xFFFFFF;
+	PERF_BUS(who, offset, 1, PERF_HEAT_READ);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset < 0x800000)
 	{
-		return (jaguarMainRAM[(offset+0) & (vjs.DRAM_size - 1)] << 8) | jaguarMainRAM[(offset+1) & (vjs.DRAM_size - 1)];
+		uint32_t ramOffset = offset & (vjs.DRAM_size - 1);
+
+		if (ramOffset <= (vjs.DRAM_size - 2))
+			return GET16(jaguarMainRAM, ramOffset);
+
+		return (jaguarMainRAM[ramOffset] << 8) | jaguarMainRAM[0];
 	}
 	else if ((offset >= 0x800000) && (offset < 0xDFFF00))
 	{
 		offset -= 0x800000;
-		return (jaguarMainROM[offset+0] << 8) | jaguarMainROM[offset+1];
+		return GET16(jaguarMainROM, offset);
 	}
 //	else if ((offset >= 0xDFFF00) && (offset < 0xDFFF00))
 	else if ((offset >= 0xDFFF00) && (offset <= 0xDFFFFE))
@@ -2100,7 +2276,7 @@ uint16_t JaguarReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 	else if ((offset >= 0xE00000) && (offset <= 0xE3FFFE))
 //		return (jaguarBootROM[(offset+0) & 0x3FFFF] << 8) | jaguarBootROM[(offset+1) & 0x3FFFF];
 //		return (jaguarDevBootROM1[(offset+0) & 0x3FFFF] << 8) | jaguarDevBootROM1[(offset+1) & 0x3FFFF];
-		return (jagMemSpace[offset + 0] << 8) | jagMemSpace[offset + 1];
+		return GET16(jagMemSpace, offset);
 	else if ((offset >= 0xF00000) && (offset <= 0xF0FFFE))
 		return TOMReadWord(offset, who);
 	else if ((offset >= 0xF10000) && (offset <= 0xF1FFFE))
@@ -2124,11 +2300,14 @@ void JaguarWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 		WriteLog("JWB: Byte %02X written at %08X by %s\n", data, offset, whoName[who]);//*/
 
 	offset &= 0xFFFFFF;
+	PERF_BUS(who, offset, 1, PERF_HEAT_WRITE);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset < 0x800000)
 	{
 		jaguarMainRAM[offset & (vjs.DRAM_size - 1)] = data;
+		M68K_CODE_WRITE(offset & (vjs.DRAM_size - 1));
+		OP_BUS_WRITE(offset & (vjs.DRAM_size - 1));
 		return;
 	}
 	else if ((offset >= 0xDFFF00) && (offset <= 0xDFFFFF))
@@ -2175,6 +2354,7 @@ if (offset == 0x0102)//64*4)
 	WriteLog("Jaguar: Word %04X written to TOC+%02X by %s\n", data, offset-0x2C00, whoName[who]);//*/
 
 	offset &= 0xFFFFFF;
+	PERF_BUS(who, offset, 1, PERF_HEAT_WRITE);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset <= 0x7FFFFE)
@@ -2265,8 +2445,15 @@ if (who == GPU && (gpu_pc == 0xF03604 || gpu_pc == 0xF03638))
 if (offset == 0x11D31A + 0x48000 || offset == 0x11D31A)
 	WriteLog("JWW: %s writing star %04X at %08X...\n", whoName[who], data, offset);//*/
 
-		jaguarMainRAM[(offset+0) & (vjs.DRAM_size - 1)] = data >> 8;
-		jaguarMainRAM[(offset+1) & (vjs.DRAM_size - 1)] = data & 0xFF;
+		uint32_t ramOffset = offset & (vjs.DRAM_size - 1);
+
+		if (ramOffset <= (vjs.DRAM_size - 2))
+			SET16(jaguarMainRAM, ramOffset, data);
+		else
+			jaguarMainRAM[ramOffset] = data >> 8, jaguarMainRAM[0] = data & 0xFF;
+
+		M68K_CODE_WRITE(ramOffset);
+		OP_BUS_WRITE(ramOffset);
 		return;
 	}
 	else if (offset >= 0xDFFF00 && offset <= 0xDFFFFE)
@@ -2292,9 +2479,28 @@ if (offset == 0x11D31A + 0x48000 || offset == 0x11D31A)
 }
 
 
-// We really should re-do this so that it does *real* 32-bit access... !!! FIX !!!
+// RAM & ROM are read with a *real* 32-bit access, the other locations by words
 uint32_t JaguarReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
+	offset &= 0xFFFFFF;
+
+	// First 2M is mirrored in the $0 - $7FFFFF range
+	if (offset < 0x800000)
+	{
+		uint32_t ramOffset = offset & (vjs.DRAM_size - 1);
+
+		if (ramOffset <= (vjs.DRAM_size - 4))
+		{
+			PERF_BUS(who, offset, 2, PERF_HEAT_READ);
+			return GET32(jaguarMainRAM, ramOffset);
+		}
+	}
+	else if (offset <= 0xDFFEFC)
+	{
+		PERF_BUS(who, offset, 2, PERF_HEAT_READ);
+		return GET32(jaguarMainROM, offset - 0x800000);
+	}
+
 	return (JaguarReadWord(offset, who) << 16) | JaguarReadWord(offset+2, who);
 }
 
@@ -2311,6 +2517,23 @@ void JaguarWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 /*if (offset == 0x0100)//64*4)
 	WriteLog("M68K: %s wrote dword to VI vector value %08X...\n", whoName[who], data);//*/
 
+	// First 2M is mirrored in the $0 - $7FFFFF range, and is written at once
+	if ((offset & 0xFFFFFF) < 0x800000)
+	{
+		uint32_t ramOffset = offset & (vjs.DRAM_size - 1);
+
+		if (ramOffset <= (vjs.DRAM_size - 4))
+		{
+			PERF_BUS(who, offset, 2, PERF_HEAT_WRITE);
+			SET32(jaguarMainRAM, ramOffset, data);
+			M68K_CODE_WRITE(ramOffset);
+			OP_BUS_WRITE(ramOffset);
+			M68K_CODE_WRITE(ramOffset + 2);
+			OP_BUS_WRITE(ramOffset + 2);
+			return;
+		}
+	}
+
 	JaguarWriteWord(offset, data >> 16, who);
 	JaguarWriteWord(offset+2, data & 0xFFFF, who);
 }
@@ -2335,6 +2558,9 @@ void JaguarSetScreenPitch(uint32_t pitch)
 //
 void JaguarInit(void)
 {
+	// The shared lookup tables are built by the first machine
+	JaguarMachinesLock();
+
 	// For randomizing RAM
 	srand((unsigned int)time(NULL));
 
@@ -2360,12 +2586,16 @@ void JaguarInit(void)
 memset(jaguarMainRAM + 0x804, 0xFF, 4);
 
 	m68k_pulse_reset();							// Need to do this so UAE disasm doesn't segfault on exit
+	SaveDataInit();
+	PerfInit();
+	TraceInit();
 	GPUInit();
 	DSPInit();
 	TOMInit();
 	JERRYInit();
 	CDROMInit();
 	m68k_brk_init();
+	JaguarMachinesUnlock();
 }
 
 
@@ -2409,6 +2639,14 @@ void JaguarReset(void)
 	GPUReset();
 	DSPReset();
 	CDROMReset();
+	DasmCacheFlush();
+	TraceReset();
+	// Flags have to be exact, and every instruction seen, when the debugger can be used
+	m68k_set_noflags(!vjs.hardwareTypeAlpine && !vjs.softTypeDebugger);
+	m68k_set_blocks(!vjs.hardwareTypeAlpine && !vjs.softTypeDebugger);
+	m68k_set_idle_skip(JaguarIdleSkip());
+	GPUSetIdleSkip(JaguarIdleSkip());
+	DSPSetIdleSkip(JaguarIdleSkip());
     m68k_pulse_reset();								// Reset the 68000
 	WriteLog("Jaguar: 68K reset. PC=%06X SP=%08X\n", m68k_get_reg(NULL, M68K_REG_PC), m68k_get_reg(NULL, M68K_REG_A7));
 	lowerField = false;								// Reset the lower field flag
@@ -2515,12 +2753,18 @@ void JaguarDone(void)
 	M68K_show_context();
 //#endif
 
+	// The shared host threads are stopped by the last machine
+	JaguarMachinesLock();
 	CDROMDone();
 	GPUDone();
 	DSPDone();
 	TOMDone();
 	JERRYDone();
+	SaveDataDone();
+	PerfDone();
+	TraceDone();
 	m68k_brk_close();
+	JaguarMachinesUnlock();
 
 	// temp, until debugger is in place
 //00802016: jsr     $836F1A.l
@@ -2591,21 +2835,49 @@ uint8_t * GetRamPtr(void)
 //
 void JaguarExecuteNew(void)
 {
+	uint64_t frameTime = PerfHostTime(), startTime, endTime;
 	frameDone = false;
 
 	do
 	{
 		double timeToNextEvent = GetTimeToNextEvent();
+		uint32_t riscCycles = USEC_TO_RISC_CYCLES(timeToNextEvent);
 //WriteLog("JEN: Time to next event (%u) is %f usec (%u RISC cycles)...\n", nextEvent, timeToNextEvent, USEC_TO_RISC_CYCLES(timeToNextEvent));
 
-		m68k_execute(USEC_TO_M68K_CYCLES(timeToNextEvent));
+		PERF_COUNT(gpu.cycles, riscCycles);
 
-		if (vjs.GPUEnabled)
-			GPUExec(USEC_TO_RISC_CYCLES(timeToNextEvent));
+		if (!vjs.GPUEnabled || !GPUIsRunning())
+			PERF_COUNT(gpu.idleCycles, riscCycles);
 
+		startTime = PerfHostTime();
+
+		// The GPU may run its slice on its own host thread, along with the 68K (its host
+		// time is then the time waited for it)
+		if (vjs.GPUEnabled && vjs.threadedGPU && GPUExecAsync(riscCycles))
+		{
+			PERF_COUNT(m68k.cycles, m68k_execute(USEC_TO_M68K_CYCLES(timeToNextEvent)));
+			PERF_COUNT(hostTime[PERF_TIME_M68K], (endTime = PerfHostTime()) - startTime);
+			GPUExecAsyncWait();
+		}
+		else
+		{
+			PERF_COUNT(m68k.cycles, m68k_execute(USEC_TO_M68K_CYCLES(timeToNextEvent)));
+			PERF_COUNT(hostTime[PERF_TIME_M68K], (endTime = PerfHostTime()) - startTime);
+
+			if (vjs.GPUEnabled)
+				GPUExec(riscCycles);
+		}
+
+		PERF_COUNT(hostTime[PERF_TIME_GPU], (startTime = PerfHostTime()) - endTime);
 		HandleNextEvent();
+		PERF_COUNT(hostTime[PERF_TIME_EVENTS], PerfHostTime() - startTime);
  	}
 	while (!frameDone);
+
+	// No line is left rendered ahead once the frame is done
+	OPSpeculationCancel();
+	PERF_COUNT(hostTime[PERF_TIME_FRAME], PerfHostTime() - frameTime);
+	PerfFrameDone();
 }
 
 
@@ -5,6 +5,8 @@
 #include <stdint.h>
 #include "memory.h"							// For "UNKNOWN" enum
 
+struct BrkCondition;
+
 // Breakpoint struture
 typedef struct BrkInfo
 {
@@ -16,6 +18,8 @@ typedef struct BrkInfo
 	size_t NumLine;				// Line number
 	size_t Adr;					// Breakpoint address
 	size_t HitCounts;			// Hit counts
+	char *Condition;			// Condition (allocated), & its bytecode (see brkcond.h)
+	BrkCondition *Cond;
 }S_BrkInfo;
 
 void JaguarSetScreenBuffer(uint32_t * buffer);
@@ -31,6 +35,7 @@ uint32_t JaguarReadLong(uint32_t offset, uint32_t who = UNKNOWN);
 void JaguarWriteByte(uint32_t offset, uint8_t data, uint32_t who = UNKNOWN);
 void JaguarWriteWord(uint32_t offset, uint16_t data, uint32_t who = UNKNOWN);
 void JaguarWriteLong(uint32_t offset, uint32_t data, uint32_t who = UNKNOWN);
+bool JaguarIsIdleRead(uint32_t address);
 
 bool JaguarInterruptHandlerIsValid(uint32_t i);
 void JaguarDasm(uint32_t offset, uint32_t qt);
@@ -39,15 +44,37 @@ void JaguarExecuteNew(void);
 int JaguarStepInto(void);
 int JaguarStepOver(int depth);
 
+// Jaguar state of a machine
+
+struct JaguarState
+{
+	uint32_t jaguarMainROMCRC32, jaguarROMSize, jaguarRunAddress;
+	bool jaguarCartInserted;
+	bool lowerField;
+	bool frameDone;
+	// M68K execution trace
+	uint32_t pcQueue[0x400];
+	uint32_t a0Queue[0x400], a1Queue[0x400], a2Queue[0x400], a3Queue[0x400];
+	uint32_t a4Queue[0x400], a5Queue[0x400], a6Queue[0x400], a7Queue[0x400];
+	uint32_t d0Queue[0x400], d1Queue[0x400], d2Queue[0x400], d3Queue[0x400];
+	uint32_t d4Queue[0x400], d5Queue[0x400], d6Queue[0x400], d7Queue[0x400];
+	uint32_t srQueue[0x400];
+	uint32_t pcQPtr;
+};
+
 // Exports from JAGUAR.CPP
 
 extern int32_t jaguarCPUInExec;
-extern uint32_t jaguarMainROMCRC32, jaguarROMSize, jaguarRunAddress;
 extern char * jaguarEepromsPath;
-extern bool jaguarCartInserted;
+// Of the current machine (see machine.h)
+#define jaguarMainROMCRC32	(jaguarMachine->jaguar.jaguarMainROMCRC32)
+#define jaguarROMSize		(jaguarMachine->jaguar.jaguarROMSize)
+#define jaguarRunAddress	(jaguarMachine->jaguar.jaguarRunAddress)
+#define jaguarCartInserted	(jaguarMachine->jaguar.jaguarCartInserted)
 extern bool bpmActive, bpmSaveActive;
 extern size_t bpmHitCounts;
 extern uint32_t bpmAddress1;
+extern BrkCondition *bpmCondition;
 extern bool startM68KTracing;
 extern S_BrkInfo *brkInfo;
 extern size_t brkNbr;
@@ -0,0 +1,254 @@
+//
+// jaguarcore.cpp - C interface to the Virtual Jaguar core library
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Added the execution trace dump
+// JPM   Oct./2026  Settings given by the first core only
+//
+
+#include "jaguarcore.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "crc32.h"
+#include "dac.h"
+#include "eeprom.h"
+#include "event.h"
+#include "jaguar.h"
+#include "joystick.h"
+#include "log.h"
+#include "machine.h"
+#include "modelsBIOS.h"
+#include "settings.h"
+#include "tom.h"
+#include "trace.h"
+
+
+// Screen buffer has the same size as the GUI texture
+#define SCREEN_BUFFER_WIDTH		1024
+#define SCREEN_BUFFER_HEIGHT	512
+// Enough room for the audio samples of a PAL frame
+#define AUDIO_BUFFER_SAMPLES	2048
+
+struct jaguarcore
+{
+	JaguarMachine * machine;
+	uint32_t * screen;
+	int16_t * audio;
+	unsigned int audioSamples;					// Samples produced by the last frame
+	double audioFraction;						// Part of a sample not yet produced
+};
+
+// Cores created, & the flags of the first one (the settings are process wide)
+static unsigned int coreCount = 0;
+static unsigned int coreFlags = 0;
+
+
+//
+// The first core gives the settings; the next ones must have the same flags
+//
+static bool jaguarcore_add(unsigned int flags)
+{
+	bool added = true;
+	JaguarMachinesLock();
+
+	if (!coreCount)
+	{
+		// Same defaults as the GUI, for a retail (M series) Jaguar
+		vjs.hardwareTypeNTSC = !(flags & JAGUARCORE_PAL);
+		vjs.useJaguarBIOS = !(flags & JAGUARCORE_NO_BIOS);
+		vjs.jaguarModel = JAG_M_SERIES;
+		vjs.biosType = BT_M_SERIES;
+		vjs.GPUEnabled = true;
+		vjs.DSPEnabled = true;
+		vjs.idleSkip = true;
+		vjs.trace = true;
+		vjs.DRAM_size = 0x200000;
+		strcpy(vjs.EEPROMPath, "./");
+		coreFlags = flags;
+	}
+	else if (flags != coreFlags)
+	{
+		WriteLog("Core: Flags $%X differ from the ones of the cores already created ($%X)\n", flags, coreFlags);
+		added = false;
+	}
+
+	if (added)
+		coreCount++;
+
+	JaguarMachinesUnlock();
+	return added;
+}
+
+
+static void jaguarcore_remove(void)
+{
+	JaguarMachinesLock();
+	coreCount--;
+	JaguarMachinesUnlock();
+}
+
+
+//
+// Create and power on a Jaguar
+//
+jaguarcore * jaguarcore_create(unsigned int flags)
+{
+	if (!jaguarcore_add(flags))
+		return NULL;
+
+	jaguarcore * core = (jaguarcore *)calloc(1, sizeof(jaguarcore));
+
+	if (!core)
+	{
+		jaguarcore_remove();
+		return NULL;
+	}
+
+	core->screen = (uint32_t *)calloc(SCREEN_BUFFER_WIDTH * SCREEN_BUFFER_HEIGHT, sizeof(uint32_t));
+	core->audio = (int16_t *)calloc(AUDIO_BUFFER_SAMPLES * 2, sizeof(int16_t));
+
+	if (!core->screen || !core->audio || !(core->machine = JaguarMachineCreate()))
+	{
+		free(core->audio);
+		free(core->screen);
+		free(core);
+		jaguarcore_remove();
+		return NULL;
+	}
+
+	JaguarSetScreenBuffer(core->screen);
+	JaguarSetScreenPitch(SCREEN_BUFFER_WIDTH);
+
+	// Behave as the GUI does when no cartridge has been loaded: the BIOS is running
+	jaguarCartInserted = true;
+	JaguarInit();
+	SelectBIOS(vjs.biosType);
+	jaguarcore_reset(core);
+
+	return core;
+}
+
+
+void jaguarcore_destroy(jaguarcore * core)
+{
+	if (!core)
+		return;
+
+	JaguarMachineSetCurrent(core->machine);
+	JaguarDone();
+	JaguarMachineDestroy(core->machine);
+	free(core->audio);
+	free(core->screen);
+	free(core);
+	jaguarcore_remove();
+}
+
+
+//
+// Load a cartridge ROM image in the Jaguar memory space, as JaguarLoadFile() does
+//
+int jaguarcore_load_rom(jaguarcore * core, const void * data, uint32_t size)
+{
+	// Cartridge space goes from $800000 to $DFFFFF
+	if (!data || !size || (size > 0x600000))
+		return 0;
+
+	JaguarMachineSetCurrent(core->machine);
+	jaguarROMSize = size;
+	jaguarMainROMCRC32 = crc32_calcCheckSum((unsigned char *)data, size);
+	EepromInit();
+	memcpy(jagMemSpace + 0x800000, data, size);
+	jaguarRunAddress = GET32(jagMemSpace, 0x800404);
+	jaguarCartInserted = true;
+	jaguarcore_reset(core);
+
+	return 1;
+}
+
+
+void jaguarcore_reset(jaguarcore * core)
+{
+	JaguarMachineSetCurrent(core->machine);
+	SET32(jaguarMainRAM, 0, vjs.DRAM_size);		// Set stack in the M68000's Reset SP
+	JaguarReset();
+	core->audioSamples = 0;
+	core->audioFraction = 0.0;
+}
+
+
+//
+// Run a frame, then JERRY for the same amount of time to get the audio samples
+//
+void jaguarcore_run_frame(jaguarcore * core)
+{
+	JaguarMachineSetCurrent(core->machine);
+	JaguarExecuteNew();
+
+	// A frame lasts 525 half lines of 31.78 us (NTSC), or 625 half lines of 32 us (PAL)
+	double frameTime = (vjs.hardwareTypeNTSC ? 525 * 31.777777777 : 625 * 32.0);
+	core->audioFraction += (frameTime * (double)DAC_AUDIO_RATE) / 1000000.0;
+	core->audioSamples = (unsigned int)core->audioFraction;
+	core->audioFraction -= core->audioSamples;
+
+	if (vjs.DSPEnabled && core->audioSamples)
+		DACFillBuffer((uint16_t *)core->audio, core->audioSamples * 2 * sizeof(int16_t));
+	else
+		memset(core->audio, 0, core->audioSamples * 2 * sizeof(int16_t));
+}
+
+
+const uint32_t * jaguarcore_get_frame(jaguarcore * core, unsigned int * width, unsigned int * height, unsigned int * pitch)
+{
+	JaguarMachineSetCurrent(core->machine);
+
+	if (width)
+		*width = TOMGetVideoModeWidth();
+
+	if (height)
+		*height = TOMGetVideoModeHeight();
+
+	if (pitch)
+		*pitch = SCREEN_BUFFER_WIDTH;
+
+	return core->screen;
+}
+
+
+const int16_t * jaguarcore_get_audio(jaguarcore * core, unsigned int * count)
+{
+	if (count)
+		*count = core->audioSamples;
+
+	return core->audio;
+}
+
+
+unsigned int jaguarcore_get_audio_rate(void)
+{
+	return DAC_AUDIO_RATE;
+}
+
+
+void jaguarcore_set_pad(jaguarcore * core, unsigned int pad, uint32_t buttons)
+{
+	JaguarMachineSetCurrent(core->machine);
+	uint8_t * joypadButtons = (pad ? joypad1Buttons : joypad0Buttons);
+
+	for(int i=BUTTON_FIRST; i<=BUTTON_LAST; i++)
+		joypadButtons[i] = (buttons & (1 << i) ? 0x01 : 0x00);
+}
+
+
+int jaguarcore_dump_trace(jaguarcore * core, const char * filename)
+{
+	JaguarMachineSetCurrent(core->machine);
+
+	return TraceDump(filename, "Requested") ? 1 : 0;
+}
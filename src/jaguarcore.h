@@ -0,0 +1,99 @@
+//
+// jaguarcore.h - C interface to the Virtual Jaguar core library
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Added the execution trace dump
+// JPM   Oct./2026  Settings given by the first core only
+//
+// This interface is used to embed the emulator without the Qt GUI. The library
+// is built without Qt & SDL by: make -f jaguarcore.mak STANDALONE=1
+// and linked with: -Lobj -ljaguarcore -lstdc++ -lm -lz
+//
+// Each core is an emulated Jaguar; several cores can be created & used by
+// different threads, but a core must only be used by one thread at a time. The
+// video standard & BIOS usage are process wide settings, given by the first
+// core created: the next ones are refused if they have other flags, as long as
+// a core remains.
+//
+
+#ifndef __JAGUARCORE_H__
+#define __JAGUARCORE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Flags used by jaguarcore_create()
+#define JAGUARCORE_NTSC				0x00
+#define JAGUARCORE_PAL				0x01
+#define JAGUARCORE_NO_BIOS			0x02	// Start the software without the boot ROM
+
+// Buttons of a pad, used by jaguarcore_set_pad()
+#define JAGUARCORE_PAD_UP			(1 << 0)
+#define JAGUARCORE_PAD_DOWN			(1 << 1)
+#define JAGUARCORE_PAD_LEFT			(1 << 2)
+#define JAGUARCORE_PAD_RIGHT		(1 << 3)
+#define JAGUARCORE_PAD_STAR			(1 << 4)
+#define JAGUARCORE_PAD_7			(1 << 5)
+#define JAGUARCORE_PAD_4			(1 << 6)
+#define JAGUARCORE_PAD_1			(1 << 7)
+#define JAGUARCORE_PAD_0			(1 << 8)
+#define JAGUARCORE_PAD_8			(1 << 9)
+#define JAGUARCORE_PAD_5			(1 << 10)
+#define JAGUARCORE_PAD_2			(1 << 11)
+#define JAGUARCORE_PAD_HASH			(1 << 12)
+#define JAGUARCORE_PAD_9			(1 << 13)
+#define JAGUARCORE_PAD_6			(1 << 14)
+#define JAGUARCORE_PAD_3			(1 << 15)
+#define JAGUARCORE_PAD_A			(1 << 16)
+#define JAGUARCORE_PAD_B			(1 << 17)
+#define JAGUARCORE_PAD_C			(1 << 18)
+#define JAGUARCORE_PAD_OPTION		(1 << 19)
+#define JAGUARCORE_PAD_PAUSE		(1 << 20)
+
+typedef struct jaguarcore jaguarcore;
+
+// Create a powered on Jaguar without cartridge, returns NULL in case of error
+// (or if the flags are not the ones of the cores already created)
+jaguarcore * jaguarcore_create(unsigned int flags);
+void jaguarcore_destroy(jaguarcore * core);
+
+// Insert a cartridge ROM image (without any header) and reset the Jaguar
+// Returns 0 if the image cannot be used. The EEPROM of the cartridge is kept
+// in the current directory.
+int jaguarcore_load_rom(jaguarcore * core, const void * data, uint32_t size);
+void jaguarcore_reset(jaguarcore * core);
+
+// Emulate one video frame (a field of 1/59.94 s in NTSC, 1/50 s in PAL),
+// with the audio samples produced during this time
+void jaguarcore_run_frame(jaguarcore * core);
+
+// Last emulated frame: each pixel is a 32-bit word 0xRRGGBBAA in host order
+// (same as GL_RGBA with GL_UNSIGNED_INT_8_8_8_8), and pitch is in pixels
+const uint32_t * jaguarcore_get_frame(jaguarcore * core, unsigned int * width, unsigned int * height, unsigned int * pitch);
+
+// Audio samples of the last emulated frame: signed 16-bit left/right pairs at
+// jaguarcore_get_audio_rate() Hz, and count is the number of pairs
+const int16_t * jaguarcore_get_audio(jaguarcore * core, unsigned int * count);
+unsigned int jaguarcore_get_audio_rate(void);
+
+// Buttons pressed on pad 0 or 1 (JAGUARCORE_PAD_* bits)
+void jaguarcore_set_pad(jaguarcore * core, unsigned int pad, uint32_t buttons);
+
+// Write the last instructions run by the 68K, GPU & DSP (read by the vjtrace
+// tool, see src/tools/vjtrace.cpp); returns 0 if the file cannot be written
+int jaguarcore_dump_trace(jaguarcore * core, const char * filename);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	// __JAGUARCORE_H__
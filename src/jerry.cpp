@@ -10,6 +10,7 @@
 // WHO  WHEN        WHAT
 // ---  ----------  -----------------------------------------------------------
 // JLH  11/25/2009  Major rewrite of memory subsystem and handlers
+// JPM   Oct./2026  JERRY state moved in the machine context
 //
 
 // ------------------------------------------------------------
@@ -163,6 +164,7 @@
 #include "jaguar.h"
 #include "joystick.h"
 #include "log.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
 #include "memtrack.h"
 #include "settings.h"
@@ -173,7 +175,20 @@
 //Note that 44100 Hz requires samples every 22.675737 usec.
 //#define JERRY_DEBUG
 
-/*static*/ uint8_t jerry_ram_8[0x10000];
+// JERRY state lives in the machine context (see jerry.h)
+#define jerry_ram_8				(jaguarMachine->jerry.jerry_ram_8)
+#define analog_x				(jaguarMachine->jerry.analog_x)
+#define analog_y				(jaguarMachine->jerry.analog_y)
+#define JERRYPIT1Prescaler		(jaguarMachine->jerry.JERRYPIT1Prescaler)
+#define JERRYPIT1Divider		(jaguarMachine->jerry.JERRYPIT1Divider)
+#define JERRYPIT2Prescaler		(jaguarMachine->jerry.JERRYPIT2Prescaler)
+#define JERRYPIT2Divider		(jaguarMachine->jerry.JERRYPIT2Divider)
+#define jerry_timer_1_counter	(jaguarMachine->jerry.jerry_timer_1_counter)
+#define jerry_timer_2_counter	(jaguarMachine->jerry.jerry_timer_2_counter)
+#define jerryI2SCycles			(jaguarMachine->jerry.jerryI2SCycles)
+#define jerryIntPending			(jaguarMachine->jerry.jerryIntPending)
+#define jerryInterruptMask		(jaguarMachine->jerry.jerryInterruptMask)
+#define jerryPendingInterrupt	(jaguarMachine->jerry.jerryPendingInterrupt)
 
 //#define JERRY_CONFIG	0x4002						// ??? What's this ???
 
@@ -193,22 +208,7 @@
 #define SMODE		0xA154
 
 
-uint8_t analog_x, analog_y;
-
-static uint32_t JERRYPIT1Prescaler;
-static uint32_t JERRYPIT1Divider;
-static uint32_t JERRYPIT2Prescaler;
-static uint32_t JERRYPIT2Divider;
-static int32_t jerry_timer_1_counter;
-static int32_t jerry_timer_2_counter;
-
 //uint32_t JERRYI2SInterruptDivide = 8;
-int32_t JERRYI2SInterruptTimer = -1;
-uint32_t jerryI2SCycles;
-uint32_t jerryIntPending;
-
-static uint16_t jerryInterruptMask = 0;
-static uint16_t jerryPendingInterrupt = 0;
 
 // Private function prototypes
 
@@ -368,6 +368,7 @@ void JERRYInit(void)
 	JERRYPIT2Divider = 0xFFFF;
 	jerryInterruptMask = 0x0000;
 	jerryPendingInterrupt = 0x0000;
+	JERRYI2SInterruptTimer = -1;
 
 	DACInit();
 }
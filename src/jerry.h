@@ -36,9 +36,28 @@ void JERRYSetPendingIRQ(int irq);
 // Need to set up an interface function so that this can go back
 void JERRYI2SCallback(void);
 
-// External variables
+// JERRY state of a machine
+
+struct JERRYState
+{
+	uint8_t jerry_ram_8[0x10000];
+	uint8_t analog_x, analog_y;
+	uint32_t JERRYPIT1Prescaler;
+	uint32_t JERRYPIT1Divider;
+	uint32_t JERRYPIT2Prescaler;
+	uint32_t JERRYPIT2Divider;
+	int32_t jerry_timer_1_counter;
+	int32_t jerry_timer_2_counter;
+	int32_t JERRYI2SInterruptTimer;
+	uint32_t jerryI2SCycles;
+	uint32_t jerryIntPending;
+	uint16_t jerryInterruptMask;
+	uint16_t jerryPendingInterrupt;
+};
+
+// External variables (of the current machine, see machine.h)
 
 //extern uint32_t JERRYI2SInterruptDivide;
-extern int32_t JERRYI2SInterruptTimer;
+#define JERRYI2SInterruptTimer	(jaguarMachine->jerry.JERRYI2SInterruptTimer)
 
 #endif
@@ -13,6 +13,8 @@
 // ---  ----------  -------------------------------------------------------------
 // JLH  01/16/2010  Created this log ;-)
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  Joypads state moved in the machine context
+// JPM   Oct./2026  Host gamepads buttons read at the time of the joypads registers read
 //
 
 #include "joystick.h"
@@ -20,13 +22,12 @@
 #include "gpu.h"
 #include "jaguar.h"
 #include "log.h"
+#include "machine.h"
 #include "settings.h"
 
 // Global vars
 
-static uint8_t joystick_ram[4];
-uint8_t joypad0Buttons[21];
-uint8_t joypad1Buttons[21];
+#define joystick_ram	(jaguarMachine->joystick.joystick_ram)	// In the machine context (see joystick.h)
 bool audioEnabled = false;
 bool joysticksEnabled = false;
 
@@ -71,6 +72,7 @@ void JoystickReset(void)
 	memset(joystick_ram, 0x00, 4);
 	memset(joypad0Buttons, 0, 21);
 	memset(joypad1Buttons, 0, 21);
+	jaguarMachine->joystick.hostButtons[0] = jaguarMachine->joystick.hostButtons[1] = 0;
 }
 
 
@@ -79,6 +81,16 @@ void JoystickDone(void)
 }
 
 
+//
+// Set the buttons held on the host gamepad of a joypad; it can be called by another
+// thread, while the machine runs, the registers reads taking the buttons at that time
+//
+void JoystickSetHostButtons(JaguarMachine * machine, uint32_t pad, uint32_t buttons)
+{
+	machine->joystick.hostButtons[pad & 0x01] = buttons;
+}
+
+
 uint16_t JoystickReadWord(uint32_t offset)
 {
 	// E, D, B, 7
@@ -96,6 +108,10 @@ uint16_t JoystickReadWord(uint32_t offset)
 #endif // _MSC_VER
 	offset &= 0x03;
 
+	// Host gamepads buttons held at the time of the read
+	uint32_t host0 = jaguarMachine->joystick.hostButtons[0];
+	uint32_t host1 = jaguarMachine->joystick.hostButtons[1];
+
 	if (offset == 0)
 	{
 		if (!joysticksEnabled)
@@ -113,7 +129,7 @@ uint16_t JoystickReadWord(uint32_t offset)
 			uint16_t msk2[4] = { 0xFFFF, 0xFFFD, 0xFFFB, 0xFFF7 };
 
 			for(uint8_t i=0; i<4; i++)
-				data &= (joypad0Buttons[offset0 + i] ? mask[i] : 0xFFFF);
+				data &= ((joypad0Buttons[offset0 + i] || (host0 & (1 << (offset0 + i)))) ? mask[i] : 0xFFFF);
 
 			data &= msk2[offset0 / 4];
 		}
@@ -124,7 +140,7 @@ uint16_t JoystickReadWord(uint32_t offset)
 			uint16_t msk2[4] = { 0xFF7F, 0xFFBF, 0xFFDF, 0xFFEF };
 
 			for(uint8_t i=0; i<4; i++)
-				data &= (joypad1Buttons[offset1 + i] ? mask[i] : 0xFFFF);
+				data &= ((joypad1Buttons[offset1 + i] || (host1 & (1 << (offset1 + i)))) ? mask[i] : 0xFFFF);
 
 			data &= msk2[offset1 / 4];
 		}
@@ -149,20 +165,20 @@ uint16_t JoystickReadWord(uint32_t offset)
 		{
 			offset0 /= 4;	// Make index 0, 1, 2, 3 instead of 0, 4, 8, 12
 			uint8_t mask[4][2] = { { BUTTON_A, BUTTON_PAUSE }, { BUTTON_B, 0xFF }, { BUTTON_C, 0xFF }, { BUTTON_OPTION, 0xFF } };
-			data &= (joypad0Buttons[mask[offset0][0]] ? 0xFFFD : 0xFFFF);
+			data &= ((joypad0Buttons[mask[offset0][0]] || (host0 & (1 << mask[offset0][0]))) ? 0xFFFD : 0xFFFF);
 
 			if (mask[offset0][1] != 0xFF)
-				data &= (joypad0Buttons[mask[offset0][1]] ? 0xFFFE : 0xFFFF);
+				data &= ((joypad0Buttons[mask[offset0][1]] || (host0 & (1 << mask[offset0][1]))) ? 0xFFFE : 0xFFFF);
 		}
 
 		if (offset1 != 0xFF)
 		{
 			offset1 /= 4;	// Make index 0, 1, 2, 3 instead of 0, 4, 8, 12
 			uint8_t mask[4][2] = { { BUTTON_A, BUTTON_PAUSE }, { BUTTON_B, 0xFF }, { BUTTON_C, 0xFF }, { BUTTON_OPTION, 0xFF } };
-			data &= (joypad1Buttons[mask[offset1][0]] ? 0xFFF7 : 0xFFFF);
+			data &= ((joypad1Buttons[mask[offset1][0]] || (host1 & (1 << mask[offset1][0]))) ? 0xFFF7 : 0xFFFF);
 
 			if (mask[offset1][1] != 0xFF)
-				data &= (joypad1Buttons[mask[offset1][1]] ? 0xFFFB : 0xFFFF);
+				data &= ((joypad1Buttons[mask[offset1][1]] || (host1 & (1 << mask[offset1][1]))) ? 0xFFFB : 0xFFFF);
 		}
 
 		return data;
@@ -39,9 +39,20 @@ void JoystickWriteWord(uint32_t, uint16_t);
 //uint8_t JoystickReadByte(uint32_t);
 uint16_t JoystickReadWord(uint32_t);
 void JoystickExec(void);
-
-extern uint8_t joypad0Buttons[];
-extern uint8_t joypad1Buttons[];
+void JoystickSetHostButtons(struct JaguarMachine * machine, uint32_t pad, uint32_t buttons);
+
+// Joysticks state of a machine
+struct JoystickState
+{
+	uint8_t joystick_ram[4];
+	uint8_t joypad0Buttons[21];
+	uint8_t joypad1Buttons[21];
+	volatile uint32_t hostButtons[2];			// Buttons held on the host gamepads (bit by button), set at any time by an input thread
+};
+
+// Of the current machine (see machine.h)
+#define joypad0Buttons	(jaguarMachine->joystick.joypad0Buttons)
+#define joypad1Buttons	(jaguarMachine->joystick.joypad1Buttons)
 extern bool audioEnabled;
 extern bool joysticksEnabled;
 
@@ -12,6 +12,7 @@
 #define __CPUDEFS_H__
 
 #include "sysdeps.h"
+#include "m68kinterface.h"
 
 /* Special flags */
 #define SPCFLAG_DEBUGGER      0x001
@@ -29,7 +30,7 @@
 
 struct regstruct
 {
-	uint32_t regs[16];
+	uint32_t da[16];						/* D0-D7 & A0-A7 */
 	uint32_t usp, isp;
 	uint16_t sr;
 	uint8_t s;
@@ -56,10 +57,46 @@ struct regstruct
 	uint32_t interruptCycles;
 };
 
-extern struct regstruct regs, lastint_regs;
+/* Straight run of 68K code, analysed for its flags liveness & run as threaded code (see m68kinterface.c) */
+#define M68K_BLOCK_CACHE_SIZE	4096		/* Blocks analysed (power of 2) */
+#define M68K_BLOCK_MAX_INSTR	16			/* Instructions in a block */
 
-#define m68k_dreg(r, num) ((r).regs[(num)])
-#define m68k_areg(r, num) (((r).regs + 8)[(num)])
+struct m68k_block
+{
+	uint32_t pc;							/* Address of the first instruction (odd for a free entry) */
+	uint32_t generation;					/* Generation of the code line holding the block */
+	uint32_t noFlags;						/* Instructions run by their flag free handler (a bit each) */
+	uint8_t count;							/* Number of instructions */
+	uint8_t idle;							/* Loops on itself writing registers only (idle loop candidate) */
+	uint8_t length[M68K_BLOCK_MAX_INSTR];	/* Size of each instruction, in bytes */
+	uint16_t opcode[M68K_BLOCK_MAX_INSTR];	/* Prefetched opcodes */
+	unsigned long (* handler[M68K_BLOCK_MAX_INSTR])(uint32_t);	/* Their handlers, flag free or not */
+};
+
+/* CPU context of one emulated machine */
+struct m68k_context
+{
+	struct regstruct regs;
+	int32_t initialCycles;
+	int checkForIRQToHandle;
+	int IRQLevelToHandle;
+	int noFlagsEnabled;
+	int blocksEnabled;
+	int idleSkipEnabled;
+	int traceEnabled;
+	uint64_t instructions;					/* Instructions run (performance counters) */
+	uint64_t idleCycles;					/* Cycles skipped in idle loops, or stopped */
+	struct m68k_block blocks[M68K_BLOCK_CACHE_SIZE];
+	unsigned int codeLines[0x1000000 >> M68K_CODE_LINE_SHIFT];
+};
+
+extern THREAD_LOCAL struct m68k_context * m68kContext;
+extern struct regstruct lastint_regs;
+
+#define regs (m68kContext->regs)
+
+#define m68k_dreg(r, num) ((r).da[(num)])
+#define m68k_areg(r, num) (((r).da + 8)[(num)])
 
 #define ZFLG (regs.z)
 #define NFLG (regs.n)
@@ -11,15 +11,15 @@
 #include "inlines.h"
 
 
-uint16_t last_op_for_exception_3;		// Opcode of faulting instruction
-uint32_t last_addr_for_exception_3;		// PC at fault time
-uint32_t last_fault_for_exception_3;	// Address that generated the exception
+THREAD_LOCAL uint16_t last_op_for_exception_3;		// Opcode of faulting instruction
+THREAD_LOCAL uint32_t last_addr_for_exception_3;	// PC at fault time
+THREAD_LOCAL uint32_t last_fault_for_exception_3;	// Address that generated the exception
 
-int OpcodeFamily;						// Used by cpuemu.c...
-int BusCyclePenalty = 0;				// Used by cpuemu.c...
-int CurrentInstrCycles;
+THREAD_LOCAL int OpcodeFamily;						// Used by cpuemu.c...
+THREAD_LOCAL int BusCyclePenalty = 0;				// Used by cpuemu.c...
+THREAD_LOCAL int CurrentInstrCycles;
 
-struct regstruct regs;
+THREAD_LOCAL struct m68k_context * m68kContext;		// Context of the machine run by this thread
 
 
 //
@@ -28,7 +28,7 @@ struct regstruct regs;
 uint32_t get_disp_ea_000(uint32_t base, uint32_t dp)
 {
 	int reg = (dp >> 12) & 0x0F;
-	int32_t regd = regs.regs[reg];
+	int32_t regd = regs.da[reg];
 
 #if 1
 	if ((dp & 0x800) == 0)
@@ -189,6 +189,9 @@ while (disPC < (currpc + 10));
 
 /*if( nr>=2 && nr<10 )  fprintf(stderr,"Exception (-> %i bombs)!\n",nr);*/
 
+	if (m68kContext->traceEnabled)
+		M68KTraceException(nr, currpc);
+
 	MakeSR();
 
 	// Change to supervisor mode if necessary
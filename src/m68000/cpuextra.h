@@ -2,6 +2,7 @@
 #define __CPUEXTRA_H__
 
 #include "sysdeps.h"
+#include "m68kinterface.h"
 
 typedef unsigned long cpuop_func(uint32_t);
 
@@ -12,17 +13,18 @@ struct cputbl
 	uint16_t opcode;
 };
 
-extern uint16_t last_op_for_exception_3;	/* Opcode of faulting instruction */
-extern uint32_t last_addr_for_exception_3;	/* PC at fault time */
-extern uint32_t last_fault_for_exception_3;	/* Address that generated the exception */
+/* These only live for the instruction being executed, so they belong to the host thread */
+extern THREAD_LOCAL uint16_t last_op_for_exception_3;	/* Opcode of faulting instruction */
+extern THREAD_LOCAL uint32_t last_addr_for_exception_3;	/* PC at fault time */
+extern THREAD_LOCAL uint32_t last_fault_for_exception_3;	/* Address that generated the exception */
 
 /* Family of the latest instruction executed (to check for pairing) */
-extern int OpcodeFamily;			/* see instrmnem in readcpu.h */
+extern THREAD_LOCAL int OpcodeFamily;			/* see instrmnem in readcpu.h */
 
 /* How many cycles to add to the current instruction in case a "misaligned" bus access is made */
 /* (used when addressing mode is d8(an,ix)) */
-extern int BusCyclePenalty;
-extern int CurrentInstrCycles;
+extern THREAD_LOCAL int BusCyclePenalty;
+extern THREAD_LOCAL int CurrentInstrCycles;
 
 extern uint32_t get_disp_ea_000(uint32_t base, uint32_t dp);
 extern void MakeSR(void);
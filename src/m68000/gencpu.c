@@ -65,6 +65,8 @@
 /*			Use BusCyclePenalty to properly handle the 2/4 cycles added in that case when	*/
 /*			addressing mode	is Ad8r or PC8r	(ULM Demo Menu, Anomaly Demo Intro, DHS		*/
 /*			Sommarhack 2010) (see m68000.h)							*/
+/* 2026/10/19	[JPM]	Generate cpuemu_nf.c & cpustbl_nf.c, building the handlers without flags	*/
+/*			update (see noflags.h), and share the tables with the NOFLAGS build.		*/
 
 
 //const char GenCpu_fileid[] = "Hatari gencpu.c : " __DATE__ " " __TIME__;
@@ -1736,7 +1738,7 @@ static void gen_opcode (unsigned long int opcode)
 	printf ("\tuint32_t oldpc = m68k_getpc();\n");
 	genamode (curi->smode, "srcreg", curi->size, "extra", 1, 0);
 	genamode (curi->dmode, "dstreg", curi->size, "dst", 2, 0);
-	printf ("\t{int32_t upper,lower,reg = regs.regs[(extra >> 12) & 15];\n");
+	printf ("\t{int32_t upper,lower,reg = regs.da[(extra >> 12) & 15];\n");
 	switch (curi->size) {
 	case sz_byte:
 	    printf ("\tlower=(int32_t)(int8_t)m68k_read_memory_8(dsta); upper = (int32_t)(int8_t)m68k_read_memory_8(dsta+1);\n");
@@ -2183,14 +2185,14 @@ static void gen_opcode (unsigned long int opcode)
 	genamode (curi->smode, "srcreg", curi->size, "src", 1, 0);
 	start_brace ();
 	printf ("\tint regno = (src >> 12) & 15;\n");
-	printf ("\tuint32_t *regp = regs.regs + regno;\n");
+	printf ("\tuint32_t *regp = regs.da + regno;\n");
 	printf ("\tif (! m68k_movec2(src & 0xFFF, regp)) goto %s;\n", endlabelstr);
 	break;
     case i_MOVE2C:
 	genamode (curi->smode, "srcreg", curi->size, "src", 1, 0);
 	start_brace ();
 	printf ("\tint regno = (src >> 12) & 15;\n");
-	printf ("\tuint32_t *regp = regs.regs + regno;\n");
+	printf ("\tuint32_t *regp = regs.da + regno;\n");
 	printf ("\tif (! m68k_move2c(src & 0xFFF, regp)) goto %s;\n", endlabelstr);
 	break;
     case i_CAS:
@@ -2215,8 +2217,8 @@ static void gen_opcode (unsigned long int opcode)
     break;
     case i_CAS2:
 	genamode (curi->smode, "srcreg", curi->size, "extra", 1, 0);
-	printf ("\tuint32_t rn1 = regs.regs[(extra >> 28) & 15];\n");
-	printf ("\tuint32_t rn2 = regs.regs[(extra >> 12) & 15];\n");
+	printf ("\tuint32_t rn1 = regs.da[(extra >> 28) & 15];\n");
+	printf ("\tuint32_t rn2 = regs.da[(extra >> 12) & 15];\n");
 	if (curi->size == sz_word) {
 	    int old_brace_level = n_braces;
 	    printf ("\tuint16_t dst1 = m68k_read_memory_16(rn1), dst2 = m68k_read_memory_16(rn2);\n");
@@ -2256,7 +2258,7 @@ static void gen_opcode (unsigned long int opcode)
 	printf ("\tif (extra & 0x800)\n");
 	old_brace_level = n_braces;
 	start_brace ();
-	printf ("\tuint32_t src = regs.regs[(extra >> 12) & 15];\n");
+	printf ("\tuint32_t src = regs.da[(extra >> 12) & 15];\n");
 	genamode (curi->dmode, "dstreg", curi->size, "dst", 2, 0);
 	genastore ("src", curi->dmode, "dstreg", curi->size, "dst");
 	pop_braces (old_brace_level);
@@ -2542,7 +2544,15 @@ static void GenerateTables(FILE * f)
 {
 	int i, j;
 
-	fprintf(f, "\nconst int areg_byteinc[] = { 1, 1, 1, 1, 1, 1, 1, 2 };\n");
+	// The flag free build includes this file too, and uses the same tables
+	fprintf(f, "\n#ifdef NOFLAGS\n");
+	fprintf(f, "extern const int areg_byteinc[];\n");
+	fprintf(f, "extern const int imm8_table[];\n");
+	fprintf(f, "extern const int movem_index1[256];\n");
+	fprintf(f, "extern const int movem_index2[256];\n");
+	fprintf(f, "extern const int movem_next[256];\n");
+	fprintf(f, "#else\n");
+	fprintf(f, "const int areg_byteinc[] = { 1, 1, 1, 1, 1, 1, 1, 2 };\n");
 	fprintf(f, "const int imm8_table[]   = { 8, 1, 2, 3, 4, 5, 6, 7 };\n\n");
 	fprintf(f, "const int movem_index1[256] = {\n");
 
@@ -2588,7 +2598,25 @@ static void GenerateTables(FILE * f)
 			fprintf(f, "\n");
 	}
 
-	fprintf(f, "};\n\n");
+	fprintf(f, "};\n");
+	fprintf(f, "#endif\n\n");
+}
+
+
+// Flag free handlers are the same source, built with NOFLAGS defined
+static void GenerateNoFlagsFile(const char * filename, const char * source)
+{
+	FILE * f = fopen(filename, "wb");
+
+	if (f == NULL)
+	{
+		perror(filename);
+		exit(-1);
+	}
+
+	fprintf(f, "#define NOFLAGS\n");
+	fprintf(f, "#include \"%s\"\n", source);
+	fclose(f);
 }
 
 static int postfix;
@@ -2813,6 +2841,9 @@ int main(int argc, char ** argv)
 
 	generate_func();
 
+	GenerateNoFlagsFile("cpuemu_nf.c", "cpuemu.c");
+	GenerateNoFlagsFile("cpustbl_nf.c", "cpustbl.c");
+
 	free(table68k);
 	return 0;
 }
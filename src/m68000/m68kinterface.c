@@ -9,10 +9,17 @@
 // Who  When        What
 // ---  ----------  -------------------------------------------------------------
 // JLH  10/28/2011  Created this file ;-)
+// JPM   Oct./2026  CPU state moved in a per machine context
+// JPM   Oct./2026  Flag free opcode handlers selected by the flags liveness
+// JPM   Oct./2026  Blocks of code run as threaded code
+// JPM   Oct./2026  Idle loops skipped up to the end of the time slice
+// JPM   Oct./2026  Instructions & idle cycles counted for the performance counters
+// JPM   Oct./2026  Instructions, exceptions & idle loops given to the execution trace
 //
 
 #include "m68kinterface.h"
 //#include <pthread.h>
+#include <string.h>
 #include "cpudefs.h"
 #include "inlines.h"
 #include "cpuextra.h"
@@ -43,6 +50,7 @@
 //extern const struct cputbl op_smalltbl_3_ff[];	/* 68010 */
 extern const struct cputbl op_smalltbl_4_ff[];	/* 68000 */
 extern const struct cputbl op_smalltbl_5_ff[];	/* 68000 slow but compatible.  */
+extern const struct cputbl op_smalltbl_5_nf[];	/* Same, without flags update (see noflags.h) */
 
 // Externs, supplied by the user...
 //extern int irq_ack_handler(int);
@@ -55,16 +63,30 @@ STATIC_INLINE void m68ki_stack_frame_3word(uint32_t pc, uint32_t sr);
 unsigned long IllegalOpcode(uint32_t opcode);
 void BuildCPUFunctionTable(void);
 void m68k_set_irq2(unsigned int intLevel);
+static void m68k_flush_blocks(m68k_context * context);
 
 // Local "Global" vars
-static int32_t initialCycles;
-cpuop_func * cpuFunctionTable[65536];
+cpuop_func * cpuFunctionTable[65536];			// Shared by all the CPU contexts
+cpuop_func * cpuFunctionTableNF[65536];			// Flag free handlers, shared too
+THREAD_LOCAL unsigned int * m68kCodeLines;		// Code lines of the current CPU context
+
+// These ones are part of the current CPU context (see cpudefs.h)
+#define initialCycles			(m68kContext->initialCycles)
 
 // By virtue of the fact that m68k_set_irq() can be called asychronously by
 // another thread, we need something along the lines of this:
-static int checkForIRQToHandle = 0;
+#define checkForIRQToHandle		(m68kContext->checkForIRQToHandle)
 //static pthread_mutex_t executionLock = PTHREAD_MUTEX_INITIALIZER;
-static int IRQLevelToHandle = 0;
+#define IRQLevelToHandle		(m68kContext->IRQLevelToHandle)
+#define noFlagsEnabled			(m68kContext->noFlagsEnabled)
+#define blocksEnabled			(m68kContext->blocksEnabled)
+#define idleSkipEnabled			(m68kContext->idleSkipEnabled)
+#define traceEnabled			(m68kContext->traceEnabled)
+#define instructionCount		(m68kContext->instructions)
+#define idleCycleCount			(m68kContext->idleCycles)
+
+// All the flags (bits are X, N, Z, V & C as in table68k)
+#define M68K_ALL_FLAGS			0x1F
 
 #if 0
 #define ADD_CYCLES(A)    m68ki_remaining_cycles += (A)
@@ -118,7 +140,7 @@ void DumpRegisters(void)
 
 	for(i=0; i<16; i++)
 	{
-		printf("%s%i: %08X ", (i < 8 ? "D" : "A"), i & 0x7, regs.regs[i]);
+		printf("%s%i: %08X ", (i < 8 ? "D" : "A"), i & 0x7, regs.da[i]);
 
 		if ((i & 0x03) == 3)
 			printf("\n");
@@ -159,12 +181,420 @@ void m68k_set_cpu_type(unsigned int type)
 }
 
 
-// Pulse the RESET line on the CPU
-void m68k_pulse_reset(void)
+//
+// Create the CPU context of a new emulated machine
+//
+m68k_context * m68k_create_context(void)
+{
+	m68k_context * context = (m68k_context *)calloc(1, sizeof(m68k_context));
+
+	if (context)
+		m68k_flush_blocks(context);
+
+	return context;
+}
+
+
+void m68k_destroy_context(m68k_context * context)
+{
+	if (m68kContext == context)
+		m68kContext = NULL;
+
+	free(context);
+}
+
+
+//
+// Select the CPU context run by the calling host thread
+//
+void m68k_set_current_context(m68k_context * context)
+{
+	m68kContext = context;
+	m68kCodeLines = (context ? context->codeLines : NULL);
+}
+
+
+void m68k_set_noflags(int enable)
+{
+	noFlagsEnabled = enable;
+}
+
+
+void m68k_set_blocks(int enable)
+{
+	blocksEnabled = enable;
+}
+
+
+// Idle loops are only found in the blocks
+void m68k_set_idle_skip(int enable)
+{
+	idleSkipEnabled = enable;
+}
+
+
+void m68k_set_trace(int enable)
+{
+	traceEnabled = enable;
+}
+
+
+void m68k_get_counters(uint64_t * instructions, uint64_t * idleCycles)
+{
+	*instructions = instructionCount;
+	*idleCycles = idleCycleCount;
+	instructionCount = idleCycleCount = 0;
+}
+
+
+//
+// Give an instruction about to be run to the execution trace
+// The flag free handlers leave the CCR as it was, so the traced instructions run
+// the full ones, for the SR recorded to hold the flags of the previous instruction
+//
+STATIC_INLINE void m68k_trace_instruction(uint32_t pc, uint32_t opcode)
+{
+	uint32_t sr = (regs.s << 13) | (regs.intmask << 8) | (GET_XFLG << 4) | (GET_NFLG << 3) | (GET_ZFLG << 2) | (GET_VFLG << 1) | GET_CFLG;
+	M68KTraceInstruction(pc, opcode, regs.da, sr);
+}
+
+
+//
+// Forget all the analysed blocks (code may have been loaded without M68K_CODE_WRITE)
+//
+static void m68k_flush_blocks(m68k_context * context)
+{
+	int i;
+
+	for(i=0; i<M68K_BLOCK_CACHE_SIZE; i++)
+		context->blocks[i].pc = 1;
+}
+
+
+//
+// Size of the extension words of an addressing mode
+//
+static uint32_t m68k_extension_size(const struct instr * instruction, int mode)
+{
+	switch (mode)
+	{
+	case Ad16: case Ad8r: case PC16: case PC8r: case absw: case imm0: case imm1:
+		return 2;
+	case absl: case imm2:
+		return 4;
+	case imm:
+		return (instruction->size == sz_long ? 4 : 2);
+	default:
+		return 0;
+	}
+}
+
+
+//
+// Size of an instruction, from the extension words of its addressing modes
+//
+static uint32_t m68k_instruction_size(const struct instr * instruction)
+{
+	return 2 + m68k_extension_size(instruction, instruction->smode) + m68k_extension_size(instruction, instruction->dmode);
+}
+
+
+//
+// An idle loop operand is a register, or memory which is only read with a mode
+// whose address can be found back from the registers and the extension words
+//
+static int m68k_idle_operand(int mode, int use)
+{
+	if (!use)
+		return 1;
+
+	// Written
+	if (use & 0x02)
+		return ((mode == Dreg) || (mode == Areg));
+
+	switch (mode)
+	{
+	case Dreg: case Areg: case Aind: case Ad16: case absw: case absl: case PC16:
+	case imm: case imm0: case imm1: case imm2: case immi:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+
+//
+// A block branching back to itself, whose instructions only write registers, may be
+// an idle loop (waiting for an interrupt, or for a value changed by another processor)
+//
+static int m68k_idle_candidate(struct m68k_block * block)
+{
+	uint32_t address = block->pc;
+	int i;
+
+	if (!block->count)
+		return 0;
+
+	for(i=0; i<(block->count - 1); i++)
+	{
+		const struct instr * instruction = &table68k[block->opcode[i]];
+
+		switch (instruction->mnemo)
+		{
+		case i_OR: case i_AND: case i_EOR: case i_SUB: case i_SUBA: case i_SUBX: case i_ADD: case i_ADDA: case i_ADDX:
+		case i_NEG: case i_NEGX: case i_CLR: case i_NOT: case i_TST: case i_BTST: case i_BCHG: case i_BCLR: case i_BSET:
+		case i_CMP: case i_CMPA: case i_MOVE: case i_MOVEA: case i_SWAP: case i_EXG: case i_EXT: case i_NOP: case i_LEA:
+		case i_Scc: case i_MULU: case i_MULS: case i_ASR: case i_ASL: case i_LSR: case i_LSL: case i_ROL: case i_ROR:
+		case i_ROXL: case i_ROXR:
+			break;
+		default:
+			return 0;
+		}
+
+		if (!m68k_idle_operand(instruction->smode, instruction->sduse >> 4) || !m68k_idle_operand(instruction->dmode, instruction->sduse & 0x0F))
+			return 0;
+
+		address += block->length[i];
+	}
+
+	// Bcc.B or Bcc.W back to the start of the block
+	uint16_t opcode = block->opcode[block->count - 1];
+
+	if ((table68k[opcode].mnemo != i_Bcc) || ((opcode & 0xFF) == 0xFF))
+		return 0;
+
+	int32_t displacement = ((opcode & 0xFF) ? (int8_t)opcode : (int16_t)m68k_read_code_16(address + 2));
+
+	return ((address + 2 + displacement) == block->pc);
+}
+
+
+//
+// Analyse the straight run of code starting at pc, within its code line
+// The flags are live at the end of the block; going backward, an instruction
+// can skip its flags update if none of the flags it sets is live after it
+//
+static void m68k_analyse_block(struct m68k_block * block, uint32_t pc)
+{
+	uint32_t address = pc;
+	uint32_t lineEnd = ((pc >> M68K_CODE_LINE_SHIFT) + 1) << M68K_CODE_LINE_SHIFT;
+	unsigned int * codeLine = &m68kCodeLines[(pc & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT];
+	int count = 0, live = M68K_ALL_FLAGS, i;
+
+	while (count < M68K_BLOCK_MAX_INSTR)
+	{
+		unsigned int opcode = m68k_read_code_16(address);
+
+		if ((opcode > 0xFFFF) || (table68k[opcode].mnemo == i_ILLG) || (table68k[opcode].clev > 0))
+			break;
+
+		uint32_t size = m68k_instruction_size(&table68k[opcode]);
+
+		if ((address + size) > lineEnd)
+			break;
+
+		block->opcode[count] = opcode;
+		block->length[count++] = size;
+		address += size;
+
+		// Jumps, and instructions with unknown flags, end the block
+		if (table68k[opcode].isjmp || (table68k[opcode].flagdead == -1))
+			break;
+	}
+
+	block->pc = pc;
+	block->count = count;
+	block->noFlags = 0;
+
+	for(i=count-1; i>=0; i--)
+	{
+		const struct instr * instruction = &table68k[block->opcode[i]];
+		block->handler[i] = cpuFunctionTable[block->opcode[i]];
+
+		if ((instruction->flagdead > 0) && !(instruction->flagdead & live))
+		{
+			block->noFlags |= 1u << i;
+
+			if (noFlagsEnabled)
+				block->handler[i] = cpuFunctionTableNF[block->opcode[i]];
+		}
+
+		// A privileged instruction may trap, and stack the flags
+		if ((instruction->flagdead == -1) || instruction->plev)
+			live = M68K_ALL_FLAGS;
+		else
+			live = (live & ~instruction->flagdead) | instruction->flaglive;
+	}
+
+	block->idle = m68k_idle_candidate(block);
+	*codeLine |= 1;
+	block->generation = *codeLine;
+}
+
+
+//
+// Get the analysis of the block starting at pc, done again if its code line has been written
+//
+static struct m68k_block * m68k_find_block(uint32_t pc)
+{
+	struct m68k_block * block = &m68kContext->blocks[(pc >> 1) & (M68K_BLOCK_CACHE_SIZE - 1)];
+
+	if ((block->pc != pc) || (block->generation != m68kCodeLines[(pc & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT]))
+		m68k_analyse_block(block, pc);
+
+	return block;
+}
+
+
+//
+// Run the instructions of a block, as long as the code goes straight through it
+// Cycles are counted as by the interpreter, and it is left as soon as an interrupt
+// has to be handled
+//
+static void m68k_run_block(struct m68k_block * block)
+{
+	unsigned int * codeLine = &m68kCodeLines[(block->pc & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT];
+	uint32_t pc = block->pc;
+	int i;
+
+	for(i=0; i<block->count; i++)
+	{
+		cpuop_func * handler = block->handler[i];
+
+		if (traceEnabled)
+		{
+			m68k_trace_instruction(pc, block->opcode[i]);
+			handler = cpuFunctionTable[block->opcode[i]];
+		}
+
+		regs.remainingCycles -= (int32_t)(*handler)(block->opcode[i]);
+		pc += block->length[i];
+
+		// Jump, exception, end of the time slice, debugger halt, or code of the block written
+		if ((m68k_getpc() != pc) || (regs.remainingCycles <= 0) || checkForIRQToHandle
+			|| (regs.spcflags & SPCFLAG_DEBUGGER) || (block->generation != *codeLine))
+			break;
+	}
+
+	instructionCount += (i < block->count ? i + 1 : i);
+}
+
+
+//
+// Check the memory read by an instruction about to be run, its address coming from
+// the registers as they are now
+//
+static int m68k_idle_reads(const struct instr * instruction, uint32_t pc)
+{
+	uint32_t extension = pc + 2, address;
+	int i;
+
+	for(i=0; i<2; i++)
+	{
+		int mode = (i ? instruction->dmode : instruction->smode);
+		int reg = (i ? instruction->dreg : instruction->sreg);
+		int use = (i ? instruction->sduse & 0x0F : instruction->sduse >> 4);
+
+		switch (mode)
+		{
+		case Aind:
+			address = m68k_areg(regs, reg);
+			break;
+		case Ad16:
+			address = m68k_areg(regs, reg) + (int16_t)m68k_read_code_16(extension);
+			break;
+		case absw:
+			address = (int16_t)m68k_read_code_16(extension);
+			break;
+		case absl:
+			address = (m68k_read_code_16(extension) << 16) | m68k_read_code_16(extension + 2);
+			break;
+		case PC16:
+			address = extension + (int16_t)m68k_read_code_16(extension);
+			break;
+		default:
+			use = 0;
+			break;
+		}
+
+		if (use && !m68k_is_idle_read(address & 0xFFFFFF))
+			return 0;
+
+		extension += m68k_extension_size(instruction, mode);
+	}
+
+	return 1;
+}
+
+
+//
+// Run a block looping on itself; if an iteration leaves the registers & the flags as
+// they were, having only read memory without side effect, the next ones would do the
+// same up to the end of the time slice, and they are skipped, their cycles being used
+// as if they had been run. A write of the DSP (run by the host audio thread) or of the
+// GPU on its host thread is then seen at the next time slice, a halfline at most.
+//
+static void m68k_run_idle_block(struct m68k_block * block)
+{
+	unsigned int * codeLine = &m68kCodeLines[(block->pc & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT];
+	uint32_t da[16], flags[5];
+	uint32_t pc = block->pc;
+	int32_t iteration = regs.remainingCycles;
+	int pure = 1, i;
+
+	memcpy(da, regs.da, sizeof(da));
+	flags[0] = regs.c, flags[1] = regs.z, flags[2] = regs.n, flags[3] = regs.v, flags[4] = regs.x;
+
+	for(i=0; i<block->count; i++)
+	{
+		pure = pure && m68k_idle_reads(&table68k[block->opcode[i]], pc);
+
+		cpuop_func * handler = block->handler[i];
+
+		if (traceEnabled)
+		{
+			m68k_trace_instruction(pc, block->opcode[i]);
+			handler = cpuFunctionTable[block->opcode[i]];
+		}
+
+		regs.remainingCycles -= (int32_t)(*handler)(block->opcode[i]);
+		pc += block->length[i];
+
+		if ((m68k_getpc() != pc) || (regs.remainingCycles <= 0) || checkForIRQToHandle
+			|| (regs.spcflags & SPCFLAG_DEBUGGER) || (block->generation != *codeLine))
+			break;
+	}
+
+	instructionCount += (i < block->count ? i + 1 : i);
+
+	// Branched back to the start, with time left for at least another iteration
+	iteration -= regs.remainingCycles;
+
+	if (!pure || (i != (block->count - 1)) || (m68k_getpc() != block->pc) || (iteration <= 0)
+		|| (regs.remainingCycles <= iteration) || checkForIRQToHandle || (regs.spcflags & SPCFLAG_DEBUGGER)
+		|| (block->generation != *codeLine) || memcmp(da, regs.da, sizeof(da)) || (flags[0] != regs.c)
+		|| (flags[1] != regs.z) || (flags[2] != regs.n) || (flags[3] != regs.v) || (flags[4] != regs.x))
+		return;
+
+	// The last iteration, maybe not complete, is run as usual
+	int32_t skipped = (regs.remainingCycles - 1) / iteration;
+	regs.remainingCycles -= skipped * iteration;
+	idleCycleCount += skipped * iteration;
+	instructionCount += skipped * block->count;
+
+	if (traceEnabled)
+		M68KTraceIdle(block->pc, skipped * iteration);
+}
+
+
+//
+// Build the opcode handler jump table (shared by all the CPU contexts), from the first
+// JaguarInit(), under the machines lock
+//
+void m68k_build_tables(void)
 {
 	static uint32_t emulation_initialized = 0;
 
-	// The first call to this function initializes the opcode handler jump table
 	if (!emulation_initialized)
 	{
 #if 0
@@ -183,6 +613,14 @@ void m68k_pulse_reset(void)
 #endif
 		emulation_initialized = 1;
 	}
+}
+
+
+// Pulse the RESET line on the CPU
+void m68k_pulse_reset(void)
+{
+	// The first call to this function initializes the opcode handler jump table
+	m68k_build_tables();
 
 //	if (CPU_TYPE == 0)	/* KW 990319 */
 //		m68k_set_cpu_type(M68K_CPU_TYPE_68000);
@@ -215,6 +653,7 @@ void m68k_pulse_reset(void)
 	m68ki_jump(REG_PC);
 #else
 	checkForIRQToHandle = 0;
+	m68k_flush_blocks(m68kContext);
 	regs.spcflags = 0;
 	regs.stopped = 0;
 	regs.remainingCycles = 0;
@@ -232,10 +671,15 @@ void m68k_pulse_reset(void)
 
 int m68k_execute(int num_cycles)
 {
+	// Block holding the instruction being run, for the flag free handlers
+	struct m68k_block * block = NULL;
+	uint32_t blockIndex = 0, nextPC = 1;
+
 	if (regs.stopped)
 	{
 		regs.remainingCycles = 0;	// int32_t
 		regs.interruptCycles = 0;	// uint32_t
+		idleCycleCount += num_cycles;
 
 		return num_cycles;
 	}
@@ -307,7 +751,7 @@ if (regs.pc == 0x803416)
 	hitCount++;
 	inRoutine = 1;
 	instSeen = 0;
-	printf("%i: $80340A start. A0=%08X, A1=%08X ", hitCount, regs.regs[8], regs.regs[9]);
+	printf("%i: $80340A start. A0=%08X, A1=%08X ", hitCount, regs.da[8], regs.da[9]);
 }
 else if (regs.pc == 0x803422)
 {
@@ -331,7 +775,7 @@ if (inRoutine)
 	if (regs.pc == 0x94C6)
 		go = 0;
 
-//	if (regs.regs[10] == 0xFFFFFFFF && go)
+//	if (regs.da[10] == 0xFFFFFFFF && go)
 	if (go)
 	{
 //		printf("A2=-1, PC=%08X\n", regs.pc);
@@ -356,6 +800,23 @@ if (inRoutine)
 #ifdef M68K_HOOK_FUNCTION
 		M68KInstructionHook();
 #endif
+		// Threaded code, the interpreter below being used for what cannot be analysed
+		if (blocksEnabled && !(m68k_getpc() & 0x01))
+		{
+			struct m68k_block * runBlock = m68k_find_block(m68k_getpc());
+
+			if (runBlock->count)
+			{
+				if (runBlock->idle && idleSkipEnabled)
+					m68k_run_idle_block(runBlock);
+				else
+					m68k_run_block(runBlock);
+
+				nextPC = 1;
+				continue;
+			}
+		}
+
 		uint32_t opcode = get_iword(0);
 //if ((opcode & 0xFFF8) == 0x31C0)
 //{
@@ -368,7 +829,39 @@ if (inRoutine)
 		}
 		else
 		{
-			cycles = (int32_t)(*cpuFunctionTable[opcode])(opcode);
+			cpuop_func * handler = cpuFunctionTable[opcode];
+
+			if (noFlagsEnabled)
+			{
+				uint32_t pc = m68k_getpc();
+
+				// Next instruction of the block, unless code has been written meanwhile
+				if ((pc != nextPC) || (++blockIndex >= block->count)
+					|| (block->generation != m68kCodeLines[(pc & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT]))
+				{
+					block = m68k_find_block(pc);
+					blockIndex = 0;
+				}
+
+				if (blockIndex < block->count)
+				{
+					nextPC = pc + block->length[blockIndex];
+
+					if (block->noFlags & (1u << blockIndex))
+						handler = cpuFunctionTableNF[opcode];
+				}
+				else
+					nextPC = 1;
+			}
+
+			if (traceEnabled)
+			{
+				m68k_trace_instruction(m68k_getpc(), opcode);
+				handler = cpuFunctionTable[opcode];
+			}
+
+			cycles = (int32_t)(*handler)(opcode);
+			instructionCount++;
 		}
 		regs.remainingCycles -= cycles;
 //		pthread_mutex_unlock(&executionLock);
@@ -540,6 +1033,9 @@ void m68ki_exception_interrupt(uint32_t intLevel)
 		return;
 	}
 
+	if (traceEnabled)
+		M68KTraceException(vector, regs.pc);
+
 	// Start exception processing
 	uint32_t sr = m68ki_init_exception();
 
@@ -630,7 +1126,7 @@ STATIC_INLINE void m68ki_stack_frame_3word(uint32_t pc, uint32_t sr)
 unsigned int m68k_get_reg(void * context, m68k_register_t reg)
 {
 	if (reg <= M68K_REG_A7)
-		return regs.regs[reg];
+		return regs.da[reg];
 	else if (reg == M68K_REG_PC)
 		return regs.pc;
 	else if (reg == M68K_REG_SR)
@@ -639,7 +1135,7 @@ unsigned int m68k_get_reg(void * context, m68k_register_t reg)
 		return regs.sr;
 	}
 	else if (reg == M68K_REG_SP)
-		return regs.regs[15];
+		return regs.da[15];
 
 	return 0;
 }
@@ -648,7 +1144,7 @@ unsigned int m68k_get_reg(void * context, m68k_register_t reg)
 void m68k_set_reg(m68k_register_t reg, unsigned int value)
 {
 	if (reg <= M68K_REG_A7)
-		regs.regs[reg] = value;
+		regs.da[reg] = value;
 	else if (reg == M68K_REG_PC)
 		regs.pc = value;
 	else if (reg == M68K_REG_SR)
@@ -657,7 +1153,7 @@ void m68k_set_reg(m68k_register_t reg, unsigned int value)
 		MakeFromSR();
 	}
 	else if (reg == M68K_REG_SP)
-		regs.regs[15] = value;
+		regs.da[15] = value;
 }
 
 
@@ -755,11 +1251,15 @@ void BuildCPUFunctionTable(void)
 
 	// Set all instructions to Illegal...
 	for(opcode=0; opcode<65536; opcode++)
-		cpuFunctionTable[opcode] = IllegalOpcode;
+		cpuFunctionTable[opcode] = cpuFunctionTableNF[opcode] = IllegalOpcode;
 
 	// Move functions from compact table into our full function table...
+	// (the flag free table lists the same opcodes)
 	for(i=0; tbl[i].handler!=NULL; i++)
+	{
 		cpuFunctionTable[tbl[i].opcode] = tbl[i].handler;
+		cpuFunctionTableNF[tbl[i].opcode] = op_smalltbl_5_nf[i].handler;
+	}
 
 //JLH: According to readcpu.c, handler is set to -1 and never changes.
 // Actually, it does read this crap in readcpu.c, do_merges() does it... :-P
@@ -780,6 +1280,7 @@ void BuildCPUFunctionTable(void)
 				abort();
 
 			cpuFunctionTable[opcode] = f;
+			cpuFunctionTableNF[opcode] = cpuFunctionTableNF[table68k[opcode].handler];
 		}
 	}
 #endif
@@ -4,6 +4,16 @@
 // by James Hammons
 // (C) 2011 Underground Software
 //
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Flag free opcode handlers & code lines written notification
+// JPM   Oct./2026  Blocks of code run as threaded code
+// JPM   Oct./2026  Idle loops skip
+// JPM   Oct./2026  Performance counters
+// JPM   Oct./2026  Execution trace hooks
+//
 // Most of these functions are in place to help make it easy to replace the
 // Musashi core with my bastardized UAE one. :-)
 //
@@ -11,10 +21,21 @@
 #ifndef __M68KINTERFACE_H__
 #define __M68KINTERFACE_H__
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Storage class of the per host thread pointers to the current CPU context
+#if defined(_MSC_VER)
+#define THREAD_LOCAL	__declspec(thread)
+#elif defined(__GNUC__) && defined(__ELF__)
+#define THREAD_LOCAL	__thread __attribute__((tls_model("initial-exec")))
+#else
+#define THREAD_LOCAL	__thread
+#endif
+
 /* Registers used by m68k_get_reg() and m68k_set_reg() */
 typedef enum
 {
@@ -69,6 +90,39 @@ typedef enum
  */
 #define M68K_INT_ACK_SPURIOUS      0xFFFFFFFE
 
+// CPU contexts: each emulated machine has its own, and a host thread runs the
+// context it has made current (all the functions below work on that one)
+typedef struct m68k_context m68k_context;
+
+m68k_context * m68k_create_context(void);
+void m68k_destroy_context(m68k_context * context);
+void m68k_set_current_context(m68k_context * context);
+void m68k_build_tables(void);
+
+// Run the flag free opcode handlers when the flags are overwritten before being
+// read (off by default, and to keep off when the flags are checked by a debugger)
+void m68k_set_noflags(int enable);
+
+// Run the straight runs of code found in RAM & ROM as blocks of prefetched
+// opcodes & handlers, instead of fetching & decoding each instruction (off by
+// default, and to keep off when the debugger has to stop on any instruction)
+void m68k_set_blocks(int enable);
+void m68k_set_idle_skip(int enable);
+
+// Give the instructions run, the exceptions & the idle loops skipped to the
+// execution trace hooks below (off by default)
+void m68k_set_trace(int enable);
+
+// Instructions run & idle cycles of the current CPU context, cleared once read
+void m68k_get_counters(uint64_t * instructions, uint64_t * idleCycles);
+
+// The analysis of the 68K code is kept by lines of 256 bytes, each one having a
+// generation count (odd once code has been analysed there). Every write in RAM
+// or ROM, by any bus master, has to use M68K_CODE_WRITE() to drop it.
+#define M68K_CODE_LINE_SHIFT	8
+extern THREAD_LOCAL unsigned int * m68kCodeLines;		// Lines of the current CPU context
+#define M68K_CODE_WRITE(address)	{ unsigned int * codeLine = &m68kCodeLines[((address) & 0xFFFFFF) >> M68K_CODE_LINE_SHIFT]; if (*codeLine & 1) (*codeLine)++; }
+
 void m68k_set_cpu_type(unsigned int);
 void m68k_pulse_reset(void);
 int m68k_execute(int num_cycles);
@@ -86,8 +140,23 @@ void m68k_write_memory_8(unsigned int address, unsigned int value);
 void m68k_write_memory_16(unsigned int address, unsigned int value);
 void m68k_write_memory_32(unsigned int address, unsigned int value);
 
+// Read code without any side effect, for its analysis; must return a value
+// above $FFFF if the address is not in RAM or ROM
+unsigned int m68k_read_code_16(unsigned int address);
+
+// Tell if a read has no side effect, and returns a value only changed by
+// another processor or by an event (used by the idle loops skip)
+int m68k_is_idle_read(unsigned int address);
+
 int irq_ack_handler(int);
 
+// Execution trace, called once enabled by m68k_set_trace(): an instruction about
+// to be run, with the registers (D0-D7 & A0-A7) & SR as they are before it, an
+// exception or an interrupt taken from pc, & the cycles of an idle loop skipped
+void M68KTraceInstruction(uint32_t pc, uint32_t opcode, const uint32_t * registers, uint32_t sr);
+void M68KTraceException(uint32_t vector, uint32_t pc);
+void M68KTraceIdle(uint32_t pc, uint32_t cycles);
+
 // Convenience functions
 
 // Uncomment this to have the emulated CPU call a hook function after every instruction
@@ -0,0 +1,40 @@
+//
+// noflags.h: Build the opcode handlers without updating the condition codes
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// Included by the generated files when NOFLAGS is defined (see cpuemu_nf.c &
+// cpustbl_nf.c). The handlers become op_xxxx_nf, and are only run for
+// instructions whose flags are overwritten before being read.
+//
+
+#ifndef __NOFLAGS_H__
+#define __NOFLAGS_H__
+
+#undef CPUFUNC
+#define CPUFUNC(x) x##_nf
+
+#undef SET_CFLG
+#undef SET_NFLG
+#undef SET_VFLG
+#undef SET_ZFLG
+#undef SET_XFLG
+#define SET_CFLG(x) ((void)0)
+#define SET_NFLG(x) ((void)0)
+#define SET_VFLG(x) ((void)0)
+#define SET_ZFLG(x) ((void)0)
+#define SET_XFLG(x) ((void)0)
+
+#undef CLEAR_CZNV
+#define CLEAR_CZNV do { } while (0)
+
+#undef COPY_CARRY
+#define COPY_CARRY ((void)0)
+
+#endif	// __NOFLAGS_H__
@@ -7,6 +7,13 @@
 #include "noflags.h"
 #endif
 
+#ifdef NOFLAGS
+extern const int areg_byteinc[];
+extern const int imm8_table[];
+extern const int movem_index1[256];
+extern const int movem_index2[256];
+extern const int movem_next[256];
+#else
 const int areg_byteinc[] = { 1, 1, 1, 1, 1, 1, 1, 2 };
 const int imm8_table[]   = { 8, 1, 2, 3, 4, 5, 6, 7 };
 
@@ -66,6 +73,7 @@ const int movem_next[256] = {
 0xC0, 0xE0, 0xE0, 0xE2, 0xE0, 0xE4, 0xE4, 0xE6, 0xE0, 0xE8, 0xE8, 0xEA, 0xE8, 0xEC, 0xEC, 0xEE, 
 0xE0, 0xF0, 0xF0, 0xF2, 0xF0, 0xF4, 0xF4, 0xF6, 0xF0, 0xF8, 0xF8, 0xFA, 0xF8, 0xFC, 0xFC, 0xFE, 
 };
+#endif
 
 
 #if !defined(PART_1) && !defined(PART_2) && !defined(PART_3) && !defined(PART_4) && !defined(PART_5) && !defined(PART_6) && !defined(PART_7) && !defined(PART_8)
@@ -0,0 +1,2 @@
+#define NOFLAGS
+#include "cpustbl.c"
@@ -0,0 +1,106 @@
+//
+// Emulated machine context
+//
+// by Jean-Paul Mari
+//
+// The state of a Jaguar (memory space, chips, CPUs, devices) is gathered in a
+// machine context, and each host thread works on the machine it has made
+// current. The subsystems access their state of the current machine through
+// macros named like the former global variables.
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Machines lock
+//
+
+#include "machine.h"
+
+#include <mutex>
+#include <stdlib.h>
+#include "log.h"
+
+
+THREAD_LOCAL JaguarMachine * jaguarMachine = NULL;
+static std::mutex jaguarMachinesMutex;			// Held while a machine is initialised or done
+
+
+//
+// Create a machine, and make it current for the calling thread
+// Machines can be created from several threads at once: the first JaguarInit()
+// builds the shared lookup tables, under the machines lock
+//
+JaguarMachine * JaguarMachineCreate(void)
+{
+	JaguarMachine * machine = (JaguarMachine *)calloc(1, sizeof(JaguarMachine));
+
+	if (machine)
+	{
+		if ((machine->m68k = m68k_create_context()))
+		{
+			JaguarMachineSetCurrent(machine);
+
+			if ((jagMemSpace = (uint8_t *)calloc(1, JAGMEMSPACE_SIZE)))
+			{
+				return machine;
+			}
+		}
+
+		JaguarMachineDestroy(machine);
+	}
+
+	WriteLog("Machine: Unable to allocate a new machine\n");
+	return NULL;
+}
+
+
+//
+// Free a machine (it must not run anymore)
+//
+void JaguarMachineDestroy(JaguarMachine * machine)
+{
+	if (machine)
+	{
+		JaguarMachine * current = jaguarMachine;
+		jaguarMachine = machine;
+		free(jagMemSpace);
+		DasmCacheFlush();
+		jaguarMachine = current;
+
+		if (jaguarMachine == machine)
+		{
+			JaguarMachineSetCurrent(NULL);
+		}
+
+		m68k_destroy_context(machine->m68k);
+		free(machine);
+	}
+}
+
+
+//
+// Set the machine run by the calling thread
+//
+void JaguarMachineSetCurrent(JaguarMachine * machine)
+{
+	jaguarMachine = machine;
+	m68k_set_current_context(machine ? machine->m68k : NULL);
+}
+
+
+//
+// Lock held by JaguarInit() & JaguarDone(), so the machines build the shared lookup
+// tables, & start or stop the shared host threads, one at a time
+//
+void JaguarMachinesLock(void)
+{
+	jaguarMachinesMutex.lock();
+}
+
+
+void JaguarMachinesUnlock(void)
+{
+	jaguarMachinesMutex.unlock();
+}
@@ -0,0 +1,76 @@
+//
+// machine.h: Emulated machine context
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Performance counters
+// JPM   Oct./2026  Disassembly cache
+// JPM   Oct./2026  Execution trace
+// JPM   Oct./2026  Save data files copies
+// JPM   Oct./2026  Machines lock, for the shared tables & host threads
+//
+
+#ifndef __MACHINE_H__
+#define __MACHINE_H__
+
+#include "blitter.h"
+#include "cdrom.h"
+#include "dasmcache.h"
+#include "dsp.h"
+#include "eeprom.h"
+#include "event.h"
+#include "gpu.h"
+#include "jaguar.h"
+#include "jerry.h"
+#include "joystick.h"
+#include "memory.h"
+#include "memtrack.h"
+#include "op.h"
+#include "perfcounters.h"
+#include "savedata.h"
+#include "tom.h"
+#include "trace.h"
+#include "m68000/m68kinterface.h"
+
+// Everything which makes up one Jaguar. A host thread runs the machine it has
+// made current, so several machines can run side by side on their own threads.
+// Lookup tables, settings & debugger data are shared by all the machines; the
+// lookup tables are built, and the shared host threads started & stopped, by
+// JaguarInit() & JaguarDone() under the machines lock.
+struct JaguarMachine
+{
+	MemoryState memory;
+	JaguarState jaguar;
+	TOMState tom;
+	OPState op;
+	BlitterState blitter;
+	GPUState gpu;
+	JERRYState jerry;
+	DSPState dsp;
+	EventState event;
+	EEPROMState eeprom;
+	MemoryTrackState memtrack;
+	SaveDataState saveData;
+	CDROMState cdrom;
+	JoystickState joystick;
+	PerfState perf;
+	DasmCacheState dasmCache;
+	TraceState trace;
+	m68k_context * m68k;
+};
+
+// Machine run by the host thread
+extern THREAD_LOCAL JaguarMachine * jaguarMachine;
+
+extern JaguarMachine * JaguarMachineCreate(void);
+extern void JaguarMachineDestroy(JaguarMachine * machine);
+extern void JaguarMachineSetCurrent(JaguarMachine * machine);
+extern void JaguarMachinesLock(void);
+extern void JaguarMachinesUnlock(void);
+
+#endif	// __MACHINE_H__
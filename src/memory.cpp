@@ -28,14 +28,10 @@ N.B.: Jaguar RAM is only 2 megs. ROM is 6 megs max, IO is 128K
 */
 
 #include "memory.h"
+#include "mmu.h"
 
-uint8_t jagMemSpace[0xF20000];					// The entire memory space of the Jaguar...!
-
-uint8_t * jaguarMainRAM = &jagMemSpace[0x000000];
-uint8_t * jaguarMainROM = &jagMemSpace[0x800000];
-uint8_t * cdRAM         = &jagMemSpace[0xDFFF00];
-uint8_t * gpuRAM        = &jagMemSpace[0xF03000];
-uint8_t * dspRAM        = &jagMemSpace[0xF1B000];
+// The entire memory space of the Jaguar...! It belongs to the machine context
+// now (see machine.h), and jaguarMainRAM & co. are macros pointing into it.
 
 #if 0
 union Word
@@ -115,6 +111,9 @@ unsigned long ByteSwap1 (unsigned long nLongNumber)
 
 //Not sure if this is a good approach yet...
 //should be if we use proper aliasing, and htonl and friends...
+// N.B.: These references are only used by the new MMU code, and are bound to the
+//       memory space of the machine current at startup, so they are not machine aware
+#ifdef USE_NEW_MMU
 #if 1
 uint32_t & butch     = *((uint32_t *)&jagMemSpace[0xDFFF00]);	// base of Butch == interrupt control register, R/W
 uint32_t & dscntrl   = *((uint32_t *)&jagMemSpace[0xDFFF04]);	// DSA control register, R/W
@@ -258,13 +257,8 @@ uint32_t & d_mod     = *((uint32_t *)&jagMemSpace[0xF1A118]);
 uint32_t & d_divctrl = *((uint32_t *)&jagMemSpace[0xF1A11C]);
 uint32_t d_remain;								// Dual register with $F0211C
 uint32_t & d_machi   = *((uint32_t *)&jagMemSpace[0xF1A120]);
-uint16_t & ltxd      = *((uint16_t *)&jagMemSpace[0xF1A148]);
-uint16_t lrxd;									// Dual register with $F1A148
-uint16_t & rtxd      = *((uint16_t *)&jagMemSpace[0xF1A14C]);
-uint16_t rrxd;									// Dual register with $F1A14C
-uint8_t  & sclk      = *((uint8_t *) &jagMemSpace[0xF1A150]);
 uint8_t sstat;									// Dual register with $F1A150
-uint32_t & smode     = *((uint32_t *)&jagMemSpace[0xF1A154]);
+#endif
 
 // Memory debugging identifiers
 
@@ -8,20 +8,41 @@
 // Who  When        What
 // ---  ----------  -------------------------------------------------------------
 // JPM  06/16/2016  Added a Big to Little endian
+// JPM   Oct./2026  Memory space moved in the machine context
+// JPM   Oct./2026  Big endian accesses done by a single load/store & a byte swap
 //
 
 #ifndef __MEMORY_H__
 #define __MEMORY_H__
 
 #include <stdint.h>
+#include <string.h>
 
-extern uint8_t jagMemSpace[];
-
-extern uint8_t * jaguarMainRAM;
-extern uint8_t * jaguarMainROM;
-extern uint8_t * gpuRAM;
-extern uint8_t * dspRAM;
+// Size of the hosted Jaguar memory space
+#define JAGMEMSPACE_SIZE	0xF20000
 
+// Memory state of a machine
+struct MemoryState
+{
+	uint8_t * jagMemSpace;						// The entire memory space of the Jaguar...!
+	uint16_t lrxd;								// Dual register with $F1A148
+	uint16_t rrxd;								// Dual register with $F1A14C
+};
+
+// Access to the memory of the current machine (see machine.h)
+#define jagMemSpace		(jaguarMachine->memory.jagMemSpace)
+#define jaguarMainRAM	(&jagMemSpace[0x000000])
+#define jaguarMainROM	(&jagMemSpace[0x800000])
+#define gpuRAM			(&jagMemSpace[0xF03000])
+#define dspRAM			(&jagMemSpace[0xF1B000])
+#define ltxd			(*((uint16_t *)&jagMemSpace[0xF1A148]))
+#define lrxd			(jaguarMachine->memory.lrxd)
+#define rtxd			(*((uint16_t *)&jagMemSpace[0xF1A14C]))
+#define rrxd			(jaguarMachine->memory.rrxd)
+#define sclk			(*((uint8_t *)&jagMemSpace[0xF1A150]))
+#define smode			(*((uint32_t *)&jagMemSpace[0xF1A154]))
+
+#ifdef USE_NEW_MMU
 #if 1
 extern uint32_t & butch, & dscntrl;
 extern uint16_t & ds_data;
@@ -56,18 +77,8 @@ extern uint32_t & d_flags, & d_mtxc, & d_mtxa, & d_end, & d_pc, & d_ctrl,
 	& d_mod, & d_divctrl;
 extern uint32_t d_remain;
 extern uint32_t & d_machi;
-extern uint16_t & ltxd, lrxd, & rtxd, rrxd;
-extern uint8_t & sclk, sstat;
-extern uint32_t & smode;
-/*
-uint16_t & ltxd      = *((uint16_t *)&jagMemSpace[0xF1A148]);
-uint16_t lrxd;									// Dual register with $F1A148
-uint16_t & rtxd      = *((uint16_t *)&jagMemSpace[0xF1A14C]);
-uint16_t rrxd;									// Dual register with $F1A14C
-uint8_t  & sclk      = *((uint8_t *) &jagMemSpace[0xF1A150]);
-uint8_t sstat;									// Dual register with $F1A150
-uint32_t & smode     = *((uint32_t *)&jagMemSpace[0xF1A154]);
-*/
+extern uint8_t sstat;
+#endif
 
 // Read/write tracing enumeration
 
@@ -79,22 +90,79 @@ extern const char * whoName[10];
 //enum { BIOS_NORMAL=0x01, BIOS_CD=0x02, BIOS_STUB1=0x04, BIOS_STUB2=0x08, BIOS_DEV_CD=0x10 };
 //extern int biosAvailable;
 
+// Byte swapping, compiled down to a single instruction
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#define BSWAP16(x)		_byteswap_ushort(x)
+#define BSWAP32(x)		_byteswap_ulong(x)
+#define BSWAP64(x)		_byteswap_uint64(x)
+#else
+#define BSWAP16(x)		__builtin_bswap16(x)
+#define BSWAP32(x)		__builtin_bswap32(x)
+#define BSWAP64(x)		__builtin_bswap64(x)
+#endif
+
+// Conversion between the host endian & the big endian (jaguar native)
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define HOSTTOBIG16(x)	(x)
+#define HOSTTOBIG32(x)	(x)
+#define HOSTTOBIG64(x)	(x)
+#else
+#define HOSTTOBIG16(x)	BSWAP16(x)
+#define HOSTTOBIG32(x)	BSWAP32(x)
+#define HOSTTOBIG64(x)	BSWAP64(x)
+#endif
+
+// Big endian accesses to a memory buffer: a single (possibly unaligned) load or
+// store, instead of assembling the value byte by byte
+static inline uint16_t GetBig16(const uint8_t * p)
+{
+	uint16_t v;
+	memcpy(&v, p, sizeof(v));
+	return HOSTTOBIG16(v);
+}
+
+static inline uint32_t GetBig32(const uint8_t * p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return HOSTTOBIG32(v);
+}
+
+static inline uint64_t GetBig64(const uint8_t * p)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return HOSTTOBIG64(v);
+}
+
+static inline void SetBig16(uint8_t * p, uint16_t v)
+{
+	v = HOSTTOBIG16(v);
+	memcpy(p, &v, sizeof(v));
+}
+
+static inline void SetBig32(uint8_t * p, uint32_t v)
+{
+	v = HOSTTOBIG32(v);
+	memcpy(p, &v, sizeof(v));
+}
+
+static inline void SetBig64(uint8_t * p, uint64_t v)
+{
+	v = HOSTTOBIG64(v);
+	memcpy(p, &v, sizeof(v));
+}
+
 // Some handy macros to help converting native endian to big endian (jaguar native)
 // & vice versa
 
-#define SET64(r, a, v) 	r[(a)] = ((v) & 0xFF00000000000000) >> 56, r[(a)+1] = ((v) & 0x00FF000000000000) >> 48, \
-						r[(a)+2] = ((v) & 0x0000FF0000000000) >> 40, r[(a)+3] = ((v) & 0x000000FF00000000) >> 32, \
-						r[(a)+4] = ((v) & 0xFF000000) >> 24, r[(a)+5] = ((v) & 0x00FF0000) >> 16, \
-						r[(a)+6] = ((v) & 0x0000FF00) >> 8, r[(a)+7] = (v) & 0x000000FF
-#define GET64(r, a)		(((uint64_t)r[(a)] << 56) | ((uint64_t)r[(a)+1] << 48) | \
-						((uint64_t)r[(a)+2] << 40) | ((uint64_t)r[(a)+3] << 32) | \
-						((uint64_t)r[(a)+4] << 24) | ((uint64_t)r[(a)+5] << 16) | \
-						((uint64_t)r[(a)+6] << 8) | (uint64_t)r[(a)+7])
-#define SET32(r, a, v)	r[(a)] = ((v) & 0xFF000000) >> 24, r[(a)+1] = ((v) & 0x00FF0000) >> 16, \
-						r[(a)+2] = ((v) & 0x0000FF00) >> 8, r[(a)+3] = (v) & 0x000000FF
-#define GET32(r, a)		((r[(a)] << 24) | (r[(a)+1] << 16) | (r[(a)+2] << 8) | r[(a)+3])
-#define SET16(r, a, v)	r[(a)] = ((v) & 0xFF00) >> 8, r[(a)+1] = (v) & 0xFF
-#define GET16(r, a)		((r[(a)] << 8) | r[(a)+1])
+#define SET64(r, a, v)	SetBig64(&(r)[(a)], (v))
+#define GET64(r, a)		GetBig64(&(r)[(a)])
+#define SET32(r, a, v)	SetBig32(&(r)[(a)], (v))
+#define GET32(r, a)		GetBig32(&(r)[(a)])
+#define SET16(r, a, v)	SetBig16(&(r)[(a)], (v))
+#define GET16(r, a)		GetBig16(&(r)[(a)])
 
 #define	BigToLittleEndian16(a)	(((a & 0xFF) << 8) | (a >> 8))
 #define	BigToLittleEndian32(a)	(((a & 0xFF) << 24) | ((a & 0xFF00) << 8) | ((a & 0xFF0000) >> 8) | ((a & 0xFF000000) >> 24))
@@ -21,6 +21,8 @@
 // ---  ----------  -----------------------------------------------------------
 // JLH  06/12/2016  Created this file ;-)
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  Memory Track state moved in the machine context
+// JPM   Oct./2026  NVRAM file written by the save data persistence, as soon as the NVRAM is written
 //
 
 #include "memtrack.h"
@@ -28,6 +30,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include "log.h"		// JPM: changed <log.h> to "log.h"
+#include "machine.h"
+#include "savedata.h"
 #include "settings.h"	// JPM: changed <settings.h> to "settings.h"
 
 
@@ -37,11 +41,12 @@
 enum { MT_NONE, MT_PROD_ID, MT_RESET, MT_WRITE_ENABLE };
 enum { MT_IDLE, MT_PHASE1, MT_PHASE2 };
 
-uint8_t mtMem[0x20000];
-uint8_t mtCommand = MT_NONE;
-uint8_t mtState = MT_IDLE;
-bool haveMT = false;
-char mtFilename[MAX_PATH];
+// Memory Track state lives in the machine context (see memtrack.h)
+#define mtMem		(jaguarMachine->memtrack.mtMem)
+#define mtCommand	(jaguarMachine->memtrack.mtCommand)
+#define mtState		(jaguarMachine->memtrack.mtState)
+#define haveMT		(jaguarMachine->memtrack.haveMT)
+#define mtFilename	(jaguarMachine->memtrack.mtFilename)
 
 // Private function prototypes
 void MTWriteFile(void);
@@ -75,24 +80,20 @@ void MTReset(void)
 void MTDone(void)
 {
 	MTWriteFile();
+	SaveDataFlush();
 	WriteLog("MT: Done.\n");
 }
 
 
+//
+// File is written later, by the save data persistence, once the writes are over
+//
 void MTWriteFile(void)
 {
 	if (!haveMT)
 		return;
 
-	FILE * fp = fopen(mtFilename, "wb");
-
-	if (fp)
-	{
-		fwrite(mtMem, 1, 0x20000, fp);
-		fclose(fp);
-	}
-	else
-		WriteLog("MT: Could not create file \"%s\"!", mtFilename);
+	SaveDataUpdate(mtFilename, mtMem, 0x20000, 0, 0x20000);
 }
 
 
@@ -160,6 +161,10 @@ WriteLog("MT: Writing word @ $%06X: $%04X (Writing is %sabled)\n", addr, data, (
 	if (mtCommand == MT_WRITE_ENABLE)
 	{
 		mtMem[(addr & 0x7FFFC) >> 2] = (uint8_t)(data & 0xFF);
+
+		if (haveMT)
+			SaveDataUpdate(mtFilename, mtMem, 0x20000, (addr & 0x7FFFC) >> 2, 1);
+
 		return;
 	}
 
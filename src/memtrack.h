@@ -2,7 +2,21 @@
 // memtrack.h: Header file
 //
 
+#ifndef __MEMTRACK_H__
+#define __MEMTRACK_H__
+
 #include <stdint.h>
+#include "settings.h"
+
+// Memory Track state of a machine
+struct MemoryTrackState
+{
+	uint8_t mtMem[0x20000];
+	uint8_t mtCommand;
+	uint8_t mtState;
+	bool haveMT;
+	char mtFilename[MAX_PATH];
+};
 
 void MTInit(void);
 void MTReset(void);
@@ -13,3 +27,4 @@ uint32_t MTReadLong(uint32_t addr);
 void MTWriteWord(uint32_t addr, uint16_t data);
 void MTWriteLong(uint32_t addr, uint32_t data);
 
+#endif	// __MEMTRACK_H__
@@ -8,23 +8,53 @@
 // Who  When        What
 // ---  ----------  -----------------------------------------------------------
 // JPM  09/04/2018  Created this file
+// JPM   Oct./2026  BIOS & firmware images kept compressed, and decompressed on demand in read-only pages
+// JPM   Oct./2026  Images decompressed straight in the Jaguar memory
+//
+// The images are compiled in zlib compressed (see src/tools/bin2z.cpp); an image
+// is decompressed straight in the Jaguar memory each time it is copied there, so
+// no other copy of it is kept.
 //
 
 
 #include "string.h"
+#include <zlib.h>
 #include "settings.h"
 #include "jagbios.h"
 #include "jagbios2.h"
 #include "jagcdbios.h"
+#include "jagdevcdbios.h"
 #include "jagstub1bios.h"
 #include "jagstub2bios.h"
-#include "memory.h"
+#include "log.h"
+#include "machine.h"
+#include "modelsBIOS.h"
+
+
+typedef struct InfosImage
+{
+	const uint8_t *ptrCompressed;
+	const uint32_t *sizeCompressed;
+	size_t sizeImage;
+	const char *nameImage;
+}
+S_InfosImage;
+
+
+S_InfosImage TabInfosImage[BI_MAX]	=
+{
+	{ jaguarBootROMCompressed, &jaguarBootROMCompressedSize, 0x20000, "K series BIOS" },
+	{ jaguarBootROM2Compressed, &jaguarBootROM2CompressedSize, 0x20000, "M series BIOS" },
+	{ jaguarDevBootROM1Compressed, &jaguarDevBootROM1CompressedSize, 0x20000, "Stubulator 1 BIOS" },
+	{ jaguarDevBootROM2Compressed, &jaguarDevBootROM2CompressedSize, 0x20000, "Stubulator 2 BIOS" },
+	{ jaguarCDBootROMCompressed, &jaguarCDBootROMCompressedSize, 0x40000, "CD BIOS" },
+	{ jaguarDevCDBootROMCompressed, &jaguarDevCDBootROMCompressedSize, 0x40000, "Developer CD BIOS" }
+};
 
 
 typedef struct InfosBIOS
 {
-	void *ptrBIOS;
-	size_t sizeBIOS;
+	int imageBIOS;
 	size_t intBIOS;
 }
 S_InfosBIOS;
@@ -32,14 +62,42 @@ S_InfosBIOS;
 
 S_InfosBIOS TabInfosBIOS[]	=
 {
-	{ NULL, 0, BT_NULL },
-	{ jaguarBootROM, 0x20000, BT_K_SERIES },
-	{ jaguarBootROM2, 0x20000, BT_M_SERIES },
-	{ jaguarDevBootROM1, 0x20000, BT_STUBULATOR_1 },
-	{ jaguarDevBootROM2, 0x20000, BT_STUBULATOR_2 }
+	{ -1, BT_NULL },
+	{ BI_K_SERIES, BT_K_SERIES },
+	{ BI_M_SERIES, BT_M_SERIES },
+	{ BI_STUBULATOR_1, BT_STUBULATOR_1 },
+	{ BI_STUBULATOR_2, BT_STUBULATOR_2 }
 };
 
 
+// Get an image size
+size_t GetBIOSImageSize(int image)
+{
+	return (((image >= 0) && (image < BI_MAX)) ? TabInfosImage[image].sizeImage : 0);
+}
+
+
+// Copy an image in the Jaguar memory, decompressed straight in it
+bool CopyBIOSImage(int image, uint8_t *dest)
+{
+	if ((image < 0) || (image >= BI_MAX))
+	{
+		return false;
+	}
+
+	S_InfosImage *infos = &TabInfosImage[image];
+	uLongf size = (uLongf)infos->sizeImage;
+
+	if ((uncompress(dest, &size, infos->ptrCompressed, *infos->sizeCompressed) != Z_OK) || (size != infos->sizeImage))
+	{
+		WriteLog("BIOS: Unable to decompress the %s image\n", infos->nameImage);
+		return false;
+	}
+
+	return true;
+}
+
+
 // Select a BIOS
 // A valid default BIOS will be selected in case of no valid BIOS has been requested
 bool SelectBIOS(int indexbios)
@@ -82,8 +140,7 @@ bool SelectBIOS(int indexbios)
 	// Put BIOS in memory or return if no BIOS exist (but it should never happen)
 	if (IndexBIOS)
 	{
-		memcpy(jagMemSpace + 0xE00000, TabInfosBIOS[IndexBIOS].ptrBIOS, TabInfosBIOS[IndexBIOS].sizeBIOS);
-		return true;
+		return CopyBIOSImage(TabInfosBIOS[IndexBIOS].imageBIOS, jagMemSpace + 0xE00000);
 	}
 	else
 	{
@@ -1,9 +1,17 @@
 #ifndef __MODELSBIOS_H__
 #define __MODELSBIOS_H__
 
+#include <stddef.h>
+#include <stdint.h>
+
+// BIOS & firmware images
+enum { BI_K_SERIES, BI_M_SERIES, BI_STUBULATOR_1, BI_STUBULATOR_2, BI_CD, BI_DEV_CD, BI_MAX };
+
 
 extern bool SetBIOS(void);
 extern bool SelectBIOS(int indexbios);
+extern size_t GetBIOSImageSize(int image);
+extern bool CopyBIOSImage(int image, uint8_t *dest);
 
 
 #endif	// __MODELSBIOS_H__
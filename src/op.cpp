@@ -13,17 +13,28 @@
 // ---  ----------  -----------------------------------------------------------
 // JLH  01/16/2010  Created this log ;-)
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  OP state moved in the machine context
+// JPM   Oct./2026  Phrases in RAM & ROM loaded at once
+// JPM   Oct./2026  Objects performance counters
+// JPM   Oct./2026  Line buffer span written by the bitmap objects
+// JPM   Oct./2026  Optional OP host thread rendering the next line ahead, taken if no write has changed what it has read
+// JPM   Oct./2026  Only the TOM parts read by the OP given to the line rendered ahead
 //
 
 #include "op.h"
 
+#ifndef NO_SDL
+#include <SDL.h>								// For the OP host thread
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "gpu.h"
 #include "jaguar.h"
 #include "log.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
 #include "memory.h"
+#include "settings.h"
 #include "tom.h"
 
 //#define OP_DEBUG
@@ -51,6 +62,48 @@
 #define OPFLAG_REFLECT		1					// Horizontal mirror bit
 #endif
 
+#define OP_SPEC_STORES		256					// Phrases a line rendered ahead can store
+#define OP_SPEC_REGISTERS	0x60				// TOM registers read by the OP
+#define OP_SPEC_CLUT		0x400				// CLUT & line buffers, up to OP_SPEC_LBUF_END
+#define OP_SPEC_LBUF		0x800
+#define OP_SPEC_LBUF_END	0x2000
+
+enum { OP_SPEC_IDLE = 0, OP_SPEC_START, OP_SPEC_RUNNING, OP_SPEC_DONE };
+
+// Next line rendered ahead on the OP host thread, by a machine sharing the
+// memory space of the running one; the line keeps track of the RAM & ROM pages
+// it reads, while its phrases stores & its STOP object are done once it is taken
+struct OPSpeculation
+{
+	JaguarMachine * machine;
+	SDL_Thread * thread;
+	SDL_mutex * mutex;
+	SDL_cond * cond;
+	bool quit;
+	int state;
+	int halfline;
+	bool valid;									// Nothing met which can't be done ahead
+	bool stopped;
+	uint64_t stopObject;
+	uint32_t lbufStart, lbufEnd;				// Line buffer part to take
+	bool lbufSame;								// Line buffers the same as the running machine ones
+	uint32_t nbStores;
+	struct
+	{
+		uint32_t offset, location;
+		uint64_t phrase;
+	} stores[OP_SPEC_STORES];
+	uint32_t nbReadPages;
+	uint16_t readList[OP_PAGES];
+	uint8_t readPages[OP_PAGES];
+	uint8_t storedPages[OP_PAGES];
+	uint8_t dirtyPages[OP_PAGES];
+	uint32_t lineCount, againCount;
+};
+
+#define opSpec			(jaguarMachine->op.spec)
+#define opSpeculated	(jaguarMachine->op.rendering)
+
 // Private function prototypes
 
 void OPProcessFixedBitmap(uint64_t p0, uint64_t p1, bool render);
@@ -61,6 +114,7 @@ void DumpScaledObject(uint64_t p0, uint64_t p1, uint64_t p2);
 void DumpFixedObject(uint64_t p0, uint64_t p1);
 void DumpBitmapCore(uint64_t p0, uint64_t p1);
 uint64_t OPLoadPhrase(uint32_t offset);
+static void OPThreadDone(void);
 
 // Local global variables
 
@@ -71,22 +125,21 @@ static uint8_t op_blend_cr[0x10000];
 // some of the regular TOM RAM...
 //#warning objectp_ram is separated from TOM RAM--need to fix that!
 //static uint8_t objectp_ram[0x40];			// This is based at $F00000
-uint8_t objectp_running = 0;
 //bool objectp_stop_reading_list;
 
 static uint8_t op_bitmap_bit_depth[8] = { 1, 2, 4, 8, 16, 24, 32, 0 };
 //static uint32_t op_bitmap_bit_size[8] =
 //	{ (uint32_t)(0.125*65536), (uint32_t)(0.25*65536), (uint32_t)(0.5*65536), (uint32_t)(1*65536),
 //	  (uint32_t)(2*65536),     (uint32_t)(1*65536),    (uint32_t)(1*65536),   (uint32_t)(1*65536) };
-static uint32_t op_pointer;
+#define op_pointer	(jaguarMachine->op.op_pointer)	// In the machine context (see op.h)
 
 int32_t phraseWidthToPixels[8] = { 64, 32, 16, 8, 4, 2, 0, 0 };
 
 
 //
-// Object Processor initialization
+// Blend tables, shared by all the machines
 //
-void OPInit(void)
+static void OPFillBlendTables(void)
 {
 	// Here we calculate the saturating blend of a signed 4-bit value and an
 	// existing Cyan/Red value as well as a signed 8-bit value and an existing intensity...
@@ -125,6 +178,21 @@ void OPInit(void)
 
 		op_blend_cr[i] = (c2 << 4) | c1;
 	}
+}
+
+
+//
+// Object Processor initialization
+//
+void OPInit(void)
+{
+	static bool blendTablesFilled = false;
+
+	if (!blendTablesFilled)
+	{
+		OPFillBlendTables();
+		blendTablesFilled = true;
+	}
 
 	OPReset();
 }
@@ -137,6 +205,7 @@ void OPReset(void)
 {
 //	memset(objectp_ram, 0x00, 0x40);
 	objectp_running = 0;
+	OPSpeculationCancel();
 }
 
 
@@ -152,6 +221,8 @@ static uint32_t numberOfObjects;
 
 void OPDone(void)
 {
+	OPThreadDone();
+
 //#warning "!!! Fix OL dump so that it follows links !!!"
 //	const char * opType[8] =
 //	{ "(BITMAP)", "(SCALED BITMAP)", "(GPU INT)", "(BRANCH)", "(STOP)", "???", "???", "???" };
@@ -380,9 +451,136 @@ void OPSetCurrentObject(uint64_t object)
 }
 
 
+//
+// STOP object: the list is over, and the 68K may be interrupted
+//
+static void OPStopObject(uint64_t p0)
+{
+	OPSetCurrentObject(p0);
+
+	if ((p0 & 0x08) && TOMIRQEnabled(IRQ_OPFLAG))
+	{
+		TOMSetPendingObjectInt();
+		m68k_set_irq(2);		// Cause a 68K IPL 2 to occur...
+	}
+}
+
+
+//
+// RAM or ROM location, RAM being mirrored in the first 8MB
+//
+static inline uint32_t OPLocation(uint32_t offset)
+{
+	offset &= 0xFFFFFF;
+	return (offset < 0x800000 ? offset & (vjs.DRAM_size - 1) : offset);
+}
+
+
+//
+// A line rendered ahead may only read RAM & ROM, and keeps track of the pages
+// it reads; reading a page it has stored a phrase in is allowed for its phrases
+//
+static bool OPSpeculationReadable(uint32_t offset, bool stored)
+{
+	OPSpeculation * spec = opSpeculated;
+	uint32_t page = OPLocation(offset) >> OP_PAGE_SHIFT;
+
+	if (((offset & 0xFFFFFF) > 0xDFFEF8) || (!stored && spec->storedPages[page]))
+	{
+		spec->valid = false;
+		return false;
+	}
+
+	if (!spec->readPages[page])
+	{
+		spec->readPages[page] = 1;
+		spec->readList[spec->nbReadPages++] = page;
+	}
+
+	return true;
+}
+
+
+//
+// Phrase read by a line rendered ahead, which gets back the phrases it has stored
+// Returns false if the phrase has to be read from the memory
+//
+static bool OPSpeculationLoad(uint32_t offset, uint64_t * p)
+{
+	OPSpeculation * spec = opSpeculated;
+	uint32_t location = OPLocation(offset);
+
+	*p = 0;
+
+	if (!OPSpeculationReadable(offset, true))
+		return true;
+
+	if (spec->storedPages[location >> OP_PAGE_SHIFT])
+	{
+		for(uint32_t i=spec->nbStores; i>0; i--)
+		{
+			if (spec->stores[i - 1].location == location)
+			{
+				*p = spec->stores[i - 1].phrase;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+//
+// Phrase stored by a line rendered ahead; it is kept to be stored once the line
+// is taken, only in RAM
+//
+static void OPSpeculationStore(uint32_t offset, uint64_t p)
+{
+	OPSpeculation * spec = opSpeculated;
+	uint32_t location = OPLocation(offset);
+
+	if (((offset & 0xFFFFFF) >= 0x800000) || (spec->nbStores == OP_SPEC_STORES))
+	{
+		spec->valid = false;
+		return;
+	}
+
+	spec->stores[spec->nbStores].offset = offset;
+	spec->stores[spec->nbStores].location = location;
+	spec->stores[spec->nbStores++].phrase = p;
+	spec->storedPages[location >> OP_PAGE_SHIFT] = 1;
+}
+
+
+//
+// Phrase of bitmap data
+//
+static inline uint64_t OPReadData(uint32_t data)
+{
+	if (opSpeculated && (!OPSpeculationReadable(data, false) || !OPSpeculationReadable(data + 4, false)))
+		return 0;
+
+	return ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+}
+
+
 uint64_t OPLoadPhrase(uint32_t offset)
 {
 	offset &= ~0x07;						// 8 byte alignment
+
+	// A line rendered ahead gets back the phrases it has stored
+	uint64_t p;
+
+	if (opSpeculated && OPSpeculationLoad(offset, &p))
+		return p;
+
+	// Object data is mostly in RAM, or in the cartridge ROM
+	if ((offset & 0xFFFFFF) < 0x800000)
+		return GET64(jaguarMainRAM, offset & (vjs.DRAM_size - 1));
+	else if ((offset & 0xFFFFFF) <= 0xDFFEF8)
+		return GET64(jaguarMainROM, (offset & 0xFFFFFF) - 0x800000);
+
 	return ((uint64_t)JaguarReadLong(offset, OP) << 32) | (uint64_t)JaguarReadLong(offset+4, OP);
 }
 
@@ -390,11 +588,325 @@ uint64_t OPLoadPhrase(uint32_t offset)
 void OPStorePhrase(uint32_t offset, uint64_t p)
 {
 	offset &= ~0x07;						// 8 byte alignment
+
+	if (opSpeculated)
+	{
+		OPSpeculationStore(offset, p);
+		return;
+	}
+
 	JaguarWriteLong(offset, p >> 32, OP);
 	JaguarWriteLong(offset + 4, p & 0xFFFFFFFF, OP);
 }
 
 
+//
+// Line buffer span written by a bitmap object, from its start to its end
+// offsets (whichever is the lowest)
+//
+static void OPLineBufferWritten(uint32_t start, uint32_t end)
+{
+	if (end < start)
+	{
+		uint32_t lowest = end;
+		end = start;
+		start = lowest;
+	}
+
+	TOMLineBufferWritten(start, end - start + 4);
+	OPSpeculationWritten(start, end + 4);
+}
+
+
+//
+// Line buffer span written by a line rendered ahead (by its objects, or its clear
+// with BG), which gives the part to take; past the line buffers, where the line
+// has not been given what the running machine has, the line is rendered again
+//
+void OPSpeculationWritten(uint32_t start, uint32_t end)
+{
+	OPSpeculation * spec = opSpeculated;
+
+	if (!spec)
+		return;
+
+	if (end > OP_SPEC_LBUF_END)
+	{
+		spec->valid = false;
+		return;
+	}
+
+	if (start < spec->lbufStart)
+		spec->lbufStart = start;
+
+	if (end > spec->lbufEnd)
+		spec->lbufEnd = end;
+}
+
+
+#ifndef NO_SDL
+static int OPThreadFunc(void *);
+
+//
+// Create the OP host thread, and the machine it renders the lines with
+//
+static bool OPThreadInit(void)
+{
+	OPSpeculation * spec = (OPSpeculation *)calloc(1, sizeof(OPSpeculation));
+
+	if (spec)
+	{
+		spec->machine = (JaguarMachine *)calloc(1, sizeof(JaguarMachine));
+		spec->mutex = SDL_CreateMutex();
+		spec->cond = SDL_CreateCond();
+		spec->state = OP_SPEC_IDLE;
+
+		if (spec->machine && spec->mutex && spec->cond && (spec->thread = SDL_CreateThread(OPThreadFunc, spec)))
+		{
+			opSpec = spec;
+			WriteLog("OP: Host thread started\n");
+			return true;
+		}
+
+		if (spec->cond)
+			SDL_DestroyCond(spec->cond);
+
+		if (spec->mutex)
+			SDL_DestroyMutex(spec->mutex);
+
+		free(spec->machine);
+		free(spec);
+	}
+
+	WriteLog("OP: Unable to start the host thread (%s), lines will be rendered when reached\n", SDL_GetError());
+	return false;
+}
+
+
+//
+// Stop & destroy the OP host thread
+//
+static void OPThreadDone(void)
+{
+	OPSpeculation * spec = opSpec;
+
+	if (!spec)
+		return;
+
+	OPSpeculationCancel();
+	SDL_LockMutex(spec->mutex);
+	spec->quit = true;
+	SDL_CondBroadcast(spec->cond);
+	SDL_UnlockMutex(spec->mutex);
+	SDL_WaitThread(spec->thread, NULL);
+	SDL_DestroyCond(spec->cond);
+	SDL_DestroyMutex(spec->mutex);
+	opSpec = NULL;
+
+	WriteLog("OP: Host thread stopped (%u lines rendered ahead, %u rendered again)\n", spec->lineCount, spec->againCount);
+
+	// The machine shares the memory space of the running one
+	free(spec->machine);
+	free(spec);
+}
+
+
+//
+// OP host thread: render the lines requested by OPSpeculationStart()
+//
+static int OPThreadFunc(void * data)
+{
+	OPSpeculation * spec = (OPSpeculation *)data;
+
+	// The OP thread renders on its own machine, made from the running one
+	JaguarMachineSetCurrent(spec->machine);
+
+	SDL_LockMutex(spec->mutex);
+
+	while (true)
+	{
+		while ((spec->state != OP_SPEC_START) && !spec->quit)
+			SDL_CondWait(spec->cond, spec->mutex);
+
+		if (spec->quit)
+			break;
+
+		spec->state = OP_SPEC_RUNNING;
+		SDL_UnlockMutex(spec->mutex);
+
+		TOMLineBufferRender(spec->halfline);
+
+		SDL_LockMutex(spec->mutex);
+		spec->state = OP_SPEC_DONE;
+		SDL_CondBroadcast(spec->cond);
+	}
+
+	SDL_UnlockMutex(spec->mutex);
+	return 0;
+}
+
+
+//
+// Let the OP thread finish the line, and stop marking the writes
+// Returns false if there was no line rendered ahead
+//
+static bool OPSpeculationWait(OPSpeculation * spec)
+{
+	if (!spec || (spec->state == OP_SPEC_IDLE))
+		return false;
+
+	SDL_LockMutex(spec->mutex);
+
+	while (spec->state != OP_SPEC_DONE)
+		SDL_CondWait(spec->cond, spec->mutex);
+
+	spec->state = OP_SPEC_IDLE;
+	SDL_UnlockMutex(spec->mutex);
+
+	jaguarMachine->op.dirtyPages = NULL;
+	return true;
+}
+
+
+//
+// Render a line ahead on the OP host thread, from the current TOM & OP states;
+// the RAM & ROM writes are marked until the line is reached
+// Of TOM, the line is given the registers, the CLUT & the line buffers the OP
+// reads; the line buffers are kept if the previous line has just been taken,
+// as they are then the same
+//
+void OPSpeculationStart(int halfline)
+{
+	if (!opSpec && !OPThreadInit())
+		return;
+
+	OPSpeculation * spec = opSpec;
+	JaguarMachine * machine = spec->machine;
+	OPSpeculationWait(spec);
+
+	// TOM RAM comes first in the TOM state
+	uint8_t * tom = (uint8_t *)&machine->tom;
+	memcpy(tom, tomRam8, OP_SPEC_REGISTERS);
+	memcpy(tom + OP_SPEC_CLUT, tomRam8 + OP_SPEC_CLUT, (spec->lbufSame ? OP_SPEC_LBUF : OP_SPEC_LBUF_END) - OP_SPEC_CLUT);
+	memcpy(tom + sizeof(tomRam8), (uint8_t *)&jaguarMachine->tom + sizeof(tomRam8), sizeof(TOMState) - sizeof(tomRam8));
+
+	machine->memory = jaguarMachine->memory;
+	machine->op = jaguarMachine->op;
+	machine->op.spec = NULL;
+	machine->op.rendering = spec;
+	machine->op.dirtyPages = NULL;
+	memset(&machine->perf, 0, sizeof(PerfState));
+
+	for(uint32_t i=0; i<spec->nbReadPages; i++)
+		spec->readPages[spec->readList[i]] = 0;
+
+	for(uint32_t i=0; i<spec->nbStores; i++)
+		spec->storedPages[spec->stores[i].location >> OP_PAGE_SHIFT] = 0;
+
+	memset(spec->dirtyPages, 0, sizeof(spec->dirtyPages));
+	spec->nbReadPages = spec->nbStores = 0;
+	spec->halfline = halfline;
+	spec->valid = true;
+	spec->stopped = false;
+	spec->lbufStart = OP_SPEC_LBUF_END;
+	spec->lbufEnd = 0;
+	spec->lbufSame = false;
+
+	jaguarMachine->op.tomWritten = false;
+	jaguarMachine->op.dirtyPages = spec->dirtyPages;
+
+	SDL_LockMutex(spec->mutex);
+	spec->state = OP_SPEC_START;
+	SDL_CondBroadcast(spec->cond);
+	SDL_UnlockMutex(spec->mutex);
+
+	spec->lineCount++;
+}
+
+
+//
+// Take the line rendered ahead, if nothing it has read has been written since it
+// has been started; its phrases stores & STOP object are done as the OP does them
+// Returns false if the line has to be rendered
+//
+bool OPSpeculationCommit(int halfline)
+{
+	OPSpeculation * spec = opSpec;
+	bool done = OPSpeculationWait(spec);
+
+	if (spec)
+		spec->lbufSame = false;
+
+	if (!done)
+		return false;
+
+	bool taken = spec->valid && (spec->halfline == halfline) && !jaguarMachine->op.tomWritten;
+
+	for(uint32_t i=0; taken && (i<spec->nbReadPages); i++)
+		taken = !spec->dirtyPages[spec->readList[i]];
+
+	if (!taken)
+	{
+		spec->againCount++;
+		return false;
+	}
+
+	JaguarMachine * machine = spec->machine;
+	TOMLineBufferTake(machine, spec->lbufStart, spec->lbufEnd);
+
+	// Objects & bus accesses counted by the OP thread
+	PERF_COUNT(opLines, machine->perf.counters.opLines);
+	PERF_COUNT(opObjects, machine->perf.counters.opObjects);
+
+	for(int i=0; i<PERF_MASTERS; i++)
+	{
+		for(int j=0; j<PERF_BUS_REGIONS; j++)
+			jaguarMachine->perf.counters.busAccesses[i][j] += machine->perf.counters.busAccesses[i][j];
+	}
+
+	for(uint32_t i=0; i<spec->nbStores; i++)
+		OPStorePhrase(spec->stores[i].offset, spec->stores[i].phrase);
+
+	if (spec->stopped)
+		OPStopObject(spec->stopObject);
+
+	// Nothing else has been written in the line buffers meanwhile
+	spec->lbufSame = true;
+	return true;
+}
+
+
+//
+// Drop the line rendered ahead, if any
+//
+void OPSpeculationCancel(void)
+{
+	OPSpeculationWait(opSpec);
+
+	if (opSpec)
+		opSpec->lbufSame = false;
+}
+#else
+// Without SDL, there is no OP host thread and the lines are rendered when reached
+static void OPThreadDone(void)
+{
+}
+
+void OPSpeculationStart(int halfline)
+{
+}
+
+bool OPSpeculationCommit(int halfline)
+{
+	return false;
+}
+
+void OPSpeculationCancel(void)
+{
+}
+#endif
+
+
 //
 // Debugging routines
 //
@@ -470,6 +982,7 @@ void OPProcessList(int halfline, bool render)
 extern int op_start_log;
 
 	op_pointer = OPGetListPointer();
+	PERF_COUNT(opLines, 1);
 
 //	objectp_stop_reading_list = false;
 
@@ -500,6 +1013,7 @@ else
 
 		uint64_t p0 = OPLoadPhrase(op_pointer);
 		op_pointer += 8;
+		PERF_COUNT(opObjects, 1);
 //WriteLog("\t%08X type %i\n", op_pointer, (uint8_t)p0 & 0x07);
 
 #if 1
@@ -792,6 +1306,13 @@ OP: Scaled bitmap 4x? 4bpp at 34,? hscale=80 fpix=0 data=000756E8 pitch 1 hflipp
 #else
 #warning "Need to fix OP GPU IRQ handling! !!! FIX !!!"
 #endif // _MSC_VER
+			// The GPU can't be interrupted ahead of the line
+			if (opSpeculated)
+			{
+				opSpeculated->valid = false;
+				return;
+			}
+
 			OPSetCurrentObject(p0);
 			GPUSetIRQLine(3, ASSERT_LINE);
 //Also, OP processing is suspended from this point until OBF (F00026) is written to...
@@ -829,6 +1350,10 @@ OP: Scaled bitmap 4x? 4bpp at 34,? hscale=80 fpix=0 data=000756E8 pitch 1 hflipp
 					op_pointer = link;
 				break;
 			case CONDITION_SECOND_HALF_LINE:
+				// HC is not known ahead of the line
+				if (opSpeculated)
+					opSpeculated->valid = false;
+
 				// Branch if bit 10 of HC is set...
 				if (TOMGetHC() & 0x0400)
 					op_pointer = link;
@@ -841,13 +1366,14 @@ OP: Scaled bitmap 4x? 4bpp at 34,? hscale=80 fpix=0 data=000756E8 pitch 1 hflipp
 		}
 		case OBJECT_TYPE_STOP:
 		{
-			OPSetCurrentObject(p0);
-
-			if ((p0 & 0x08) && TOMIRQEnabled(IRQ_OPFLAG))
+			// A line rendered ahead stops once it is taken
+			if (opSpeculated)
 			{
-				TOMSetPendingObjectInt();
-				m68k_set_irq(2);		// Cause a 68K IPL 2 to occur...
+				opSpeculated->stopObject = p0;
+				opSpeculated->stopped = true;
 			}
+			else
+				OPStopObject(p0);
 
 			// Bail out, we're done...
 			return;
@@ -904,7 +1430,6 @@ void OPProcessFixedBitmap(uint64_t p0, uint64_t p1, bool render)
 	pitch <<= 3;							// Optimization: Multiply pitch by 8
 
 //	int16_t scanlineWidth = tom_getVideoModeWidth();
-	uint8_t * tomRam8 = TOMGetRamPointer();
 	uint8_t * paletteRAM = &tomRam8[0x400];
 	// This is OK as long as it's used correctly: For 16-bit RAM to RAM direct
 	// copies--NOT for use when using endian-corrected data (i.e., any of the
@@ -1078,7 +1603,7 @@ if (depth > 5)
 		int32_t lbufDelta = ((int8_t)((flags << 7) & 0xFF) >> 5) | 0x02;
 
 		// Fetch 1st phrase...
-		uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+		uint64_t pixels = OPReadData(data);
 //Note that firstPix should only be honored *if* we start with the 1st phrase of the bitmap
 //i.e., we didn't clip on the margin... !!! FIX !!!
 		pixels <<= firstPix;						// Skip first N pixels (N=firstPix)...
@@ -1116,7 +1641,7 @@ if (depth > 5)
 			i = 0;
 			// Fetch next phrase...
 			data += pitch;
-			pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+			pixels = OPReadData(data);
 		}
 	}
 	else if (depth == 1)							// 2 BPP
@@ -1130,7 +1655,7 @@ if (firstPix)
 		while (iwidth--)
 		{
 			// Fetch phrase...
-			uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+			uint64_t pixels = OPReadData(data);
 			data += pitch;
 
 			for(int i=0; i<32; i++)
@@ -1174,7 +1699,7 @@ if (firstPix)
 		while (iwidth--)
 		{
 			// Fetch phrase...
-			uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+			uint64_t pixels = OPReadData(data);
 			data += pitch;
 
 			for(int i=0; i<16; i++)
@@ -1213,7 +1738,7 @@ if (firstPix)
 		int32_t lbufDelta = ((int8_t)((flags << 7) & 0xFF) >> 5) | 0x02;
 
 		// Fetch 1st phrase...
-		uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+		uint64_t pixels = OPReadData(data);
 //Note that firstPix should only be honored *if* we start with the 1st phrase of the bitmap
 //i.e., we didn't clip on the margin... !!! FIX !!!
 		firstPix &= 0x30;							// Only top two bits are valid for 8 BPP
@@ -1256,7 +1781,7 @@ if (firstPix)
 			i = 0;
 			// Fetch next phrase...
 			data += pitch;
-			pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+			pixels = OPReadData(data);
 		}
 	}
 	else if (depth == 4)							// 16 BPP
@@ -1269,7 +1794,7 @@ if (firstPix)
 		while (iwidth--)
 		{
 			// Fetch phrase...
-			uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+			uint64_t pixels = OPReadData(data);
 			data += pitch;
 
 			for(int i=0; i<4; i++)
@@ -1317,7 +1842,7 @@ if (firstPix)
 		while (iwidth--)
 		{
 			// Fetch phrase...
-			uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+			uint64_t pixels = OPReadData(data);
 			data += pitch;
 
 			for(int i=0; i<2; i++)
@@ -1339,6 +1864,11 @@ if (firstPix)
 			}
 		}
 	}
+
+	// Line buffer span written, from both ends of the object (in REFLECT mode
+	// as well), including the last pixel
+	uint32_t lbufEnd = (uint32_t)(currentLineBuffer - tomRam8);
+	OPLineBufferWritten(lbufAddress, lbufEnd);
 }
 
 
@@ -1371,7 +1901,6 @@ if (firstPix)
 	uint8_t index = (p1 >> 37) & 0xFE;				// CLUT index offset (upper pix, 1-4 bpp)
 	uint32_t pitch = (p1 >> 15) & 0x07;				// Phrase pitch
 
-	uint8_t * tomRam8 = TOMGetRamPointer();
 	uint8_t * paletteRAM = &tomRam8[0x400];
 	// This is OK as long as it's used correctly: For 16-bit RAM to RAM direct
 	// copies--NOT for use when using endian-corrected data (i.e., any of the
@@ -1578,7 +2107,7 @@ if (firstPix != 0)
 		int32_t lbufDelta = ((int8_t)((flags << 7) & 0xFF) >> 5) | 0x02;
 
 		int pixCount = 0;
-		uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+		uint64_t pixels = OPReadData(data);
 
 		while ((int32_t)iwidth > 0)
 		{
@@ -1631,7 +2160,7 @@ wide, so we could probably go back to that (as long as we make it an int16_t and
 				int phrasesToSkip = pixCount / 64, pixelShift = pixCount % 64;
 
 				data += (pitch << 3) * phrasesToSkip;
-				pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+				pixels = OPReadData(data);
 				pixels <<= 1 * pixelShift;
 				iwidth -= phrasesToSkip;
 				pixCount = pixelShift;
@@ -1647,7 +2176,7 @@ if (firstPix != 0)
 		int32_t lbufDelta = ((int8_t)((flags << 7) & 0xFF) >> 5) | 0x02;
 
 		int pixCount = 0;
-		uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+		uint64_t pixels = OPReadData(data);
 
 		while ((int32_t)iwidth > 0)
 		{
@@ -1695,7 +2224,7 @@ if (firstPix != 0)
 				int phrasesToSkip = pixCount / 32, pixelShift = pixCount % 32;
 
 				data += (pitch << 3) * phrasesToSkip;
-				pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+				pixels = OPReadData(data);
 				pixels <<= 2 * pixelShift;
 				iwidth -= phrasesToSkip;
 				pixCount = pixelShift;
@@ -1711,7 +2240,7 @@ if (firstPix != 0)
 		int32_t lbufDelta = ((int8_t)((flags << 7) & 0xFF) >> 5) | 0x02;
 
 		int pixCount = 0;
-		uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+		uint64_t pixels = OPReadData(data);
 
 		while ((int32_t)iwidth > 0)
 		{
@@ -1759,7 +2288,7 @@ if (firstPix != 0)
 				int phrasesToSkip = pixCount / 16, pixelShift = pixCount % 16;
 
 				data += (pitch << 3) * phrasesToSkip;
-				pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+				pixels = OPReadData(data);
 				pixels <<= 4 * pixelShift;
 				iwidth -= phrasesToSkip;
 				pixCount = pixelShift;
@@ -1774,7 +2303,7 @@ if (firstPix)
 		int32_t lbufDelta = ((int8_t)((flags << 7) & 0xFF) >> 5) | 0x02;
 
 		int pixCount = 0;
-		uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+		uint64_t pixels = OPReadData(data);
 
 		while ((int32_t)iwidth > 0)
 		{
@@ -1819,7 +2348,7 @@ if (firstPix)
 				int phrasesToSkip = pixCount / 8, pixelShift = pixCount % 8;
 
 				data += (pitch << 3) * phrasesToSkip;
-				pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+				pixels = OPReadData(data);
 				pixels <<= 8 * pixelShift;
 				iwidth -= phrasesToSkip;
 				pixCount = pixelShift;
@@ -1834,7 +2363,7 @@ if (firstPix != 0)
 		int32_t lbufDelta = ((int8_t)((flags << 7) & 0xFF) >> 5) | 0x02;
 
 		int pixCount = 0;
-		uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+		uint64_t pixels = OPReadData(data);
 
 		while ((int32_t)iwidth > 0)
 		{
@@ -1880,7 +2409,7 @@ if (firstPix != 0)
 				int phrasesToSkip = pixCount / 4, pixelShift = pixCount % 4;
 
 				data += (pitch << 3) * phrasesToSkip;
-				pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+				pixels = OPReadData(data);
 				pixels <<= 16 * pixelShift;
 
 				iwidth -= phrasesToSkip;
@@ -1902,7 +2431,7 @@ if (firstPix != 0)
 		while (iwidth--)
 		{
 			// Fetch phrase...
-			uint64_t pixels = ((uint64_t)JaguarReadLong(data, OP) << 32) | JaguarReadLong(data + 4, OP);
+			uint64_t pixels = OPReadData(data);
 			data += pitch << 3;						// Multiply pitch * 8 (optimize: precompute this value)
 
 			for(int i=0; i<2; i++)
@@ -1923,4 +2452,9 @@ if (firstPix != 0)
 			}
 		}
 	}
+
+	// Line buffer span written, from both ends of the object (in REFLECT mode
+	// as well), including the last pixel
+	uint32_t lbufEnd = (uint32_t)(currentLineBuffer - tomRam8);
+	OPLineBufferWritten(lbufAddress, lbufEnd);
 }
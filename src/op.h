@@ -18,14 +18,44 @@ uint32_t OPGetListPointer(void);
 void OPSetStatusRegister(uint32_t data);
 uint32_t OPGetStatusRegister(void);
 void OPSetCurrentObject(uint64_t object);
+void OPSpeculationStart(int halfline);
+bool OPSpeculationCommit(int halfline);
+void OPSpeculationCancel(void);
+void OPSpeculationWritten(uint32_t start, uint32_t end);
 
 #define OPFLAG_RELEASE		8					// Bus release bit
 #define OPFLAG_TRANS		4					// Transparency bit
 #define OPFLAG_RMW			2					// Read-Modify-Write bit
 #define OPFLAG_REFLECT		1					// Horizontal mirror bit
 
-// Exported variables
+// Speculated lines support; RAM & ROM are split in pages, a written page
+// failing the speculated line which has read it
 
-extern uint8_t objectp_running;
+#define OP_PAGE_SHIFT		12
+#define OP_PAGES			(0x1000000 >> OP_PAGE_SHIFT)
+
+struct OPSpeculation;
+
+// OP state of a machine
+
+struct OPState
+{
+	uint8_t objectp_running;
+	uint32_t op_pointer;
+	OPSpeculation * spec;						// Next line rendered on the OP host thread
+	OPSpeculation * rendering;					// Set on the machine used by the OP host thread
+	uint8_t * dirtyPages;						// Pages written while a line is speculated, NULL otherwise
+	bool tomWritten;							// OP registers, CLUT or line buffer written meanwhile
+};
+
+// Every RAM & ROM write, by any bus master, has to use OP_BUS_WRITE(); the TOM
+// writes use OP_TOM_WRITE(), which only marks the ones the OP reads: the video &
+// OP registers (HC & VC left apart), the CLUT & the line buffers
+#define OP_BUS_WRITE(address)	{ uint8_t * opDirty = jaguarMachine->op.dirtyPages; if (opDirty) opDirty[((address) & 0xFFFFFF) >> OP_PAGE_SHIFT] = 1; }
+#define OP_TOM_WRITE(offset)	{ if (jaguarMachine->op.dirtyPages && (((offset) < 0x04) || (((offset) >= 0x08) && ((offset) < 0x60)) || (((offset) >= 0x400) && ((offset) < 0x2000)))) jaguarMachine->op.tomWritten = true; }
+
+// Exported variables (of the current machine, see machine.h)
+
+#define objectp_running	(jaguarMachine->op.objectp_running)
 
 #endif	// __OBJECTP_H__
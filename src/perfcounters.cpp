@@ -0,0 +1,646 @@
+//
+// perfcounters.cpp - Hardware performance counters
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Added the bus heatmap
+//
+// Each machine counts, for every frame, the cycles given to its processors and
+// the ones they spent idle, their instructions, the blits & their pixels, the
+// OP objects, the events callbacks, the bus accesses by master & region, and the
+// host time of its subsystems. The last frame is kept for PerfGetFrame(), the
+// stats endpoint (a UNIX socket, --stats-socket) & the CSV time series
+// (--stats-csv).
+//
+// Reading the endpoint gives one JSON object, e.g. "socat - UNIX-CONNECT:<path>".
+//
+// Once turned on, the heatmap also counts the bus accesses by 4 KB bucket, master
+// & kind (read or write). The frame ones are summed in the current machine, by
+// the threads running its masters (the blitter ones atomically, as the blitter
+// runs on the thread starting it), then kept with the totals at the end of the
+// frame; the debugger window shows them, & they are written in a CSV file
+// (--heatmap, or the window export).
+//
+
+#include "perfcounters.h"
+
+#include <stdlib.h>
+#ifndef NO_SDL
+#include <SDL.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if _WIN32 || _WIN64
+#include <windows.h>
+#endif
+#if !defined(NO_SDL) && !(_WIN32 || _WIN64)
+#define PERF_SOCKET
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include "log.h"
+#include "machine.h"
+#include "settings.h"
+
+
+uint8_t perfBusRegion[0x100];
+const uint8_t perfBusMaster[0x10] = {
+	PERF_MASTER_OTHER, PERF_MASTER_OTHER, PERF_MASTER_DSP, PERF_MASTER_GPU,				// UNKNOWN, JAGUAR, DSP, GPU
+	PERF_MASTER_OTHER, PERF_MASTER_OTHER, PERF_MASTER_M68K, PERF_MASTER_BLITTER,		// TOM, JERRY, M68K, BLITTER
+	PERF_MASTER_OP, PERF_MASTER_OTHER, PERF_MASTER_OTHER, PERF_MASTER_OTHER,			// OP, DEBUG
+	PERF_MASTER_OTHER, PERF_MASTER_OTHER, PERF_MASTER_OTHER, PERF_MASTER_OTHER
+};
+
+static const char * perfRegionName[PERF_BUS_REGIONS] = { "dram", "rom", "cdrom", "bios", "tom", "jerry", "other" };
+static const char * perfMasterName[PERF_MASTERS] = { "m68k", "gpu", "dsp", "blitter", "op", "other" };
+static const char * perfTimeName[PERF_TIMES] = { "m68k", "gpu", "dsp", "events", "frame" };
+
+static int perfMachines = 0;					// Machines initialised, counted under the machines lock
+static uint64_t perfFrequency = 1;				// Host ticks per second
+static PerfCounters perfFrame;					// Last frame done, by any machine
+static bool perfFrameValid = false;
+static FILE * perfCSV = NULL;
+#ifndef NO_SDL
+static SDL_mutex * perfMutex = NULL;			// Protects the last frame
+#endif
+#ifdef PERF_SOCKET
+static SDL_Thread * perfThread = NULL;
+static int perfSocket = -1;
+static bool perfQuit = false;
+#endif
+
+// Private function prototypes
+static void PerfHeatmapFrameDone(PerfState * state);
+static void PerfWriteCSV(const PerfCounters * frame);
+#ifdef PERF_SOCKET
+static int PerfFormatJSON(const PerfCounters * frame, char * buffer, int size);
+static bool PerfOpenSocket(const char * path);
+static int PerfSocketThreadFunc(void *);
+#endif
+
+
+//
+// Set up the regions, the CSV file & the endpoint, once for all the machines
+//
+void PerfInit(void)
+{
+	// Heatmap of the machine, written when it is done
+	if (vjs.heatmapFile[0])
+		PerfHeatmapEnable(true);
+
+	if (perfMachines++)
+		return;
+
+	for(int i=0; i<0x100; i++)
+	{
+		if (i < 0x80)
+			perfBusRegion[i] = PERF_BUS_DRAM;
+		else if (i < 0xDF)
+			perfBusRegion[i] = PERF_BUS_ROM;
+		else if (i == 0xDF)
+			perfBusRegion[i] = PERF_BUS_CDROM;
+		else if (i < 0xE4)
+			perfBusRegion[i] = PERF_BUS_BIOS;
+		else if (i == 0xF0)
+			perfBusRegion[i] = PERF_BUS_TOM;
+		else if (i == 0xF1)
+			perfBusRegion[i] = PERF_BUS_JERRY;
+		else
+			perfBusRegion[i] = PERF_BUS_OTHER;
+	}
+
+	perfFrequency = PerfHostFrequency();
+#ifndef NO_SDL
+	perfMutex = SDL_CreateMutex();
+#endif
+
+	if (vjs.statsCSV[0])
+	{
+		if ((perfCSV = fopen(vjs.statsCSV, "w")))
+		{
+			fputs("frame,m68k_cycles,m68k_idle_cycles,m68k_instructions,gpu_cycles,gpu_idle_cycles,gpu_instructions,"
+				"dsp_cycles,dsp_idle_cycles,dsp_instructions,blits,blit_pixels,op_lines,op_objects,events_main,events_jerry", perfCSV);
+
+			for(int i=0; i<PERF_MASTERS; i++)
+			{
+				for(int j=0; j<PERF_BUS_REGIONS; j++)
+					fprintf(perfCSV, ",bus_%s_%s", perfMasterName[i], perfRegionName[j]);
+			}
+
+			for(int i=0; i<PERF_TIMES; i++)
+				fprintf(perfCSV, ",host_%s_us", perfTimeName[i]);
+
+			fputs("\n", perfCSV);
+			WriteLog("Perf: Writing the counters of each frame to \"%s\"\n", vjs.statsCSV);
+		}
+		else
+			WriteLog("Perf: Could not create file \"%s\"!\n", vjs.statsCSV);
+	}
+
+#ifdef PERF_SOCKET
+	if (vjs.statsSocket[0] && PerfOpenSocket(vjs.statsSocket))
+	{
+		if ((perfThread = SDL_CreateThread(PerfSocketThreadFunc, NULL)))
+			WriteLog("Perf: Stats endpoint listening on \"%s\"\n", vjs.statsSocket);
+		else
+		{
+			WriteLog("Perf: Unable to start the stats endpoint thread (%s)\n", SDL_GetError());
+			close(perfSocket);
+			unlink(vjs.statsSocket);
+			perfSocket = -1;
+		}
+	}
+#else
+	if (vjs.statsSocket[0])
+		WriteLog("Perf: Stats endpoint is not available on this host\n");
+#endif
+}
+
+
+//
+// Host time, in ticks of the host monotonic clock
+// SDL 1.2 has no performance counter, so the system one is read
+//
+uint64_t PerfHostTime(void)
+{
+#if _WIN32 || _WIN64
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (uint64_t)counter.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+
+//
+// Host monotonic clock ticks per second
+//
+uint64_t PerfHostFrequency(void)
+{
+#if _WIN32 || _WIN64
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return (uint64_t)frequency.QuadPart;
+#else
+	return 1000000000;
+#endif
+}
+
+
+//
+// Instructions run since the last call, from the opcodes use of a RISC
+// (the statistics may have been cleared meanwhile)
+//
+static uint64_t PerfOpcodeCount(const uint32_t * opcodeUse, int count, uint64_t * last)
+{
+	uint64_t total = 0, delta;
+
+	for(int i=0; i<count; i++)
+		total += opcodeUse[i];
+
+	delta = (total >= *last ? total - *last : total);
+	*last = total;
+	return delta;
+}
+
+
+//
+// End of a frame of the current machine: keep its counters
+//
+void PerfFrameDone(void)
+{
+	PerfState * state = &jaguarMachine->perf;
+	PerfCounters * total = &state->counters;
+	PerfCounters frame;
+	uint64_t instructions, idleCycles;
+
+	m68k_get_counters(&instructions, &idleCycles);
+	total->m68k.instructions += instructions;
+	total->m68k.idleCycles += idleCycles;
+	total->gpu.instructions += PerfOpcodeCount(jaguarMachine->gpu.gpu_opcode_use, 64, &state->gpuOpcodes);
+	total->frames++;
+
+	// Counters are all 64 bit ones
+	const uint64_t * now = (const uint64_t *)total;
+	const uint64_t * before = (const uint64_t *)&state->previous;
+	uint64_t * delta = (uint64_t *)&frame;
+
+	for(size_t i=0; i<(sizeof(PerfCounters) / sizeof(uint64_t)); i++)
+		delta[i] = now[i] - before[i];
+
+	memcpy(&state->previous, now, sizeof(PerfCounters));
+	frame.frames = total->frames;
+
+	for(int i=0; i<PERF_TIMES; i++)
+		frame.hostTime[i] = (frame.hostTime[i] * 1000000) / perfFrequency;
+
+#ifndef NO_SDL
+	SDL_LockMutex(perfMutex);
+#endif
+	perfFrame = frame;
+	perfFrameValid = true;
+
+	// The machines share the file
+	if (perfCSV)
+		PerfWriteCSV(&frame);
+#ifndef NO_SDL
+	SDL_UnlockMutex(perfMutex);
+#endif
+
+	if (state->heat)
+		PerfHeatmapFrameDone(state);
+}
+
+
+//
+// Keep the heatmap of the frame, & add it to the totals
+// The threads still counting go on in the other counts, cleared when they were
+// kept, so this frame ones are not counted again by the next one
+//
+static void PerfHeatmapFrameDone(PerfState * state)
+{
+	PerfHeatCounts * done = state->heat;
+	state->heat = (done == state->heatCounts ? &state->heatCounts[1] : &state->heatCounts[0]);
+
+	const uint32_t * counts = &done->accesses[0][0][0];
+	uint64_t * frame = &state->heatFrame->accesses[0][0][0];
+	uint64_t * total = &state->heatTotal->accesses[0][0][0];
+
+#ifndef NO_SDL
+	SDL_LockMutex(perfMutex);
+#endif
+	for(size_t i=0; i<(PERF_HEAT_KINDS * PERF_MASTERS * PERF_HEAT_BUCKETS); i++)
+	{
+		frame[i] = counts[i];
+		total[i] += counts[i];
+	}
+
+	state->heatFrame->frames = 1;
+	state->heatTotal->frames++;
+#ifndef NO_SDL
+	SDL_UnlockMutex(perfMutex);
+#endif
+
+	memset(done, 0, sizeof(PerfHeatCounts));
+}
+
+
+//
+// Turn on (its counts starting from scratch) or off the heatmap of the current machine
+//
+void PerfHeatmapEnable(bool enable)
+{
+	PerfState * state = &jaguarMachine->perf;
+
+	if (!enable || state->heat)
+	{
+		state->heat = (enable ? state->heat : NULL);
+		return;
+	}
+
+	// The counts are kept allocated, as a thread may be counting when it is turned off
+	if (!state->heatCounts)
+	{
+		state->heatCounts = (PerfHeatCounts *)malloc(2 * sizeof(PerfHeatCounts));
+		state->heatFrame = (PerfHeatmap *)malloc(sizeof(PerfHeatmap));
+		state->heatTotal = (PerfHeatmap *)malloc(sizeof(PerfHeatmap));
+
+		if (!state->heatCounts || !state->heatFrame || !state->heatTotal)
+		{
+			WriteLog("Perf: Unable to allocate the bus heatmap\n");
+			free(state->heatCounts);
+			free(state->heatFrame);
+			free(state->heatTotal);
+			state->heatCounts = NULL;
+			state->heatFrame = state->heatTotal = NULL;
+			return;
+		}
+	}
+
+	memset(state->heatCounts, 0, 2 * sizeof(PerfHeatCounts));
+#ifndef NO_SDL
+	if (perfMutex)
+		SDL_LockMutex(perfMutex);
+#endif
+	memset(state->heatFrame, 0, sizeof(PerfHeatmap));
+	memset(state->heatTotal, 0, sizeof(PerfHeatmap));
+#ifndef NO_SDL
+	if (perfMutex)
+		SDL_UnlockMutex(perfMutex);
+#endif
+	state->heat = state->heatCounts;
+}
+
+
+bool PerfHeatmapIsEnabled(void)
+{
+	return (jaguarMachine->perf.heat != NULL);
+}
+
+
+//
+// Heatmap of the last frame, or the totals, of the current machine; false if it
+// has never been turned on
+//
+bool PerfGetHeatmap(PerfHeatmap * heatmap, bool total)
+{
+	PerfState * state = &jaguarMachine->perf;
+
+	if (!state->heatCounts)
+		return false;
+
+#ifndef NO_SDL
+	if (perfMutex)
+		SDL_LockMutex(perfMutex);
+#endif
+	memcpy(heatmap, (total ? state->heatTotal : state->heatFrame), sizeof(PerfHeatmap));
+#ifndef NO_SDL
+	if (perfMutex)
+		SDL_UnlockMutex(perfMutex);
+#endif
+
+	return true;
+}
+
+
+//
+// Write the heatmap of the current machine in a CSV file, a line by bucket &
+// master having accesses: totals, then the ones of the last frame
+//
+bool PerfHeatmapSave(const char * filename)
+{
+	PerfHeatmap * heatmap = (PerfHeatmap *)malloc(2 * sizeof(PerfHeatmap));
+	FILE * fp = NULL;
+
+	if (!heatmap || !PerfGetHeatmap(&heatmap[0], true) || !PerfGetHeatmap(&heatmap[1], false) || !(fp = fopen(filename, "w")))
+	{
+		WriteLog("Perf: Could not write the bus heatmap to \"%s\"!\n", filename);
+		free(heatmap);
+		return false;
+	}
+
+	fprintf(fp, "address,master,reads,writes,frame_reads,frame_writes\n");
+
+	for(uint32_t i=0; i<PERF_HEAT_BUCKETS; i++)
+	{
+		for(int j=0; j<PERF_MASTERS; j++)
+		{
+			if (heatmap[0].accesses[PERF_HEAT_READ][j][i] || heatmap[0].accesses[PERF_HEAT_WRITE][j][i])
+			{
+				fprintf(fp, "%06X,%s,%llu,%llu,%llu,%llu\n", (i << PERF_HEAT_SHIFT), perfMasterName[j],
+					(unsigned long long)heatmap[0].accesses[PERF_HEAT_READ][j][i], (unsigned long long)heatmap[0].accesses[PERF_HEAT_WRITE][j][i],
+					(unsigned long long)heatmap[1].accesses[PERF_HEAT_READ][j][i], (unsigned long long)heatmap[1].accesses[PERF_HEAT_WRITE][j][i]);
+			}
+		}
+	}
+
+	WriteLog("Perf: Bus heatmap of %llu frames written to \"%s\"\n", (unsigned long long)heatmap[0].frames, filename);
+	fclose(fp);
+	free(heatmap);
+	return true;
+}
+
+
+const char * PerfMasterName(int master)
+{
+	return perfMasterName[master];
+}
+
+
+//
+// Count the DSP instructions run, by the thread running the DSP (the host audio one)
+//
+void PerfDSPDone(void)
+{
+	PerfState * state = &jaguarMachine->perf;
+	state->counters.dsp.instructions += PerfOpcodeCount(jaguarMachine->dsp.dsp_opcode_use, 65, &state->dspOpcodes);
+}
+
+
+//
+// Counters of the last frame done; false if there is none yet
+//
+bool PerfGetFrame(PerfCounters * frame)
+{
+#ifndef NO_SDL
+	if (!perfMutex)
+		return false;
+
+	SDL_LockMutex(perfMutex);
+#endif
+	bool valid = perfFrameValid;
+
+	if (valid)
+		*frame = perfFrame;
+#ifndef NO_SDL
+	SDL_UnlockMutex(perfMutex);
+#endif
+
+	return valid;
+}
+
+
+void PerfDone(void)
+{
+	PerfState * state = &jaguarMachine->perf;
+
+	if (state->heat && vjs.heatmapFile[0])
+		PerfHeatmapSave(vjs.heatmapFile);
+
+	state->heat = NULL;
+	free(state->heatCounts);
+	free(state->heatFrame);
+	free(state->heatTotal);
+	state->heatCounts = NULL;
+	state->heatFrame = state->heatTotal = NULL;
+
+	// The endpoint, the CSV file & the lock are shared, & kept until the last machine is done
+	if (!perfMachines || --perfMachines)
+		return;
+
+#ifdef PERF_SOCKET
+	if (perfThread)
+	{
+		perfQuit = true;
+		SDL_WaitThread(perfThread, NULL);
+		perfThread = NULL;
+		perfQuit = false;
+		close(perfSocket);
+		unlink(vjs.statsSocket);
+		perfSocket = -1;
+	}
+#endif
+
+	if (perfCSV)
+	{
+		fclose(perfCSV);
+		perfCSV = NULL;
+	}
+
+#ifndef NO_SDL
+	if (perfMutex)
+	{
+		SDL_DestroyMutex(perfMutex);
+		perfMutex = NULL;
+	}
+#endif
+
+	perfFrameValid = false;
+}
+
+
+#ifdef PERF_SOCKET
+//
+// One JSON object, with the counters grouped by subsystem
+//
+static int PerfFormatJSON(const PerfCounters * frame, char * buffer, int size)
+{
+	int length = snprintf(buffer, size, "{\"frame\":%llu,"
+		"\"m68k\":{\"cycles\":%llu,\"idleCycles\":%llu,\"instructions\":%llu},"
+		"\"gpu\":{\"cycles\":%llu,\"idleCycles\":%llu,\"instructions\":%llu},"
+		"\"dsp\":{\"cycles\":%llu,\"idleCycles\":%llu,\"instructions\":%llu},"
+		"\"blitter\":{\"blits\":%llu,\"pixels\":%llu},"
+		"\"op\":{\"lines\":%llu,\"objects\":%llu},"
+		"\"events\":{\"main\":%llu,\"jerry\":%llu},\"bus\":{",
+		(unsigned long long)frame->frames,
+		(unsigned long long)frame->m68k.cycles, (unsigned long long)frame->m68k.idleCycles, (unsigned long long)frame->m68k.instructions,
+		(unsigned long long)frame->gpu.cycles, (unsigned long long)frame->gpu.idleCycles, (unsigned long long)frame->gpu.instructions,
+		(unsigned long long)frame->dsp.cycles, (unsigned long long)frame->dsp.idleCycles, (unsigned long long)frame->dsp.instructions,
+		(unsigned long long)frame->blits, (unsigned long long)frame->blitPixels,
+		(unsigned long long)frame->opLines, (unsigned long long)frame->opObjects,
+		(unsigned long long)frame->events[0], (unsigned long long)frame->events[1]);
+
+	for(int i=0; (i<PERF_MASTERS) && (length < size); i++)
+	{
+		length += snprintf(buffer + length, size - length, "%s\"%s\":{", (i ? "," : ""), perfMasterName[i]);
+
+		for(int j=0; (j<PERF_BUS_REGIONS) && (length < size); j++)
+			length += snprintf(buffer + length, size - length, "%s\"%s\":%llu", (j ? "," : ""), perfRegionName[j], (unsigned long long)frame->busAccesses[i][j]);
+
+		if (length < size)
+			length += snprintf(buffer + length, size - length, "}");
+	}
+
+	if (length < size)
+		length += snprintf(buffer + length, size - length, "},\"hostTimeUs\":{");
+
+	for(int i=0; (i<PERF_TIMES) && (length < size); i++)
+		length += snprintf(buffer + length, size - length, "%s\"%s\":%llu", (i ? "," : ""), perfTimeName[i], (unsigned long long)frame->hostTime[i]);
+
+	if (length < size)
+		length += snprintf(buffer + length, size - length, "}}\n");
+
+	return (length < size ? length : size - 1);
+}
+#endif
+
+
+// Same order as the header written by PerfInit()
+static void PerfWriteCSV(const PerfCounters * frame)
+{
+	fprintf(perfCSV, "%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu",
+		(unsigned long long)frame->frames,
+		(unsigned long long)frame->m68k.cycles, (unsigned long long)frame->m68k.idleCycles, (unsigned long long)frame->m68k.instructions,
+		(unsigned long long)frame->gpu.cycles, (unsigned long long)frame->gpu.idleCycles, (unsigned long long)frame->gpu.instructions,
+		(unsigned long long)frame->dsp.cycles, (unsigned long long)frame->dsp.idleCycles, (unsigned long long)frame->dsp.instructions,
+		(unsigned long long)frame->blits, (unsigned long long)frame->blitPixels,
+		(unsigned long long)frame->opLines, (unsigned long long)frame->opObjects,
+		(unsigned long long)frame->events[0], (unsigned long long)frame->events[1]);
+
+	for(int i=0; i<PERF_MASTERS; i++)
+	{
+		for(int j=0; j<PERF_BUS_REGIONS; j++)
+			fprintf(perfCSV, ",%llu", (unsigned long long)frame->busAccesses[i][j]);
+	}
+
+	for(int i=0; i<PERF_TIMES; i++)
+		fprintf(perfCSV, ",%llu", (unsigned long long)frame->hostTime[i]);
+
+	fputs("\n", perfCSV);
+}
+
+
+#ifdef PERF_SOCKET
+//
+// Listening UNIX socket, replacing a stale one left by a previous run
+//
+static bool PerfOpenSocket(const char * path)
+{
+	struct sockaddr_un address;
+
+	if (strlen(path) >= sizeof(address.sun_path))
+	{
+		WriteLog("Perf: Stats socket path \"%s\" is too long\n", path);
+		return false;
+	}
+
+	if ((perfSocket = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+	{
+		WriteLog("Perf: Could not create the stats socket\n");
+		return false;
+	}
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path);
+	unlink(path);
+
+	if (bind(perfSocket, (struct sockaddr *)&address, sizeof(address)) || listen(perfSocket, 4))
+	{
+		WriteLog("Perf: Could not listen on \"%s\"\n", path);
+		close(perfSocket);
+		perfSocket = -1;
+		return false;
+	}
+
+	return true;
+}
+
+
+//
+// Endpoint thread: each connection gets the last frame, then is closed
+//
+static int PerfSocketThreadFunc(void *)
+{
+	char buffer[2048];
+	struct pollfd listener;
+	listener.fd = perfSocket;
+	listener.events = POLLIN;
+
+	while (!perfQuit)
+	{
+		// Short timeout, so the thread notices it has to quit
+		if (poll(&listener, 1, 100) <= 0)
+			continue;
+
+		int client = accept(perfSocket, NULL, NULL);
+
+		if (client < 0)
+			continue;
+
+		PerfCounters frame;
+		int length = (PerfGetFrame(&frame) ? PerfFormatJSON(&frame, buffer, sizeof(buffer)) : snprintf(buffer, sizeof(buffer), "{}\n"));
+
+		for(int written=0, count; written<length; written+=count)
+		{
+			if ((count = send(client, buffer + written, length - written, MSG_NOSIGNAL)) <= 0)
+				break;
+		}
+
+		close(client);
+	}
+
+	return 0;
+}
+#endif
@@ -0,0 +1,119 @@
+//
+// perfcounters.h: Hardware performance counters
+//
+
+#ifndef __PERFCOUNTERS_H__
+#define __PERFCOUNTERS_H__
+
+#include <stdint.h>
+
+// Bus regions, by 64K pages of the 24 bit address space
+enum { PERF_BUS_DRAM = 0, PERF_BUS_ROM, PERF_BUS_CDROM, PERF_BUS_BIOS, PERF_BUS_TOM, PERF_BUS_JERRY, PERF_BUS_OTHER, PERF_BUS_REGIONS };
+
+// Bus masters, from the "who" of the memory accesses
+enum { PERF_MASTER_M68K = 0, PERF_MASTER_GPU, PERF_MASTER_DSP, PERF_MASTER_BLITTER, PERF_MASTER_OP, PERF_MASTER_OTHER, PERF_MASTERS };
+
+// Heatmap of the bus accesses, by 4 KB buckets of the 24 bit address space
+#define PERF_HEAT_SHIFT		12
+#define PERF_HEAT_BUCKETS	(0x1000000 >> PERF_HEAT_SHIFT)
+enum { PERF_HEAT_READ = 0, PERF_HEAT_WRITE, PERF_HEAT_KINDS };
+
+// Host time spent by the subsystems
+enum { PERF_TIME_M68K = 0, PERF_TIME_GPU, PERF_TIME_DSP, PERF_TIME_EVENTS, PERF_TIME_FRAME, PERF_TIMES };
+
+// Cycles are the emulated time given to a processor, idle ones being those spent
+// stopped or skipped in an idle loop
+struct PerfProcessor
+{
+	uint64_t cycles, idleCycles, instructions;
+};
+
+// Counters of a machine; they only go up, and a frame is the difference between two
+// snapshots of them. Each one is counted by a single host thread, but the blitter
+// ones: the blitter is run by the thread of the processor starting it (the DSP one
+// included), so they are added atomically
+struct PerfCounters
+{
+	uint64_t frames;
+	PerfProcessor m68k, gpu, dsp;
+	uint64_t blits, blitPixels;
+	uint64_t opLines, opObjects;
+	uint64_t events[2];									// EVENT_MAIN & EVENT_JERRY callbacks
+	uint64_t busAccesses[PERF_MASTERS][PERF_BUS_REGIONS];	// Bytes & words accesses (a long one counts as 2)
+	uint64_t hostTime[PERF_TIMES];						// Host ticks (microseconds in a frame)
+};
+
+// Bytes & words accesses of the current frame, by kind, master & bucket
+struct PerfHeatCounts
+{
+	uint32_t accesses[PERF_HEAT_KINDS][PERF_MASTERS][PERF_HEAT_BUCKETS];
+};
+
+// Heatmap of a frame, or of all the frames since it has been turned on
+struct PerfHeatmap
+{
+	uint64_t frames;
+	uint64_t accesses[PERF_HEAT_KINDS][PERF_MASTERS][PERF_HEAT_BUCKETS];
+};
+
+// Counters of a machine, & what is needed to tell its frames apart
+struct PerfState
+{
+	PerfCounters counters;
+	PerfCounters previous;								// Counters at the end of the last frame
+	uint64_t gpuOpcodes, dspOpcodes;					// Sums of the RISC opcodes use when last counted
+	PerfHeatCounts * heat;								// NULL while the heatmap is off
+	PerfHeatCounts * heatCounts;						// 2 counts, used in turn by the frames; kept allocated once the heatmap has been on
+	PerfHeatmap * heatFrame, * heatTotal;
+};
+
+extern uint8_t perfBusRegion[0x100];
+extern const uint8_t perfBusMaster[0x10];
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define PERF_SHARED_ADD64(counter, count)	_InterlockedExchangeAdd64((volatile __int64 *)&(counter), (__int64)(count))
+#define PERF_SHARED_ADD32(counter, count)	_InterlockedExchangeAdd((volatile long *)&(counter), (long)(count))
+#else
+#define PERF_SHARED_ADD64(counter, count)	__atomic_fetch_add(&(counter), (uint64_t)(count), __ATOMIC_RELAXED)
+#define PERF_SHARED_ADD32(counter, count)	__atomic_fetch_add(&(counter), (uint32_t)(count), __ATOMIC_RELAXED)
+#endif
+
+#define PERF_COUNT(counter, count)	(jaguarMachine->perf.counters.counter += (count))
+#define PERF_COUNT_SHARED(counter, count)	PERF_SHARED_ADD64(jaguarMachine->perf.counters.counter, (count))
+#define PERF_BUS(who, address, count, kind)	\
+	do \
+	{ \
+		PerfState * perfState = &jaguarMachine->perf; \
+		PerfHeatCounts * perfHeat = perfState->heat; \
+		uint32_t perfMaster = perfBusMaster[(who) & 0x0F]; \
+		uint64_t * perfBus = &perfState->counters.busAccesses[perfMaster][perfBusRegion[((address) >> 16) & 0xFF]]; \
+		uint32_t * perfBucket = (perfHeat ? &perfHeat->accesses[kind][perfMaster][((address) >> PERF_HEAT_SHIFT) & (PERF_HEAT_BUCKETS - 1)] : NULL); \
+		if (perfMaster != PERF_MASTER_BLITTER) \
+		{ \
+			*perfBus += (count); \
+			if (perfBucket) \
+				*perfBucket += (count); \
+		} \
+		else \
+		{ \
+			PERF_SHARED_ADD64(*perfBus, (count)); \
+			if (perfBucket) \
+				PERF_SHARED_ADD32(*perfBucket, (count)); \
+		} \
+	} while (0)
+
+void PerfInit(void);
+void PerfFrameDone(void);
+void PerfDSPDone(void);
+bool PerfGetFrame(PerfCounters * frame);
+uint64_t PerfHostTime(void);
+uint64_t PerfHostFrequency(void);
+void PerfHeatmapEnable(bool enable);
+bool PerfHeatmapIsEnabled(void);
+bool PerfGetHeatmap(PerfHeatmap * heatmap, bool total);
+bool PerfHeatmapSave(const char * filename);
+const char * PerfMasterName(int master);
+void PerfDone(void);
+
+#endif	// __PERFCOUNTERS_H__
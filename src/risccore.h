@@ -0,0 +1,786 @@
+//
+// risccore.h: RISC core shared by the GPU & the DSP
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Added the DRAM fast path of the loads & stores
+//
+// The GPU & the DSP share most of their instruction set; their cores are built
+// from this template, specialized at compile time by a unit class giving:
+//  - Accumulator: the MAC width
+//  - hasModulo: ADDQMOD & SUBQMOD instead of PACK & SAT8
+//  - hasMirror: MIRROR instead of STOREP
+//  - hasSat16s: SAT16S, SAT32S & an illegal opcode instead of SAT16, LOADP & SAT24
+//  - its registers, flags & ALU registers accessors, & ConvertZero, giving the
+//    immediate data where 0 stands for 32
+//  - its loads & stores, their alignment & bus rules being its own
+//  - Fetch, which does the work needed before an instruction & returns it,
+//    Retire, which counts its cycles, & DelaySlot, which runs a branch delay slot
+// The unit state stays in the machine context (see machine.h). Handlers get the
+// decoded operands (m: source or immediate, n: destination) as arguments, & the
+// dispatch loop uses computed gotos when the compiler has them.
+// The long & phrase loads & stores reaching the DRAM skip the bus dispatch: they
+// are done straight in the memory space, with the same counting & the same
+// write hooks as the bus; the I/O & the ROM still go through the unit accessors.
+//
+
+#ifndef __RISCCORE_H__
+#define __RISCCORE_H__
+
+#include <stdint.h>
+#include "machine.h"
+#include "memory.h"
+#include "op.h"
+#include "perfcounters.h"
+#include "settings.h"
+#include "m68000/m68kinterface.h"
+
+#if defined(__GNUC__)
+#define RISC_COMPUTED_GOTO
+#endif
+
+#ifdef RISC_COMPUTED_GOTO
+#define RISC_OPCODE(index)	opcode##index:
+#define RISC_NEXT			goto retire
+#else
+#define RISC_OPCODE(index)	case index:
+#define RISC_NEXT			break
+#endif
+
+// Unit feature, selecting a handler at compile time
+template <bool feature> struct RISCFeature {};
+
+//
+// DRAM location of a size bytes access, or NULL if it must go through the bus
+// The first 2M is mirrored in the $0 - $7FFFFF range (see JaguarReadLong)
+//
+static inline uint8_t * RISCDRAM(uint32_t address, uint32_t size)
+{
+	if ((address & 0xFFFFFF) >= 0x800000)
+		return NULL;
+
+	uint32_t ramOffset = address & (vjs.DRAM_size - 1);
+
+	if (ramOffset > (vjs.DRAM_size - size))
+		return NULL;
+
+	return &jaguarMainRAM[ramOffset];
+}
+
+// DRAM accesses, done like the bus does them
+static inline uint32_t RISCDRAMReadLong(const uint8_t * dram, uint32_t address, uint32_t who)
+{
+	PERF_BUS(who, (address & 0xFFFFFF), 2, PERF_HEAT_READ);
+	return GetBig32(dram);
+}
+
+static inline uint64_t RISCDRAMReadPhrase(const uint8_t * dram, uint32_t address, uint32_t who)
+{
+	PERF_BUS(who, (address & 0xFFFFFF), 4, PERF_HEAT_READ);
+	return GetBig64(dram);
+}
+
+static inline void RISCDRAMWriteLong(uint8_t * dram, uint32_t address, uint32_t data, uint32_t who)
+{
+	uint32_t ramOffset = (uint32_t)(dram - jaguarMainRAM);
+
+	PERF_BUS(who, (address & 0xFFFFFF), 2, PERF_HEAT_WRITE);
+	SetBig32(dram, data);
+	M68K_CODE_WRITE(ramOffset);
+	OP_BUS_WRITE(ramOffset);
+	M68K_CODE_WRITE(ramOffset + 2);
+	OP_BUS_WRITE(ramOffset + 2);
+}
+
+static inline void RISCDRAMWritePhrase(uint8_t * dram, uint32_t address, uint64_t data, uint32_t who)
+{
+	uint32_t ramOffset = (uint32_t)(dram - jaguarMainRAM);
+
+	PERF_BUS(who, (address & 0xFFFFFF), 4, PERF_HEAT_WRITE);
+	SetBig64(dram, data);
+	M68K_CODE_WRITE(ramOffset);
+	OP_BUS_WRITE(ramOffset);
+	M68K_CODE_WRITE(ramOffset + 7);
+	OP_BUS_WRITE(ramOffset + 7);
+}
+
+template <class Unit>
+struct RISCCore
+{
+	typedef typename Unit::Accumulator Accumulator;
+
+	//
+	// Run the instructions of a time slice; returns the cycles left
+	//
+	static int32_t Run(int32_t cycles)
+	{
+#ifdef RISC_COMPUTED_GOTO
+		static void * const opcodeLabel[64] =
+		{
+			&&opcode0,  &&opcode1,  &&opcode2,  &&opcode3,  &&opcode4,  &&opcode5,  &&opcode6,  &&opcode7,
+			&&opcode8,  &&opcode9,  &&opcode10, &&opcode11, &&opcode12, &&opcode13, &&opcode14, &&opcode15,
+			&&opcode16, &&opcode17, &&opcode18, &&opcode19, &&opcode20, &&opcode21, &&opcode22, &&opcode23,
+			&&opcode24, &&opcode25, &&opcode26, &&opcode27, &&opcode28, &&opcode29, &&opcode30, &&opcode31,
+			&&opcode32, &&opcode33, &&opcode34, &&opcode35, &&opcode36, &&opcode37, &&opcode38, &&opcode39,
+			&&opcode40, &&opcode41, &&opcode42, &&opcode43, &&opcode44, &&opcode45, &&opcode46, &&opcode47,
+			&&opcode48, &&opcode49, &&opcode50, &&opcode51, &&opcode52, &&opcode53, &&opcode54, &&opcode55,
+			&&opcode56, &&opcode57, &&opcode58, &&opcode59, &&opcode60, &&opcode61, &&opcode62, &&opcode63
+		};
+#endif
+
+		while (cycles > 0 && Unit::Running())
+		{
+			uint32_t opcode = Unit::Fetch();
+			uint32_t pc = Unit::PC();
+			uint32_t index = opcode >> 10;
+			uint32_t m = (opcode >> 5) & 0x1F;
+			uint32_t n = opcode & 0x1F;
+			Unit::PC() += 2;
+
+#ifdef RISC_COMPUTED_GOTO
+			goto *opcodeLabel[index];
+#else
+			switch (index)
+			{
+#endif
+			RISC_OPCODE(0)	Add(m, n);			RISC_NEXT;
+			RISC_OPCODE(1)	AddC(m, n);			RISC_NEXT;
+			RISC_OPCODE(2)	AddQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(3)	AddQT(m, n);			RISC_NEXT;
+			RISC_OPCODE(4)	Sub(m, n);			RISC_NEXT;
+			RISC_OPCODE(5)	SubC(m, n);			RISC_NEXT;
+			RISC_OPCODE(6)	SubQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(7)	SubQT(m, n);			RISC_NEXT;
+			RISC_OPCODE(8)	Neg(n);				RISC_NEXT;
+			RISC_OPCODE(9)	And(m, n);			RISC_NEXT;
+			RISC_OPCODE(10)	Or(m, n);			RISC_NEXT;
+			RISC_OPCODE(11)	Xor(m, n);			RISC_NEXT;
+			RISC_OPCODE(12)	Not(n);				RISC_NEXT;
+			RISC_OPCODE(13)	BTst(m, n);			RISC_NEXT;
+			RISC_OPCODE(14)	BSet(m, n);			RISC_NEXT;
+			RISC_OPCODE(15)	BClr(m, n);			RISC_NEXT;
+			RISC_OPCODE(16)	Mult(m, n);			RISC_NEXT;
+			RISC_OPCODE(17)	IMult(m, n);			RISC_NEXT;
+			RISC_OPCODE(18)	IMultN(m, n);		RISC_NEXT;
+			RISC_OPCODE(19)	ResMac(n);			RISC_NEXT;
+			RISC_OPCODE(20)	IMacN(m, n);			RISC_NEXT;
+			RISC_OPCODE(21)	Div(m, n);			RISC_NEXT;
+			RISC_OPCODE(22)	Abs(n);				RISC_NEXT;
+			RISC_OPCODE(23)	Sh(m, n);			RISC_NEXT;
+			RISC_OPCODE(24)	ShLQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(25)	ShRQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(26)	ShA(m, n);			RISC_NEXT;
+			RISC_OPCODE(27)	ShARQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(28)	Ror(m, n);			RISC_NEXT;
+			RISC_OPCODE(29)	RorQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(30)	Cmp(m, n);			RISC_NEXT;
+			RISC_OPCODE(31)	CmpQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(32)	Opcode32(m, n, RISCFeature<Unit::hasModulo>());	RISC_NEXT;
+			RISC_OPCODE(33)	Opcode33(m, n, RISCFeature<Unit::hasSat16s>());	RISC_NEXT;
+			RISC_OPCODE(34)	Move(m, n);			RISC_NEXT;
+			RISC_OPCODE(35)	MoveQ(m, n);			RISC_NEXT;
+			RISC_OPCODE(36)	MoveTA(m, n);		RISC_NEXT;
+			RISC_OPCODE(37)	MoveFA(m, n);		RISC_NEXT;
+			RISC_OPCODE(38)	MoveI(n);			RISC_NEXT;
+			RISC_OPCODE(39)	Unit::LoadB(m, n);	RISC_NEXT;
+			RISC_OPCODE(40)	Unit::LoadW(m, n);	RISC_NEXT;
+			RISC_OPCODE(41)	Unit::Load(m, n);	RISC_NEXT;
+			RISC_OPCODE(42)	Opcode42(m, n, RISCFeature<Unit::hasSat16s>());	RISC_NEXT;
+			RISC_OPCODE(43)	Unit::LoadR14Indexed(m, n);	RISC_NEXT;
+			RISC_OPCODE(44)	Unit::LoadR15Indexed(m, n);	RISC_NEXT;
+			RISC_OPCODE(45)	Unit::StoreB(m, n);	RISC_NEXT;
+			RISC_OPCODE(46)	Unit::StoreW(m, n);	RISC_NEXT;
+			RISC_OPCODE(47)	Unit::Store(m, n);	RISC_NEXT;
+			RISC_OPCODE(48)	Opcode48(m, n, RISCFeature<Unit::hasMirror>());	RISC_NEXT;
+			RISC_OPCODE(49)	Unit::StoreR14Indexed(m, n);	RISC_NEXT;
+			RISC_OPCODE(50)	Unit::StoreR15Indexed(m, n);	RISC_NEXT;
+			RISC_OPCODE(51)	MovePC(n);			RISC_NEXT;
+			RISC_OPCODE(52)	Jump(m, n);			RISC_NEXT;
+			RISC_OPCODE(53)	JR(m, n);			RISC_NEXT;
+			RISC_OPCODE(54)	MMult(m, n);			RISC_NEXT;
+			RISC_OPCODE(55)	MToI(m, n);			RISC_NEXT;
+			RISC_OPCODE(56)	NormI(m, n);			RISC_NEXT;
+			RISC_OPCODE(57)							RISC_NEXT;		// NOP
+			RISC_OPCODE(58)	Unit::LoadR14RI(m, n);	RISC_NEXT;
+			RISC_OPCODE(59)	Unit::LoadR15RI(m, n);	RISC_NEXT;
+			RISC_OPCODE(60)	Unit::StoreR14RI(m, n);	RISC_NEXT;
+			RISC_OPCODE(61)	Unit::StoreR15RI(m, n);	RISC_NEXT;
+			RISC_OPCODE(62)	Opcode62(m, n, RISCFeature<Unit::hasSat16s>());	RISC_NEXT;
+			RISC_OPCODE(63)	Opcode63(m, n, RISCFeature<Unit::hasModulo>());	RISC_NEXT;
+#ifdef RISC_COMPUTED_GOTO
+retire:
+#else
+			}
+#endif
+			cycles = Unit::Retire(pc, index, cycles);
+		}
+
+		return cycles;
+	}
+
+private:
+	//
+	// Flags
+	//
+	static inline void SetZN(uint32_t r)
+	{
+		Unit::FlagN() = (r >> 31) & 0x01;
+		Unit::FlagZ() = (r == 0);
+	}
+
+	static inline void SetZNCAdd(uint32_t a, uint32_t b, uint32_t r)
+	{
+		SetZN(r);
+		Unit::FlagC() = (b > (uint32_t)~a);
+	}
+
+	static inline void SetZNCSub(uint32_t a, uint32_t b, uint32_t r)
+	{
+		SetZN(r);
+		Unit::FlagC() = (b > a);
+	}
+
+	//
+	// Arithmetic & logic
+	//
+	static inline void Add(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t res = reg[n] + reg[m];
+		SetZNCAdd(reg[n], reg[m], res);
+		reg[n] = res;
+	}
+
+	static inline void AddC(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t carry = Unit::FlagC();
+		uint32_t res = reg[n] + reg[m] + carry;
+		SetZNCAdd(reg[n] + carry, reg[m], res);
+		reg[n] = res;
+	}
+
+	static inline void AddQ(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = Unit::ConvertZero(m);
+		uint32_t res = reg[n] + r1;
+		SetZNCAdd(reg[n], r1, res);
+		reg[n] = res;
+	}
+
+	static inline void AddQT(uint32_t m, uint32_t n)
+	{
+		Unit::Reg()[n] += Unit::ConvertZero(m);
+	}
+
+	static inline void Sub(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t res = reg[n] - reg[m];
+		SetZNCSub(reg[n], reg[m], res);
+		reg[n] = res;
+	}
+
+	// Two's complement with inverted carry, the carry out being inverted too
+	static inline void SubC(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint64_t res = (uint64_t)reg[n] + (uint64_t)(reg[m] ^ 0xFFFFFFFF) + (Unit::FlagC() ^ 1);
+		Unit::FlagC() = ((res >> 32) & 0x01) ^ 1;
+		reg[n] = (res & 0xFFFFFFFF);
+		SetZN(reg[n]);
+	}
+
+	static inline void SubQ(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = Unit::ConvertZero(m);
+		uint32_t res = reg[n] - r1;
+		SetZNCSub(reg[n], r1, res);
+		reg[n] = res;
+	}
+
+	static inline void SubQT(uint32_t m, uint32_t n)
+	{
+		Unit::Reg()[n] -= Unit::ConvertZero(m);
+	}
+
+	static inline void Neg(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t res = -reg[n];
+		SetZNCSub(0, reg[n], res);
+		reg[n] = res;
+	}
+
+	static inline void Cmp(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		SetZNCSub(reg[n], reg[m], reg[n] - reg[m]);
+	}
+
+	// Signed immediate data
+	static inline void CmpQ(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = (uint32_t)((int32_t)(m << 27) >> 27);
+		SetZNCSub(reg[n], r1, reg[n] - r1);
+	}
+
+	static inline void And(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] &= reg[m];
+		SetZN(reg[n]);
+	}
+
+	static inline void Or(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] |= reg[m];
+		SetZN(reg[n]);
+	}
+
+	static inline void Xor(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] ^= reg[m];
+		SetZN(reg[n]);
+	}
+
+	static inline void Not(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] = ~reg[n];
+		SetZN(reg[n]);
+	}
+
+	static inline void BTst(uint32_t m, uint32_t n)
+	{
+		Unit::FlagZ() = (~Unit::Reg()[n] >> m) & 1;
+	}
+
+	static inline void BSet(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] |= (1 << m);
+		SetZN(reg[n]);
+	}
+
+	static inline void BClr(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] &= ~(1 << m);
+		SetZN(reg[n]);
+	}
+
+	static inline void Abs(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r = reg[n];
+
+		if (r == 0x80000000)
+		{
+			Unit::FlagN() = 1;
+
+			if (Unit::absSetsAllFlags)
+				Unit::FlagC() = 1, Unit::FlagZ() = 0;
+		}
+		else
+		{
+			Unit::FlagC() = r >> 31;
+			reg[n] = (r & 0x80000000 ? -r : r);
+			Unit::FlagN() = 0;
+			Unit::FlagZ() = (reg[n] == 0);
+		}
+	}
+
+	//
+	// Multiply, MAC & divide
+	//
+	static inline void Mult(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] = (uint16_t)reg[m] * (uint16_t)reg[n];
+		SetZN(reg[n]);
+	}
+
+	static inline void IMult(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] = (int16_t)reg[n] * (int16_t)reg[m];
+		SetZN(reg[n]);
+	}
+
+	static inline void IMultN(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		int32_t res = (int16_t)reg[n] * (int16_t)reg[m];
+		Unit::Acc() = (Accumulator)res;
+		SetZN(res);
+	}
+
+	static inline void IMacN(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		int32_t res = (int16_t)reg[m] * (int16_t)reg[n];
+		Unit::Acc() += (Accumulator)res;
+	}
+
+	static inline void ResMac(uint32_t n)
+	{
+		Unit::Reg()[n] = (uint32_t)Unit::Acc();
+	}
+
+	// Real algorithm, courtesy of SCPCD: NYAN!
+	static inline void Div(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t q = reg[n];
+		uint32_t r = 0;
+
+		// If 16.16 division, stuff top 16 bits of RN into remainder and put the
+		// bottom 16 of RN in top 16 of quotient
+		if (Unit::DivControl() & 0x01)
+			q <<= 16, r = reg[n] >> 16;
+
+		for(int i=0; i<32; i++)
+		{
+			uint32_t sign = r & 0x80000000;
+			r = (r << 1) | ((q >> 31) & 0x01);
+			r += (sign ? reg[m] : -reg[m]);
+			q = (q << 1) | (((~r) >> 31) & 0x01);
+		}
+
+		reg[n] = q;
+		Unit::Remain() = r;
+	}
+
+	static inline void MMult(uint32_t m, uint32_t n)
+	{
+		int count = Unit::MatrixControl() & 0x0F;				// Matrix width
+		uint32_t step = (Unit::MatrixControl() & 0x10 ? 4 * count : 4);	// Column or row stepping
+		uint32_t addr = Unit::PointerToMatrix();				// In the local RAM
+		uint32_t * alternateReg = Unit::AlternateReg();
+		int64_t accum = 0;
+
+		for(int i=0; i<count; i++)
+		{
+			int16_t a;
+
+			if (i & 0x01)
+				a = (int16_t)((alternateReg[m + (i >> 1)] >> 16) & 0xFFFF);
+			else
+				a = (int16_t)(alternateReg[m + (i >> 1)] & 0xFFFF);
+
+			int16_t b = (int16_t)Unit::ReadWord(addr + 2);
+			accum += a * b;
+			addr += step;
+		}
+
+		// Carry flag to do (out of the last add)
+		Unit::Reg()[n] = (int32_t)accum;
+		SetZN((uint32_t)(int32_t)accum);
+	}
+
+	//
+	// Shifts & rotates
+	//
+	// NB: SHLQ is the *only* instruction doing (32 - immediate data)
+	static inline void ShLQ(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		int32_t r1 = 32 - m;
+		uint32_t res = reg[n] << r1;
+		SetZN(res); Unit::FlagC() = (reg[n] >> 31) & 1;
+		reg[n] = res;
+	}
+
+	static inline void ShRQ(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		int32_t r1 = Unit::ConvertZero(m);
+		uint32_t res = reg[n] >> r1;
+		SetZN(res); Unit::FlagC() = reg[n] & 1;
+		reg[n] = res;
+	}
+
+	static inline void ShARQ(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t res = (int32_t)reg[n] >> Unit::ConvertZero(m);
+		SetZN(res); Unit::FlagC() = reg[n] & 0x01;
+		reg[n] = res;
+	}
+
+	// Negative RM shifts left
+	static inline void Sh(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+
+		if (reg[m] & 0x80000000)
+		{
+			Unit::FlagC() = reg[n] >> 31;
+			reg[n] = ((int32_t)reg[m] <= -32 ? 0 : reg[n] << -(int32_t)reg[m]);
+		}
+		else
+		{
+			Unit::FlagC() = reg[n] & 0x01;
+			reg[n] = (reg[m] >= 32 ? 0 : reg[n] >> reg[m]);
+		}
+
+		SetZN(reg[n]);
+	}
+
+	static inline void ShA(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t res;
+
+		if ((int32_t)reg[m] < 0)
+		{
+			res = ((int32_t)reg[m] <= -32) ? 0 : (reg[n] << -(int32_t)reg[m]);
+			Unit::FlagC() = reg[n] >> 31;
+		}
+		else
+		{
+			res = ((int32_t)reg[m] >= 32) ? ((int32_t)reg[n] >> 31) : ((int32_t)reg[n] >> (int32_t)reg[m]);
+			Unit::FlagC() = reg[n] & 0x01;
+		}
+
+		reg[n] = res;
+		SetZN(res);
+	}
+
+	static inline void Ror(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = reg[m] & 0x1F;
+		uint32_t res = (reg[n] >> r1) | (reg[n] << (32 - r1));
+		SetZN(res); Unit::FlagC() = (reg[n] >> 31) & 1;
+		reg[n] = res;
+	}
+
+	static inline void RorQ(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = Unit::ConvertZero(m);
+		uint32_t r2 = reg[n];
+		uint32_t res = (r2 >> r1) | (r2 << (32 - r1));
+		reg[n] = res;
+		SetZN(res); Unit::FlagC() = (r2 >> 31) & 0x01;
+	}
+
+	//
+	// Conversions & saturations
+	//
+	static inline void MToI(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r = reg[m];
+		reg[n] = (((int32_t)r >> 8) & 0xFF800000) | (r & 0x007FFFFF);
+		SetZN(reg[n]);
+	}
+
+	static inline void NormI(uint32_t m, uint32_t n)
+	{
+		uint32_t r = Unit::Reg()[m];
+		uint32_t res = 0;
+
+		if (r)
+		{
+			while ((r & 0xFFC00000) == 0)
+			{
+				r <<= 1;
+				res--;
+			}
+
+			while ((r & 0xFF800000) != 0)
+			{
+				r >>= 1;
+				res++;
+			}
+		}
+
+		Unit::Reg()[n] = res;
+		SetZN(res);
+	}
+
+	static inline void Sat8(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] = ((int32_t)reg[n] < 0 ? 0 : (reg[n] > 0xFF ? 0xFF : reg[n]));
+		SetZN(reg[n]);
+	}
+
+	static inline void Sat16(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] = ((int32_t)reg[n] < 0 ? 0 : (reg[n] > 0xFFFF ? 0xFFFF : reg[n]));
+		SetZN(reg[n]);
+	}
+
+	static inline void Sat24(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] = ((int32_t)reg[n] < 0 ? 0 : (reg[n] > 0xFFFFFF ? 0xFFFFFF : reg[n]));
+		SetZN(reg[n]);
+	}
+
+	static inline void Sat16S(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		int32_t r2 = reg[n];
+		uint32_t res = (r2 < -32768) ? -32768 : (r2 > 32767) ? 32767 : r2;
+		reg[n] = res;
+		SetZN(res);
+	}
+
+	// Saturated from the accumulator upper bits
+	static inline void Sat32S(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		int32_t r2 = reg[n];
+		int32_t temp = Unit::Acc() >> 32;
+		uint32_t res = (temp < -1) ? (int32_t)0x80000000 : (temp > 0) ? (int32_t)0x7FFFFFFF : r2;
+		reg[n] = res;
+		SetZN(res);
+	}
+
+	// RM selects between PACK (0) & UNPACK
+	static inline void Pack(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t val = reg[n];
+
+		if (m == 0)
+			reg[n] = ((val >> 10) & 0x0000F000) | ((val >> 5) & 0x00000F00) | (val & 0x000000FF);
+		else
+			reg[n] = ((val & 0x0000F000) << 10) | ((val & 0x00000F00) << 5) | (val & 0x000000FF);
+	}
+
+	static inline void Mirror(uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = reg[n];
+		reg[n] = (Unit::Mirror16(r1 & 0xFFFF) << 16) | Unit::Mirror16(r1 >> 16);
+		SetZN(reg[n]);
+	}
+
+	static inline void AddQMod(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = Unit::ConvertZero(m);
+		uint32_t r2 = reg[n];
+		uint32_t res = r2 + r1;
+		res = (res & ~Unit::Modulo()) | (r2 & Unit::Modulo());
+		reg[n] = res;
+		SetZNCAdd(r2, r1, res);
+	}
+
+	static inline void SubQMod(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		uint32_t r1 = Unit::ConvertZero(m);
+		uint32_t r2 = reg[n];
+		uint32_t res = r2 - r1;
+		res = (res & ~Unit::Modulo()) | (r2 & Unit::Modulo());
+		reg[n] = res;
+		SetZNCSub(r2, r1, res);
+	}
+
+	//
+	// Moves
+	//
+	static inline void Move(uint32_t m, uint32_t n)
+	{
+		uint32_t * reg = Unit::Reg();
+		reg[n] = reg[m];
+	}
+
+	static inline void MoveQ(uint32_t m, uint32_t n)
+	{
+		Unit::Reg()[n] = m;
+	}
+
+	static inline void MoveTA(uint32_t m, uint32_t n)
+	{
+		Unit::AlternateReg()[n] = Unit::Reg()[m];
+	}
+
+	static inline void MoveFA(uint32_t m, uint32_t n)
+	{
+		Unit::Reg()[n] = Unit::AlternateReg()[m];
+	}
+
+	// Followed by the 32-bit value in LSW / MSW format
+	static inline void MoveI(uint32_t n)
+	{
+		uint32_t pc = Unit::PC();
+		Unit::Reg()[n] = (uint32_t)Unit::ReadWord(pc) | ((uint32_t)Unit::ReadWord(pc + 2) << 16);
+		Unit::PC() += 4;
+	}
+
+	// PC of the instruction itself
+	static inline void MovePC(uint32_t n)
+	{
+		Unit::Reg()[n] = Unit::PC() - 2;
+	}
+
+	//
+	// Branches, the delay slot being run before the PC is set
+	//
+	static inline bool Condition(uint32_t cc)
+	{
+		uint32_t flags = (Unit::FlagN() << 2) | (Unit::FlagC() << 1) | Unit::FlagZ();
+		return Unit::BranchCondition(cc, flags);
+	}
+
+	static inline void Jump(uint32_t m, uint32_t n)
+	{
+		if (Condition(n))
+		{
+			uint32_t delayedPC = Unit::Reg()[m];
+			Unit::DelaySlot();
+			Unit::PC() = delayedPC;
+		}
+	}
+
+	static inline void JR(uint32_t m, uint32_t n)
+	{
+		if (Condition(n))
+		{
+			int32_t offset = (m & 0x10 ? 0xFFFFFFF0 | m : m);		// Sign extend the offset
+			uint32_t delayedPC = Unit::PC() + (offset * 2);
+			Unit::DelaySlot();
+			Unit::PC() = delayedPC;
+		}
+	}
+
+	//
+	// Opcodes told apart by the unit features
+	//
+	static inline void Opcode32(uint32_t m, uint32_t n, RISCFeature<true>) { SubQMod(m, n); }
+	static inline void Opcode32(uint32_t, uint32_t n, RISCFeature<false>) { Sat8(n); }
+	static inline void Opcode33(uint32_t, uint32_t n, RISCFeature<true>) { Sat16S(n); }
+	static inline void Opcode33(uint32_t, uint32_t n, RISCFeature<false>) { Sat16(n); }
+	static inline void Opcode42(uint32_t, uint32_t n, RISCFeature<true>) { Sat32S(n); }
+	static inline void Opcode42(uint32_t m, uint32_t n, RISCFeature<false>) { Unit::LoadP(m, n); }
+	static inline void Opcode48(uint32_t, uint32_t n, RISCFeature<true>) { Mirror(n); }
+	static inline void Opcode48(uint32_t m, uint32_t n, RISCFeature<false>) { Unit::StoreP(m, n); }
+	static inline void Opcode62(uint32_t m, uint32_t n, RISCFeature<true>) { Unit::Illegal(m, n); }
+	static inline void Opcode62(uint32_t, uint32_t n, RISCFeature<false>) { Sat24(n); }
+	static inline void Opcode63(uint32_t m, uint32_t n, RISCFeature<true>) { AddQMod(m, n); }
+	static inline void Opcode63(uint32_t m, uint32_t n, RISCFeature<false>) { Pack(m, n); }
+};
+
+#undef RISC_OPCODE
+#undef RISC_NEXT
+
+#endif	// __RISCCORE_H__
@@ -0,0 +1,365 @@
+//
+// savedata.cpp - Save data persistence
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Files copies kept in the machine context
+//
+// EEPROM & Memory Track data are kept in the machine, in a copy of their files,
+// marked as dirty by the emulation writes. A host thread writes the dirty files
+// once a burst of writes is over (SAVEDATA_DELAY), in a temporary file renamed
+// over the previous one, so a crash never leaves a truncated file behind. Without
+// SDL, the files are written at once.
+//
+
+#include "savedata.h"
+
+#ifndef NO_SDL
+#include <SDL.h>								// For the host thread
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if _WIN32 || _WIN64
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#include "log.h"
+#include "machine.h"
+
+
+// Files copies of the current machine
+#define saveFiles				(jaguarMachine->saveData.files)
+
+// The host thread & its locks are shared by all the machines: one thread is enough to
+// write their files, & each of them may be done before the others. It writes the files
+// of the machines listed, which keep the copies of their own files.
+#ifndef NO_SDL
+static SDL_Thread * saveThread = NULL;
+static SDL_mutex * saveMutex = NULL;			// Protects the files copies & the machines list
+static SDL_mutex * saveWriteMutex = NULL;		// Files written by a single thread at a time
+static SDL_cond * saveCond = NULL;
+static bool saveQuit = false;
+static bool saveDirty = false;
+static SaveDataState * saveStates = NULL;		// Machines having files copies
+#endif
+
+// Private function prototypes
+static void SaveDataWrite(SaveDataState * state);
+static bool SaveDataWriteFile(const char * filename, const uint8_t * data, uint32_t size);
+#ifndef NO_SDL
+static int SaveDataThreadFunc(void *);
+#endif
+
+
+//
+// Create the locks, from the thread creating the machines
+//
+void SaveDataInit(void)
+{
+#ifndef NO_SDL
+	if (saveMutex)
+		return;
+
+	saveMutex = SDL_CreateMutex();
+	saveWriteMutex = SDL_CreateMutex();
+	saveCond = SDL_CreateCond();
+#endif
+}
+
+
+//
+// Get the entry of a file, a new one being filled with the whole data
+//
+static SaveDataFile * SaveDataFind(const char * filename, const uint8_t * data, uint32_t size)
+{
+	SaveDataFile * file = NULL;
+
+	for(int i=0; i<SAVEDATA_MAX_FILES; i++)
+	{
+		if (!strcmp(saveFiles[i].filename, filename))
+		{
+			if (saveFiles[i].size == size)
+				return &saveFiles[i];
+
+			file = &saveFiles[i];
+			break;
+		}
+	}
+
+	// Free entry, or one already written
+	for(int i=0; !file && (i<SAVEDATA_MAX_FILES); i++)
+	{
+		if (!saveFiles[i].filename[0] || !saveFiles[i].dirty)
+			file = &saveFiles[i];
+	}
+
+	if (!file)
+		return NULL;
+
+	uint8_t * copy = (uint8_t *)realloc(file->data, size);
+
+	if (!copy)
+		return NULL;
+
+	strncpy(file->filename, filename, MAX_PATH - 1);
+	file->filename[MAX_PATH - 1] = 0;
+	file->data = copy;
+	file->size = size;
+	memcpy(file->data, data, size);
+
+	return file;
+}
+
+
+//
+// The bytes from offset to offset + length have been written in the file data of the
+// current machine
+//
+void SaveDataUpdate(const char * filename, const uint8_t * data, uint32_t size, uint32_t offset, uint32_t length)
+{
+	if (!filename[0])
+		return;
+
+#ifndef NO_SDL
+	SDL_LockMutex(saveMutex);
+#endif
+	SaveDataFile * file = SaveDataFind(filename, data, size);
+
+	if (!file)
+	{
+#ifndef NO_SDL
+		SDL_UnlockMutex(saveMutex);
+#endif
+		WriteLog("SaveData: No room to keep \"%s\", written at once\n", filename);
+		SaveDataWriteFile(filename, data, size);
+		return;
+	}
+
+	memcpy(file->data + offset, data + offset, length);
+	file->dirty = true;
+#ifndef NO_SDL
+	if (!jaguarMachine->saveData.listed)
+	{
+		jaguarMachine->saveData.next = saveStates;
+		jaguarMachine->saveData.listed = true;
+		saveStates = &jaguarMachine->saveData;
+	}
+
+	if (!saveThread && !(saveThread = SDL_CreateThread(SaveDataThreadFunc, NULL)))
+		WriteLog("SaveData: Unable to start the host thread (%s), files will be written at once\n", SDL_GetError());
+
+	// The thread waits for the end of the writes burst from the first one
+	if (!saveDirty)
+	{
+		saveDirty = true;
+		SDL_CondSignal(saveCond);
+	}
+
+	SDL_UnlockMutex(saveMutex);
+
+	if (!saveThread)
+#endif
+		SaveDataFlush();
+}
+
+
+//
+// Write all the dirty files of the current machine now
+//
+void SaveDataFlush(void)
+{
+	SaveDataWrite(&jaguarMachine->saveData);
+}
+
+
+//
+// Write the dirty files of a machine, or of all the machines listed (NULL)
+//
+static void SaveDataWrite(SaveDataState * state)
+{
+	SaveDataFile * written;
+	int count = 0, machines = 1;
+
+#ifndef NO_SDL
+	SDL_LockMutex(saveWriteMutex);
+	SDL_LockMutex(saveMutex);
+
+	if (!state)
+	{
+		saveDirty = false;
+		machines = 0;
+
+		for(SaveDataState * listed=saveStates; listed; listed=listed->next)
+			machines++;
+	}
+#endif
+
+	if ((written = (SaveDataFile *)malloc(machines * SAVEDATA_MAX_FILES * sizeof(SaveDataFile))))
+	{
+		// Files are copied, so the emulation can go on writing them meanwhile
+#ifndef NO_SDL
+		for(SaveDataState * files=(state ? state : saveStates); files; files=(state ? NULL : files->next))
+#else
+		SaveDataState * files = state;
+#endif
+		{
+			for(int i=0; i<SAVEDATA_MAX_FILES; i++)
+			{
+				if (!files->files[i].dirty)
+					continue;
+
+				written[count] = files->files[i];
+
+				if ((written[count].data = (uint8_t *)malloc(files->files[i].size)))
+				{
+					memcpy(written[count++].data, files->files[i].data, files->files[i].size);
+					files->files[i].dirty = false;
+				}
+			}
+		}
+	}
+
+#ifndef NO_SDL
+	SDL_UnlockMutex(saveMutex);
+#endif
+
+	for(int i=0; i<count; i++)
+	{
+		SaveDataWriteFile(written[i].filename, written[i].data, written[i].size);
+		free(written[i].data);
+	}
+
+	free(written);
+#ifndef NO_SDL
+	SDL_UnlockMutex(saveWriteMutex);
+#endif
+}
+
+
+//
+// Write what is left for the current machine, and free its files copies
+// The host thread is stopped once no machine has files copies anymore
+//
+void SaveDataDone(void)
+{
+	SaveDataFlush();
+
+#ifndef NO_SDL
+	SDL_LockMutex(saveMutex);
+
+	for(SaveDataState ** listed=&saveStates; *listed; listed=&(*listed)->next)
+	{
+		if (*listed == &jaguarMachine->saveData)
+		{
+			*listed = jaguarMachine->saveData.next;
+			jaguarMachine->saveData.listed = false;
+			break;
+		}
+	}
+
+	SDL_Thread * thread = (saveStates ? NULL : saveThread);
+
+	if (thread)
+	{
+		saveQuit = true;
+		SDL_CondSignal(saveCond);
+	}
+
+	SDL_UnlockMutex(saveMutex);
+
+	if (thread)
+	{
+		SDL_WaitThread(thread, NULL);
+		SDL_LockMutex(saveMutex);
+		saveThread = NULL;
+		saveQuit = false;
+		SDL_UnlockMutex(saveMutex);
+	}
+#endif
+
+	for(int i=0; i<SAVEDATA_MAX_FILES; i++)
+	{
+		free(saveFiles[i].data);
+		memset(&saveFiles[i], 0, sizeof(SaveDataFile));
+	}
+}
+
+
+#ifndef NO_SDL
+//
+// Host thread: write the dirty files once no more writes come in
+//
+static int SaveDataThreadFunc(void *)
+{
+	SDL_LockMutex(saveMutex);
+
+	while (!saveQuit)
+	{
+		if (!saveDirty)
+		{
+			SDL_CondWait(saveCond, saveMutex);
+			continue;
+		}
+
+		// Writes done meanwhile are written along
+		SDL_CondWaitTimeout(saveCond, saveMutex, SAVEDATA_DELAY);
+
+		if (saveQuit)
+			break;
+
+		SDL_UnlockMutex(saveMutex);
+		SaveDataWrite(NULL);
+		SDL_LockMutex(saveMutex);
+	}
+
+	SDL_UnlockMutex(saveMutex);
+	return 0;
+}
+#endif
+
+
+//
+// Write a file in a temporary one, flushed to the disk, then renamed over the file
+//
+static bool SaveDataWriteFile(const char * filename, const uint8_t * data, uint32_t size)
+{
+	char tempFilename[MAX_PATH + 4];
+	snprintf(tempFilename, sizeof(tempFilename), "%s.tmp", filename);
+	FILE * fp = fopen(tempFilename, "wb");
+
+	if (!fp)
+	{
+		WriteLog("SaveData: Could not create file \"%s\"!\n", tempFilename);
+		return false;
+	}
+
+	bool ok = (fwrite(data, 1, size, fp) == size) && !fflush(fp);
+#if _WIN32 || _WIN64
+	ok = ok && !_commit(_fileno(fp));
+#else
+	ok = ok && !fsync(fileno(fp));
+#endif
+	ok = !fclose(fp) && ok;
+
+#if _WIN32 || _WIN64
+	ok = ok && MoveFileExA(tempFilename, filename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	ok = ok && !rename(tempFilename, filename);
+#endif
+
+	if (!ok)
+	{
+		WriteLog("SaveData: Could not write file \"%s\"!\n", filename);
+		remove(tempFilename);
+	}
+
+	return ok;
+}
@@ -0,0 +1,35 @@
+//
+// savedata.h: Save data persistence
+//
+
+#ifndef __SAVEDATA_H__
+#define __SAVEDATA_H__
+
+#include <stdint.h>
+#include "settings.h"							// For MAX_PATH
+
+#define SAVEDATA_MAX_FILES	8				// Files written at the same time
+#define SAVEDATA_DELAY		500				// Writes coalesced before a file is written (ms)
+
+struct SaveDataFile
+{
+	char filename[MAX_PATH];					// Empty for a free entry
+	uint8_t * data;								// Copy of the file contents
+	uint32_t size;
+	bool dirty;
+};
+
+// Copies of the files of a machine, listed for the host thread while it has some
+struct SaveDataState
+{
+	SaveDataFile files[SAVEDATA_MAX_FILES];
+	SaveDataState * next;
+	bool listed;
+};
+
+void SaveDataInit(void);
+void SaveDataUpdate(const char * filename, const uint8_t * data, uint32_t size, uint32_t offset, uint32_t length);
+void SaveDataFlush(void);
+void SaveDataDone(void);
+
+#endif	// __SAVEDATA_H__
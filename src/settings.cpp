@@ -12,16 +12,20 @@
 // JLH  01/16/2010  Created this log
 // JLH  02/23/2013  Finally removed commented out stuff :-P
 // JPM  09/08/2017  Added erase settings functions
+// JPM   Oct./2026  Settings functions are not available in a build without Qt (NO_QT)
 //
 
 #include "settings.h"
+#ifndef NO_QT
 #include <QtCore/QSettings>
+#endif
 
 // Global variables
 
 VJSettings vjs;
 
 
+#ifndef NO_QT
 const char *ES[] = {	"", "all", "ui", "alpine", "debugger"	};
 
 
@@ -55,4 +59,5 @@ bool EraseSettings(char *Setting)
 
 	return false;
 }
+#endif
 
@@ -11,6 +11,14 @@
 // JPM  10/10/2018  Added search paths in settings
 // JPM  04/06/2019  Added ELF sections check
 //  RG   Jan./2021  Linux build fix
+// JPM   Oct./2026  Added threaded GPU & rendering settings
+// JPM   Oct./2026  Added audio & video capture setting
+// JPM   Oct./2026  Added idle loops skip setting
+// JPM   Oct./2026  Added performance counters endpoint & time series settings
+// JPM   Oct./2026  Added execution trace settings
+// JPM   Oct./2026  Added bus heatmap setting
+// JPM   Oct./2026  Added threaded OP setting
+// JPM   Oct./2026  Added frames pacing & turbo settings
 //
 
 #ifndef __SETTINGS_H__
@@ -68,15 +76,23 @@ struct VJSettings
 	bool useRetailBIOS;											// Use of Retail BIOS
 	bool useDevBIOS;											// Use of Development BIOS
 	bool GPUEnabled;											// Use of GPU
+	bool threadedGPU;											// GPU runs on its own host thread
+	bool threadedOP;											// OP renders the next line ahead on its own host thread
 	bool DSPEnabled;											// Use of DSP
 	bool usePipelinedDSP;
+	bool idleSkip;											// Idle & spin-wait loops fast-forwarded to the next event
+	bool trace;													// Execution trace recorded
 	bool fullscreen;											// Emulator in full screen mode so video output display only
 	bool useOpenGL;												// OpenGL support (always 'true')
+	bool threadedRendering;										// Video output is displayed from its own thread
+	uint32_t captureType;										// Audio & video capture started with the emulation
 	uint32_t glFilter;
 	bool hardwareTypeAlpine;									// Alpine mode
 	bool softTypeDebugger;										// Soft type debugger mode
 	bool audioEnabled;
 	uint32_t frameSkip;
+	uint32_t frameSync;											// Frames paced by the host clock or by the host audio (FS_*)
+	uint32_t turbo;												// Emulation speed multiplier (0 for uncapped)
 	uint32_t renderType;
 	uint32_t refresh;
 	bool allowM68KExceptionCatch;								// Allow M68K exception catch
@@ -108,12 +124,24 @@ struct VJSettings
 	char debuggerROMPath[MAX_PATH];
 	char absROMPath[MAX_PATH];
 	char screenshotPath[MAX_PATH];
+	char statsSocket[MAX_PATH];									// Performance counters endpoint (--stats-socket)
+	char statsCSV[MAX_PATH];									// Performance counters time series (--stats-csv)
+	char traceDump[MAX_PATH];									// Execution trace written on a crash or a breakpoint (--trace-dump)
+	char heatmapFile[MAX_PATH];									// Bus heatmap written at the end (--heatmap)
 	char sourcefilesearchPaths[4096];
 };
 
 // Render types
 enum { RT_NORMAL = 0, RT_TV = 1 };
 
+// Capture types
+enum { CT_NONE = 0, CT_Y4M = 1, CT_PNG = 2 };
+
+// Frames pacing
+enum { FS_CLOCK = 0, FS_AUDIO = 1 };
+
+#define TURBO_MAX		8									// Highest speed multiplier
+
 // Jaguar models
 enum { JAG_NULL_SERIES, JAG_K_SERIES, JAG_M_SERIES };
 
@@ -0,0 +1,142 @@
+//
+// coretest.cpp - Cores created & destroyed by two threads
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// Two threads create, run & destroy cores in turn, while the other one's core is
+// running: each core must show the frame of a core run alone, & a core with other
+// flags must be refused while the cores remain. The GPU & OP host threads, the
+// execution trace & the bus heatmap are used, to have the state shared by the
+// machines set up & torn down with them. Built & run by:
+// make -f jaguarcore.mak STANDALONE=1 test
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include "jaguarcore.h"
+#include "settings.h"
+
+#define TEST_FRAMES		60
+#define TEST_ROUNDS		3
+
+
+//
+// Hash of the frame shown
+//
+static uint64_t FrameHash(jaguarcore * core)
+{
+	unsigned int width, height, pitch;
+	const uint32_t * frame = jaguarcore_get_frame(core, &width, &height, &pitch);
+	uint64_t hash = 1469598103934665603ULL;
+
+	for(unsigned int y=0; y<height; y++)
+	{
+		for(unsigned int x=0; x<width; x++)
+			hash = (hash ^ frame[(y * pitch) + x]) * 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+
+//
+// Run a core for some frames; returns the hash of the last one, or 0 if the core
+// could not be created
+//
+static uint64_t RunCore(unsigned int frames, const char * traceFile)
+{
+	jaguarcore * core = jaguarcore_create(JAGUARCORE_NTSC);
+
+	if (!core)
+		return 0;
+
+	for(unsigned int i=0; i<frames; i++)
+		jaguarcore_run_frame(core);
+
+	uint64_t hash = FrameHash(core);
+
+	if (traceFile && !jaguarcore_dump_trace(core, traceFile))
+		hash = 0;
+
+	jaguarcore_destroy(core);
+	return hash;
+}
+
+
+struct TestThread
+{
+	unsigned int id;
+	uint64_t expected;
+	unsigned int failures;
+};
+
+
+//
+// Rounds of a thread; the second one starts with a shorter core, to have its
+// cores created & destroyed while the first thread ones are running
+//
+static void TestThreadRun(TestThread * test)
+{
+	char traceFile[64];
+	snprintf(traceFile, sizeof(traceFile), "obj/coretest%u.trace", test->id);
+
+	if (test->id && !RunCore(TEST_FRAMES / 2, NULL))
+		test->failures++;
+
+	for(unsigned int i=0; i<TEST_ROUNDS; i++)
+	{
+		uint64_t hash = RunCore(TEST_FRAMES, traceFile);
+
+		if (hash != test->expected)
+		{
+			printf("Thread %u, round %u: frame hash %016llX instead of %016llX\n", test->id, i, (unsigned long long)hash, (unsigned long long)test->expected);
+			test->failures++;
+		}
+	}
+}
+
+
+int main(int argc, char * argv[])
+{
+	vjs.threadedGPU = true;
+	vjs.threadedOP = true;
+	strcpy(vjs.heatmapFile, "obj/coretest.heatmap");
+
+	uint64_t expected = RunCore(TEST_FRAMES, NULL);
+
+	if (!expected)
+	{
+		printf("Could not create a core!\n");
+		return 1;
+	}
+
+	TestThread tests[2] = { { 0, expected, 0 }, { 1, expected, 0 } };
+	std::thread thread0(TestThreadRun, &tests[0]);
+	std::thread thread1(TestThreadRun, &tests[1]);
+
+	// Other flags are refused while a core remains
+	jaguarcore * core = jaguarcore_create(JAGUARCORE_NTSC);
+	unsigned int failures = 0;
+
+	if (!core || jaguarcore_create(JAGUARCORE_PAL))
+	{
+		printf("A core with other flags has been created along the NTSC ones!\n");
+		failures++;
+	}
+
+	jaguarcore_destroy(core);
+	thread0.join();
+	thread1.join();
+	failures += tests[0].failures + tests[1].failures;
+
+	printf("coretest: %u cores created & destroyed, %u failures\n", 3 + (2 * TEST_ROUNDS), failures);
+	return (failures ? 1 : 0);
+}
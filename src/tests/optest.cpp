@@ -0,0 +1,216 @@
+//
+// optest.cpp - Lines rendered ahead on the OP host thread
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// The lines of a frame shown by the boot ROM are rendered ahead, each one started
+// after the previous one has been taken as TOMExecHalfline() does, and must give
+// the TOM state & the RAM of the lines rendered when reached. A line rendered
+// ahead must be dropped when the registers or the CLUT are written meanwhile, when
+// a page it has read is written, or when another line is reached. Built & run by:
+// make -f jaguarcore.mak STANDALONE=1 test
+// The OP host thread needs SDL, so the test is skipped by the self-contained
+// library; it runs when linked with the objects of an SDL build.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jaguar.h"
+#include "jaguarcore.h"
+#include "machine.h"
+#include "memory.h"
+#include "op.h"
+#include "settings.h"
+#include "tom.h"
+
+#define TEST_FRAMES		60
+#define TEST_LBUF		0x1800					// Line buffer the OP writes
+#define TEST_LBUF_END	0x2000
+
+#ifndef NO_SDL
+// State of the machine the lines change
+struct OPTestState
+{
+	uint8_t * dram;
+	TOMState tom;
+};
+
+static unsigned int failures = 0;
+
+
+static void SaveState(OPTestState * state)
+{
+	memcpy(state->dram, jaguarMainRAM, vjs.DRAM_size);
+	state->tom = jaguarMachine->tom;
+}
+
+
+static void RestoreState(const OPTestState * state)
+{
+	memcpy(jaguarMainRAM, state->dram, vjs.DRAM_size);
+	jaguarMachine->tom = state->tom;
+}
+
+
+//
+// Check the current TOM state, & the RAM if it is given, are the expected ones; the
+// first difference is shown
+//
+static void CheckState(const TOMState * expectedTOM, const uint8_t * expectedDRAM, int halfline)
+{
+	const uint8_t * tom = (const uint8_t *)&jaguarMachine->tom, * expected = (const uint8_t *)expectedTOM;
+
+	for(uint32_t i=0; i<sizeof(TOMState); i++)
+	{
+		if (tom[i] != expected[i])
+		{
+			printf("Halfline %i: TOM state byte $%X is $%02X instead of $%02X\n", halfline, i, tom[i], expected[i]);
+			failures++;
+			return;
+		}
+	}
+
+	for(uint32_t i=0; expectedDRAM && (i<vjs.DRAM_size); i++)
+	{
+		if (jaguarMainRAM[i] != expectedDRAM[i])
+		{
+			printf("Halfline %i: RAM byte $%06X is $%02X instead of $%02X\n", halfline, i, jaguarMainRAM[i], expectedDRAM[i]);
+			failures++;
+			return;
+		}
+	}
+}
+
+
+//
+// Check a line rendered ahead is dropped; the write is done after it is started
+//
+static void CheckDropped(const OPTestState * start, int halfline, int reached, const char * write, uint32_t address)
+{
+	RestoreState(start);
+	OPSpeculationCancel();
+	OPSpeculationStart(halfline);
+
+	if (address >= 0xF00000)
+		TOMWriteWord(address, TOMReadWord(address, M68K), M68K);
+	else if (address)
+		JaguarWriteLong(address, JaguarReadLong(address, M68K), M68K);
+
+	if (OPSpeculationCommit(reached))
+	{
+		printf("Halfline %i: Line rendered ahead taken after %s\n", halfline, write);
+		failures++;
+	}
+}
+#endif
+
+
+int main(int argc, char * argv[])
+{
+#ifdef NO_SDL
+	printf("optest: skipped, there is no OP host thread without SDL\n");
+	return 0;
+#else
+	jaguarcore * core = jaguarcore_create(JAGUARCORE_NTSC);
+
+	if (!core)
+	{
+		printf("Could not create a core!\n");
+		return 1;
+	}
+
+	for(int i=0; i<TEST_FRAMES; i++)
+		jaguarcore_run_frame(core);
+
+	// Lines of the frame, as TOMExecHalfline() renders them, up to the last halfline
+	int startingHalfline = GET16(tomRam8, 0x46), endingHalfline = GET16(tomRam8, 0x48);
+
+	if (endingHalfline > GET16(tomRam8, 0x3E))
+	{
+		startingHalfline = 0;
+		endingHalfline = GET16(tomRam8, 0x3E);
+	}
+
+	int lines = (endingHalfline - startingHalfline + 1) / 2;
+	TOMState * rendered = (TOMState *)malloc(lines * sizeof(TOMState));
+	OPTestState start, end;
+	start.dram = (uint8_t *)malloc(vjs.DRAM_size);
+	end.dram = (uint8_t *)malloc(vjs.DRAM_size);
+
+	// Lines rendered when reached; TOM RAM comes first in the TOM state
+	SaveState(&start);
+	const uint8_t * startLBuf = (const uint8_t *)&start.tom + TEST_LBUF;
+	int drawn = 0;
+
+	for(int i=0; i<lines; i++)
+	{
+		TOMLineBufferRender(startingHalfline + (i * 2));
+		rendered[i] = jaguarMachine->tom;
+
+		if (memcmp(&tomRam8[TEST_LBUF], startLBuf, TEST_LBUF_END - TEST_LBUF))
+			drawn++;
+	}
+
+	SaveState(&end);
+
+	if (!drawn)
+	{
+		printf("No object has been drawn in the %i lines\n", lines);
+		failures++;
+	}
+
+	// Same lines rendered ahead; the line buffers are kept between two lines
+	RestoreState(&start);
+	OPSpeculationCancel();
+	OPSpeculationStart(startingHalfline);
+
+	for(int i=0; (i<lines) && !failures; i++)
+	{
+		int halfline = startingHalfline + (i * 2);
+
+		if (!OPSpeculationCommit(halfline))
+		{
+			printf("Halfline %i: Line rendered ahead dropped without any write\n", halfline);
+			failures++;
+			break;
+		}
+
+		if ((halfline + 2) < endingHalfline)
+			OPSpeculationStart(halfline + 2);
+
+		CheckState(&rendered[i], ((i + 1) == lines ? end.dram : NULL), halfline);
+	}
+
+	// Writes done while the line is rendered ahead
+	uint32_t listPage = OPGetListPointer();
+
+	for(int i=0; i<lines; i+=16)
+	{
+		int halfline = startingHalfline + (i * 2);
+		CheckDropped(&start, halfline, halfline, "a BG write", 0xF00058);
+		CheckDropped(&start, halfline, halfline, "a CLUT write", 0xF00400);
+		CheckDropped(&start, halfline, halfline, "a VMODE write", 0xF00028);
+		CheckDropped(&start, halfline, halfline, "an object list write", listPage);
+		CheckDropped(&start, halfline, halfline + 2, "another line reached", 0);
+	}
+
+	RestoreState(&start);
+	OPSpeculationCancel();
+	jaguarcore_destroy(core);
+
+	free(rendered);
+	free(start.dram);
+	free(end.dram);
+
+	printf("optest: %i lines rendered ahead, %i drawn, %u failures\n", lines, drawn, failures);
+	return (failures ? 1 : 0);
+#endif
+}
@@ -0,0 +1,229 @@
+//
+// riscdramtest.cpp - GPU & DSP DRAM loads & stores, straight & through the bus
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// The long & phrase loads & stores the GPU & the DSP do straight in the DRAM (see
+// risccore.h) must read & write the same bytes as the GPU & DSP accessors going
+// through the bus, count the same bus accesses, & mark the same pages for the OP &
+// the same lines for the 68K code; the addresses out of the DRAM, or an access
+// going past its end, must be left to the bus. Built & run by:
+// make -f jaguarcore.mak STANDALONE=1 test
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dsp.h"
+#include "gpu.h"
+#include "jaguarcore.h"
+#include "memory.h"
+#include "risccore.h"
+
+// Addresses tried, & the accesses done straight in the DRAM at each of them
+struct RISCDRAMTest
+{
+	uint32_t address;
+	bool longStraight;
+	bool phraseStraight;
+};
+
+static const RISCDRAMTest tests[] = {
+	{ 0x00000000, true, true },
+	{ 0x00001000, true, true },
+	{ 0x00001001, true, true },					// The GPU doesn't align its DRAM accesses
+	{ 0x00001002, true, true },
+	{ 0x00001FFC, true, true },					// Phrase across two OP pages
+	{ 0x000FFFFC, true, true },
+	{ 0x001FFFF8, true, true },
+	{ 0x001FFFFC, true, false },				// Phrase going past the DRAM end
+	{ 0x001FFFFE, false, false },
+	{ 0x00200000, true, true },					// Mirrors of the DRAM
+	{ 0x005ABCD4, true, true },
+	{ 0x007FFFF8, true, true },
+	{ 0x007FFFFC, true, false },
+	{ 0xFF001234, true, true },					// Upper byte left out
+	{ 0x00800000, false, false },				// ROM
+	{ 0x00F03000, false, false },				// GPU RAM
+	{ 0x00F1B000, false, false }				// DSP RAM
+};
+
+// Changes a DRAM access has done
+struct RISCDRAMAccess
+{
+	uint64_t data;
+	uint64_t busAccesses[PERF_MASTERS][PERF_BUS_REGIONS];
+	uint8_t opPages[OP_PAGES];
+	unsigned int codeLines[2];
+	uint8_t * dram;
+};
+
+static unsigned int failures = 0;
+static uint8_t * dramStart;
+static uint8_t opPages[OP_PAGES];
+
+
+//
+// Set the DRAM & the counters back, the 68K code lines of the access being marked
+//
+static void StartAccess(uint32_t ramOffset)
+{
+	memcpy(jaguarMainRAM, dramStart, vjs.DRAM_size);
+	memset(jaguarMachine->perf.counters.busAccesses, 0, sizeof(jaguarMachine->perf.counters.busAccesses));
+	memset(opPages, 0, sizeof(opPages));
+	jaguarMachine->op.dirtyPages = opPages;
+	m68kCodeLines[ramOffset >> M68K_CODE_LINE_SHIFT] = 1;
+	m68kCodeLines[(ramOffset + 7) >> M68K_CODE_LINE_SHIFT] = 1;
+}
+
+
+static void EndAccess(RISCDRAMAccess * access, uint32_t ramOffset, uint64_t data)
+{
+	access->data = data;
+	memcpy(access->busAccesses, jaguarMachine->perf.counters.busAccesses, sizeof(access->busAccesses));
+	memcpy(access->opPages, opPages, sizeof(opPages));
+	access->codeLines[0] = m68kCodeLines[ramOffset >> M68K_CODE_LINE_SHIFT];
+	access->codeLines[1] = m68kCodeLines[(ramOffset + 7) >> M68K_CODE_LINE_SHIFT];
+	memcpy(access->dram, jaguarMainRAM, vjs.DRAM_size);
+	jaguarMachine->op.dirtyPages = NULL;
+}
+
+
+static void CheckAccess(const RISCDRAMAccess * straight, const RISCDRAMAccess * bus, uint32_t address, const char * access)
+{
+	const char * differs = NULL;
+
+	if (straight->data != bus->data)
+		differs = "the data";
+	else if (memcmp(straight->busAccesses, bus->busAccesses, sizeof(bus->busAccesses)))
+		differs = "the bus accesses count";
+	else if (memcmp(straight->opPages, bus->opPages, sizeof(bus->opPages)))
+		differs = "the OP pages marked";
+	else if (memcmp(straight->codeLines, bus->codeLines, sizeof(bus->codeLines)))
+		differs = "the 68K code lines marked";
+	else if (memcmp(straight->dram, bus->dram, vjs.DRAM_size))
+		differs = "the DRAM";
+
+	if (differs)
+	{
+		printf("$%08X: %s differs from the bus for %s\n", address, access, differs);
+		failures++;
+	}
+}
+
+
+//
+// Loads & stores of a unit at an address, done straight & through the bus
+//
+static void TestAddress(uint32_t address, uint32_t who, RISCDRAMAccess * straight, RISCDRAMAccess * bus)
+{
+	uint32_t (* readLong)(uint32_t, uint32_t) = (who == GPU ? GPUReadLong : DSPReadLong);
+	void (* writeLong)(uint32_t, uint32_t, uint32_t) = (who == GPU ? GPUWriteLong : DSPWriteLong);
+	const uint64_t phrase = 0x0123456789ABCDEFULL;
+	uint8_t * dram = RISCDRAM(address, 4);
+
+	if (dram)
+	{
+		uint32_t ramOffset = (uint32_t)(dram - jaguarMainRAM);
+
+		StartAccess(ramOffset);
+		EndAccess(straight, ramOffset, RISCDRAMReadLong(dram, address, who));
+		StartAccess(ramOffset);
+		EndAccess(bus, ramOffset, readLong(address, who));
+		CheckAccess(straight, bus, address, "Long load");
+
+		StartAccess(ramOffset);
+		RISCDRAMWriteLong(dram, address, (uint32_t)phrase, who);
+		EndAccess(straight, ramOffset, 0);
+		StartAccess(ramOffset);
+		writeLong(address, (uint32_t)phrase, who);
+		EndAccess(bus, ramOffset, 0);
+		CheckAccess(straight, bus, address, "Long store");
+	}
+
+	// The DSP has no phrase loads & stores
+	if ((who == GPU) && (dram = RISCDRAM(address, 8)))
+	{
+		uint32_t ramOffset = (uint32_t)(dram - jaguarMainRAM);
+
+		StartAccess(ramOffset);
+		EndAccess(straight, ramOffset, RISCDRAMReadPhrase(dram, address, who));
+		StartAccess(ramOffset);
+		uint64_t data = (uint64_t)readLong(address, who) << 32;
+		EndAccess(bus, ramOffset, data | readLong(address + 4, who));
+		CheckAccess(straight, bus, address, "Phrase load");
+
+		StartAccess(ramOffset);
+		RISCDRAMWritePhrase(dram, address, phrase, who);
+		EndAccess(straight, ramOffset, 0);
+		StartAccess(ramOffset);
+		writeLong(address, (uint32_t)(phrase >> 32), who);
+		writeLong(address + 4, (uint32_t)phrase, who);
+		EndAccess(bus, ramOffset, 0);
+		CheckAccess(straight, bus, address, "Phrase store");
+	}
+}
+
+
+int main(int argc, char * argv[])
+{
+	jaguarcore * core = jaguarcore_create(JAGUARCORE_NTSC | JAGUARCORE_NO_BIOS);
+
+	if (!core)
+	{
+		printf("Could not create a core!\n");
+		return 1;
+	}
+
+	RISCDRAMAccess straight, bus;
+	dramStart = (uint8_t *)malloc(vjs.DRAM_size);
+	straight.dram = (uint8_t *)malloc(vjs.DRAM_size);
+	bus.dram = (uint8_t *)malloc(vjs.DRAM_size);
+
+	for(uint32_t i=0; i<vjs.DRAM_size; i++)
+		dramStart[i] = (uint8_t)((i * 0x9E3779B1) >> 24);
+
+	unsigned int tried = 0;
+
+	for(size_t i=0; i<(sizeof(tests) / sizeof(tests[0])); i++)
+	{
+		uint32_t address = tests[i].address;
+
+		if (!RISCDRAM(address, 4) != !tests[i].longStraight)
+		{
+			printf("$%08X: Long access %s\n", address, (tests[i].longStraight ? "left to the bus" : "done in the DRAM"));
+			failures++;
+		}
+
+		if (!RISCDRAM(address, 8) != !tests[i].phraseStraight)
+		{
+			printf("$%08X: Phrase access %s\n", address, (tests[i].phraseStraight ? "left to the bus" : "done in the DRAM"));
+			failures++;
+		}
+
+		TestAddress(address, GPU, &straight, &bus);
+		tried++;
+
+		// The DSP aligns its long accesses
+		if (!(address & 0x03))
+		{
+			TestAddress(address, DSP, &straight, &bus);
+			tried++;
+		}
+	}
+
+	jaguarcore_destroy(core);
+	free(bus.dram);
+	free(straight.dram);
+	free(dramStart);
+
+	printf("riscdramtest: %u GPU & DSP addresses tried, %u failures\n", tried, failures);
+	return (failures ? 1 : 0);
+}
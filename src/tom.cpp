@@ -14,6 +14,9 @@
 // JLH  01/16/2010  Created this log ;-)
 // JLH  01/20/2011  Change rendering to RGBA, removed unnecessary code
 // JPM  06/06/2016  Visual Studio support
+// JPM   Oct./2026  TOM state moved in the machine context
+// JPM   Oct./2026  Wide fills for the line buffer BG & the border, BG restored only where the line buffer has been written
+// JPM   Oct./2026  Line rendered ahead on the OP host thread taken when it is still valid
 //
 // Note: TOM has only a 16K memory space
 //
@@ -262,6 +265,7 @@
 #include "gpu.h"
 #include "jaguar.h"
 #include "log.h"
+#include "machine.h"
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
 #include "op.h"
@@ -348,18 +352,12 @@
 //(It's easier to do it here, though...)
 //#define TOM_DEBUG
 
-uint8_t tomRam8[0x4000];
-uint32_t tomWidth, tomHeight;
-uint32_t tomTimerPrescaler;
-uint32_t tomTimerDivider;
-int32_t tomTimerCounter;
-uint16_t tom_jerry_int_pending, tom_timer_int_pending, tom_object_int_pending,
-	tom_gpu_int_pending, tom_video_int_pending;
-
-// These are set by the "user" of the Jaguar core lib, since these are
-// OS/system dependent.
-uint32_t * screenBuffer;
-uint32_t screenPitch;
+// TOM state lives in the machine context (see tom.h)
+#define tom_jerry_int_pending	(jaguarMachine->tom.tom_jerry_int_pending)
+#define tom_timer_int_pending	(jaguarMachine->tom.tom_timer_int_pending)
+#define tom_object_int_pending	(jaguarMachine->tom.tom_object_int_pending)
+#define tom_gpu_int_pending		(jaguarMachine->tom.tom_gpu_int_pending)
+#define tom_video_int_pending	(jaguarMachine->tom.tom_video_int_pending)
 
 static const char * videoMode_to_str[8] =
 	{ "16 BPP CRY", "24 BPP RGB", "16 BPP DIRECT", "16 BPP RGB",
@@ -668,6 +666,129 @@ uint16_t TOMGetMEMCON1(void)
 }
 
 
+#define LBUF_BG_SIZE	(720 * 2)					// Line buffer bytes cleared with BG
+
+#define lbufWrittenStart	(jaguarMachine->tom.lbufWrittenStart)
+#define lbufWrittenEnd		(jaguarMachine->tom.lbufWrittenEnd)
+#define lbufBG				(jaguarMachine->tom.lbufBG)
+#define lbufBGValid			(jaguarMachine->tom.lbufBGValid)
+
+
+//
+// Fill a buffer with the value found in its first unit; the filled part is
+// copied after itself, so each copy is twice as wide as the previous one
+//
+static void TOMFillWide(uint8_t * buffer, uint32_t size, uint32_t unit)
+{
+	for(uint32_t filled=unit; filled<size; filled*=2)
+		memcpy(buffer + filled, buffer, (size - filled < filled ? size - filled : filled));
+}
+
+
+//
+// Fill pixels of the backbuffer with the border color, and return the
+// following pixel
+//
+static uint32_t * TOMFillBorder(uint32_t * backbuffer, uint32_t count)
+{
+	uint8_t g = tomRam8[BORD1], r = tomRam8[BORD1 + 1], b = tomRam8[BORD2 + 1];
+
+	if (count)
+	{
+		*backbuffer = 0x000000FF | (r << 24) | (g << 16) | (b << 8);
+		TOMFillWide((uint8_t *)backbuffer, count * sizeof(uint32_t), sizeof(uint32_t));
+	}
+
+	return backbuffer + count;
+}
+
+
+//
+// Keep track of the line buffer span written (by the OP, or by a write in TOM)
+// since its last clear with BG
+//
+void TOMLineBufferWritten(uint32_t offset, uint32_t size)
+{
+	if ((offset + size > 0x1800) && (offset < 0x1800 + LBUF_BG_SIZE))
+	{
+		uint32_t start = (offset < 0x1800 ? 0 : (offset - 0x1800) & ~1);
+		uint32_t end = (offset + size - 0x1800 + 1) & ~1;
+
+		if (end > LBUF_BG_SIZE)
+			end = LBUF_BG_SIZE;
+
+		if (start < lbufWrittenStart)
+			lbufWrittenStart = start;
+
+		if (end > lbufWrittenEnd)
+			lbufWrittenEnd = end;
+	}
+}
+
+
+//
+// Clear the line buffer with BG; if it already has been cleared with the same
+// BG, only the span written since then is cleared again
+//
+static void TOMLineBufferClear(void)
+{
+	uint8_t * lineBuffer = &tomRam8[0x1800];
+	uint16_t bg = GET16(tomRam8, BG);
+	uint32_t start = 0, end = LBUF_BG_SIZE;
+
+	if (lbufBGValid && (lbufBG == bg))
+		start = lbufWrittenStart, end = lbufWrittenEnd;
+
+	if (start < end)
+	{
+		lineBuffer[start] = bg >> 8, lineBuffer[start + 1] = bg & 0xFF;
+		TOMFillWide(lineBuffer + start, end - start, 2);
+		OPSpeculationWritten(0x1800 + start, 0x1800 + end);
+	}
+
+	lbufBG = bg;
+	lbufBGValid = true;
+	lbufWrittenStart = LBUF_BG_SIZE;
+	lbufWrittenEnd = 0;
+}
+
+
+//
+// Render a line in the line buffer: clear it with BG, and let the OP process
+// its list
+//
+void TOMLineBufferRender(uint16_t halfline)
+{
+	if (GET16(tomRam8, VMODE) & BGEN) // && (CRY or RGB16)...
+		TOMLineBufferClear();
+
+	OPProcessList(halfline, true);
+}
+
+
+//
+// Take the line buffer rendered by another machine, from the start offset to
+// the end one, along with its written span & BG
+//
+void TOMLineBufferTake(JaguarMachine * from, uint32_t start, uint32_t end)
+{
+	JaguarMachine * current = jaguarMachine;
+	jaguarMachine = from;
+	uint8_t * lineBuffer = &tomRam8[start];
+	uint32_t writtenStart = lbufWrittenStart, writtenEnd = lbufWrittenEnd;
+	uint16_t bg = lbufBG;
+	bool bgValid = lbufBGValid;
+	jaguarMachine = current;
+
+	if (start < end)
+		memcpy(&tomRam8[start], lineBuffer, end - start);
+	lbufWrittenStart = writtenStart;
+	lbufWrittenEnd = writtenEnd;
+	lbufBG = bg;
+	lbufBGValid = bgValid;
+}
+
+
 #define LEFT_BG_FIX
 //
 // 16 BPP CRY/RGB mixed mode rendering
@@ -698,12 +819,7 @@ void tom_render_16bpp_cry_rgb_mix_scanline(uint32_t * backbuffer)
 // and so is the backbuffer.
 #ifdef LEFT_BG_FIX
 	{
-		uint8_t g = tomRam8[BORD1], r = tomRam8[BORD1 + 1], b = tomRam8[BORD2 + 1];
-		uint32_t pixel = 0x000000FF | (r << 24) | (g << 16) | (b << 8);
-
-		for(int16_t i=0; i<startPos; i++)
-			*backbuffer++ = pixel;
-
+		backbuffer = TOMFillBorder(backbuffer, startPos);
 		width -= startPos;
 	}
 #else
@@ -740,12 +856,7 @@ void tom_render_16bpp_cry_scanline(uint32_t * backbuffer)
 	else
 #ifdef LEFT_BG_FIX
 	{
-		uint8_t g = tomRam8[BORD1], r = tomRam8[BORD1 + 1], b = tomRam8[BORD2 + 1];
-		uint32_t pixel = 0x000000FF | (r << 24) | (g << 16) | (b << 8);
-
-		for(int16_t i=0; i<startPos; i++)
-			*backbuffer++ = pixel;
-
+		backbuffer = TOMFillBorder(backbuffer, startPos);
 		width -= startPos;
 	}
 #else
@@ -783,12 +894,7 @@ void tom_render_24bpp_scanline(uint32_t * backbuffer)
 	else
 #ifdef LEFT_BG_FIX
 	{
-		uint8_t g = tomRam8[BORD1], r = tomRam8[BORD1 + 1], b = tomRam8[BORD2 + 1];
-		uint32_t pixel = 0x000000FF | (r << 24) | (g << 16) | (b << 8);
-
-		for(int16_t i=0; i<startPos; i++)
-			*backbuffer++ = pixel;
-
+		backbuffer = TOMFillBorder(backbuffer, startPos);
 		width -= startPos;
 	}
 #else
@@ -850,12 +956,7 @@ void tom_render_16bpp_rgb_scanline(uint32_t * backbuffer)
 	else
 #ifdef LEFT_BG_FIX
 	{
-		uint8_t g = tomRam8[BORD1], r = tomRam8[BORD1 + 1], b = tomRam8[BORD2 + 1];
-		uint32_t pixel = 0x000000FF | (r << 24) | (g << 16) | (b << 8);
-
-		for(int16_t i=0; i<startPos; i++)
-			*backbuffer++ = pixel;
-
+		backbuffer = TOMFillBorder(backbuffer, startPos);
 		width -= startPos;
 	}
 #else
@@ -955,15 +1056,13 @@ TOM: Vertical Interrupt written by M68K: 491
 	{
 		if (render)
 		{
-			uint8_t * current_line_buffer = (uint8_t *)&tomRam8[0x1800];
-			uint8_t bgHI = tomRam8[BG], bgLO = tomRam8[BG + 1];
+			// The line may have been rendered ahead, on the OP host thread
+			if (!OPSpeculationCommit(halfline))
+				TOMLineBufferRender(halfline);
 
-			// Clear line buffer with BG
-			if (GET16(tomRam8, VMODE) & BGEN) // && (CRY or RGB16)...
-				for(uint32_t i=0; i<720; i++)
-					*current_line_buffer++ = bgHI, *current_line_buffer++ = bgLO;
-
-			OPProcessList(halfline, render);
+			// Render the next line while the processors run up to it
+			if (vjs.threadedOP && ((halfline + 2) < endingHalfline))
+				OPSpeculationStart(halfline + 2);
 		}
 	}
 	else
@@ -1062,13 +1161,7 @@ void tom_render_24bpp_scanline(uint32_t * backbuffer)
 		else
 		{
 			// If outside of VDB & VDE, then display the border color
-			uint32_t * currentLineBuffer = TOMCurrentLine;
-			uint8_t g = tomRam8[BORD1], r = tomRam8[BORD1 + 1], b = tomRam8[BORD2 + 1];
-//Hm.			uint32_t pixel = 0xFF000000 | (b << 16) | (g << 8) | r;
-			uint32_t pixel = 0x000000FF | (r << 24) | (g << 16) | (b << 8);
-
-			for(uint32_t i=0; i<tomWidth; i++)
-				*currentLineBuffer++ = pixel;
+			TOMFillBorder(TOMCurrentLine, tomWidth);
 		}
 	}
 }
@@ -1079,7 +1172,14 @@ void tom_render_24bpp_scanline(uint32_t * backbuffer)
 //
 void TOMInit(void)
 {
-	TOMFillLookupTables();
+	static bool lookupTablesFilled = false;		// Shared by all the machines
+
+	if (!lookupTablesFilled)
+	{
+		TOMFillLookupTables();
+		lookupTablesFilled = true;
+	}
+
 	OPInit();
 	BlitterInit();
 	TOMReset();
@@ -1181,6 +1281,7 @@ void TOMReset(void)
 	OPReset();
 	BlitterReset();
 	memset(tomRam8, 0x00, 0x4000);
+	lbufBGValid = false;
 
 	if (vjs.hardwareTypeNTSC)
 	{
@@ -1379,6 +1480,8 @@ void TOMWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 {
 	// Moved here tentatively, so we can see everything written to TOM.
 	tomRam8[offset & 0x3FFF] = data;
+	TOMLineBufferWritten(offset & 0x3FFF, 1);
+	OP_TOM_WRITE(offset & 0x3FFF);
 
 #ifdef TOM_DEBUG
 	WriteLog("TOM: Writing byte %02X at %06X", data, offset);
@@ -1466,6 +1569,8 @@ void TOMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 	// Moved here tentatively, so we can see everything written to TOM.
 	tomRam8[(offset + 0) & 0x3FFF] = data >> 8;
 	tomRam8[(offset + 1) & 0x3FFF] = data & 0xFF;
+	TOMLineBufferWritten(offset & 0x3FFF, 2);
+	OP_TOM_WRITE(offset & 0x3FFF);
 
 #ifdef TOM_DEBUG
 	WriteLog("TOM: Writing byte %04X at %06X", data, offset);
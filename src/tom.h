@@ -45,6 +45,9 @@ uint16_t TOMGetHC(void);
 uint16_t TOMGetVP(void);
 uint16_t TOMGetMEMCON1(void);
 void TOMDumpIORegistersToLog(void);
+void TOMLineBufferWritten(uint32_t offset, uint32_t size);
+void TOMLineBufferRender(uint16_t halfline);
+void TOMLineBufferTake(struct JaguarMachine * from, uint32_t start, uint32_t end);
 
 
 int TOMIRQEnabled(int irq);
@@ -58,16 +61,37 @@ void TOMSetPendingGPUInt(void);
 void TOMSetPendingVideoInt(void);
 void TOMResetPIT(void);
 
-// Exported variables
-
-extern uint32_t tomWidth;
-extern uint32_t tomHeight;
-extern uint8_t tomRam8[];
-extern uint32_t tomTimerPrescaler;
-extern uint32_t tomTimerDivider;
-extern int32_t tomTimerCounter;
-
-extern uint32_t screenPitch;
-extern uint32_t * screenBuffer;
+// TOM state of a machine
+
+struct TOMState
+{
+	uint8_t tomRam8[0x4000];
+	uint32_t tomWidth, tomHeight;
+	uint32_t tomTimerPrescaler;
+	uint32_t tomTimerDivider;
+	int32_t tomTimerCounter;
+	uint16_t tom_jerry_int_pending, tom_timer_int_pending, tom_object_int_pending,
+		tom_gpu_int_pending, tom_video_int_pending;
+	// These are set by the "user" of the Jaguar core lib, since these are
+	// OS/system dependent.
+	uint32_t * screenBuffer;
+	uint32_t screenPitch;
+	// Line buffer span written since its last clear with BG, and this BG
+	uint32_t lbufWrittenStart, lbufWrittenEnd;
+	uint16_t lbufBG;
+	bool lbufBGValid;
+};
+
+// Exported variables (of the current machine, see machine.h)
+
+#define tomWidth			(jaguarMachine->tom.tomWidth)
+#define tomHeight			(jaguarMachine->tom.tomHeight)
+#define tomRam8				(jaguarMachine->tom.tomRam8)
+#define tomTimerPrescaler	(jaguarMachine->tom.tomTimerPrescaler)
+#define tomTimerDivider		(jaguarMachine->tom.tomTimerDivider)
+#define tomTimerCounter		(jaguarMachine->tom.tomTimerCounter)
+
+#define screenPitch			(jaguarMachine->tom.screenPitch)
+#define screenBuffer		(jaguarMachine->tom.screenBuffer)
 
 #endif	// __TOM_H__
@@ -0,0 +1,82 @@
+//
+// bin2z.cpp - Compiled in images generator
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+//
+// Writes the source file of a BIOS or firmware image compiled in zlib compressed
+// (src/jagbios.cpp & the like), decompressed when used by modelsBIOS.cpp; it
+// replaces bin2c for them. Built by:
+// make -f jaguarcore.mak bin2z
+// & the sources are written again from the images, in BIOSDIR, by:
+// make -f jaguarcore.mak bios BIOSDIR=<directory>
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <zlib.h>
+
+
+int main(int argc, char * argv[])
+{
+	if ((argc < 4) || (argc > 5))
+	{
+		printf("Usage: bin2z <image> <array> <header> [<note>]\n"
+			"Prints the source file of the image, compressed in the <array>Compressed\n"
+			"array & its size in <array>CompressedSize, both declared in <header>.\n");
+		return 1;
+	}
+
+	FILE * fp = fopen(argv[1], "rb");
+
+	if (!fp)
+	{
+		fprintf(stderr, "Could not open file \"%s\"!\n", argv[1]);
+		return 1;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	size_t size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	uint8_t * image = (uint8_t *)malloc(size ? size : 1);
+	uLongf compressedSize = compressBound(size);
+	uint8_t * compressed = (uint8_t *)malloc(compressedSize);
+
+	if (!image || !compressed || (fread(image, 1, size, fp) != size))
+	{
+		fprintf(stderr, "Could not read file \"%s\"!\n", argv[1]);
+		return 1;
+	}
+
+	fclose(fp);
+
+	if (compress2(compressed, &compressedSize, image, size, Z_BEST_COMPRESSION) != Z_OK)
+	{
+		fprintf(stderr, "Could not compress file \"%s\"!\n", argv[1]);
+		return 1;
+	}
+
+	printf("//\n// This file was generated by bin2z (see src/tools/bin2z.cpp)\n//\n");
+
+	if (argc == 5)
+		printf("// NOTE: %s\n", argv[4]);
+
+	printf("// The image is zlib compressed, and decompressed on demand (see modelsBIOS.cpp)\n//\n\n");
+	printf("#include \"%s\"\n\n", argv[3]);
+	printf("const uint8_t %sCompressed[%lu] = {\n", argv[2], (unsigned long)compressedSize);
+
+	for(uLongf i=0; i<compressedSize; i++)
+		printf("%s0x%02X%s", ((i % 32) ? "" : "\t"), compressed[i], (i == (compressedSize - 1) ? "\n" : ((i % 32) == 31 ? ", \n" : ", ")));
+
+	printf("};\n\nconst uint32_t %sCompressedSize = sizeof(%sCompressed);\n", argv[2], argv[2]);
+
+	free(image);
+	free(compressed);
+	return 0;
+}
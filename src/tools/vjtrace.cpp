@@ -0,0 +1,410 @@
+//
+// vjtrace.cpp - Execution trace reader
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Registers changes shown on the instruction doing them
+//
+// Prints the records of an execution trace written by the emulator (see
+// src/trace.h), one line each, processor by processor. Built by:
+// make -f jaguarcore.mak vjtrace
+//
+// An instruction is recorded before being run, with the registers changed since
+// the previous one: its line is printed at the next instruction, with the changes
+// recorded there, followed by the interrupts, exceptions, events & idle loops
+// recorded in between. The last instruction before a gap has no changes shown.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "trace.h"
+
+
+static const char * cpuName[TRACE_CPUS] = { "68K", "GPU", "DSP" };
+static const char * m68kRegisterName[TRACE_M68K_REGISTERS] = {
+	"D0", "D1", "D2", "D3", "D4", "D5", "D6", "D7",
+	"A0", "A1", "A2", "A3", "A4", "A5", "A6", "A7", "SR"
+};
+
+// State of a processor, as decoded so far
+struct Decoder
+{
+	uint32_t pc;
+	uint32_t registerCount;
+	uint32_t registers[TRACE_MAX_REGISTERS];
+	uint64_t instructions;
+	uint64_t first;						// First instruction to print
+	int32_t lastSequence;
+	bool pending;						// Instruction waiting for the registers it changed
+	uint64_t pendingNumber;
+	uint32_t pendingPC, pendingOpcode;
+	char markers[1024];					// Lines of the records following it
+	size_t markersLength;
+};
+
+static Decoder decoders[TRACE_CPUS];
+
+
+static uint32_t Get32(const uint8_t * p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+
+//
+// Read a LEB128 value; returns false at the end of the records
+//
+static bool GetValue(const uint8_t ** p, const uint8_t * end, uint64_t * value)
+{
+	*value = 0;
+
+	for(int shift=0; (*p < end) && (shift < 64); shift+=7)
+	{
+		uint8_t byte = *(*p)++;
+		*value |= (uint64_t)(byte & 0x7F) << shift;
+
+		if (!(byte & 0x80))
+			return true;
+	}
+
+	return false;
+}
+
+
+static const char * RegisterName(int cpu, uint32_t i, char * buffer)
+{
+	if (cpu == TRACE_M68K)
+		return m68kRegisterName[i];
+
+	if (i == (TRACE_RISC_REGISTERS - 1))
+		return "ZCN";
+
+	snprintf(buffer, 16, "R%u", i);
+	return buffer;
+}
+
+
+//
+// Print the pending instruction, with the registers changed given, & the records
+// following it
+//
+static void PrintPending(int cpu, uint64_t changed)
+{
+	Decoder * decoder = &decoders[cpu];
+	char name[16];
+
+	if (!decoder->pending)
+		return;
+
+	printf("%s  #%-10llu %06X  %04X ", cpuName[cpu], (unsigned long long)decoder->pendingNumber, decoder->pendingPC, decoder->pendingOpcode);
+
+	for(uint32_t i=0; (i<decoder->registerCount) && changed; i++, changed>>=1)
+	{
+		if (changed & 1)
+			printf(" %s=%0*X", RegisterName(cpu, i, name), ((cpu == TRACE_M68K) && (i == (TRACE_M68K_REGISTERS - 1)) ? 4 : 8), decoder->registers[i]);
+	}
+
+	printf("\n%s", decoder->markers);
+	decoder->pending = false;
+	decoder->markers[0] = 0;
+	decoder->markersLength = 0;
+}
+
+
+//
+// Print a record following an instruction, once the instruction is
+//
+static void PrintMarker(int cpu, const char * line)
+{
+	Decoder * decoder = &decoders[cpu];
+	size_t length = strlen(line);
+
+	if (!decoder->pending)
+	{
+		fputs(line, stdout);
+		return;
+	}
+
+	// Too many records: the instruction is printed without its changes
+	if ((decoder->markersLength + length) >= sizeof(decoder->markers))
+	{
+		PrintPending(cpu, 0);
+		fputs(line, stdout);
+		return;
+	}
+
+	memcpy(decoder->markers + decoder->markersLength, line, length + 1);
+	decoder->markersLength += length;
+}
+
+
+//
+// Decode the records of a chunk, printed if print is set
+//
+static void DecodeChunk(int cpu, const uint8_t * p, const uint8_t * end, bool print)
+{
+	Decoder * decoder = &decoders[cpu];
+	uint64_t value1, value2;
+
+	while (p < end)
+	{
+		uint8_t type = *p++;
+
+		switch (type)
+		{
+		case TRACE_KEYFRAME:
+		{
+			if (!GetValue(&p, end, &decoder->instructions) || !GetValue(&p, end, &value1) || (p >= end))
+				return;
+
+			decoder->pc = (uint32_t)value1;
+			decoder->registerCount = *p++;
+
+			if (decoder->registerCount > TRACE_MAX_REGISTERS)
+			{
+				fprintf(stderr, "%s: Bad keyframe\n", cpuName[cpu]);
+				return;
+			}
+
+			for(uint32_t i=0; i<decoder->registerCount; i++)
+			{
+				if (!GetValue(&p, end, &value1))
+					return;
+
+				decoder->registers[i] = (uint32_t)value1;
+			}
+
+			break;
+		}
+		case TRACE_INSTRUCTION:
+		{
+			uint64_t zigzag, changed;
+
+			if (!GetValue(&p, end, &zigzag) || ((p + 2) > end))
+				return;
+
+			uint32_t opcode = p[0] | (p[1] << 8);
+			p += 2;
+
+			if (!GetValue(&p, end, &changed))
+				return;
+
+			decoder->pc += (uint32_t)((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+
+			// Changes done by the previous instruction
+			for(uint64_t bits=changed, i=0; (i<decoder->registerCount) && bits; i++, bits>>=1)
+			{
+				if (!(bits & 1))
+					continue;
+
+				if (!GetValue(&p, end, &value1))
+					return;
+
+				decoder->registers[i] ^= (uint32_t)value1;
+			}
+
+			if (print)
+				PrintPending(cpu, changed);
+
+			if (print && (decoder->instructions >= decoder->first))
+			{
+				decoder->pending = true;
+				decoder->pendingNumber = decoder->instructions;
+				decoder->pendingPC = decoder->pc;
+				decoder->pendingOpcode = opcode;
+			}
+
+			decoder->instructions++;
+			break;
+		}
+		case TRACE_INTERRUPT:
+		case TRACE_EXCEPTION:
+		case TRACE_EVENT:
+		case TRACE_IDLE:
+		{
+			if (!GetValue(&p, end, &value1) || !GetValue(&p, end, &value2))
+				return;
+
+			if (!print || (decoder->instructions < decoder->first))
+				break;
+
+			char line[128];
+
+			if (type == TRACE_INTERRUPT)
+				snprintf(line, sizeof(line), "%s  interrupt %s%u at %06X\n", cpuName[cpu], (cpu == TRACE_M68K ? "vector " : "#"), (uint32_t)value1, (uint32_t)value2);
+			else if (type == TRACE_EXCEPTION)
+				snprintf(line, sizeof(line), "%s  exception vector %u at %06X\n", cpuName[cpu], (uint32_t)value1, (uint32_t)value2);
+			else if (type == TRACE_EVENT)
+				snprintf(line, sizeof(line), "%s  event of the %s list, %.3f us elapsed\n", cpuName[cpu], (value1 ? "JERRY" : "main"), (double)value2 / 1000.0);
+			else
+				snprintf(line, sizeof(line), "%s  idle loop at %06X, %u cycles skipped\n", cpuName[cpu], (uint32_t)value1, (uint32_t)value2);
+
+			PrintMarker(cpu, line);
+
+			break;
+		}
+		default:
+			fprintf(stderr, "%s: Unknown record $%02X\n", cpuName[cpu], type);
+			return;
+		}
+	}
+}
+
+
+//
+// Decode all the chunks of the file; returns false if it cannot be read
+//
+static bool DecodeFile(const uint8_t * data, size_t size, int cpuFilter, bool print)
+{
+	static uint8_t records[TRACE_CHUNK_SIZE];
+	size_t offset = 4 + 4 + TRACE_FILE_REASON + 4;
+	uint32_t count = Get32(data + 8 + TRACE_FILE_REASON);
+	int lastCPU = -1;
+
+	for(int i=0; i<TRACE_CPUS; i++)
+		decoders[i].lastSequence = -1;
+
+	for(uint32_t i=0; i<count; i++)
+	{
+		if ((offset + 16) > size)
+			return false;
+
+		int cpu = data[offset];
+		bool compressed = (data[offset + 1] != 0);
+		uint32_t sequence = Get32(data + offset + 4);
+		uLongf rawSize = Get32(data + offset + 8);
+		uint32_t chunkSize = Get32(data + offset + 12);
+		const uint8_t * chunk = data + offset + 16;
+		offset += 16 + chunkSize;
+
+		if ((cpu >= TRACE_CPUS) || (offset > size) || (rawSize > TRACE_CHUNK_SIZE))
+			return false;
+
+		if ((cpuFilter >= 0) && (cpu != cpuFilter))
+			continue;
+
+		// The last instruction of the processor printed before has no changes shown
+		if (print && (cpu != lastCPU) && (lastCPU >= 0))
+			PrintPending(lastCPU, 0);
+
+		lastCPU = cpu;
+
+		if (print && (decoders[cpu].lastSequence != ((int32_t)sequence - 1)))
+		{
+			PrintPending(cpu, 0);
+			printf("%s  (%s)\n", cpuName[cpu], (decoders[cpu].lastSequence < 0 ? "older records dropped" : "records lost"));
+		}
+
+		decoders[cpu].lastSequence = (int32_t)sequence;
+
+		if (compressed)
+		{
+			if ((uncompress(records, &rawSize, chunk, chunkSize) != Z_OK))
+			{
+				fprintf(stderr, "%s: Chunk %u cannot be decompressed\n", cpuName[cpu], sequence);
+				PrintPending(cpu, 0);
+				continue;
+			}
+
+			DecodeChunk(cpu, records, records + rawSize, print);
+		}
+		else
+			DecodeChunk(cpu, chunk, chunk + chunkSize, print);
+	}
+
+	if (print && (lastCPU >= 0))
+		PrintPending(lastCPU, 0);
+
+	return true;
+}
+
+
+int main(int argc, char * argv[])
+{
+	const char * filename = NULL;
+	int cpuFilter = -1;
+	uint64_t last = 0;
+
+	for(int i=1; i<argc; i++)
+	{
+		if (!strcmp(argv[i], "-c") && ((i + 1) < argc))
+		{
+			i++;
+
+			for(int j=0; j<TRACE_CPUS; j++)
+			{
+				if (!strcmp(argv[i], cpuName[j]) || ((argv[i][0] | 0x20) == (cpuName[j][0] | 0x20)))
+					cpuFilter = j;
+			}
+		}
+		else if (!strcmp(argv[i], "-n") && ((i + 1) < argc))
+			last = strtoull(argv[++i], NULL, 10);
+		else
+			filename = argv[i];
+	}
+
+	if (!filename)
+	{
+		printf("Usage: vjtrace [-c 68k|gpu|dsp] [-n <instructions>] <file>\n"
+			"Prints the execution trace written by Virtual Jaguar (--trace-dump); -c keeps\n"
+			"the records of a processor, -n the last instructions of each processor.\n");
+		return 1;
+	}
+
+	FILE * fp = fopen(filename, "rb");
+
+	if (!fp)
+	{
+		fprintf(stderr, "Could not open file \"%s\"!\n", filename);
+		return 1;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	size_t size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	uint8_t * data = (uint8_t *)malloc(size ? size : 1);
+
+	if (!data || (fread(data, 1, size, fp) != size))
+	{
+		fprintf(stderr, "Could not read file \"%s\"!\n", filename);
+		return 1;
+	}
+
+	fclose(fp);
+
+	if ((size < (4 + 4 + TRACE_FILE_REASON + 4)) || memcmp(data, TRACE_FILE_MAGIC, 4) || (Get32(data + 4) != TRACE_FILE_VERSION))
+	{
+		fprintf(stderr, "\"%s\" is not an execution trace!\n", filename);
+		return 1;
+	}
+
+	char reason[TRACE_FILE_REASON + 1];
+	memcpy(reason, data + 8, TRACE_FILE_REASON);
+	reason[TRACE_FILE_REASON] = 0;
+	printf("Execution trace: %s\n", reason);
+
+	// The instructions of each processor are counted first, to only print the last ones
+	if (last)
+	{
+		DecodeFile(data, size, cpuFilter, false);
+
+		for(int i=0; i<TRACE_CPUS; i++)
+			decoders[i].first = (decoders[i].instructions > last ? decoders[i].instructions - last : 0);
+	}
+
+	if (!DecodeFile(data, size, cpuFilter, true))
+	{
+		fprintf(stderr, "\"%s\" is truncated!\n", filename);
+		return 1;
+	}
+
+	free(data);
+	return 0;
+}
@@ -0,0 +1,577 @@
+//
+// trace.cpp - Execution trace recorder
+//
+// by Jean-Paul Mari
+//
+// JPM = Jean-Paul Mari <djipi.mari@gmail.com>
+//
+// Who  When        What
+// ---  ----------  -------------------------------------------------------------
+// JPM   Oct./2026  Created this file
+// JPM   Oct./2026  Chunks handed over, kept & dumped under the lock
+// JPM   Oct./2026  Host thread stopped by the last machine only
+//
+// The 68K, GPU & DSP instructions are recorded with the registers they change,
+// along with the interrupts, the exceptions, the events & the idle loops
+// skipped, in a stream of records for each processor (see trace.h). Recording
+// only appends a few bytes to the chunk being written; a full chunk is handed
+// over to a host thread which compresses it, and the last TRACE_CHUNKS ones of
+// each stream are kept. Without SDL, the chunks are compressed at once.
+//
+// The trace is written to the file given by --trace-dump on a 68K error
+// exception, an odd PC, or a breakpoint; src/tools/vjtrace.cpp reads it.
+//
+
+#include "trace.h"
+
+#ifndef NO_SDL
+#include <SDL.h>								// For the host thread
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "log.h"
+#include "machine.h"
+#include "settings.h"
+
+
+#define TRACE_PENDING	8						// Chunks waiting for their compression
+
+#define traceStreams	(jaguarMachine->trace.streams)
+
+#ifndef NO_SDL
+struct TracePendingChunk
+{
+	TraceStream * stream;
+	uint8_t * buffer;
+	uint32_t size;
+	uint32_t sequence;
+};
+
+static SDL_Thread * traceThread = NULL;
+static SDL_mutex * traceMutex = NULL;			// Protects the compressed chunks & the pending ones
+static SDL_cond * traceCond = NULL;				// Signaled when a chunk is pending
+static SDL_cond * traceDoneCond = NULL;			// Signaled when a chunk has been compressed
+static bool traceQuit = false;
+static TracePendingChunk tracePending[TRACE_PENDING];
+static int tracePendingFirst = 0, tracePendingCount = 0;
+static bool traceCompressing = false;
+static uint8_t * traceFreeBuffers[TRACE_PENDING];
+static int traceFreeCount = 0;
+static int traceMachines = 0;					// Machines initialised, counted under the lock
+#endif
+
+// Private function prototypes
+static uint8_t * TraceNewChunk(TraceStream * stream);
+static uint8_t * TraceCompress(const uint8_t * buffer, uint32_t size, uint32_t * compressedSize);
+static void TraceKeepChunk(TraceStream * stream, uint8_t * data, uint32_t size, uint32_t rawSize, uint32_t sequence);
+static void TraceFree(void);
+#ifndef NO_SDL
+static void TraceWaitPending(void);
+static int TraceThreadFunc(void *);
+#endif
+
+
+//
+// Create the locks, once for all the machines (under the machines lock), & count
+// the machine
+//
+void TraceInit(void)
+{
+#ifndef NO_SDL
+	if (!traceMutex)
+	{
+		traceMutex = SDL_CreateMutex();
+		traceCond = SDL_CreateCond();
+		traceDoneCond = SDL_CreateCond();
+	}
+
+	SDL_LockMutex(traceMutex);
+	traceMachines++;
+	SDL_UnlockMutex(traceMutex);
+#endif
+}
+
+
+//
+// Forget the records of the machine, and start recording again if the trace is on
+//
+void TraceReset(void)
+{
+	TraceFree();
+
+	for(int i=0; i<TRACE_CPUS; i++)
+		traceStreams[i].registerCount = (i == TRACE_M68K ? TRACE_M68K_REGISTERS : TRACE_RISC_REGISTERS);
+
+	TRACE_ACTIVE = vjs.trace;
+	m68k_set_trace(TRACE_ACTIVE);
+}
+
+
+static inline uint8_t * TraceWriteValue(uint8_t * p, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		*p++ = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+
+	*p++ = (uint8_t)value;
+	return p;
+}
+
+
+//
+// Room for a record; a chunk is started when the stream is empty (used - 1 wraps
+// around), or nearly full
+//
+static inline uint8_t * TraceRecord(TraceStream * stream)
+{
+	if ((stream->used - 1) >= (TRACE_CHUNK_SIZE - (2 * TRACE_RECORD_MAX)))
+		return TraceNewChunk(stream);
+
+	return stream->buffer + stream->used;
+}
+
+
+//
+// Record an instruction about to be run, with the registers changed since the
+// previous one; registers holds all of them but the last one, given by flags
+//
+void TraceInstruction(int cpu, uint32_t pc, uint32_t opcode, const uint32_t * registers, uint32_t flags)
+{
+	TraceStream * stream = &traceStreams[cpu];
+	uint8_t * p = TraceRecord(stream);
+
+	if (!p)
+		return;
+
+	uint32_t count = stream->registerCount - 1;
+	uint64_t changed = (uint64_t)(flags != stream->registers[count]) << count;
+
+	for(uint32_t i=0; i<count; i++)
+		changed |= (uint64_t)(registers[i] != stream->registers[i]) << i;
+
+	int32_t delta = (int32_t)(pc - stream->pc);
+	*p++ = TRACE_INSTRUCTION;
+	p = TraceWriteValue(p, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+	*p++ = (uint8_t)opcode;
+	*p++ = (uint8_t)(opcode >> 8);
+	p = TraceWriteValue(p, changed);
+
+	for(uint32_t i=0; changed; i++, changed>>=1)
+	{
+		if (changed & 1)
+		{
+			uint32_t value = (i < count ? registers[i] : flags);
+			p = TraceWriteValue(p, value ^ stream->registers[i]);
+			stream->registers[i] = value;
+		}
+	}
+
+	stream->pc = pc;
+	stream->instructions++;
+	stream->used = (uint32_t)(p - stream->buffer);
+}
+
+
+//
+// Record an interrupt, an exception, an event or an idle loop skip
+//
+void TraceMarker(int cpu, int type, uint32_t value1, uint32_t value2)
+{
+	TraceStream * stream = &traceStreams[cpu];
+	uint8_t * p = TraceRecord(stream);
+
+	if (!p)
+		return;
+
+	*p++ = (uint8_t)type;
+	p = TraceWriteValue(p, value1);
+	p = TraceWriteValue(p, value2);
+	stream->used = (uint32_t)(p - stream->buffer);
+}
+
+
+//
+// Hand the full chunk over for its compression, and start the next one with a
+// keyframe; the trace is stopped if there is no memory left for it
+// The chunk is changed under the lock, so a dump never sees it twice
+//
+static uint8_t * TraceNewChunk(TraceStream * stream)
+{
+#ifndef NO_SDL
+	stream->threadID = SDL_ThreadID();
+#endif
+
+	if (stream->used)
+	{
+#ifndef NO_SDL
+		bool handed = false;
+		SDL_LockMutex(traceMutex);
+
+		if (!traceThread && !(traceThread = SDL_CreateThread(TraceThreadFunc, NULL)))
+			WriteLog("Trace: Unable to start the host thread (%s), chunks will be compressed at once\n", SDL_GetError());
+
+		// Chunks of a stream have to be compressed in sequence
+		while (traceThread && (tracePendingCount == TRACE_PENDING))
+			SDL_CondWait(traceDoneCond, traceMutex);
+
+		if (traceThread)
+		{
+			uint8_t * buffer = (traceFreeCount ? traceFreeBuffers[--traceFreeCount] : (uint8_t *)malloc(TRACE_CHUNK_SIZE));
+
+			if (buffer)
+			{
+				TracePendingChunk * pending = &tracePending[(tracePendingFirst + tracePendingCount++) % TRACE_PENDING];
+				pending->stream = stream;
+				pending->buffer = stream->buffer;
+				pending->size = stream->used;
+				pending->sequence = stream->sequence;
+				stream->buffer = buffer;
+				stream->sequence++;
+				stream->used = 0;
+				handed = true;
+				SDL_CondSignal(traceCond);
+			}
+		}
+
+		SDL_UnlockMutex(traceMutex);
+
+		if (!handed)
+#endif
+		{
+			uint32_t compressedSize;
+			uint8_t * data = TraceCompress(stream->buffer, stream->used, &compressedSize);
+#ifndef NO_SDL
+			SDL_LockMutex(traceMutex);
+#endif
+			if (data)
+				TraceKeepChunk(stream, data, compressedSize, stream->used, stream->sequence);
+
+			stream->sequence++;
+			stream->used = 0;
+#ifndef NO_SDL
+			SDL_UnlockMutex(traceMutex);
+#endif
+		}
+	}
+
+	if (!stream->buffer && !(stream->buffer = (uint8_t *)malloc(TRACE_CHUNK_SIZE)))
+	{
+		WriteLog("Trace: Not enough memory, the execution trace is stopped\n");
+		TRACE_ACTIVE = false;
+		m68k_set_trace(0);
+		return NULL;
+	}
+
+	uint8_t * p = stream->buffer;
+	*p++ = TRACE_KEYFRAME;
+	p = TraceWriteValue(p, stream->instructions);
+	p = TraceWriteValue(p, stream->pc);
+	*p++ = (uint8_t)stream->registerCount;
+
+	for(uint32_t i=0; i<stream->registerCount; i++)
+		p = TraceWriteValue(p, stream->registers[i]);
+
+	stream->used = (uint32_t)(p - stream->buffer);
+	return p;
+}
+
+
+//
+// Compress a chunk; returns NULL if it cannot be
+//
+static uint8_t * TraceCompress(const uint8_t * buffer, uint32_t size, uint32_t * compressedSize)
+{
+	uLongf dataSize = compressBound(size);
+	uint8_t * data = (uint8_t *)malloc(dataSize);
+
+	if (!data || (compress2(data, &dataSize, buffer, size, Z_BEST_SPEED) != Z_OK))
+	{
+		WriteLog("Trace: Unable to compress a chunk, records are lost\n");
+		free(data);
+		return NULL;
+	}
+
+	uint8_t * shrunk = (uint8_t *)realloc(data, dataSize);
+	*compressedSize = (uint32_t)dataSize;
+	return (shrunk ? shrunk : data);
+}
+
+
+//
+// Keep a compressed chunk in place of the oldest one if the ring is full (the lock being held)
+//
+static void TraceKeepChunk(TraceStream * stream, uint8_t * data, uint32_t size, uint32_t rawSize, uint32_t sequence)
+{
+	if (stream->chunkCount == TRACE_CHUNKS)
+	{
+		free(stream->chunks[stream->firstChunk].data);
+		stream->firstChunk = (stream->firstChunk + 1) % TRACE_CHUNKS;
+		stream->chunkCount--;
+	}
+
+	TraceChunk * chunk = &stream->chunks[(stream->firstChunk + stream->chunkCount++) % TRACE_CHUNKS];
+	chunk->data = data;
+	chunk->size = size;
+	chunk->rawSize = rawSize;
+	chunk->sequence = sequence;
+}
+
+
+static void TracePut32(uint8_t * p, uint32_t value)
+{
+	p[0] = (uint8_t)value, p[1] = (uint8_t)(value >> 8), p[2] = (uint8_t)(value >> 16), p[3] = (uint8_t)(value >> 24);
+}
+
+
+static bool TraceWriteChunk(FILE * fp, int cpu, bool compressed, uint32_t sequence, uint32_t rawSize, const uint8_t * data, uint32_t size)
+{
+	uint8_t header[16];
+	header[0] = (uint8_t)cpu;
+	header[1] = (compressed ? 1 : 0);
+	header[2] = header[3] = 0;
+	TracePut32(header + 4, sequence);
+	TracePut32(header + 8, rawSize);
+	TracePut32(header + 12, size);
+
+	return (fwrite(header, 1, 16, fp) == 16) && (fwrite(data, 1, size, fp) == size);
+}
+
+
+//
+// Write the records of the machine; the chunk being written by a stream is included
+// when it is written by the calling thread, as another thread may be appending to it
+//
+bool TraceDump(const char * filename, const char * reason)
+{
+	FILE * fp = fopen(filename, "wb");
+
+	if (!fp)
+	{
+		WriteLog("Trace: Could not create file \"%s\"!\n", filename);
+		return false;
+	}
+
+#ifndef NO_SDL
+	SDL_LockMutex(traceMutex);
+	TraceWaitPending();
+#endif
+	uint8_t header[4 + 4 + TRACE_FILE_REASON + 4];
+	uint32_t count = 0, used[TRACE_CPUS];
+
+	for(int i=0; i<TRACE_CPUS; i++)
+	{
+#ifndef NO_SDL
+		used[i] = ((traceStreams[i].threadID == SDL_ThreadID()) ? traceStreams[i].used : 0);
+#else
+		used[i] = traceStreams[i].used;
+#endif
+		count += traceStreams[i].chunkCount + (used[i] ? 1 : 0);
+	}
+
+	memset(header, 0, sizeof(header));
+	memcpy(header, TRACE_FILE_MAGIC, 4);
+	TracePut32(header + 4, TRACE_FILE_VERSION);
+	strncpy((char *)header + 8, reason, TRACE_FILE_REASON - 1);
+	TracePut32(header + 8 + TRACE_FILE_REASON, count);
+	bool ok = (fwrite(header, 1, sizeof(header), fp) == sizeof(header));
+
+	for(int i=0; i<TRACE_CPUS; i++)
+	{
+		TraceStream * stream = &traceStreams[i];
+
+		for(uint32_t j=0; ok && (j<stream->chunkCount); j++)
+		{
+			TraceChunk * chunk = &stream->chunks[(stream->firstChunk + j) % TRACE_CHUNKS];
+			ok = TraceWriteChunk(fp, i, true, chunk->sequence, chunk->rawSize, chunk->data, chunk->size);
+		}
+
+		if (ok && used[i])
+			ok = TraceWriteChunk(fp, i, false, stream->sequence, used[i], stream->buffer, used[i]);
+	}
+#ifndef NO_SDL
+	SDL_UnlockMutex(traceMutex);
+#endif
+
+	ok = !fclose(fp) && ok;
+
+	if (ok)
+		WriteLog("Trace: %s, execution trace written to \"%s\"\n", reason, filename);
+	else
+		WriteLog("Trace: Could not write file \"%s\"!\n", filename);
+
+	return ok;
+}
+
+
+//
+// Something went wrong: write the trace, if a file has been given for it
+//
+void TraceTrigger(const char * reason)
+{
+	if (TRACE_ACTIVE && vjs.traceDump[0])
+		TraceDump(vjs.traceDump, reason);
+}
+
+
+//
+// Free the records of the machine; the last machine stops the host thread, which
+// is no longer given chunks once it is told to quit
+//
+void TraceDone(void)
+{
+	TraceFree();
+	TRACE_ACTIVE = false;
+	m68k_set_trace(0);
+
+#ifndef NO_SDL
+	SDL_Thread * thread = NULL;
+	SDL_LockMutex(traceMutex);
+
+	if (traceMachines && !--traceMachines)
+	{
+		thread = traceThread;
+		traceThread = NULL;
+		traceQuit = true;
+		SDL_CondSignal(traceCond);
+	}
+
+	SDL_UnlockMutex(traceMutex);
+
+	if (thread)
+		SDL_WaitThread(thread, NULL);
+
+	SDL_LockMutex(traceMutex);
+
+	if (!traceMachines)
+	{
+		traceQuit = false;
+
+		while (traceFreeCount)
+			free(traceFreeBuffers[--traceFreeCount]);
+	}
+
+	SDL_UnlockMutex(traceMutex);
+#endif
+}
+
+
+//
+// Free the chunks of the machine, once the pending ones have been compressed
+//
+static void TraceFree(void)
+{
+#ifndef NO_SDL
+	SDL_LockMutex(traceMutex);
+	TraceWaitPending();
+#endif
+	for(int i=0; i<TRACE_CPUS; i++)
+	{
+		TraceStream * stream = &traceStreams[i];
+		free(stream->buffer);
+
+		for(uint32_t j=0; j<stream->chunkCount; j++)
+			free(stream->chunks[(stream->firstChunk + j) % TRACE_CHUNKS].data);
+
+		memset(stream, 0, sizeof(TraceStream));
+	}
+#ifndef NO_SDL
+	SDL_UnlockMutex(traceMutex);
+#endif
+}
+
+
+#ifndef NO_SDL
+//
+// Wait for the pending chunks to be compressed (the lock being held)
+//
+static void TraceWaitPending(void)
+{
+	while (traceThread && (tracePendingCount || traceCompressing))
+		SDL_CondWait(traceDoneCond, traceMutex);
+}
+
+
+//
+// Host thread: compress the pending chunks, in the order they have been handed
+// over; the ones left are compressed before quitting
+//
+static int TraceThreadFunc(void *)
+{
+	SDL_LockMutex(traceMutex);
+
+	while (!traceQuit || tracePendingCount)
+	{
+		if (!tracePendingCount)
+		{
+			SDL_CondWait(traceCond, traceMutex);
+			continue;
+		}
+
+		TracePendingChunk pending = tracePending[tracePendingFirst];
+		tracePendingFirst = (tracePendingFirst + 1) % TRACE_PENDING;
+		tracePendingCount--;
+		traceCompressing = true;
+		SDL_UnlockMutex(traceMutex);
+
+		uint32_t compressedSize;
+		uint8_t * data = TraceCompress(pending.buffer, pending.size, &compressedSize);
+
+		SDL_LockMutex(traceMutex);
+
+		if (data)
+			TraceKeepChunk(pending.stream, data, compressedSize, pending.size, pending.sequence);
+
+		if (traceFreeCount < TRACE_PENDING)
+			traceFreeBuffers[traceFreeCount++] = pending.buffer;
+		else
+			free(pending.buffer);
+
+		traceCompressing = false;
+		SDL_CondBroadcast(traceDoneCond);
+	}
+
+	SDL_UnlockMutex(traceMutex);
+	return 0;
+}
+#endif
+
+
+//
+// 68K core hooks (see m68kinterface.h)
+//
+void M68KTraceInstruction(uint32_t pc, uint32_t opcode, const uint32_t * registers, uint32_t sr)
+{
+	TraceInstruction(TRACE_M68K, pc, opcode, registers, sr);
+}
+
+
+void M68KTraceException(uint32_t vector, uint32_t pc)
+{
+	// The interrupts use the autovectors, and the Jaguar the first user vector
+	if (((vector >= 24) && (vector < 32)) || (vector >= 64))
+	{
+		TraceMarker(TRACE_M68K, TRACE_INTERRUPT, vector, pc);
+		return;
+	}
+
+	TraceMarker(TRACE_M68K, TRACE_EXCEPTION, vector, pc);
+
+	// Bus & address errors, illegal instruction, zero divide, CHK, TRAPV,
+	// privilege violation, trace, line A & line F
+	if ((vector >= 2) && (vector <= 11))
+	{
+		char reason[TRACE_FILE_REASON];
+		snprintf(reason, sizeof(reason), "68K exception %u at $%06X", vector, pc);
+		TraceTrigger(reason);
+	}
+}
+
+
+void M68KTraceIdle(uint32_t pc, uint32_t cycles)
+{
+	TraceMarker(TRACE_M68K, TRACE_IDLE, pc, cycles);
+}
@@ -0,0 +1,91 @@
+//
+// trace.h: Execution trace recorder
+//
+// The records of each processor are written in a stream of bytes, cut in
+// chunks which are compressed once full. A chunk starts with a keyframe, so it
+// can be read without the chunks before it, which are dropped over time.
+//
+// Values are unsigned LEB128, unless noted otherwise; the first byte of a record
+// gives its type:
+//  - TRACE_KEYFRAME: instructions recorded so far, PC, number of registers, then
+//    the value of each register
+//  - TRACE_INSTRUCTION: PC, as a signed (zigzag) difference with the PC of the
+//    previous instruction, opcode (16 bits, low byte first), mask of the
+//    registers changed since the previous instruction, then the new value of
+//    each of them XORed with the former one, lowest register first
+//  - TRACE_INTERRUPT: interrupt number (68K vector, or GPU & DSP latch), PC
+//  - TRACE_EXCEPTION: 68K vector, PC
+//  - TRACE_EVENT: events list (EVENT_MAIN or EVENT_JERRY), time elapsed (ns)
+//  - TRACE_IDLE: PC of the idle loop, cycles skipped
+// The 68K registers are D0-D7, A0-A7 & SR; the GPU & DSP ones are R0-R31 of the
+// current bank, & the flags (Z in bit 0, C in bit 1, N in bit 2).
+//
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <stdint.h>
+
+// Traced processors, a stream each
+enum { TRACE_M68K = 0, TRACE_GPU, TRACE_DSP, TRACE_CPUS };
+
+// Records
+enum { TRACE_KEYFRAME = 1, TRACE_INSTRUCTION, TRACE_INTERRUPT, TRACE_EXCEPTION, TRACE_EVENT, TRACE_IDLE };
+
+#define TRACE_M68K_REGISTERS	17
+#define TRACE_RISC_REGISTERS	33
+#define TRACE_MAX_REGISTERS		33
+#define TRACE_RECORD_MAX		192			// Largest record (a keyframe, or an instruction changing all the registers)
+#define TRACE_CHUNK_SIZE		0x10000		// Records of a chunk, before compression
+#define TRACE_CHUNKS			64			// Compressed chunks kept for each stream
+
+// Dump file, little endian: TRACE_FILE_MAGIC, version (32 bits), reason (64
+// characters, NUL padded), number of chunks (32 bits), then for each chunk:
+// processor (8 bits), compressed (8 bits, zlib), reserved (16 bits), sequence,
+// size of the records, size of the data (32 bits each), & the data. Chunks of a
+// processor are in sequence order, the last one not being compressed.
+#define TRACE_FILE_MAGIC		"VJTR"
+#define TRACE_FILE_VERSION		1
+#define TRACE_FILE_REASON		64
+
+// Compressed chunk
+struct TraceChunk
+{
+	uint8_t * data;
+	uint32_t size;
+	uint32_t rawSize;
+	uint32_t sequence;
+};
+
+// Records of a processor; written by the host thread running it only
+struct TraceStream
+{
+	uint8_t * buffer;									// Chunk being written (NULL until the first record)
+	uint32_t used;
+	uint32_t sequence;									// Of the chunk being written
+	uint32_t threadID;									// Host thread writing it
+	uint32_t registerCount;
+	uint32_t pc;										// PC & registers of the previous instruction
+	uint32_t registers[TRACE_MAX_REGISTERS];
+	uint64_t instructions;
+	TraceChunk chunks[TRACE_CHUNKS];					// Ring of the compressed chunks, oldest first
+	uint32_t firstChunk, chunkCount;
+};
+
+struct TraceState
+{
+	bool active;
+	TraceStream streams[TRACE_CPUS];
+};
+
+#define TRACE_ACTIVE	(jaguarMachine->trace.active)
+
+void TraceInit(void);
+void TraceReset(void);
+void TraceInstruction(int cpu, uint32_t pc, uint32_t opcode, const uint32_t * registers, uint32_t flags);
+void TraceMarker(int cpu, int type, uint32_t value1, uint32_t value2);
+bool TraceDump(const char * filename, const char * reason);
+void TraceTrigger(const char * reason);
+void TraceDone(void);
+
+#endif	// __TRACE_H__
@@ -100,6 +100,9 @@ HEADERS = \
 	src/gui/keygrabber.h \
 	src/gui/mainwin.h \
 	src/gui/profile.h \
+	src/gui/renderthread.h \
+	src/gui/capturethread.h \
+	src/gui/framescheduler.h \
 	src/gui/emustatus.h \
 	src/gui/debug/cpubrowser.h \
 	src/gui/debug/hwregsblitterbrowser.h \
@@ -124,6 +127,7 @@ HEADERS = \
 	src/debugger/DWARFManager.h \
 	src/debugger/memory1browser.h \
 	src/debugger/heapallocatorbrowser.h \
+	src/debugger/heatmapbrowser.h \
 	src/debugger/BreakpointsWin.h \
 	src/debugger/VideoWin.h \
 	src/debugger/FilesrcListWin.h \
@@ -159,6 +163,9 @@ SOURCES = \
 	src/gui/keygrabber.cpp \
 	src/gui/mainwin.cpp \
 	src/gui/profile.cpp \
+	src/gui/renderthread.cpp \
+	src/gui/capturethread.cpp \
+	src/gui/framescheduler.cpp \
 	src/gui/emustatus.cpp \
 	src/gui/debug/cpubrowser.cpp \
 	src/gui/debug/hwregsblitterbrowser.cpp \
@@ -183,6 +190,7 @@ SOURCES = \
 	src/debugger/DWARFManager.cpp \
 	src/debugger/memory1browser.cpp \
 	src/debugger/heapallocatorbrowser.cpp \
+	src/debugger/heatmapbrowser.cpp \
 	src/debugger/BreakpointsWin.cpp \
 	src/debugger/VideoWin.cpp \
 	src/debugger/FilesrcListWin.cpp \